@@ -168,6 +168,100 @@ typedef struct SDL_AudioSpec
 struct SDL_AudioStream;  /* this is opaque to the outside world. */
 typedef struct SDL_AudioStream SDL_AudioStream;
 
+/**
+ * The number of buckets in SDL_AudioDeviceStats::process_histogram.
+ */
+#define SDL_AUDIO_STATS_HISTOGRAM_BUCKETS 8
+
+/**
+ * Statistics about the thread that feeds an audio device.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ */
+typedef struct SDL_AudioDeviceStats
+{
+    Uint64 period_ns;           /**< Length of one device buffer, in nanoseconds */
+    Uint64 periods;             /**< Number of buffers the device thread has processed */
+    Uint64 process_ns_total;    /**< Time spent mixing, converting and handing buffers to the device, in nanoseconds */
+    Uint64 process_ns_max;      /**< Longest time spent on a single buffer, in nanoseconds */
+    Uint64 process_histogram[SDL_AUDIO_STATS_HISTOGRAM_BUCKETS]; /**< Buffers by processing time: bucket i counts buffers that took i/8 to (i+1)/8 of a period, the last bucket also counts anything slower */
+    Uint64 xruns;               /**< Buffers that took longer than a period to process, so the device likely ran dry or overflowed */
+    Uint64 late_wakeups;        /**< Times the device thread woke up more than half a period later than expected */
+    Uint64 postmix_ns_total;    /**< Time spent in post-mix callbacks, in nanoseconds; this is part of process_ns_total */
+    Uint64 postmix_ns_max;      /**< Longest time spent in post-mix callbacks for a single buffer, in nanoseconds */
+} SDL_AudioDeviceStats;
+
+/**
+ * Statistics about an audio stream bound to an audio device.
+ *
+ * \sa SDL_GetAudioStreamStats
+ */
+typedef struct SDL_AudioStreamStats
+{
+    int queued_frames;          /**< Sample frames waiting in the stream the last time the device thread used it, in the stream's input format */
+    Uint64 device_transfers;    /**< Number of times the device thread pulled data from, or pushed data into, the stream */
+    Uint64 starved;             /**< Times an output device asked for more data than the stream had */
+    Uint64 convert_ns_total;    /**< Time the device thread spent moving data through this stream, including conversion and the stream's callbacks, in nanoseconds */
+    Uint64 convert_ns_max;      /**< Longest single conversion, in nanoseconds */
+} SDL_AudioStreamStats;
+
+/**
+ * A callback that processes the mixed audio of a device.
+ *
+ * The buffer holds float32 samples in the device's channel layout and sample
+ * rate, described by `spec`. The callback may change the samples in place,
+ * for example to apply a limiter or an equalizer. It is called from the
+ * device thread while the device is locked, once per device buffer, so it
+ * should return quickly.
+ *
+ * \param userdata the pointer passed to SDL_AddAudioPostmixCallback()
+ * \param spec the format of the buffer; `format` is always SDL_AUDIO_F32SYS
+ * \param buffer the mixed samples, which can be modified
+ * \param buflen the size of `buffer` in bytes
+ *
+ * \since This datatype is available since SDL 3.0.0.
+ *
+ * \sa SDL_AddAudioPostmixCallback
+ */
+typedef void (SDLCALL *SDL_AudioPostmixCallback)(void *userdata, const SDL_AudioSpec *spec, float *buffer, int buflen);
+
+/**
+ * Timing statistics of a post-mix callback.
+ *
+ * \sa SDL_GetAudioPostmixStats
+ */
+typedef struct SDL_AudioPostmixStats
+{
+    Uint64 calls;               /**< Number of times the callback was called */
+    Uint64 ns_total;            /**< Total time spent in the callback, in nanoseconds */
+    Uint64 ns_max;              /**< Longest single call, in nanoseconds */
+} SDL_AudioPostmixStats;
+
+/**
+ * The number of device buffers kept for SDL_AudioCaptureReader.
+ *
+ * \sa SDL_CreateAudioCaptureReader
+ */
+#define SDL_AUDIO_CAPTURE_RING_BUFFERS 8
+
+/**
+ * A consumer of a capture device's raw buffers.
+ *
+ * \sa SDL_CreateAudioCaptureReader
+ */
+typedef struct SDL_AudioCaptureReader SDL_AudioCaptureReader;
+
+/**
+ * Statistics about an SDL_AudioCaptureReader.
+ *
+ * \sa SDL_GetAudioCaptureReaderStats
+ */
+typedef struct SDL_AudioCaptureReaderStats
+{
+    Uint64 buffers;             /**< Number of device buffers the reader has acquired */
+    Uint64 dropped;             /**< Device buffers that were overwritten before the reader got to them */
+} SDL_AudioCaptureReaderStats;
+
 
 /* Function prototypes */
 
@@ -494,6 +588,336 @@ extern DECLSPEC int SDLCALL SDL_ResumeAudioDevice(SDL_AudioDeviceID dev);
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_IsAudioDevicePaused(SDL_AudioDeviceID dev);
 
+/**
+ * Change the gain of an audio device.
+ *
+ * The gain is a multiplier applied to every audio stream bound to the device
+ * when the device mixes them. The default gain is 1.0f, which leaves the
+ * audio unchanged. 0.0f silences the device while its bound streams keep
+ * progressing, unlike SDL_PauseAudioDevice(). Values above 1.0f amplify the
+ * audio; mixing happens in float32, so nothing clips until the final mix is
+ * converted to the hardware's format, and devices that use a float32 format
+ * receive the mix unclamped.
+ *
+ * Physical devices do not have a gain, only logical devices created through
+ * SDL_OpenAudioDevice() can have one. Capture devices ignore their gain.
+ *
+ * \param devid a device opened by SDL_OpenAudioDevice()
+ * \param gain the new gain, 0.0f or greater
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioDeviceGain
+ * \sa SDL_SetAudioStreamGain
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioDeviceGain(SDL_AudioDeviceID devid, float gain);
+
+/**
+ * Get the gain of an audio device.
+ *
+ * \param devid a device opened by SDL_OpenAudioDevice()
+ * \returns the gain of the device, or -1.0f on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetAudioDeviceGain
+ */
+extern DECLSPEC float SDLCALL SDL_GetAudioDeviceGain(SDL_AudioDeviceID devid);
+
+/**
+ * Get statistics about the thread that feeds an audio device.
+ *
+ * SDL measures every buffer the device thread processes: how long it spent
+ * mixing, converting and handing the buffer to the hardware, compared to the
+ * length of the buffer. A device thread that regularly needs most of a period
+ * is at risk of audio dropouts; `xruns` counts the buffers that took longer
+ * than a period.
+ *
+ * Logical devices report the statistics of their physical device, since all
+ * logical devices on a physical device are processed together. The
+ * statistics cover the time since the device was opened or since the last
+ * call to SDL_ResetAudioDeviceStats().
+ *
+ * \param devid the instance ID of an opened device
+ * \param stats on return, filled in with the device's statistics
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ResetAudioDeviceStats
+ * \sa SDL_GetAudioStreamStats
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceStats(SDL_AudioDeviceID devid, SDL_AudioDeviceStats *stats);
+
+/**
+ * Reset the statistics of an audio device.
+ *
+ * This clears the counters of the physical device and of every audio stream
+ * bound to it, so a measurement can start fresh.
+ *
+ * \param devid the instance ID of an opened device
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ */
+extern DECLSPEC int SDLCALL SDL_ResetAudioDeviceStats(SDL_AudioDeviceID devid);
+
+/**
+ * Add a callback that processes the mix of an output device.
+ *
+ * Callbacks added to a logical device (an ID from SDL_OpenAudioDevice())
+ * see only the streams bound to that logical device, after stream and device
+ * gain were applied. Their output is then mixed with the other logical
+ * devices on the same hardware. Callbacks added to a physical device see the
+ * final mix of all its logical devices, just before it is converted to the
+ * hardware's format. Either way, processing happens inside the device thread
+ * on the float32 mix buffer, so there is no added latency or copy.
+ *
+ * Several callbacks can be added to the same device; they run in the order
+ * they were added, each one processing the output of the previous one. The
+ * same callback and userdata pair can only be added once per device.
+ *
+ * Callbacks on a physical device are removed when the physical device closes,
+ * which happens when its last logical device is closed. Callbacks on a
+ * logical device are removed when it is closed.
+ *
+ * Capture devices don't mix, so they don't have post-mix callbacks.
+ *
+ * \param devid the instance ID of an opened logical device, or of an opened
+ *              physical output device
+ * \param callback the function to call
+ * \param userdata a pointer that is passed to `callback`
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RemoveAudioPostmixCallback
+ * \sa SDL_GetAudioPostmixStats
+ */
+extern DECLSPEC int SDLCALL SDL_AddAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallback callback, void *userdata);
+
+/**
+ * Remove a callback added with SDL_AddAudioPostmixCallback().
+ *
+ * Once this function returns, the device thread won't call the callback
+ * again.
+ *
+ * \param devid the device the callback was added to
+ * \param callback the function that was added
+ * \param userdata the pointer that was added with it
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AddAudioPostmixCallback
+ */
+extern DECLSPEC int SDLCALL SDL_RemoveAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallback callback, void *userdata);
+
+/**
+ * Get timing statistics of a post-mix callback.
+ *
+ * The counters start when the callback is added, and are cleared by
+ * SDL_ResetAudioDeviceStats() on its physical device.
+ *
+ * \param devid the device the callback was added to
+ * \param callback the function that was added
+ * \param userdata the pointer that was added with it
+ * \param stats on return, filled in with the callback's statistics
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AddAudioPostmixCallback
+ * \sa SDL_GetAudioDeviceStats
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioPostmixStats(SDL_AudioDeviceID devid, SDL_AudioPostmixCallback callback, void *userdata, SDL_AudioPostmixStats *stats);
+
+/**
+ * Process buffers on an audio device that is rendered offline.
+ *
+ * When SDL_HINT_AUDIO_OFFLINE_MODE is set to "manual" and the disk or dummy
+ * driver is in use, opened devices don't get a thread of their own. Instead,
+ * each call to this function mixes and plays (or captures and distributes)
+ * the given number of device buffers on the calling thread, exactly as the
+ * device thread would have, and as fast as the CPU allows. Since nothing
+ * depends on timing, the output of the disk driver is sample-exact and the
+ * same on every run.
+ *
+ * Audio stream callbacks of bound streams are called from the calling
+ * thread. If another thread closes the device while this function is
+ * running, closing waits for the current buffer to finish and this function
+ * returns an error.
+ *
+ * \param devid the instance ID of an opened device
+ * \param periods the number of device buffers to process
+ * \returns the number of sample frames processed on success or a negative
+ *          error code on failure; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ */
+extern DECLSPEC int SDLCALL SDL_StepAudioDevice(SDL_AudioDeviceID devid, int periods);
+
+/**
+ * Get the position of an audio device's clock.
+ *
+ * The clock counts the sample frames the device thread has handed to the
+ * hardware (or received from it, for capture devices) since the device was
+ * opened. It advances by one device buffer at a time. Along with it, SDL
+ * records when the most recent buffer was handed over, as returned by
+ * SDL_GetTicksNS(), so an app can estimate the current position between
+ * buffers from the device's sample rate.
+ *
+ * Frame numbers from this clock are what SDL_ScheduleAudioStream() expects.
+ * Logical devices report the clock of their physical device, since they are
+ * all processed together.
+ *
+ * \param devid the instance ID of an opened device
+ * \param frames on return, the number of sample frames processed so far.
+ *               May be NULL.
+ * \param timestamp_ns on return, when the last buffer was processed, in
+ *                     nanoseconds, or 0 if none has been yet. May be NULL.
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ScheduleAudioStream
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceClock(SDL_AudioDeviceID devid, Uint64 *frames, Uint64 *timestamp_ns);
+
+/**
+ * Create a reader of a capture device's raw buffers.
+ *
+ * Audio streams bound to a capture device each get their own copy of the
+ * captured audio. A reader instead gets pointers straight into the buffers
+ * the device captured into, in the device's own format (see
+ * SDL_GetAudioDeviceFormat()), without any copies.
+ *
+ * All readers of a device share a ring of SDL_AUDIO_CAPTURE_RING_BUFFERS
+ * device buffers, which the device thread fills without ever waiting for a
+ * reader. A reader that falls further behind than that loses the oldest
+ * buffers, which is counted in SDL_AudioCaptureReaderStats::dropped. A new
+ * reader starts with the next buffer the device captures.
+ *
+ * The reader stops working when its device is closed; destroy it with
+ * SDL_DestroyAudioCaptureReader().
+ *
+ * \param devid the instance ID of an opened capture device
+ * \returns a new reader on success or NULL on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AcquireAudioCaptureBuffer
+ * \sa SDL_DestroyAudioCaptureReader
+ */
+extern DECLSPEC SDL_AudioCaptureReader *SDLCALL SDL_CreateAudioCaptureReader(SDL_AudioDeviceID devid);
+
+/**
+ * Get the next captured buffer a reader hasn't seen yet.
+ *
+ * The buffer stays valid, and the device thread won't overwrite it, until
+ * it is given back with SDL_ReleaseAudioCaptureBuffer(). Hold it briefly: a
+ * held buffer can't be reused, so every reader loses the buffer the device
+ * captures in its place. Only one buffer can be held per reader at a time.
+ *
+ * \param reader the reader to use
+ * \param buffer on return, points to the captured audio, in the device's
+ *               format
+ * \returns the size of the buffer in bytes, 0 if the reader is caught up,
+ *          or a negative error code on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but a
+ *               reader should only be used by one thread at a time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_ReleaseAudioCaptureBuffer
+ */
+extern DECLSPEC int SDLCALL SDL_AcquireAudioCaptureBuffer(SDL_AudioCaptureReader *reader, const void **buffer);
+
+/**
+ * Give back the buffer from SDL_AcquireAudioCaptureBuffer().
+ *
+ * \param reader the reader that holds a buffer
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but a
+ *               reader should only be used by one thread at a time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AcquireAudioCaptureBuffer
+ */
+extern DECLSPEC int SDLCALL SDL_ReleaseAudioCaptureBuffer(SDL_AudioCaptureReader *reader);
+
+/**
+ * Get statistics about a capture reader.
+ *
+ * \param reader the reader to query
+ * \param stats on return, filled in with the reader's statistics
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but a
+ *               reader should only be used by one thread at a time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_AcquireAudioCaptureBuffer
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioCaptureReaderStats(SDL_AudioCaptureReader *reader, SDL_AudioCaptureReaderStats *stats);
+
+/**
+ * Destroy a capture reader.
+ *
+ * A buffer the reader still holds is released.
+ *
+ * \param reader the reader to destroy
+ *
+ * \threadsafety It is safe to call this function from any thread, but a
+ *               reader should only be used by one thread at a time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateAudioCaptureReader
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyAudioCaptureReader(SDL_AudioCaptureReader *reader);
+
 /**
  * Close a previously-opened audio device.
  *
@@ -536,6 +960,12 @@ extern DECLSPEC void SDLCALL SDL_CloseAudioDevice(SDL_AudioDeviceID devid);
  * settings. The caller is welcome to change the other end of the stream's
  * format at any time.
  *
+ * Output devices mix their streams in float32, so a stream bound to an output
+ * device gets an SDL_AUDIO_F32SYS output format at the device's channel
+ * count and frequency, whatever format the device itself uses. The mix is
+ * clamped to -1.0f..1.0f only when it is converted to an integer device
+ * format; devices that use a float32 format receive the mix unclamped.
+ *
  * \param devid an audio device to bind a stream to.
  * \param streams an array of audio streams to unbind.
  * \param num_streams Number streams listed in the `streams` array.
@@ -640,6 +1070,40 @@ extern DECLSPEC void SDLCALL SDL_UnbindAudioStream(SDL_AudioStream *stream);
  */
 extern DECLSPEC SDL_AudioDeviceID SDLCALL SDL_GetAudioStreamBinding(SDL_AudioStream *stream);
 
+/**
+ * Schedule a bound output stream to start and stop at exact device frames.
+ *
+ * Normally a bound stream plays from the next buffer the device thread
+ * mixes, which can be up to a buffer late. A scheduled stream is silent
+ * until the device clock reaches `start_frame`, and its first sample frame is
+ * mixed into exactly that frame of the device's output, even if that's the
+ * middle of a buffer. From `stop_frame` on, the stream is silent again; data
+ * it still has stays queued.
+ *
+ * A stream plays as soon as it is bound and has data, so bind it while it's
+ * still empty, schedule it, and then put data in it. A start frame the
+ * device has already passed starts the stream right away.
+ * Scheduling the stream again replaces the previous schedule, and
+ * `SDL_ScheduleAudioStream(stream, 0, 0)` clears it. The schedule is cleared
+ * when the stream is unbound.
+ *
+ * \param stream an audio stream bound to an output device
+ * \param start_frame the device frame the stream starts at, or 0 to start
+ *                    right away
+ * \param stop_frame the device frame the stream stops at, or 0 to play until
+ *                   it runs out
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioDeviceClock
+ * \sa SDL_BindAudioStream
+ */
+extern DECLSPEC int SDLCALL SDL_ScheduleAudioStream(SDL_AudioStream *stream, Uint64 start_frame, Uint64 stop_frame);
+
 
 /**
  * Create a new audio stream.
@@ -666,6 +1130,10 @@ extern DECLSPEC SDL_AudioStream *SDLCALL SDL_CreateAudioStream(const SDL_AudioSp
 /**
  * Query the current format of an audio stream.
  *
+ * A stream bound to an output device reports an SDL_AUDIO_F32SYS output
+ * format, which is what the device mixes in, rather than the device's own
+ * format.
+ *
  * \param stream the SDL_AudioStream to query.
  * \param src_spec Where to store the input audio format; ignored if NULL.
  * \param dst_spec Where to store the output audio format; ignored if NULL.
@@ -708,6 +1176,66 @@ extern DECLSPEC int SDLCALL SDL_SetAudioStreamFormat(SDL_AudioStream *stream,
                                                      const SDL_AudioSpec *src_spec,
                                                      const SDL_AudioSpec *dst_spec);
 
+/**
+ * Change the gain of an audio stream.
+ *
+ * The gain is a multiplier applied to the stream's audio when it is mixed
+ * into the output device it is bound to, on top of the device's own gain.
+ * The default gain is 1.0f, which leaves the audio unchanged. Data read with
+ * SDL_GetAudioStreamData() is not affected.
+ *
+ * \param stream the stream to change
+ * \param gain the new gain, 0.0f or greater
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioStreamGain
+ * \sa SDL_SetAudioDeviceGain
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioStreamGain(SDL_AudioStream *stream, float gain);
+
+/**
+ * Get the gain of an audio stream.
+ *
+ * \param stream the stream to query
+ * \returns the gain of the stream, or -1.0f on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetAudioStreamGain
+ */
+extern DECLSPEC float SDLCALL SDL_GetAudioStreamGain(SDL_AudioStream *stream);
+
+/**
+ * Get statistics about how an audio device thread uses a stream.
+ *
+ * The counters are updated while the stream is bound to a device, each time
+ * the device thread pulls data from it (or pushes captured data into it).
+ * They keep their values when the stream is unbound.
+ *
+ * \param stream the audio stream to query
+ * \param stats on return, filled in with the stream's statistics
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ * \sa SDL_ResetAudioDeviceStats
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioStreamStats(SDL_AudioStream *stream, SDL_AudioStreamStats *stats);
+
 /**
  * Add data to be converted/resampled to the stream.
  *
@@ -1183,6 +1711,180 @@ extern DECLSPEC int SDLCALL SDL_LoadWAV_RW(SDL_RWops * src, SDL_bool freesrc,
 extern DECLSPEC int SDLCALL SDL_LoadWAV(const char *path, SDL_AudioSpec * spec,
                                         Uint8 ** audio_buf, Uint32 * audio_len);
 
+/* SDL_WAVReader decodes a WAVE file on demand instead of loading it whole.
+    - Memory use is constant, no matter how long the file is.
+    - It can seek to any sample frame.
+    - It can feed an SDL_AudioStream through the stream's get callback.
+ */
+struct SDL_WAVReader;  /* this is opaque to the outside world. */
+typedef struct SDL_WAVReader SDL_WAVReader;
+
+/**
+ * Open a WAVE file for streaming decoding.
+ *
+ * This parses the headers of the WAVE file like SDL_LoadWAV_RW() does, but
+ * leaves the data chunk in `src`. Audio is then decoded in small pieces with
+ * SDL_ReadWAVReader(), so memory use does not depend on the length of the
+ * file and playback can start right away. Compressed formats (MS ADPCM and
+ * IMA ADPCM) are decoded one block at a time.
+ *
+ * `src` must stay valid and seekable for the lifetime of the reader. The same
+ * formats and hints as SDL_LoadWAV_RW() are supported.
+ *
+ * \param src The data source for the WAVE data
+ * \param freesrc If SDL_TRUE, calls SDL_RWclose() on `src` when the reader is
+ *                closed, or before returning if this function fails
+ * \param spec A pointer to an SDL_AudioSpec that will be set to the format
+ *             of the data returned by SDL_ReadWAVReader()
+ * \returns a new SDL_WAVReader on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CloseWAVReader
+ * \sa SDL_ReadWAVReader
+ * \sa SDL_SeekWAVReader
+ */
+extern DECLSPEC SDL_WAVReader *SDLCALL SDL_OpenWAVReader_RW(SDL_RWops *src, SDL_bool freesrc, SDL_AudioSpec *spec);
+
+/**
+ * Open a WAVE file from a file path for streaming decoding.
+ *
+ * This is a convenience function that is effectively the same as:
+ *
+ * ```c
+ * SDL_OpenWAVReader_RW(SDL_RWFromFile(path, "rb"), SDL_TRUE, spec);
+ * ```
+ *
+ * \param path The file path of the WAV file to open.
+ * \param spec A pointer to an SDL_AudioSpec that will be set to the format
+ *             of the data returned by SDL_ReadWAVReader()
+ * \returns a new SDL_WAVReader on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CloseWAVReader
+ * \sa SDL_OpenWAVReader_RW
+ */
+extern DECLSPEC SDL_WAVReader *SDLCALL SDL_OpenWAVReader(const char *path, SDL_AudioSpec *spec);
+
+/**
+ * Decode audio from a WAVE reader.
+ *
+ * Decodes as many whole sample frames as fit into `len` bytes, starting at
+ * the current position, and advances the position. The data is in the format
+ * reported by SDL_OpenWAVReader_RW().
+ *
+ * \param reader the WAVE reader to decode from
+ * \param buf a buffer to fill with audio data
+ * \param len the maximum number of bytes to fill
+ * \returns the number of bytes read (zero at the end of the data), or -1 on
+ *          error; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but a
+ *               single reader must not be used from multiple threads at
+ *               the same time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SeekWAVReader
+ */
+extern DECLSPEC int SDLCALL SDL_ReadWAVReader(SDL_WAVReader *reader, void *buf, int len);
+
+/**
+ * Set the position of a WAVE reader.
+ *
+ * Positions are in sample frames and are clamped to the length of the audio
+ * data. For compressed formats, the block containing the new position is
+ * decoded on the next read.
+ *
+ * \param reader the WAVE reader to seek
+ * \param frame the sample frame to continue decoding from
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but a
+ *               single reader must not be used from multiple threads at
+ *               the same time.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_TellWAVReader
+ * \sa SDL_GetWAVReaderLength
+ */
+extern DECLSPEC int SDLCALL SDL_SeekWAVReader(SDL_WAVReader *reader, Sint64 frame);
+
+/**
+ * Get the current position of a WAVE reader.
+ *
+ * \param reader the WAVE reader to query
+ * \returns the next sample frame to be decoded, or -1 on error; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SeekWAVReader
+ */
+extern DECLSPEC Sint64 SDLCALL SDL_TellWAVReader(SDL_WAVReader *reader);
+
+/**
+ * Get the length of the audio data of a WAVE reader.
+ *
+ * \param reader the WAVE reader to query
+ * \returns the number of sample frames in the file, or -1 on error; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ */
+extern DECLSPEC Sint64 SDLCALL SDL_GetWAVReaderLength(SDL_WAVReader *reader);
+
+/**
+ * Feed an audio stream from a WAVE reader.
+ *
+ * This sets the input format of `stream` to the format of the reader and
+ * installs a get callback (see SDL_SetAudioStreamGetCallback()) that decodes
+ * just as much audio as the stream needs. The stream is flushed when the
+ * reader reaches the end of the data. Seeking the reader while it is attached
+ * must be done with the stream locked.
+ *
+ * The reader must stay open as long as it is attached. Pass a NULL reader to
+ * detach it; this removes the stream's get callback.
+ *
+ * \param stream the audio stream to feed
+ * \param reader the WAVE reader to decode from, or NULL to detach
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SetAudioStreamGetCallback
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioStreamWAVReader(SDL_AudioStream *stream, SDL_WAVReader *reader);
+
+/**
+ * Close a WAVE reader.
+ *
+ * \param reader the WAVE reader to close
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_OpenWAVReader_RW
+ */
+extern DECLSPEC void SDLCALL SDL_CloseWAVReader(SDL_WAVReader *reader);
+
 
 
 #define SDL_MIX_MAXVOLUME 128
@@ -304,6 +304,64 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_DEVICE_STREAM_ROLE "SDL_AUDIO_DEVICE_STREAM_ROLE"
 
+/**
+ *  \brief  A variable that makes the disk and dummy audio drivers simulate a busy device thread.
+ *
+ *  The value is a percentage of the device's buffer period that the driver
+ *  spends blocked each time it plays or captures a buffer, as if mixing or
+ *  effects were expensive. Values of 100 or more make the device thread fall
+ *  behind, which shows up in SDL_GetAudioDeviceStats(). This is meant for
+ *  testing how an application handles an overloaded audio thread.
+ *
+ *  The default value is "0". This hint is checked when a device is opened.
+ */
+#define SDL_HINT_AUDIO_SIMULATED_LOAD "SDL_AUDIO_SIMULATED_LOAD"
+
+/**
+ *  \brief  A variable that lets the disk and dummy audio drivers render faster than real time.
+ *
+ *  These drivers don't need to keep pace with a sound card, so they can be
+ *  used to render audio offline, for batch processing or automated tests.
+ *
+ *  This variable can be set to the following values:
+ *    "realtime"  - Process one buffer per buffer period, like real hardware (the default)
+ *    "fast"      - The device thread processes buffers as fast as it can
+ *    "manual"    - There is no device thread; the application processes buffers
+ *                  with SDL_StepAudioDevice(), so the output is sample-exact
+ *                  and doesn't depend on timing
+ *
+ *  This hint is checked when a device is opened and is ignored by other audio drivers.
+ */
+#define SDL_HINT_AUDIO_OFFLINE_MODE "SDL_AUDIO_OFFLINE_MODE"
+
+/**
+ *  \brief  A variable controlling whether bound streams that need the same conversion are converted together.
+ *
+ *  When many streams bound to one opened output device share a source format
+ *  (for example, dozens of 22050Hz mono sound effects on a 48000Hz stereo
+ *  device), SDL can sum their input at the source rate and then convert and
+ *  resample that sum once per buffer, instead of once per stream. Groups of
+ *  a single stream are mixed as usual.
+ *
+ *  Resampling is linear, so streams that are bound together sound the same as
+ *  they would converted separately, apart from float rounding. A stream that
+ *  joins a group later is resampled in step with the group rather than from
+ *  where its own resampler was, so its output can be shifted by a fraction of
+ *  a source sample frame and won't match a separately converted stream.
+ *
+ *  For capture devices, the captured audio is converted once for each
+ *  distinct output format among the bound streams, on the device thread, and
+ *  each stream gets a copy of the converted audio. The streams still report
+ *  the device format as their input format.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Each stream is converted on its own (the default)
+ *    "1"       - Streams that need the same conversion are converted together
+ *
+ *  This hint is checked when a device is opened.
+ */
+#define SDL_HINT_AUDIO_GROUP_STREAMS "SDL_AUDIO_GROUP_STREAMS"
+
 /**
  *  \brief  A variable controlling whether SDL updates joystick state when getting input events
  *
@@ -347,6 +405,28 @@ extern "C" {
  */
 #define SDL_HINT_BMP_SAVE_LEGACY_FORMAT "SDL_BMP_SAVE_LEGACY_FORMAT"
 
+/**
+ *  \brief  Controls how many threads SDL uses to split up large conversions.
+ *
+ *  SDL splits this work across several threads:
+ *    - decoding MS ADPCM and IMA ADPCM WAVE files in SDL_LoadWAV_RW()
+ *    - flipping and converting the pixels of BMP images in SDL_LoadBMP_RW()
+ *      and SDL_SaveBMP_RW()
+ *    - SDL_PremultiplyAlpha(), SDL_UnpremultiplyAlpha(), and turning a color
+ *      key into alpha in SDL_ConvertSurface()
+ *
+ *  Small conversions always run on the calling thread, as starting a thread
+ *  would cost more than it saves.
+ *
+ *  This variable can be set to the following values:
+ *
+ *    "0" or "1"   - Convert on the calling thread only
+ *    "N"          - Use up to N threads
+ *
+ *  By default SDL uses up to one thread per CPU core.
+ */
+#define SDL_HINT_CONVERT_THREADS "SDL_CONVERT_THREADS"
+
 /**
  *  \brief Override for SDL_GetDisplayUsableBounds()
  *
@@ -724,6 +804,17 @@ extern "C" {
   */
 #define SDL_HINT_JOYSTICK_HIDAPI_COMBINE_JOY_CONS "SDL_JOYSTICK_HIDAPI_COMBINE_JOY_CONS"
 
+/**
+  *  \brief  A variable controlling whether axis motion is coalesced when the HIDAPI drivers read several input reports in one update
+  *
+  *  This variable can be set to the following values:
+  *    "0"       - Every axis change in every input report is sent (the default)
+  *    "1"       - Only the final position of each axis is sent, button, hat and sensor changes are always sent
+  *
+  *  This hint can be changed at any time.
+  */
+#define SDL_HINT_JOYSTICK_HIDAPI_COALESCE_AXES "SDL_JOYSTICK_HIDAPI_COALESCE_AXES"
+
 /**
   *  \brief  A variable controlling whether Nintendo Switch Joy-Con controllers will be in vertical mode when using the HIDAPI driver
   *
@@ -1034,12 +1125,18 @@ extern "C" {
 
 /**
   *  \brief  A variable controlling whether a separate thread should be used
-  *          for handling joystick detection and raw input messages on Windows
+  *          for handling joystick detection and raw input messages on Windows,
+  *          and for reading joystick input on Linux
+  *
+  *  On Linux the thread waits on all open joystick and sensor devices, and
+  *  joystick events are delivered as soon as the input arrives, without
+  *  waiting for the application to pump events.
   *
   *  This variable can be set to the following values:
   *    "0"       - A separate thread is not used (the default)
-  *    "1"       - A separate thread is used for handling raw input messages
+  *    "1"       - A separate thread is used for handling joystick input
   *
+  *  This hint should be set before SDL is initialized.
   */
 #define SDL_HINT_JOYSTICK_THREAD "SDL_JOYSTICK_THREAD"
 
@@ -1539,6 +1636,27 @@ extern "C" {
  */
 #define SDL_HINT_SCREENSAVER_INHIBIT_ACTIVITY_NAME "SDL_SCREENSAVER_INHIBIT_ACTIVITY_NAME"
 
+/**
+ *  \brief  A variable controlling whether SDL_ConvertSurface() dithers when converting to an 8-bit palette.
+ *
+ *  By default, SDL_ConvertSurface() maps each pixel of a surface without a
+ *  palette to an SDL_PIXELFORMAT_INDEX8 surface through a fixed 3-3-2 color
+ *  cube, which can band badly. With dithering, each pixel is matched to the
+ *  closest palette color, after spreading the rounding error around.
+ *
+ *  Surfaces with a color key are never dithered, so the key stays exact.
+ *
+ *  This variable can be set to the following values:
+ *    "none"            - Don't dither (the default)
+ *    "ordered"         - Add a 4x4 Bayer pattern, which is fast and stable
+ *                        between frames
+ *    "floyd-steinberg" - Diffuse each pixel's error to its neighbors, which
+ *                        looks smoother but is slower
+ *
+ *  This hint is checked each time a surface is converted.
+ */
+#define SDL_HINT_SURFACE_DITHER "SDL_SURFACE_DITHER"
+
 /**
  *  \brief Specifies whether SDL_THREAD_PRIORITY_TIME_CRITICAL should be treated as realtime.
  *
@@ -1720,6 +1838,38 @@ extern "C" {
  */
 #define SDL_HINT_VIDEO_MINIMIZE_ON_FOCUS_LOSS   "SDL_VIDEO_MINIMIZE_ON_FOCUS_LOSS"
 
+/**
+ *  \brief  A variable controlling whether the offscreen video driver exports window frames through shared memory.
+ *
+ *  This variable can be set to the number of frames in the ring:
+ *    "0"       - Frames are not exported (the default)
+ *    "N"       - Window framebuffers live in a ring of N frames (at least 2) in
+ *                a memfd, which another process can map to read the frames
+ *                without any copies or disk I/O.
+ *
+ *  The ring layout is described in SDL_offscreen.h, which isn't included by
+ *  SDL.h. The ring starts with an SDL_OffscreenFrameRingHeader describing the frame
+ *  format and the number of the latest frame, followed by the frames. Each
+ *  frame starts with an SDL_OffscreenFrameHeader with its frame number,
+ *  presentation timestamp and the rectangles that changed. The frame number is
+ *  0 while SDL draws into the frame, readers should check it again after
+ *  copying a frame to make sure it wasn't overwritten.
+ *
+ *  The file descriptor of the memfd is available with
+ *  SDL_GetWindowData(window, SDL_WINDOW_DATA_OFFSCREEN_FRAME_RING_FD). The
+ *  window surface pixels move to the next frame of the ring after each call
+ *  to SDL_UpdateWindowSurface(), and start out matching the frame that was
+ *  just presented in every area that was updated. Only the updated areas are
+ *  copied between frames, so anything drawn outside the rectangles passed to
+ *  SDL_UpdateWindowSurfaceRects() may not show up in later frames.
+ *
+ *  This is only available on Linux, and only for windows that use the software
+ *  framebuffer, see SDL_HINT_FRAMEBUFFER_ACCELERATION.
+ *
+ *  This hint must be set before the window surface is created.
+ */
+#define SDL_HINT_VIDEO_OFFSCREEN_FRAME_RING "SDL_VIDEO_OFFSCREEN_FRAME_RING"
+
 /**
  *  \brief  A variable controlling whether the libdecor Wayland backend is allowed to be used.
  *
@@ -2586,6 +2736,9 @@ extern DECLSPEC void SDLCALL SDL_ResetHints(void);
 /**
  * Get the value of a hint.
  *
+ * The environment variable for a hint is checked every time the hint is
+ * read, so changes to the environment take effect right away.
+ *
  * \param name the hint to query
  * \returns the string value of a hint or NULL if the hint isn't set.
  *
@@ -2611,6 +2764,71 @@ extern DECLSPEC const char * SDLCALL SDL_GetHint(const char *name);
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_GetHintBoolean(const char *name, SDL_bool default_value);
 
+/**
+ * A handle to a hint, resolved once with SDL_GetHintHandle().
+ *
+ * Reading a hint through a handle skips the name lookup, and is safe to do
+ * from any thread while other threads change the hint. The hint's
+ * environment variable is still checked on every read.
+ */
+struct SDL_HintHandle;
+typedef struct SDL_HintHandle SDL_HintHandle;
+
+/**
+ * Get a handle to a hint for fast repeated queries.
+ *
+ * The handle stays valid until SDL_ClearHints() is called, which happens
+ * during SDL_Quit(). The hint doesn't need to be set to get a handle for it.
+ *
+ * \param name the hint to look up
+ * \returns a handle to the hint or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetHintHandleValue
+ * \sa SDL_GetHintHandleBoolean
+ */
+extern DECLSPEC SDL_HintHandle * SDLCALL SDL_GetHintHandle(const char *name);
+
+/**
+ * Get the value of a hint through a handle.
+ *
+ * This returns the same value as SDL_GetHint(), without looking the hint up
+ * by name. The returned string may be freed once the hint has been changed
+ * several more times, so copy it if you need to keep it.
+ *
+ * \param handle the hint handle, from SDL_GetHintHandle()
+ * \returns the string value of a hint or NULL if the hint isn't set.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetHintHandle
+ * \sa SDL_GetHint
+ */
+extern DECLSPEC const char * SDLCALL SDL_GetHintHandleValue(SDL_HintHandle *handle);
+
+/**
+ * Get the boolean value of a hint through a handle.
+ *
+ * \param handle the hint handle, from SDL_GetHintHandle()
+ * \param default_value the value to return if the hint does not exist
+ * \returns the boolean value of a hint or the provided default value if the
+ *          hint does not exist.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetHintHandle
+ * \sa SDL_GetHintBoolean
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_GetHintHandleBoolean(SDL_HintHandle *handle, SDL_bool default_value);
+
 /**
  * Type definition of the hint callback function.
  *
@@ -42,6 +42,7 @@
 #include <SDL3/SDL_error.h>
 #include <SDL3/SDL_guid.h>
 #include <SDL3/SDL_mutex.h>
+#include <SDL3/SDL_sensor.h>
 
 #include <SDL3/SDL_begin_code.h>
 /* Set up for C function definitions, even when using C++ */
@@ -115,6 +116,58 @@ typedef enum
  */
 #define SDL_IPHONE_MAX_GFORCE 5.0
 
+#define SDL_JOYSTICK_STATE_MAX_AXES     32
+#define SDL_JOYSTICK_STATE_MAX_BUTTONS  128
+#define SDL_JOYSTICK_STATE_MAX_HATS     8
+#define SDL_JOYSTICK_STATE_MAX_FINGERS  8
+#define SDL_JOYSTICK_STATE_MAX_SENSORS  4
+
+/**
+ *  The state of a touchpad finger in an SDL_JoystickState.
+ */
+typedef struct SDL_JoystickStateFinger
+{
+    Uint8 touchpad; /**< The index of the touchpad */
+    Uint8 finger;   /**< The index of the finger on the touchpad */
+    Uint8 state;    /**< 1 if the finger is down, 0 otherwise */
+    Uint8 padding;
+    float x;        /**< Normalized in the range 0...1 with 0 being on the left */
+    float y;        /**< Normalized in the range 0...1 with 0 being at the top */
+    float pressure; /**< Normalized in the range 0...1 */
+} SDL_JoystickStateFinger;
+
+/**
+ *  The state of a sensor in an SDL_JoystickState.
+ */
+typedef struct SDL_JoystickStateSensor
+{
+    SDL_SensorType type;     /**< The type of the sensor */
+    float data[3];           /**< Up to 3 values from the sensor, see SDL_sensor.h */
+    Uint64 sensor_timestamp; /**< The timestamp of the sensor reading in nanoseconds, not necessarily synchronized with the system clock */
+} SDL_JoystickStateSensor;
+
+/**
+ *  A snapshot of all the controls of a joystick, filled in by
+ *  SDL_GetJoystickState().
+ *
+ *  Controls past the SDL_JOYSTICK_STATE_MAX_* limits aren't included in the
+ *  snapshot, use the individual getter functions to read them.
+ */
+typedef struct SDL_JoystickState
+{
+    Uint64 timestamp;   /**< The timestamp of the last state change, in nanoseconds */
+    int num_axes;
+    int num_buttons;
+    int num_hats;
+    int num_fingers;
+    int num_sensors;
+    Sint16 axes[SDL_JOYSTICK_STATE_MAX_AXES];
+    Uint8 buttons[SDL_JOYSTICK_STATE_MAX_BUTTONS];
+    Uint8 hats[SDL_JOYSTICK_STATE_MAX_HATS];
+    SDL_JoystickStateFinger fingers[SDL_JOYSTICK_STATE_MAX_FINGERS];
+    SDL_JoystickStateSensor sensors[SDL_JOYSTICK_STATE_MAX_SENSORS];
+} SDL_JoystickState;
+
 
 /* Function prototypes */
 
@@ -865,6 +918,34 @@ extern DECLSPEC Uint8 SDLCALL SDL_GetJoystickHat(SDL_Joystick *joystick,
 extern DECLSPEC Uint8 SDLCALL SDL_GetJoystickButton(SDL_Joystick *joystick,
                                                     int button);
 
+/**
+ * Get a snapshot of the current state of all the controls on a joystick.
+ *
+ * This copies the axes, buttons, hats, touchpad fingers and sensor values of
+ * the joystick in one call. Unlike the other joystick functions, it doesn't
+ * take the joystick lock. The snapshot is updated as the joystick state
+ * changes, and a reader never sees a change partially applied, so it can be
+ * called from any thread at a high rate without blocking joystick updates.
+ *
+ * Because the joystick lock isn't taken, the joystick isn't checked against
+ * the list of open joysticks. The caller must make sure no other thread
+ * closes the joystick, or quits the joystick subsystem, before this function
+ * returns. Passing a joystick that has already been closed is undefined
+ * behavior.
+ *
+ * \param joystick an SDL_Joystick structure containing joystick information
+ * \param state a pointer filled in with the state of the joystick
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetJoystickAxis
+ * \sa SDL_GetJoystickButton
+ * \sa SDL_GetJoystickHat
+ */
+extern DECLSPEC int SDLCALL SDL_GetJoystickState(SDL_Joystick *joystick, SDL_JoystickState *state);
+
 /**
  * Start a rumble effect.
  *
@@ -1001,6 +1082,67 @@ extern DECLSPEC void SDLCALL SDL_CloseJoystick(SDL_Joystick *joystick);
  */
 extern DECLSPEC SDL_JoystickPowerLevel SDLCALL SDL_GetJoystickPowerLevel(SDL_Joystick *joystick);
 
+/**
+ * Get input report statistics for a joystick.
+ *
+ * Some joystick drivers, like the HIDAPI drivers, read input reports from
+ * the device at a high rate. The reports received between two joystick
+ * updates are processed as one batch. If
+ * SDL_HINT_JOYSTICK_HIDAPI_COALESCE_AXES is enabled, only the final position
+ * of each axis in the batch is sent. Button, hat, touchpad and sensor
+ * changes are always sent.
+ *
+ * Comparing the two counters shows how much input was coalesced. The report
+ * count stays 0 for drivers that don't batch their input. The counters are
+ * kept for the whole device, so joysticks that share a device, like the ports
+ * on a GameCube controller adapter, return the same values.
+ *
+ * \param joystick the SDL_Joystick to query
+ * \param reports a pointer filled in with the number of input reports read
+ *                from the device, may be NULL
+ * \param events a pointer filled in with the number of input state changes
+ *               sent for the joysticks on the device, may be NULL
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_HINT_JOYSTICK_HIDAPI_COALESCE_AXES
+ */
+extern DECLSPEC int SDLCALL SDL_GetJoystickInputStats(SDL_Joystick *joystick, Uint64 *reports, Uint64 *events);
+
+/**
+ * Get rumble statistics for a joystick.
+ *
+ * The HIDAPI drivers queue rumble requests and send them to the device from
+ * a separate thread. A request that hasn't been sent yet is replaced by newer
+ * rumble of the same kind, and requests to stop rumbling are sent ahead of
+ * any other pending rumble.
+ *
+ * \param joystick the SDL_Joystick to query
+ * \param pending a pointer filled in with the number of requests waiting to
+ *                be sent, may be NULL
+ * \param sent a pointer filled in with the number of requests sent to the
+ *             device, may be NULL
+ * \param coalesced a pointer filled in with the number of requests that
+ *                  replaced a pending request, may be NULL
+ * \param average_latency_ns a pointer filled in with the average time in
+ *                           nanoseconds between queueing a request and
+ *                           sending it, may be NULL
+ * \param max_latency_ns a pointer filled in with the longest time in
+ *                       nanoseconds between queueing a request and sending
+ *                       it, may be NULL
+ * \returns 0 on success or a negative error code on failure, including when
+ *          the joystick driver doesn't queue rumble; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RumbleJoystick
+ * \sa SDL_RumbleJoystickTriggers
+ */
+extern DECLSPEC int SDLCALL SDL_GetJoystickRumbleStats(SDL_Joystick *joystick, int *pending, Uint64 *sent, Uint64 *coalesced, Uint64 *average_latency_ns, Uint64 *max_latency_ns);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
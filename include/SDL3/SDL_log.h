@@ -392,6 +392,50 @@ extern DECLSPEC void SDLCALL SDL_LogGetOutputFunction(SDL_LogOutputFunction *cal
  */
 extern DECLSPEC void SDLCALL SDL_LogSetOutputFunction(SDL_LogOutputFunction callback, void *userdata);
 
+/**
+ * Enable or disable asynchronous log output.
+ *
+ * When asynchronous output is enabled, log messages are formatted into a
+ * buffer owned by the calling thread and the log output function is called
+ * later from a background thread. Logging then never blocks on I/O, which
+ * makes it usable from time critical threads like audio callbacks.
+ *
+ * Each thread has a fixed amount of buffer space, and messages are dropped if
+ * a thread logs faster than they can be written. Messages longer than 1024
+ * bytes are truncated. When asynchronous output is disabled, and during
+ * SDL_Quit(), pending messages are written out for a short amount of time
+ * and any left after that are dropped.
+ *
+ * This function should not be called while other threads are calling it.
+ *
+ * \param async SDL_TRUE to enable asynchronous output, SDL_FALSE to go back
+ *              to calling the output function directly
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_LogGetDroppedMessages
+ * \sa SDL_LogSetOutputFunction
+ */
+extern DECLSPEC int SDLCALL SDL_LogSetAsync(SDL_bool async);
+
+/**
+ * Get the number of log messages dropped by asynchronous log output.
+ *
+ * The count is reset when asynchronous output is enabled.
+ *
+ * \returns the number of messages that were dropped because a thread's log
+ *          buffer was full.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_LogSetAsync
+ */
+extern DECLSPEC int SDLCALL SDL_LogGetDroppedMessages(void);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -0,0 +1,101 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/**
+ *  \file SDL_offscreen.h
+ *
+ *  \brief Include file for reading offscreen window frames from another process.
+ *
+ *  This header is not included by SDL.h. It describes the layout of the
+ *  shared memory frame ring exported by the offscreen video driver, see
+ *  SDL_HINT_VIDEO_OFFSCREEN_FRAME_RING, so a reader that maps the ring knows
+ *  where to find the frames. Readers should check the magic and version in
+ *  the ring header before using the rest of it.
+ */
+
+#ifndef SDL_offscreen_h_
+#define SDL_offscreen_h_
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_rect.h>
+
+#include <SDL3/SDL_begin_code.h>
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  \brief The name of the window data holding the file descriptor of the
+ *         offscreen frame ring, see SDL_HINT_VIDEO_OFFSCREEN_FRAME_RING.
+ *
+ *  SDL_GetWindowData() returns a pointer to a const int owned by SDL, or NULL
+ *  if the window doesn't have a frame ring. The file descriptor is closed and
+ *  the pointer becomes invalid when the window surface is destroyed.
+ */
+#define SDL_WINDOW_DATA_OFFSCREEN_FRAME_RING_FD "SDL_OffscreenFrameRingFD"
+
+#define SDL_OFFSCREEN_FRAME_RING_MAGIC     0x46524453 /* "SDRF" */
+#define SDL_OFFSCREEN_FRAME_RING_VERSION   1
+#define SDL_OFFSCREEN_FRAME_RING_MAX_RECTS 16
+
+/**
+ *  \brief The header at the start of an offscreen frame ring.
+ *
+ *  The ring is followed by num_frames frames spaced frame_stride bytes apart,
+ *  starting at frame_offset. Each frame is an SDL_OffscreenFrameHeader with the
+ *  pixels at pixels_offset from the start of the frame.
+ */
+typedef struct SDL_OffscreenFrameRingHeader
+{
+    Uint32 magic;               /**< SDL_OFFSCREEN_FRAME_RING_MAGIC */
+    Uint32 version;             /**< SDL_OFFSCREEN_FRAME_RING_VERSION */
+    Uint32 format;              /**< SDL_PixelFormatEnum of the frames */
+    Sint32 w;
+    Sint32 h;
+    Sint32 pitch;
+    Uint32 num_frames;
+    Uint32 frame_offset;        /**< Offset of the first frame from the start of the ring */
+    Uint32 frame_stride;        /**< Distance in bytes between two frames */
+    Uint32 pixels_offset;       /**< Offset of the pixels from the start of a frame */
+    SDL_AtomicInt latest_frame; /**< Number of the last frame presented, 0 if there isn't one yet */
+    SDL_AtomicInt closed;       /**< Set when the window framebuffer goes away, readers should look for a new ring */
+} SDL_OffscreenFrameRingHeader;
+
+/**
+ *  \brief The header of each frame in an offscreen frame ring.
+ */
+typedef struct SDL_OffscreenFrameHeader
+{
+    SDL_AtomicInt frame_number; /**< 0 while the frame is being drawn */
+    Uint32 num_rects;           /**< Number of rectangles that changed since the previous frame, 0 if the whole frame did */
+    Uint64 timestamp;           /**< SDL_GetTicksNS() when the frame was presented */
+    SDL_Rect rects[SDL_OFFSCREEN_FRAME_RING_MAX_RECTS];
+} SDL_OffscreenFrameHeader;
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+#include <SDL3/SDL_close_code.h>
+
+#endif /* SDL_offscreen_h_ */
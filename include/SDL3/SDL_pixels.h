@@ -312,6 +312,15 @@ typedef struct SDL_Color
 } SDL_Color;
 #define SDL_Colour SDL_Color
 
+/**
+ * A set of indexed colors.
+ *
+ * Create palettes with SDL_CreatePalette() and change their colors with
+ * SDL_SetPaletteColors(), rather than writing to `colors` directly. SDL
+ * remembers the results of SDL_MapRGB() and SDL_MapRGBA() for each palette
+ * made by SDL_CreatePalette(), and only notices changes made through
+ * SDL_SetPaletteColors(), which bumps `version`.
+ */
 typedef struct SDL_Palette
 {
     int ncolors;
@@ -466,6 +475,10 @@ extern DECLSPEC int SDLCALL SDL_SetPixelFormatPalette(SDL_PixelFormat * format,
 /**
  * Set a range of colors in a palette.
  *
+ * This is the only way to change a palette's colors that SDL_MapRGB() and
+ * SDL_MapRGBA() are guaranteed to notice. Don't change the colors while
+ * other threads map colors with the palette.
+ *
  * \param palette the SDL_Palette structure to modify
  * \param colors an array of SDL_Color structures to copy into the palette
  * \param firstcolor the index of the first palette entry to modify
@@ -146,6 +146,15 @@ typedef enum
     SDL_LOGICAL_PRESENTATION_INTEGER_SCALE   /**< The rendered content is scaled up by integer multiples to fit the output resolution */
 } SDL_RendererLogicalPresentation;
 
+/**
+ * The file format of captured frames
+ */
+typedef enum
+{
+    SDL_RENDER_CAPTURE_BMP,     /**< Each frame is saved as a BMP file */
+    SDL_RENDER_CAPTURE_RAW      /**< Each frame is saved as SDL_PIXELFORMAT_XRGB8888 pixels without any header */
+} SDL_RenderCaptureFormat;
+
 /**
  * A structure representing rendering state
  */
@@ -1374,6 +1383,76 @@ extern DECLSPEC int SDLCALL SDL_RenderReadPixels(SDL_Renderer *renderer,
                                                  Uint32 format,
                                                  void *pixels, int pitch);
 
+/**
+ * Start capturing every frame presented by a renderer.
+ *
+ * Once capture is started, SDL_RenderPresent() reads the frame back into one
+ * of `max_queued_frames` reusable surfaces and hands it to a background
+ * thread, which saves it to a file named after `prefix` followed by the
+ * 8-digit frame number, starting at 1, and ".bmp" or ".raw". The render
+ * thread never waits for frames to be written: if all the surfaces are still
+ * queued, the frame is dropped and counted.
+ *
+ * The whole viewport is captured, which is the whole output unless a
+ * viewport is set when the frame is presented.
+ *
+ * \param renderer the rendering context
+ * \param prefix the path and name prefix of the captured frame files
+ * \param format an SDL_RenderCaptureFormat value for the captured frames
+ * \param max_queued_frames the maximum number of frames waiting to be
+ *                          written, at least 1
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety You may only call this function on the main thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetRenderCaptureStats
+ * \sa SDL_StopRenderCapture
+ */
+extern DECLSPEC int SDLCALL SDL_StartRenderCapture(SDL_Renderer *renderer, const char *prefix, SDL_RenderCaptureFormat format, int max_queued_frames);
+
+/**
+ * Stop capturing frames presented by a renderer.
+ *
+ * This waits until all the queued frames have been written.
+ *
+ * \param renderer the rendering context
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety You may only call this function on the main thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_StartRenderCapture
+ */
+extern DECLSPEC int SDLCALL SDL_StopRenderCapture(SDL_Renderer *renderer);
+
+/**
+ * Get the frame capture counters of a renderer.
+ *
+ * The counters are reset when capture is started, and keep their final
+ * values after capture is stopped.
+ *
+ * \param renderer the rendering context
+ * \param captured a pointer filled in with the number of frames read back
+ *                 and queued for writing, may be NULL
+ * \param written a pointer filled in with the number of frames written to
+ *                disk, may be NULL
+ * \param dropped a pointer filled in with the number of frames that were
+ *                dropped because the queue was full or because they couldn't
+ *                be written, may be NULL
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_StartRenderCapture
+ */
+extern DECLSPEC int SDLCALL SDL_GetRenderCaptureStats(SDL_Renderer *renderer, Uint64 *captured, Uint64 *written, Uint64 *dropped);
+
 /**
  * Update the screen with any rendering performed since the previous call.
  *
@@ -44,6 +44,30 @@ extern "C" {
  */
 int SDLTest_TrackAllocations(void);
 
+/**
+ * Number of allocation size classes in SDLTest_MemoryStats
+ */
+#define SDLTEST_MEMORY_SIZE_CLASSES 10
+
+/**
+ * \brief Statistics about the allocations made while tracking
+ */
+typedef struct SDLTest_MemoryStats
+{
+    int allocations;            /**< Number of allocations in use */
+    Uint64 bytes_in_use;        /**< Number of bytes in use */
+    Uint64 peak_bytes_in_use;   /**< Highest number of bytes in use at any time */
+    Uint64 total_allocations;   /**< Number of allocations made since tracking started */
+    Uint64 size_classes[SDLTEST_MEMORY_SIZE_CLASSES]; /**< Number of allocations made of up to (16 << index) bytes, the last class counts all larger allocations */
+} SDLTest_MemoryStats;
+
+/**
+ * \brief Get statistics about the allocations made since tracking started
+ *
+ * \param stats filled in with the current statistics, zeroed if allocations aren't tracked
+ */
+void SDLTest_GetMemoryStats(SDLTest_MemoryStats *stats);
+
 /**
  * \brief Print a log of any outstanding allocations
  *
@@ -201,6 +201,7 @@
 #cmakedefine HAVE_GETAUXVAL 1
 #cmakedefine HAVE_ELF_AUX_INFO 1
 #cmakedefine HAVE_POLL 1
+#cmakedefine HAVE_MEMFD_CREATE 1
 #cmakedefine HAVE__EXIT 1
 
 #else
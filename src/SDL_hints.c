@@ -22,9 +22,24 @@
 
 #include "SDL_hints_c.h"
 
-/* Assuming there aren't many hints set and they aren't being queried in
-   critical performance paths, we'll just use linked lists here.
+/* Hints are kept in a hash table so they can be looked up quickly. Entries
+   are only added when a hint is set, watched or a handle is taken, and are
+   never removed until SDL_ClearHints(), so lookups don't take any locks.
+
+   The environment can change without SDL knowing, so it isn't cached and is
+   checked on every lookup, as it always has been.
+
+   Each hint keeps a single copy of each of its recent values, so a value
+   pointer can be compared instead of the string. Once a hint has had more
+   than SDL_HINT_MAX_VALUES different values the least recently used one is
+   freed, so a value stays valid for a while after the hint changes.
+
+   Memory is allocated and freed, and the environment is read, outside of
+   SDL_hint_lock.
  */
+#define SDL_HINT_BUCKETS    128 /* must be a power of two */
+#define SDL_HINT_MAX_VALUES 8
+
 typedef struct SDL_HintWatch
 {
     SDL_HintCallback callback;
@@ -32,124 +47,277 @@ typedef struct SDL_HintWatch
     struct SDL_HintWatch *next;
 } SDL_HintWatch;
 
-typedef struct SDL_Hint
+typedef struct SDL_HintValue
+{
+    struct SDL_HintValue *next;
+    char value[1];
+} SDL_HintValue;
+
+struct SDL_HintHandle
 {
     char *name;
-    char *value;
-    SDL_HintPriority priority;
+    Uint32 hash;
+    void *value; /* the value set with SDL_SetHint(), read atomically */
+    SDL_AtomicInt priority;
+    SDL_HintValue *values; /* most recently used first */
+    int num_values;
     SDL_HintWatch *callbacks;
-    struct SDL_Hint *next;
-} SDL_Hint;
+    struct SDL_HintHandle *next;
+};
+typedef struct SDL_HintHandle SDL_Hint;
+
+static void *SDL_hint_buckets[SDL_HINT_BUCKETS];
+static SDL_SpinLock SDL_hint_lock;
+
+static Uint32 SDL_HashHintName(const char *name)
+{
+    /* FNV-1a */
+    Uint32 hash = 2166136261u;
+
+    while (*name) {
+        hash ^= (Uint8)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static SDL_Hint *SDL_FindHint(const char *name, Uint32 hash)
+{
+    SDL_Hint *hint = (SDL_Hint *)SDL_AtomicGetPtr(&SDL_hint_buckets[hash & (SDL_HINT_BUCKETS - 1)]);
+
+    for (; hint; hint = hint->next) {
+        if (hint->hash == hash && SDL_strcmp(name, hint->name) == 0) {
+            return hint;
+        }
+    }
+    return NULL;
+}
+
+/* Returns the entry for a hint, adding it if needed */
+static SDL_Hint *SDL_AddHint(const char *name)
+{
+    const Uint32 hash = SDL_HashHintName(name);
+    SDL_Hint *hint = SDL_FindHint(name, hash);
+    SDL_Hint *spare;
+
+    if (hint) {
+        return hint;
+    }
+
+    spare = (SDL_Hint *)SDL_calloc(1, sizeof(*spare));
+    if (spare == NULL) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    spare->name = SDL_strdup(name);
+    if (spare->name == NULL) {
+        SDL_free(spare);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    spare->hash = hash;
+    SDL_AtomicSet(&spare->priority, SDL_HINT_DEFAULT);
+
+    SDL_AtomicLock(&SDL_hint_lock);
+    hint = SDL_FindHint(name, hash);
+    if (hint == NULL) {
+        void **bucket = &SDL_hint_buckets[hash & (SDL_HINT_BUCKETS - 1)];
+
+        /* Publish the entry only once it's fully set up */
+        spare->next = (SDL_Hint *)*bucket;
+        SDL_AtomicSetPtr(bucket, spare);
+        hint = spare;
+        spare = NULL;
+    }
+    SDL_AtomicUnlock(&SDL_hint_lock);
+
+    if (spare) {
+        /* Another thread added it first */
+        SDL_free(spare->name);
+        SDL_free(spare);
+    }
+    return hint;
+}
+
+static SDL_HintValue *SDL_CreateHintValue(const char *value)
+{
+    SDL_HintValue *entry;
+    size_t len;
 
-static SDL_Hint *SDL_hints;
+    if (value == NULL) {
+        return NULL;
+    }
+
+    len = SDL_strlen(value);
+    entry = (SDL_HintValue *)SDL_malloc(sizeof(*entry) + len);
+    if (entry) {
+        SDL_memcpy(entry->value, value, len + 1);
+        entry->next = NULL;
+    }
+    return entry;
+}
+
+static void SDL_FreeHintValues(SDL_HintValue *values)
+{
+    while (values) {
+        SDL_HintValue *next = values->next;
+        SDL_free(values);
+        values = next;
+    }
+}
+
+/* Must be called with SDL_hint_lock held. Returns the hint's copy of value,
+   making it the most recently used one. If the hint has no copy yet, the new
+   copy in *spare is used and *spare is set to NULL. A value pushed out of the
+   list is added to *evicted, to be freed once the lock is released.
+ */
+static const char *SDL_InternHintValue(SDL_Hint *hint, const char *value, SDL_HintValue **spare, SDL_HintValue **evicted)
+{
+    SDL_HintValue *entry, *prev = NULL;
+
+    if (value == NULL) {
+        return NULL;
+    }
+
+    for (entry = hint->values; entry; prev = entry, entry = entry->next) {
+        if (SDL_strcmp(value, entry->value) == 0) {
+            if (prev) {
+                prev->next = entry->next;
+                entry->next = hint->values;
+                hint->values = entry;
+            }
+            return entry->value;
+        }
+    }
+
+    entry = *spare;
+    *spare = NULL;
+    entry->next = hint->values;
+    hint->values = entry;
+
+    if (++hint->num_values > SDL_HINT_MAX_VALUES) {
+        /* The least recently used value is last, and it's never the current one */
+        for (prev = hint->values; prev->next->next; prev = prev->next) {
+        }
+        prev->next->next = *evicted;
+        *evicted = prev->next;
+        prev->next = NULL;
+        --hint->num_values;
+    }
+    return entry->value;
+}
+
+static const char *SDL_GetHintCurrent(SDL_Hint *hint)
+{
+    const char *env = SDL_getenv(hint->name);
+
+    if (env == NULL || SDL_AtomicGet(&hint->priority) == SDL_HINT_OVERRIDE) {
+        return (const char *)SDL_AtomicGetPtr(&hint->value);
+    }
+    return env;
+}
+
+static void SDL_CallHintCallbacks(SDL_Hint *hint, const char *old_value, const char *new_value)
+{
+    SDL_HintWatch *entry;
+
+    for (entry = hint->callbacks; entry;) {
+        /* Save the next entry in case this one is deleted */
+        SDL_HintWatch *next = entry->next;
+        entry->callback(entry->userdata, hint->name, old_value, new_value);
+        entry = next;
+    }
+}
 
 SDL_bool SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPriority priority)
 {
-    const char *env;
     SDL_Hint *hint;
-    SDL_HintWatch *entry;
+    SDL_HintValue *spare, *evicted = NULL;
+    const char *old_value, *new_value;
 
     if (name == NULL) {
         return SDL_FALSE;
     }
 
-    env = SDL_getenv(name);
-    if (env && priority < SDL_HINT_OVERRIDE) {
+    if (SDL_getenv(name) && priority < SDL_HINT_OVERRIDE) {
         return SDL_FALSE;
     }
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if (priority < hint->priority) {
-                return SDL_FALSE;
-            }
-            if (hint->value != value &&
-                (value == NULL || !hint->value || SDL_strcmp(hint->value, value) != 0)) {
-                char *old_value = hint->value;
-
-                hint->value = value ? SDL_strdup(value) : NULL;
-                for (entry = hint->callbacks; entry;) {
-                    /* Save the next entry in case this one is deleted */
-                    SDL_HintWatch *next = entry->next;
-                    entry->callback(entry->userdata, name, old_value, value);
-                    entry = next;
-                }
-                if (old_value) {
-                    SDL_free(old_value);
-                }
-            }
-            hint->priority = priority;
-            return SDL_TRUE;
-        }
+    hint = SDL_AddHint(name);
+    if (hint == NULL) {
+        return SDL_FALSE;
     }
 
-    /* Couldn't find the hint, add a new one */
-    hint = (SDL_Hint *)SDL_malloc(sizeof(*hint));
-    if (hint == NULL) {
+    spare = SDL_CreateHintValue(value);
+    if (value && spare == NULL) {
+        SDL_OutOfMemory();
         return SDL_FALSE;
     }
-    hint->name = SDL_strdup(name);
-    hint->value = value ? SDL_strdup(value) : NULL;
-    hint->priority = priority;
-    hint->callbacks = NULL;
-    hint->next = SDL_hints;
-    SDL_hints = hint;
+
+    SDL_AtomicLock(&SDL_hint_lock);
+    if (priority < (SDL_HintPriority)SDL_AtomicGet(&hint->priority)) {
+        SDL_AtomicUnlock(&SDL_hint_lock);
+        SDL_free(spare);
+        return SDL_FALSE;
+    }
+    old_value = (const char *)hint->value;
+    new_value = SDL_InternHintValue(hint, value, &spare, &evicted);
+    SDL_AtomicSetPtr(&hint->value, (void *)new_value);
+    SDL_AtomicSet(&hint->priority, priority);
+    SDL_AtomicUnlock(&SDL_hint_lock);
+
+    SDL_free(spare);
+    SDL_FreeHintValues(evicted);
+
+    if (old_value != new_value) {
+        SDL_CallHintCallbacks(hint, old_value, value);
+    }
     return SDL_TRUE;
 }
 
+static void SDL_ResetHintEntry(SDL_Hint *hint)
+{
+    const char *env = SDL_getenv(hint->name);
+    const char *old_value;
+
+    SDL_AtomicLock(&SDL_hint_lock);
+    old_value = (const char *)hint->value;
+    SDL_AtomicSetPtr(&hint->value, NULL);
+    SDL_AtomicSet(&hint->priority, SDL_HINT_DEFAULT);
+    SDL_AtomicUnlock(&SDL_hint_lock);
+
+    if ((env == NULL && old_value != NULL) ||
+        (env != NULL && old_value == NULL) ||
+        (env != NULL && SDL_strcmp(env, old_value) != 0)) {
+        SDL_CallHintCallbacks(hint, old_value, env);
+    }
+}
+
 SDL_bool SDL_ResetHint(const char *name)
 {
-    const char *env;
     SDL_Hint *hint;
-    SDL_HintWatch *entry;
 
     if (name == NULL) {
         return SDL_FALSE;
     }
 
-    env = SDL_getenv(name);
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if ((env == NULL && hint->value != NULL) ||
-                (env != NULL && hint->value == NULL) ||
-                (env != NULL && SDL_strcmp(env, hint->value) != 0)) {
-                for (entry = hint->callbacks; entry;) {
-                    /* Save the next entry in case this one is deleted */
-                    SDL_HintWatch *next = entry->next;
-                    entry->callback(entry->userdata, name, hint->value, env);
-                    entry = next;
-                }
-            }
-            SDL_free(hint->value);
-            hint->value = NULL;
-            hint->priority = SDL_HINT_DEFAULT;
-            return SDL_TRUE;
-        }
+    hint = SDL_FindHint(name, SDL_HashHintName(name));
+    if (hint == NULL) {
+        return SDL_FALSE;
     }
-    return SDL_FALSE;
+    SDL_ResetHintEntry(hint);
+    return SDL_TRUE;
 }
 
 void SDL_ResetHints(void)
 {
-    const char *env;
     SDL_Hint *hint;
-    SDL_HintWatch *entry;
+    int i;
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        env = SDL_getenv(hint->name);
-        if ((env == NULL && hint->value != NULL) ||
-            (env != NULL && hint->value == NULL) ||
-            (env != NULL && SDL_strcmp(env, hint->value) != 0)) {
-            for (entry = hint->callbacks; entry;) {
-                /* Save the next entry in case this one is deleted */
-                SDL_HintWatch *next = entry->next;
-                entry->callback(entry->userdata, hint->name, hint->value, env);
-                entry = next;
-            }
+    for (i = 0; i < SDL_HINT_BUCKETS; ++i) {
+        for (hint = (SDL_Hint *)SDL_AtomicGetPtr(&SDL_hint_buckets[i]); hint; hint = hint->next) {
+            SDL_ResetHintEntry(hint);
         }
-        SDL_free(hint->value);
-        hint->value = NULL;
-        hint->priority = SDL_HINT_DEFAULT;
     }
 }
 
@@ -160,19 +328,43 @@ SDL_bool SDL_SetHint(const char *name, const char *value)
 
 const char *SDL_GetHint(const char *name)
 {
-    const char *env;
     SDL_Hint *hint;
 
-    env = SDL_getenv(name);
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if (env == NULL || hint->priority == SDL_HINT_OVERRIDE) {
-                return hint->value;
-            }
-            break;
-        }
+    if (name == NULL) {
+        return NULL;
     }
-    return env;
+
+    hint = SDL_FindHint(name, SDL_HashHintName(name));
+    if (hint == NULL) {
+        return SDL_getenv(name);
+    }
+    return SDL_GetHintCurrent(hint);
+}
+
+SDL_HintHandle *SDL_GetHintHandle(const char *name)
+{
+    if (name == NULL) {
+        SDL_InvalidParamError("name");
+        return NULL;
+    }
+    return SDL_AddHint(name);
+}
+
+const char *SDL_GetHintHandleValue(SDL_HintHandle *handle)
+{
+    if (handle == NULL) {
+        SDL_InvalidParamError("handle");
+        return NULL;
+    }
+    return SDL_GetHintCurrent(handle);
+}
+
+SDL_bool SDL_GetHintHandleBoolean(SDL_HintHandle *handle, SDL_bool default_value)
+{
+    if (handle == NULL) {
+        return default_value;
+    }
+    return SDL_GetStringBoolean(SDL_GetHintCurrent(handle), default_value);
 }
 
 int SDL_GetStringInteger(const char *value, int default_value)
@@ -231,37 +423,20 @@ int SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userd
     entry->callback = callback;
     entry->userdata = userdata;
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            break;
-        }
-    }
+    hint = SDL_AddHint(name);
     if (hint == NULL) {
-        /* Need to add a hint entry for this watcher */
-        hint = (SDL_Hint *)SDL_malloc(sizeof(*hint));
-        if (hint == NULL) {
-            SDL_free(entry);
-            return SDL_OutOfMemory();
-        }
-        hint->name = SDL_strdup(name);
-        if (!hint->name) {
-            SDL_free(entry);
-            SDL_free(hint);
-            return SDL_OutOfMemory();
-        }
-        hint->value = NULL;
-        hint->priority = SDL_HINT_DEFAULT;
-        hint->callbacks = NULL;
-        hint->next = SDL_hints;
-        SDL_hints = hint;
+        SDL_free(entry);
+        return -1;
     }
 
     /* Add it to the callbacks for this hint */
+    SDL_AtomicLock(&SDL_hint_lock);
     entry->next = hint->callbacks;
     hint->callbacks = entry;
+    SDL_AtomicUnlock(&SDL_hint_lock);
 
     /* Now call it with the current value */
-    value = SDL_GetHint(name);
+    value = SDL_GetHintCurrent(hint);
     callback(userdata, name, value, value);
     return 0;
 }
@@ -271,42 +446,55 @@ void SDL_DelHintCallback(const char *name, SDL_HintCallback callback, void *user
     SDL_Hint *hint;
     SDL_HintWatch *entry, *prev;
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            prev = NULL;
-            for (entry = hint->callbacks; entry; entry = entry->next) {
-                if (callback == entry->callback && userdata == entry->userdata) {
-                    if (prev) {
-                        prev->next = entry->next;
-                    } else {
-                        hint->callbacks = entry->next;
-                    }
-                    SDL_free(entry);
-                    break;
-                }
-                prev = entry;
+    if (name == NULL) {
+        return;
+    }
+
+    hint = SDL_FindHint(name, SDL_HashHintName(name));
+    if (hint == NULL) {
+        return;
+    }
+
+    SDL_AtomicLock(&SDL_hint_lock);
+    prev = NULL;
+    for (entry = hint->callbacks; entry; entry = entry->next) {
+        if (callback == entry->callback && userdata == entry->userdata) {
+            if (prev) {
+                prev->next = entry->next;
+            } else {
+                hint->callbacks = entry->next;
             }
-            return;
+            break;
         }
+        prev = entry;
     }
+    SDL_AtomicUnlock(&SDL_hint_lock);
+
+    SDL_free(entry);
 }
 
 void SDL_ClearHints(void)
 {
     SDL_Hint *hint;
     SDL_HintWatch *entry;
+    int i;
 
-    while (SDL_hints) {
-        hint = SDL_hints;
-        SDL_hints = hint->next;
+    for (i = 0; i < SDL_HINT_BUCKETS; ++i) {
+        hint = (SDL_Hint *)SDL_AtomicGetPtr(&SDL_hint_buckets[i]);
+        SDL_AtomicSetPtr(&SDL_hint_buckets[i], NULL);
 
-        SDL_free(hint->name);
-        SDL_free(hint->value);
-        for (entry = hint->callbacks; entry;) {
-            SDL_HintWatch *freeable = entry;
-            entry = entry->next;
+        while (hint) {
+            SDL_Hint *freeable = hint;
+            hint = hint->next;
+
+            SDL_free(freeable->name);
+            SDL_FreeHintValues(freeable->values);
+            for (entry = freeable->callbacks; entry;) {
+                SDL_HintWatch *next = entry->next;
+                SDL_free(entry);
+                entry = next;
+            }
             SDL_free(freeable);
         }
-        SDL_free(hint);
     }
 }
@@ -37,6 +37,7 @@
 #endif
 
 #include "stdlib/SDL_vacopy.h"
+#include "thread/SDL_systhread.h"
 
 /* The size of the stack buffer to use for rendering log messages. */
 #define SDL_MAX_LOG_MESSAGE_STACK 256
@@ -110,6 +111,254 @@ static int SDL_android_priority[SDL_NUM_LOG_PRIORITIES] = {
 };
 #endif /* __ANDROID__ */
 
+/* Asynchronous log output
+
+   Each thread that logs gets its own single producer, single consumer ring
+   buffer, so queuing a message never blocks and only allocates the first
+   time a thread logs. A background thread drains the rings and calls the
+   log output function. Messages that don't fit in a ring are dropped.
+
+   A thread finds its ring through thread local storage, which holds the ring
+   index and the session it was claimed in, so values left over from an
+   earlier session are never used to reach a freed ring. The ring is handed
+   back by the storage's destructor when the thread exits, which also
+   happens for threads SDL didn't create where the platform supports it.
+ */
+#define SDL_LOG_ASYNC_MAX_THREADS 64
+#define SDL_LOG_ASYNC_RING_SIZE   (16 * 1024) /* must be a power of two */
+#define SDL_LOG_ASYNC_MAX_MESSAGE 1024
+#define SDL_LOG_ASYNC_INTERVAL_MS 10
+#define SDL_LOG_ASYNC_FLUSH_MS    250
+
+typedef struct SDL_LogRecord
+{
+    Uint32 size; /* size of the whole record, 0 if the rest of the ring is unused */
+    int category;
+    SDL_LogPriority priority;
+} SDL_LogRecord;
+
+typedef struct SDL_LogRing
+{
+    SDL_AtomicInt owned;
+    SDL_AtomicInt head; /* only changed by the owning thread */
+    SDL_AtomicInt tail; /* only changed by the log thread */
+    char message[SDL_LOG_ASYNC_MAX_MESSAGE];
+    Uint8 data[SDL_LOG_ASYNC_RING_SIZE];
+} SDL_LogRing;
+
+static SDL_AtomicInt SDL_log_async_enabled;
+static SDL_AtomicInt SDL_log_async_users;
+static SDL_AtomicInt SDL_log_async_session;
+static SDL_AtomicInt SDL_log_async_quit;
+static SDL_AtomicInt SDL_log_async_dropped;
+static void *SDL_log_async_rings[SDL_LOG_ASYNC_MAX_THREADS];
+static SDL_TLSID SDL_log_async_tls;
+static SDL_Thread *SDL_log_async_thread;
+static SDL_Semaphore *SDL_log_async_wakeup;
+
+static int SDL_ChopLogEndline(char *message, int len)
+{
+    if ((len > 0) && (message[len - 1] == '\n')) {
+        message[--len] = '\0';
+        if ((len > 0) && (message[len - 1] == '\r')) { /* catch "\r\n", too. */
+            message[--len] = '\0';
+        }
+    }
+    return len;
+}
+
+static void SDLCALL SDL_ReleaseLogRing(void *value)
+{
+    const uintptr_t slot = (uintptr_t)value;
+
+    SDL_AtomicIncRef(&SDL_log_async_users);
+    if (SDL_AtomicGet(&SDL_log_async_enabled) &&
+        (int)(slot >> 8) == SDL_AtomicGet(&SDL_log_async_session)) {
+        SDL_LogRing *ring = (SDL_LogRing *)SDL_AtomicGetPtr(&SDL_log_async_rings[(slot & 0xFF) - 1]);
+        if (ring) {
+            SDL_AtomicSet(&ring->owned, 0);
+        }
+    }
+    (void)SDL_AtomicDecRef(&SDL_log_async_users);
+}
+
+static SDL_LogRing *SDL_GetLogRing(void)
+{
+    const int session = SDL_AtomicGet(&SDL_log_async_session);
+    const uintptr_t slot = (uintptr_t)SDL_GetTLS(SDL_log_async_tls);
+    int i;
+
+    if (slot && (int)(slot >> 8) == session) {
+        return (SDL_LogRing *)SDL_AtomicGetPtr(&SDL_log_async_rings[(slot & 0xFF) - 1]);
+    }
+
+    /* This is the first message from this thread, claim a ring for it */
+    for (i = 0; i < SDL_LOG_ASYNC_MAX_THREADS; ++i) {
+        SDL_LogRing *ring = (SDL_LogRing *)SDL_AtomicGetPtr(&SDL_log_async_rings[i]);
+
+        if (ring == NULL) {
+            ring = (SDL_LogRing *)SDL_calloc(1, sizeof(*ring));
+            if (ring == NULL) {
+                return NULL;
+            }
+            SDL_AtomicSet(&ring->owned, 1);
+            if (!SDL_AtomicCASPtr(&SDL_log_async_rings[i], NULL, ring)) {
+                SDL_free(ring);
+                continue;
+            }
+        } else if (!SDL_AtomicCAS(&ring->owned, 0, 1)) {
+            continue;
+        }
+
+        if (SDL_SetTLS(SDL_log_async_tls, (void *)(((uintptr_t)session << 8) | (i + 1)), SDL_ReleaseLogRing) < 0) {
+            SDL_AtomicSet(&ring->owned, 0);
+            return NULL;
+        }
+        return ring;
+    }
+    return NULL;
+}
+
+static void SDL_QueueLogMessage(SDL_LogRing *ring, int category, SDL_LogPriority priority, const char *fmt, va_list ap)
+{
+    SDL_LogRecord record;
+    Uint32 head, tail, offset, size, space;
+    int len;
+    va_list aq;
+
+    va_copy(aq, ap);
+    len = SDL_vsnprintf(ring->message, sizeof(ring->message), fmt, aq);
+    va_end(aq);
+
+    if (len < 0) {
+        return;
+    }
+    if (len >= (int)sizeof(ring->message)) {
+        len = (int)sizeof(ring->message) - 1;
+    }
+    len = SDL_ChopLogEndline(ring->message, len);
+
+    size = ((Uint32)(sizeof(record) + len + 1) + 3) & ~3;
+    head = (Uint32)SDL_AtomicGet(&ring->head);
+    tail = (Uint32)SDL_AtomicGet(&ring->tail);
+    space = SDL_LOG_ASYNC_RING_SIZE - (head - tail);
+    offset = head & (SDL_LOG_ASYNC_RING_SIZE - 1);
+
+    if ((SDL_LOG_ASYNC_RING_SIZE - offset) < size) {
+        /* The message doesn't fit at the end, skip to the start of the ring */
+        const Uint32 skip = SDL_LOG_ASYNC_RING_SIZE - offset;
+        if (space < skip + size) {
+            SDL_AtomicIncRef(&SDL_log_async_dropped);
+            return;
+        }
+        if (skip >= sizeof(record)) {
+            record.size = 0;
+            SDL_memcpy(&ring->data[offset], &record, sizeof(record));
+        }
+        head += skip;
+        offset = 0;
+    } else if (space < size) {
+        SDL_AtomicIncRef(&SDL_log_async_dropped);
+        return;
+    }
+
+    record.size = size;
+    record.category = category;
+    record.priority = priority;
+    SDL_memcpy(&ring->data[offset], &record, sizeof(record));
+    SDL_memcpy(&ring->data[offset + sizeof(record)], ring->message, (size_t)len + 1);
+
+    /* This publishes the message to the log thread */
+    SDL_AtomicSet(&ring->head, (int)(head + size));
+}
+
+static void SDL_DrainLogRing(SDL_LogRing *ring, Uint64 deadline)
+{
+    const Uint32 head = (Uint32)SDL_AtomicGet(&ring->head);
+    Uint32 tail = (Uint32)SDL_AtomicGet(&ring->tail);
+
+    while (tail != head) {
+        const Uint32 offset = tail & (SDL_LOG_ASYNC_RING_SIZE - 1);
+        const Uint32 remaining = SDL_LOG_ASYNC_RING_SIZE - offset;
+        SDL_LogRecord record;
+
+        if (remaining < sizeof(record)) {
+            tail += remaining;
+            continue;
+        }
+        SDL_memcpy(&record, &ring->data[offset], sizeof(record));
+        if (record.size == 0) {
+            tail += remaining;
+            continue;
+        }
+
+        if (deadline && SDL_GetTicks() >= deadline) {
+            /* We ran out of time flushing, drop the rest */
+            SDL_AtomicIncRef(&SDL_log_async_dropped);
+        } else {
+            SDL_LockMutex(log_function_mutex);
+            if (SDL_log_function) {
+                SDL_log_function(SDL_log_userdata, record.category, record.priority, (const char *)&ring->data[offset + sizeof(record)]);
+            }
+            SDL_UnlockMutex(log_function_mutex);
+        }
+
+        tail += record.size;
+        SDL_AtomicSet(&ring->tail, (int)tail);
+    }
+    SDL_AtomicSet(&ring->tail, (int)tail);
+}
+
+static int SDLCALL SDL_LogThread(void *data)
+{
+    for (;;) {
+        const SDL_bool quit = SDL_AtomicGet(&SDL_log_async_quit) ? SDL_TRUE : SDL_FALSE;
+        const Uint64 deadline = quit ? SDL_GetTicks() + SDL_LOG_ASYNC_FLUSH_MS : 0;
+        int i;
+
+        for (i = 0; i < SDL_LOG_ASYNC_MAX_THREADS; ++i) {
+            SDL_LogRing *ring = (SDL_LogRing *)SDL_AtomicGetPtr(&SDL_log_async_rings[i]);
+            if (ring) {
+                SDL_DrainLogRing(ring, deadline);
+            }
+        }
+        if (quit) {
+            break;
+        }
+        SDL_WaitSemaphoreTimeout(SDL_log_async_wakeup, SDL_LOG_ASYNC_INTERVAL_MS);
+    }
+    return 0;
+}
+
+static void SDL_StopLogThread(void)
+{
+    int i;
+
+    if (SDL_log_async_thread == NULL) {
+        return;
+    }
+
+    /* Wait for threads that are queuing messages right now */
+    SDL_AtomicSet(&SDL_log_async_enabled, 0);
+    while (SDL_AtomicGet(&SDL_log_async_users) > 0) {
+        SDL_Delay(1);
+    }
+
+    SDL_AtomicSet(&SDL_log_async_quit, 1);
+    SDL_PostSemaphore(SDL_log_async_wakeup);
+    SDL_WaitThread(SDL_log_async_thread, NULL);
+    SDL_log_async_thread = NULL;
+    SDL_DestroySemaphore(SDL_log_async_wakeup);
+    SDL_log_async_wakeup = NULL;
+
+    /* Invalidate the rings remembered by threads */
+    SDL_AtomicIncRef(&SDL_log_async_session);
+    for (i = 0; i < SDL_LOG_ASYNC_MAX_THREADS; ++i) {
+        SDL_free(SDL_AtomicGetPtr(&SDL_log_async_rings[i]));
+        SDL_AtomicSetPtr(&SDL_log_async_rings[i], NULL);
+    }
+}
+
 void SDL_InitLog(void)
 {
     if (log_function_mutex == NULL) {
@@ -120,6 +369,7 @@ void SDL_InitLog(void)
 
 void SDL_QuitLog(void)
 {
+    SDL_StopLogThread();
     SDL_LogResetPriorities();
     if (log_function_mutex) {
         SDL_DestroyMutex(log_function_mutex);
@@ -305,6 +555,20 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, const char *fmt, va
         return;
     }
 
+    if (SDL_AtomicGet(&SDL_log_async_enabled)) {
+        SDL_AtomicIncRef(&SDL_log_async_users);
+        if (SDL_AtomicGet(&SDL_log_async_enabled)) {
+            SDL_LogRing *ring = SDL_GetLogRing();
+            if (ring) {
+                SDL_QueueLogMessage(ring, category, priority, fmt, ap);
+                (void)SDL_AtomicDecRef(&SDL_log_async_users);
+                return;
+            }
+        }
+        /* Couldn't get a ring for this thread, log synchronously */
+        (void)SDL_AtomicDecRef(&SDL_log_async_users);
+    }
+
     if (log_function_mutex == NULL) {
         /* this mutex creation can race if you log from two threads at startup. You should have called SDL_Init first! */
         log_function_mutex = SDL_CreateMutex();
@@ -334,12 +598,7 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, const char *fmt, va
     }
 
     /* Chop off final endline. */
-    if ((len > 0) && (message[len - 1] == '\n')) {
-        message[--len] = '\0';
-        if ((len > 0) && (message[len - 1] == '\r')) { /* catch "\r\n", too. */
-            message[--len] = '\0';
-        }
-    }
+    len = SDL_ChopLogEndline(message, len);
 
     SDL_LockMutex(log_function_mutex);
     SDL_log_function(SDL_log_userdata, category, priority, message);
@@ -504,3 +763,43 @@ void SDL_LogSetOutputFunction(SDL_LogOutputFunction callback, void *userdata)
     SDL_log_function = callback;
     SDL_log_userdata = userdata;
 }
+
+int SDL_LogSetAsync(SDL_bool async)
+{
+    if (!async) {
+        SDL_StopLogThread();
+        return 0;
+    }
+
+    if (SDL_log_async_thread) {
+        return 0;
+    }
+
+    if (log_function_mutex == NULL) {
+        log_function_mutex = SDL_CreateMutex();
+    }
+    if (SDL_log_async_tls == 0) {
+        SDL_log_async_tls = SDL_CreateTLS();
+    }
+
+    SDL_log_async_wakeup = SDL_CreateSemaphore(0);
+    if (SDL_log_async_wakeup == NULL) {
+        return -1;
+    }
+
+    SDL_AtomicSet(&SDL_log_async_quit, 0);
+    SDL_AtomicSet(&SDL_log_async_dropped, 0);
+    SDL_log_async_thread = SDL_CreateThreadInternal(SDL_LogThread, "SDLLog", 0, NULL);
+    if (SDL_log_async_thread == NULL) {
+        SDL_DestroySemaphore(SDL_log_async_wakeup);
+        SDL_log_async_wakeup = NULL;
+        return -1;
+    }
+    SDL_AtomicSet(&SDL_log_async_enabled, 1);
+    return 0;
+}
+
+int SDL_LogGetDroppedMessages(void)
+{
+    return SDL_AtomicGet(&SDL_log_async_dropped);
+}
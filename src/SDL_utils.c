@@ -21,6 +21,7 @@
 #include "SDL_internal.h"
 
 #include "SDL_utils_c.h"
+#include "thread/SDL_systhread.h"
 
 /* Common utility functions that aren't in the public API */
 
@@ -61,3 +62,68 @@ SDL_bool SDL_endswith(const char *string, const char *suffix)
     }
     return SDL_FALSE;
 }
+
+typedef struct SDL_ParallelJob
+{
+    SDL_ParallelFunc process;
+    void *userdata;
+    int index;
+    int first;
+    int count;
+    SDL_Thread *thread;
+} SDL_ParallelJob;
+
+static int SDLCALL SDL_RunParallelJob(void *data)
+{
+    SDL_ParallelJob *job = (SDL_ParallelJob *)data;
+    job->process(job->userdata, job->index, job->first, job->count);
+    return 0;
+}
+
+int SDL_GetParallelJobCount(int count, size_t bytes)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_CONVERT_THREADS);
+    size_t threads = (size_t)SDL_GetCPUCount();
+
+    if (hint != NULL && *hint) {
+        threads = (size_t)SDL_max(SDL_atoi(hint), 0);
+    }
+    if (threads > bytes / SDL_PARALLEL_MIN_BYTES_PER_JOB) {
+        threads = bytes / SDL_PARALLEL_MIN_BYTES_PER_JOB;
+    }
+    if (threads > (size_t)SDL_max(count, 0)) {
+        threads = (size_t)SDL_max(count, 0);
+    }
+    if (threads > SDL_PARALLEL_MAX_JOBS) {
+        threads = SDL_PARALLEL_MAX_JOBS;
+    }
+    return threads > 1 ? (int)threads : 1;
+}
+
+void SDL_RunParallel(int numjobs, int count, SDL_ParallelFunc process, void *userdata)
+{
+    SDL_ParallelJob jobs[SDL_PARALLEL_MAX_JOBS];
+    int i;
+
+    numjobs = SDL_clamp(numjobs, 1, SDL_PARALLEL_MAX_JOBS);
+    for (i = 0; i < numjobs; ++i) {
+        SDL_ParallelJob *job = &jobs[i];
+        job->process = process;
+        job->userdata = userdata;
+        job->index = i;
+        job->first = (int)((Sint64)count * i / numjobs);
+        job->count = (int)((Sint64)count * (i + 1) / numjobs) - job->first;
+        job->thread = NULL;
+    }
+
+    for (i = 1; i < numjobs; ++i) {
+        jobs[i].thread = SDL_CreateThreadInternal(SDL_RunParallelJob, "SDLConvert", 0, &jobs[i]);
+    }
+    for (i = 0; i < numjobs; ++i) {
+        if (jobs[i].thread != NULL) {
+            SDL_WaitThread(jobs[i].thread, NULL);
+        } else {
+            SDL_RunParallelJob(&jobs[i]);
+        }
+    }
+}
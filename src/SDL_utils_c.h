@@ -30,4 +30,22 @@ extern int SDL_powerof2(int x);
 
 SDL_bool SDL_endswith(const char *string, const char *suffix);
 
+/* Large conversions are split into bands of items (rows, blocks) that are
+   processed on several threads. Bands with less output than this aren't worth
+   starting a thread for. */
+#define SDL_PARALLEL_MAX_JOBS          16
+#define SDL_PARALLEL_MIN_BYTES_PER_JOB (256 * 1024)
+
+/* Processes `count` items starting at `first`, `job` is the index of the band */
+typedef void (*SDL_ParallelFunc)(void *userdata, int job, int first, int count);
+
+/* Returns how many bands to split `count` items producing `bytes` of output
+   into, from 1 to SDL_PARALLEL_MAX_JOBS, following SDL_HINT_CONVERT_THREADS */
+extern int SDL_GetParallelJobCount(int count, size_t bytes);
+
+/* Splits `count` items into `numjobs` bands and calls `process` on each, and
+   returns when they are all done. The calling thread takes the first band, and
+   any band whose thread can't be created. */
+extern void SDL_RunParallel(int numjobs, int count, SDL_ParallelFunc process, void *userdata);
+
 #endif /* SDL_utils_h_ */
@@ -151,6 +151,55 @@ static SDL_AudioDeviceID assign_audio_device_instance_id(SDL_bool iscapture, SDL
     return instance_id;
 }
 
+// Call with the device lock held.
+static void FreeAudioCaptureRing(SDL_AudioCaptureRing *ring)
+{
+    if (ring) {
+        for (int i = 0; i < SDL_AUDIO_CAPTURE_RING_BUFFERS; i++) {
+            SDL_aligned_free(ring->slots[i].buffer);
+        }
+        SDL_free(ring);
+    }
+}
+
+// Call with the device lock held. Detaches every reader from a device that is closing and frees its ring.
+static void DetachAudioCaptureReaders(SDL_AudioDevice *device)
+{
+    SDL_AudioCaptureRing *ring = device->capture_ring;
+    if (ring) {
+        SDL_AudioCaptureReader *next;
+        for (SDL_AudioCaptureReader *reader = ring->readers; reader != NULL; reader = next) {
+            next = reader->next;
+            SDL_AtomicSet(&reader->detached, 1);
+            reader->held_slot = -1;
+            reader->prev = reader->next = NULL;
+        }
+        FreeAudioCaptureRing(ring);
+        device->capture_ring = NULL;
+    }
+}
+
+static void FreeAudioPostmixChain(SDL_AudioPostmixEntry *chain)
+{
+    SDL_AudioPostmixEntry *next;
+    for (SDL_AudioPostmixEntry *entry = chain; entry != NULL; entry = next) {
+        next = entry->next;
+        SDL_free(entry);
+    }
+}
+
+static void FreeAudioStreamGroups(SDL_AudioStreamGroup *groups)
+{
+    SDL_AudioStreamGroup *next;
+    for (SDL_AudioStreamGroup *group = groups; group != NULL; group = next) {
+        next = group->next;
+        SDL_DestroyAudioStream(group->stream);
+        SDL_aligned_free(group->mix_buffer);
+        SDL_aligned_free(group->work_buffer);
+        SDL_free(group);
+    }
+}
+
 // this assumes you hold the _physical_ device lock for this logical device! This will not unlock the lock or close the physical device!
 static void DestroyLogicalAudioDevice(SDL_LogicalAudioDevice *logdev)
 {
@@ -176,6 +225,8 @@ static void DestroyLogicalAudioDevice(SDL_LogicalAudioDevice *logdev)
         SDL_UnlockMutex(stream->lock);
     }
 
+    FreeAudioPostmixChain(logdev->postmix);
+    FreeAudioStreamGroups(logdev->stream_groups);
     SDL_free(logdev);
 }
 
@@ -676,6 +727,44 @@ void SDL_AudioThreadFinalize(SDL_AudioDevice *device)
     SDL_AtomicSet(&device->thread_alive, 0);
 }
 
+void SDL_InitSimulatedAudioTiming(SDL_SimulatedAudioTiming *timing, Uint32 period_ms)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_SIMULATED_LOAD);
+    const int load = hint ? SDL_max(SDL_atoi(hint), 0) : 0;
+    timing->period_ns = SDL_MS_TO_NS(period_ms);
+    timing->next_wakeup_ns = SDL_GetTicksNS();
+    timing->load_ns = (timing->period_ns * load) / 100;
+}
+
+void SDL_WaitSimulatedAudioDevice(SDL_AudioDevice *device, SDL_SimulatedAudioTiming *timing)
+{
+    if (device->offline_mode == SDL_AUDIO_OFFLINE_FAST) {
+        SDL_DelayNS(1);  // no waiting for the "hardware", but give other threads a chance at the device lock.
+        return;
+    }
+
+    // wake up once per period like real hardware would, no matter how long the last buffer took.
+    const Uint64 period = timing->period_ns;
+    const Uint64 now = SDL_GetTicksNS();
+    timing->next_wakeup_ns += period;
+    if (timing->next_wakeup_ns > now) {
+        SDL_DelayNS(timing->next_wakeup_ns - now);
+    } else {
+        // we're late. Still sleep a moment, so other threads can get at the device lock.
+        if ((now - timing->next_wakeup_ns) > period) {
+            timing->next_wakeup_ns = now;  // fell way behind; don't try to catch up all at once.
+        }
+        SDL_Delay(1);
+    }
+}
+
+void SDL_SimulateAudioDeviceLoad(const SDL_SimulatedAudioTiming *timing)
+{
+    if (timing->load_ns) {
+        SDL_DelayNS(timing->load_ns);  // pretend this was expensive.
+    }
+}
+
 // Output device thread. This is split into chunks, so backends that need to control this directly can use the pieces they need without duplicating effort.
 
 void SDL_OutputAudioThreadSetup(SDL_AudioDevice *device)
@@ -684,6 +773,384 @@ void SDL_OutputAudioThreadSetup(SDL_AudioDevice *device)
     current_audio.impl.ThreadInit(device);
 }
 
+// Output streams convert to float32 at the device's rate and channel count; the device thread mixes in that format.
+static void GetOutputStreamSpec(const SDL_AudioDevice *device, SDL_AudioSpec *spec)
+{
+    SDL_memcpy(spec, &device->spec, sizeof (SDL_AudioSpec));
+    spec->format = SDL_AUDIO_F32SYS;
+}
+
+// Call with the device lock held when the device thread starts on a buffer. Returns the start time for EndAudioDeviceStats.
+static Uint64 BeginAudioDeviceStats(SDL_AudioDevice *device)
+{
+    const Uint64 now = SDL_GetTicksNS();
+    const Uint64 period = device->stats.period_ns;
+    if (device->last_wakeup_ns && ((now - device->last_wakeup_ns) > (period + (period / 2)))) {
+        device->stats.late_wakeups++;
+    }
+    device->last_wakeup_ns = now;
+    return now;
+}
+
+// Call with the device lock held when the device thread is done with a buffer.
+static void EndAudioDeviceStats(SDL_AudioDevice *device, const Uint64 start)
+{
+    SDL_AudioDeviceStats *stats = &device->stats;
+    const Uint64 elapsed = SDL_GetTicksNS() - start;
+    const Uint64 period = stats->period_ns;
+    Uint64 bucket = SDL_AUDIO_STATS_HISTOGRAM_BUCKETS - 1;
+
+    if (period > 0) {
+        bucket = SDL_min((elapsed * SDL_AUDIO_STATS_HISTOGRAM_BUCKETS) / period, bucket);
+    }
+    stats->process_histogram[bucket]++;
+    stats->periods++;
+    stats->process_ns_total += elapsed;
+    stats->process_ns_max = SDL_max(stats->process_ns_max, elapsed);
+    if (elapsed > period) {
+        stats->xruns++;
+    }
+}
+
+// Call with the stream lock held after the device thread moved data through a bound stream.
+static void UpdateAudioStreamStats(SDL_AudioStream *stream, const Uint64 start, const SDL_bool starved)
+{
+    SDL_AudioStreamStats *stats = &stream->stats;
+    const Uint64 elapsed = SDL_GetTicksNS() - start;
+
+    stats->queued_frames = (int) (SDL_GetDataQueueSize(stream->queue) / stream->src_sample_frame_size) + stream->future_buffer_filled_frames;
+    stats->device_transfers++;
+    stats->convert_ns_total += elapsed;
+    stats->convert_ns_max = SDL_max(stats->convert_ns_max, elapsed);
+    if (starved) {
+        stats->starved++;
+    }
+}
+
+// Call with the device lock held. Runs each callback in a post-mix chain over `buffer`, returns the time it took.
+static Uint64 RunAudioPostmixChain(SDL_AudioDevice *device, SDL_AudioPostmixEntry *chain, float *buffer, const int buflen)
+{
+    SDL_AudioSpec spec;
+    GetOutputStreamSpec(device, &spec);
+
+    const Uint64 start = SDL_GetTicksNS();
+    Uint64 then = start;
+    for (SDL_AudioPostmixEntry *entry = chain; entry != NULL; entry = entry->next) {
+        entry->callback(entry->userdata, &spec, buffer, buflen);
+        const Uint64 now = SDL_GetTicksNS();
+        const Uint64 elapsed = now - then;
+        entry->stats.calls++;
+        entry->stats.ns_total += elapsed;
+        entry->stats.ns_max = SDL_max(entry->stats.ns_max, elapsed);
+        then = now;
+    }
+    return then - start;
+}
+
+static void MixFloat32Audio(float *dst, const float *src, const int num_samples, const float gain)
+{
+    if (gain == 1.0f) {
+        for (int i = 0; i < num_samples; i++) {
+            dst[i] += src[i];
+        }
+    } else {
+        for (int i = 0; i < num_samples; i++) {
+            dst[i] += src[i] * gain;
+        }
+    }
+}
+
+static SDL_bool AudioSpecsEqual(const SDL_AudioSpec *a, const SDL_AudioSpec *b)
+{
+    return (a->format == b->format) && (a->channels == b->channels) && (a->freq == b->freq);
+}
+
+static SDL_bool IsAudioStreamScheduled(const SDL_AudioStream *stream)
+{
+    return (stream->start_frame != 0) || (stream->stop_frame != 0);
+}
+
+/* Works out which part of a buffer starting at device frame `first_frame` a bound stream plays in, as a frame offset
+   into the buffer and a count. Returns SDL_FALSE if its schedule keeps it silent for the whole buffer. */
+static SDL_bool GetAudioStreamScheduledFrames(const SDL_AudioStream *stream, const Uint64 first_frame, const int num_frames, int *offset, int *frames)
+{
+    Uint64 start = first_frame;
+    Uint64 end = first_frame + num_frames;
+
+    if (stream->start_frame > start) {
+        start = stream->start_frame;
+    }
+    if (stream->stop_frame && (stream->stop_frame < end)) {
+        end = stream->stop_frame;
+    }
+    if (start >= end) {
+        return SDL_FALSE;
+    }
+
+    *offset = (int) (start - first_frame);
+    *frames = (int) (end - start);
+    return SDL_TRUE;
+}
+
+static SDL_AudioStreamGroup *FindAudioStreamGroup(SDL_LogicalAudioDevice *logdev, const SDL_AudioSpec *spec)
+{
+    for (SDL_AudioStreamGroup *group = logdev->stream_groups; group != NULL; group = group->next) {
+        if (AudioSpecsEqual(&group->src_spec, spec)) {
+            return group;
+        }
+    }
+    return NULL;
+}
+
+// Call with the device lock held. Adds a group for streams with the source format `spec`, which `stream` converts from `src_spec` to `dst_spec`.
+static SDL_AudioStreamGroup *CreateAudioStreamGroup(SDL_LogicalAudioDevice *logdev, const SDL_AudioSpec *spec, const SDL_AudioSpec *src_spec, const SDL_AudioSpec *dst_spec)
+{
+    SDL_AudioStreamGroup *group = (SDL_AudioStreamGroup *) SDL_calloc(1, sizeof (SDL_AudioStreamGroup));
+    if (!group) {
+        return NULL;
+    }
+    group->stream = SDL_CreateAudioStream(src_spec, dst_spec);
+    if (!group->stream) {
+        SDL_free(group);
+        return NULL;
+    }
+    SDL_copyp(&group->src_spec, spec);
+    group->next = logdev->stream_groups;
+    logdev->stream_groups = group;
+    return group;
+}
+
+// Call with the device lock held, after counting members. Drops groups that emptied out.
+static void RemoveEmptyAudioStreamGroups(SDL_LogicalAudioDevice *logdev)
+{
+    SDL_AudioStreamGroup **prev = &logdev->stream_groups;
+    SDL_AudioStreamGroup *next;
+    for (SDL_AudioStreamGroup *group = logdev->stream_groups; group != NULL; group = next) {
+        next = group->next;
+        if (group->members == 0) {
+            *prev = next;
+            group->next = NULL;
+            FreeAudioStreamGroups(group);
+        } else {
+            prev = &group->next;
+        }
+    }
+}
+
+// Makes sure a group's buffers hold at least `frames` sample frames of its source format as float32.
+static int EnsureAudioStreamGroupBuffers(SDL_AudioStreamGroup *group, const int frames)
+{
+    if (frames <= group->buffer_frames) {
+        return 0;
+    }
+
+    const size_t alloclen = ((size_t) frames) * group->src_spec.channels * sizeof (float);
+    float *mix_buffer = (float *) SDL_aligned_alloc(SDL_SIMDGetAlignment(), alloclen);
+    float *work_buffer = (float *) SDL_aligned_alloc(SDL_SIMDGetAlignment(), alloclen);
+    if (!mix_buffer || !work_buffer) {
+        SDL_aligned_free(mix_buffer);
+        SDL_aligned_free(work_buffer);
+        return SDL_OutOfMemory();
+    }
+    SDL_aligned_free(group->mix_buffer);
+    SDL_aligned_free(group->work_buffer);
+    group->mix_buffer = mix_buffer;
+    group->work_buffer = work_buffer;
+    group->buffer_frames = frames;
+    return 0;
+}
+
+// Call with the device lock held. Sorts a logical device's bound output streams into groups by source format, dropping groups that emptied out.
+static void UpdateAudioStreamGroups(SDL_AudioDevice *device, SDL_LogicalAudioDevice *logdev)
+{
+    for (SDL_AudioStreamGroup *group = logdev->stream_groups; group != NULL; group = group->next) {
+        group->members = 0;
+    }
+
+    for (SDL_AudioStream *stream = logdev->bound_streams; stream != NULL; stream = stream->next_binding) {
+        if (IsAudioStreamScheduled(stream)) {
+            continue;  // scheduled streams start and stop mid-buffer, so they are always mixed on their own.
+        }
+
+        SDL_AudioStreamGroup *group = FindAudioStreamGroup(logdev, &stream->src_spec);
+        if (!group) {
+            SDL_AudioSpec spec;
+            spec.format = SDL_AUDIO_F32SYS;
+            spec.channels = stream->src_spec.channels;
+            spec.freq = stream->src_spec.freq;
+            SDL_AudioSpec dst_spec;
+            GetOutputStreamSpec(device, &dst_spec);
+
+            group = CreateAudioStreamGroup(logdev, &stream->src_spec, &spec, &dst_spec);
+            if (!group) {
+                continue;  // this stream will just be converted on its own.
+            }
+        }
+        group->members++;
+    }
+
+    RemoveEmptyAudioStreamGroups(logdev);
+}
+
+/* Call with the device lock held. Sums the input of every stream in `group` at the source rate, converts and resamples
+   that once, and leaves `mix_size` bytes (or less, if it ran out) of float32 in device->work_buffer. Returns bytes, or -1 on error. */
+static int GetAudioStreamGroupData(SDL_AudioDevice *device, SDL_LogicalAudioDevice *logdev, SDL_AudioStreamGroup *group, const int mix_size)
+{
+    SDL_AudioSpec dst_spec;
+    GetOutputStreamSpec(device, &dst_spec);
+    if (!AudioSpecsEqual(&group->stream->dst_spec, &dst_spec) && (SDL_SetAudioStreamFormat(group->stream, NULL, &dst_spec) < 0)) {
+        return -1;
+    }
+
+    SDL_LockMutex(group->stream->lock);
+    const int frames = SDL_GetAudioStreamInputFramesNeeded(group->stream, mix_size);
+    SDL_UnlockMutex(group->stream->lock);
+
+    if (frames > 0) {
+        const int channels = group->src_spec.channels;
+        const int samples = frames * channels;
+
+        if (EnsureAudioStreamGroupBuffers(group, frames) < 0) {
+            return -1;
+        }
+
+        SDL_memset(group->mix_buffer, '\0', samples * sizeof (float));  // start with silence; all zero bits is 0.0f.
+
+        for (SDL_AudioStream *stream = logdev->bound_streams; stream != NULL; stream = stream->next_binding) {
+            if (IsAudioStreamScheduled(stream) || !AudioSpecsEqual(&stream->src_spec, &group->src_spec)) {
+                continue;
+            }
+
+            SDL_LockMutex(stream->lock);
+            const float gain = stream->gain * logdev->gain;
+            const Uint64 convert_start = SDL_GetTicksNS();
+            const int br = SDL_GetAudioStreamSourceData(stream, group->work_buffer, frames);
+            UpdateAudioStreamStats(stream, convert_start, (br < frames));
+            SDL_UnlockMutex(stream->lock);
+
+            if ((br > 0) && (gain != 0.0f)) {
+                MixFloat32Audio(group->mix_buffer, group->work_buffer, br * channels, gain);
+            }
+        }
+
+        // streams that ran dry just add silence, so the group stays in step with the device.
+        if (SDL_PutAudioStreamData(group->stream, group->mix_buffer, samples * (int) sizeof (float)) < 0) {
+            return -1;
+        }
+    }
+
+    return SDL_GetAudioStreamData(group->stream, device->work_buffer, mix_size);
+}
+
+/* Call with the device lock held. Sorts a logical device's bound capture streams into groups by the format they want.
+   A stream joins a group by switching to its output format on both ends, once it has no data queued in the device format;
+   from then on it gets audio its group already converted. Streams that want the device format need no conversion at all. */
+static void UpdateCaptureStreamGroups(SDL_AudioDevice *device, SDL_LogicalAudioDevice *logdev)
+{
+    for (SDL_AudioStreamGroup *group = logdev->stream_groups; group != NULL; group = group->next) {
+        group->members = 0;
+    }
+
+    for (SDL_AudioStream *stream = logdev->bound_streams; stream != NULL; stream = stream->next_binding) {
+        // streams that want the device format take it as is, the rest take what their group converted.
+        SDL_LockMutex(stream->lock);
+        const SDL_bool wants_device_format = AudioSpecsEqual(&stream->dst_spec, &device->spec);
+        const SDL_AudioSpec *input_spec = wants_device_format ? &device->spec : &stream->dst_spec;
+        if (!AudioSpecsEqual(&stream->src_spec, input_spec) && (SDL_GetDataQueueSize(stream->queue) == 0) && (stream->future_buffer_filled_frames == 0)) {
+            SDL_SetAudioStreamGroupInput(stream, wants_device_format ? NULL : input_spec);  // if this fails, the stream just keeps converting on its own.
+        }
+        SDL_UnlockMutex(stream->lock);
+
+        if (AudioSpecsEqual(&stream->src_spec, &device->spec)) {
+            continue;  // gets the raw device data.
+        }
+
+        SDL_AudioStreamGroup *group = FindAudioStreamGroup(logdev, &stream->src_spec);
+        if (!group) {
+            group = CreateAudioStreamGroup(logdev, &stream->src_spec, &device->spec, &stream->src_spec);
+            if (!group) {
+                continue;  // out of memory; this stream misses out until a group can be made.
+            }
+        }
+        group->members++;
+    }
+
+    RemoveEmptyAudioStreamGroups(logdev);
+}
+
+// Call with the device lock held. Converts a captured buffer to a group's format once and puts a copy in each of its streams.
+static int PutCapturedAudioInGroup(SDL_AudioDevice *device, SDL_LogicalAudioDevice *logdev, SDL_AudioStreamGroup *group, const Uint8 *buffer, const int buflen)
+{
+    if (!AudioSpecsEqual(&group->stream->src_spec, &device->spec) && (SDL_SetAudioStreamFormat(group->stream, &device->spec, NULL) < 0)) {
+        return -1;
+    } else if (SDL_PutAudioStreamData(group->stream, buffer, buflen) < 0) {
+        return -1;
+    }
+
+    const int available = SDL_GetAudioStreamAvailable(group->stream);
+    const int frame_size = (SDL_AUDIO_BITSIZE(group->src_spec.format) / 8) * group->src_spec.channels;
+    if (EnsureAudioStreamGroupBuffers(group, available / frame_size) < 0) {
+        return -1;
+    }
+
+    const int br = SDL_GetAudioStreamData(group->stream, group->work_buffer, available);
+    if (br <= 0) {
+        return br;
+    }
+
+    for (SDL_AudioStream *stream = logdev->bound_streams; stream != NULL; stream = stream->next_binding) {
+        if (!AudioSpecsEqual(&stream->src_spec, &group->src_spec)) {
+            continue;
+        }
+
+        SDL_LockMutex(stream->lock);
+        const Uint64 convert_start = SDL_GetTicksNS();
+        const int putrc = SDL_PutAudioStreamData(stream, group->work_buffer, br);
+        UpdateAudioStreamStats(stream, convert_start, SDL_FALSE);
+        SDL_UnlockMutex(stream->lock);
+        if (putrc < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Call with the device lock held. The ring slot the device should capture into next, or NULL if there are no readers or a reader holds it.
+static SDL_AudioCaptureSlot *GetAudioCaptureSlot(SDL_AudioDevice *device)
+{
+    SDL_AudioCaptureRing *ring = device->capture_ring;
+    if (ring) {
+        SDL_AudioCaptureSlot *slot = &ring->slots[ring->write_sequence % SDL_AUDIO_CAPTURE_RING_BUFFERS];
+        if (slot->holds == 0) {
+            // the device buffer can grow after a format change. Nobody holds this slot, so it's safe to replace.
+            if (slot->allocation < device->buffer_size) {
+                Uint8 *buffer = (Uint8 *) SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->buffer_size);
+                if (!buffer) {
+                    return NULL;  // readers will count this one as dropped, and the next slot tries again.
+                }
+                SDL_aligned_free(slot->buffer);
+                slot->buffer = buffer;
+                slot->allocation = device->buffer_size;
+            }
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+// Call with the device lock held after capturing a buffer. If it went somewhere other than `slot`, readers will count it as dropped.
+static void PublishAudioCaptureSlot(SDL_AudioDevice *device, SDL_AudioCaptureSlot *slot, const int buflen)
+{
+    SDL_AudioCaptureRing *ring = device->capture_ring;
+    if (ring) {
+        if (slot) {
+            slot->sequence = ring->write_sequence;
+            slot->buflen = buflen;
+        }
+        ring->write_sequence++;
+    }
+}
+
 SDL_bool SDL_OutputAudioThreadIterate(SDL_AudioDevice *device)
 {
     SDL_assert(!device->iscapture);
@@ -695,43 +1162,123 @@ SDL_bool SDL_OutputAudioThreadIterate(SDL_AudioDevice *device)
         return SDL_FALSE;  // we're done, shut it down.
     }
 
+    const Uint64 start = BeginAudioDeviceStats(device);
     SDL_bool retval = SDL_TRUE;
     int buffer_size = device->buffer_size;
-    Uint8 *mix_buffer = current_audio.impl.GetDeviceBuf(device, &buffer_size);
-    if (!mix_buffer) {
+    Uint8 *device_buffer = current_audio.impl.GetDeviceBuf(device, &buffer_size);
+    if (!device_buffer) {
         retval = SDL_FALSE;
     } else {
         SDL_assert(buffer_size <= device->buffer_size);  // you can ask for less, but not more.
-        SDL_memset(mix_buffer, device->silence_value, buffer_size);  // start with silence.
+
+        const int channels = device->spec.channels;
+        const int num_frames = buffer_size / ((SDL_AUDIO_BITSIZE(device->spec.format) / 8) * channels);
+        const int mix_size = num_frames * channels * (int) sizeof (float);
+        Uint64 postmix_ns = 0;
+        SDL_bool mixed = SDL_FALSE;
+
+        SDL_assert(mix_size <= device->work_buffer_size);
+        SDL_memset(device->mix_buffer, '\0', mix_size);  // start with silence; all zero bits is 0.0f.
 
         for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev != NULL; logdev = logdev->next) {
             if (SDL_AtomicGet(&logdev->paused)) {
                 continue;  // paused? Skip this logical device.
             }
 
+            // a logical device with post-mix callbacks gets a mix of its own, which is added to the final mix once they've run.
+            float *logdev_mix_buffer = device->mix_buffer;
+            if (logdev->postmix) {
+                logdev_mix_buffer = device->postmix_buffer;
+                SDL_memset(logdev_mix_buffer, '\0', mix_size);
+            }
+
+            if (device->group_streams) {
+                UpdateAudioStreamGroups(device, logdev);
+                for (SDL_AudioStreamGroup *group = logdev->stream_groups; group != NULL; group = group->next) {
+                    if (group->members <= 1) {
+                        // the stream left on its own picks up from its history; drop what the group buffered, so it isn't played if the group fills back up.
+                        if (group->active) {
+                            SDL_ClearAudioStream(group->stream);
+                            group->active = SDL_FALSE;
+                        }
+                    } else {
+                        group->active = SDL_TRUE;
+                        const int br = GetAudioStreamGroupData(device, logdev, group, mix_size);
+                        if (br < 0) {
+                            retval = SDL_FALSE;  // probably out of memory, same as a stream failing below.
+                            break;
+                        } else if (br > 0) {
+                            MixFloat32Audio(logdev_mix_buffer, (const float *) device->work_buffer, br / (int) sizeof (float), 1.0f);
+                            mixed = SDL_TRUE;
+                        }
+                    }
+                }
+            }
+
             for (SDL_AudioStream *stream = logdev->bound_streams; stream != NULL; stream = stream->next_binding) {
+                if (device->group_streams && !IsAudioStreamScheduled(stream)) {
+                    const SDL_AudioStreamGroup *group = FindAudioStreamGroup(logdev, &stream->src_spec);
+                    if (group && (group->members > 1)) {
+                        continue;  // already mixed with the rest of its group.
+                    }
+                }
+
                 /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
                    for iterating here because the binding linked list can only change while the device lock is held.
                    (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
                    the same stream to different devices at the same time, though.) */
-                const int br = SDL_GetAudioStreamData(stream, device->work_buffer, buffer_size);
+                // a scheduled stream might only play part of this buffer, starting and stopping on exact frames.
+                int offset = 0;
+                int frames = num_frames;
+                if (!GetAudioStreamScheduledFrames(stream, device->frames_played, num_frames, &offset, &frames)) {
+                    continue;  // not playing during this buffer.
+                }
+                const int stream_mix_size = frames * channels * (int) sizeof (float);
+
+                SDL_LockMutex(stream->lock);
+                const float gain = stream->gain * logdev->gain;
+                const Uint64 convert_start = SDL_GetTicksNS();
+                const int br = SDL_GetAudioStreamData(stream, device->work_buffer, stream_mix_size);
+                UpdateAudioStreamStats(stream, convert_start, (br >= 0) && (br < stream_mix_size));
+                SDL_UnlockMutex(stream->lock);
+
                 if (br < 0) {
                     // oh crud, we probably ran out of memory. This is possibly an overreaction to kill the audio device, but it's likely the whole thing is going down in a moment anyhow.
                     retval = SDL_FALSE;
                     break;
-                } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
-                    // !!! FIXME: this needs to mix to float32 or int32, so we don't clip.
-                    if (SDL_MixAudioFormat(mix_buffer, device->work_buffer, device->spec.format, br, SDL_MIX_MAXVOLUME) < 0) {  // !!! FIXME: allow streams to specify gain?
-                        SDL_assert(!"We probably ended up with some totally unexpected audio format here");
-                        retval = SDL_FALSE;  // uh...?
-                        break;
-                    }
+                } else if ((br > 0) && (gain != 0.0f)) {  // it's okay if we get less than requested, we mix what we have.
+                    MixFloat32Audio(logdev_mix_buffer + (offset * channels), (const float *) device->work_buffer, br / (int) sizeof (float), gain);
+                    mixed = SDL_TRUE;
                 }
             }
+
+            // run these even if nothing was mixed, so effects like reverb can ring out.
+            if (logdev->postmix) {
+                postmix_ns += RunAudioPostmixChain(device, logdev->postmix, logdev_mix_buffer, mix_size);
+                MixFloat32Audio(device->mix_buffer, logdev_mix_buffer, mix_size / (int) sizeof (float), 1.0f);
+                mixed = SDL_TRUE;
+            }
+        }
+
+        if (device->postmix) {
+            postmix_ns += RunAudioPostmixChain(device, device->postmix, device->mix_buffer, mix_size);
+            mixed = SDL_TRUE;
+        }
+        device->stats.postmix_ns_total += postmix_ns;
+        device->stats.postmix_ns_max = SDL_max(device->stats.postmix_ns_max, postmix_ns);
+
+        // Convert the whole mix to the device format once. Integer formats clamp here, and only here.
+        if (mixed) {
+            SDL_ConvertAudio(num_frames, device->mix_buffer, SDL_AUDIO_F32SYS, channels, device_buffer, device->spec.format, channels);
+        } else {
+            SDL_memset(device_buffer, device->silence_value, buffer_size);
         }
 
         // !!! FIXME: have PlayDevice return a value and do disconnects in here with it.
-        current_audio.impl.PlayDevice(device, mix_buffer, buffer_size);  // this SHOULD NOT BLOCK, as we are holding a lock right now. Block in WaitDevice!
+        current_audio.impl.PlayDevice(device, device_buffer, buffer_size);  // this SHOULD NOT BLOCK, as we are holding a lock right now. Block in WaitDevice!
+        device->frames_played += num_frames;
+        device->last_period_ns = SDL_GetTicksNS();
+        EndAudioDeviceStats(device, start);
     }
 
     SDL_UnlockMutex(device->lock);
@@ -790,22 +1337,49 @@ SDL_bool SDL_CaptureAudioThreadIterate(SDL_AudioDevice *device)
     } else if (device->logical_devices == NULL) {
         current_audio.impl.FlushCapture(device); // nothing wants data, dump anything pending.
     } else {
+        const Uint64 start = BeginAudioDeviceStats(device);
+        // if there are capture readers, capture straight into their ring, so everything below works from the same memory they read.
+        SDL_AudioCaptureSlot *slot = GetAudioCaptureSlot(device);
+        Uint8 *capture_buffer = slot ? slot->buffer : device->work_buffer;
         // this SHOULD NOT BLOCK, as we are holding a lock right now. Block in WaitCaptureDevice!
-        const int rc = current_audio.impl.CaptureFromDevice(device, device->work_buffer, device->buffer_size);
+        const int rc = current_audio.impl.CaptureFromDevice(device, capture_buffer, device->buffer_size);
         if (rc < 0) {  // uhoh, device failed for some reason!
             retval = SDL_FALSE;
         } else if (rc > 0) {  // queue the new data to each bound stream.
+            PublishAudioCaptureSlot(device, slot, rc);
+            device->frames_played += rc / ((SDL_AUDIO_BITSIZE(device->spec.format) / 8) * device->spec.channels);
+            device->last_period_ns = SDL_GetTicksNS();
             for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev != NULL; logdev = logdev->next) {
                 if (SDL_AtomicGet(&logdev->paused)) {
                     continue;  // paused? Skip this logical device.
                 }
 
+                // streams that want the same format share one conversion.
+                if (device->group_streams) {
+                    UpdateCaptureStreamGroups(device, logdev);
+                    for (SDL_AudioStreamGroup *group = logdev->stream_groups; group != NULL; group = group->next) {
+                        if (PutCapturedAudioInGroup(device, logdev, group, capture_buffer, rc) < 0) {
+                            retval = SDL_FALSE;  // probably out of memory, same as a stream failing below.
+                            break;
+                        }
+                    }
+                }
+
                 for (SDL_AudioStream *stream = logdev->bound_streams; stream != NULL; stream = stream->next_binding) {
+                    if (device->group_streams && !AudioSpecsEqual(&stream->src_spec, &device->spec)) {
+                        continue;  // its group already gave it the converted audio.
+                    }
+
                     /* this will hold a lock on `stream` while putting. We don't explicitly lock the streams
                        for iterating here because the binding linked list can only change while the device lock is held.
                        (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
                        the same stream to different devices at the same time, though.) */
-                    if (SDL_PutAudioStreamData(stream, device->work_buffer, rc) < 0) {
+                    SDL_LockMutex(stream->lock);
+                    const Uint64 convert_start = SDL_GetTicksNS();
+                    const int putrc = SDL_PutAudioStreamData(stream, capture_buffer, rc);
+                    UpdateAudioStreamStats(stream, convert_start, SDL_FALSE);
+                    SDL_UnlockMutex(stream->lock);
+                    if (putrc < 0) {
                         // oh crud, we probably ran out of memory. This is possibly an overreaction to kill the audio device, but it's likely the whole thing is going down in a moment anyhow.
                         retval = SDL_FALSE;
                         break;
@@ -813,6 +1387,7 @@ SDL_bool SDL_CaptureAudioThreadIterate(SDL_AudioDevice *device)
                 }
             }
         }
+        EndAudioDeviceStats(device, start);
     }
 
     SDL_UnlockMutex(device->lock);
@@ -1069,7 +1644,7 @@ int SDL_GetAudioDeviceFormat(SDL_AudioDeviceID devid, SDL_AudioSpec *spec)
 // this expects the device lock to be held.  !!! FIXME: no it doesn't...?
 static void ClosePhysicalAudioDevice(SDL_AudioDevice *device)
 {
-    SDL_assert(current_audio.impl.ProvidesOwnCallbackThread || ((device->thread == NULL) == (SDL_AtomicGet(&device->thread_alive) == 0)));
+    SDL_assert(current_audio.impl.ProvidesOwnCallbackThread || (device->offline_mode == SDL_AUDIO_OFFLINE_MANUAL) || ((device->thread == NULL) == (SDL_AtomicGet(&device->thread_alive) == 0)));
 
     if (SDL_AtomicGet(&device->thread_alive)) {
         SDL_AtomicSet(&device->shutdown, 1);
@@ -1080,6 +1655,14 @@ static void ClosePhysicalAudioDevice(SDL_AudioDevice *device)
         SDL_AtomicSet(&device->thread_alive, 0);
     }
 
+    // manually stepped devices have no thread to join; wait out any SDL_StepAudioDevice call that's in the middle of a buffer.
+    // Taking the lock makes sure a stepper that hasn't seen `shutdown` yet has at least registered itself.
+    SDL_LockMutex(device->lock);
+    SDL_UnlockMutex(device->lock);
+    while (SDL_AtomicGet(&device->steppers) > 0) {
+        SDL_Delay(1);
+    }
+
     if (device->is_opened) {
         current_audio.impl.CloseDevice(device);  // if ProvidesOwnCallbackThread, this must join on any existing device thread before returning!
         device->is_opened = SDL_FALSE;
@@ -1091,8 +1674,25 @@ static void ClosePhysicalAudioDevice(SDL_AudioDevice *device)
         device->work_buffer = NULL;
     }
 
+    if (device->mix_buffer) {
+        SDL_aligned_free(device->mix_buffer);
+        device->mix_buffer = NULL;
+    }
+
+    if (device->postmix_buffer) {
+        SDL_aligned_free(device->postmix_buffer);
+        device->postmix_buffer = NULL;
+    }
+
+    FreeAudioPostmixChain(device->postmix);
+    device->postmix = NULL;
+
+    DetachAudioCaptureReaders(device);
+
     SDL_memcpy(&device->spec, &device->default_spec, sizeof (SDL_AudioSpec));
     device->sample_frames = 0;
+    device->offline_mode = SDL_AUDIO_OFFLINE_NONE;
+    device->group_streams = SDL_FALSE;
     device->silence_value = SDL_GetSilenceValueForFormat(device->spec.format);
     SDL_AtomicSet(&device->shutdown, 0);  // ready to go again.
 }
@@ -1168,6 +1768,21 @@ static void PrepareAudioFormat(SDL_bool iscapture, SDL_AudioSpec *spec)
     }
 }
 
+static SDL_AudioOfflineMode GetOfflineMode(void)
+{
+    if (current_audio.impl.SupportsOfflineRendering) {
+        const char *hint = SDL_GetHint(SDL_HINT_AUDIO_OFFLINE_MODE);
+        if (hint) {
+            if (SDL_strcmp(hint, "fast") == 0) {
+                return SDL_AUDIO_OFFLINE_FAST;
+            } else if (SDL_strcmp(hint, "manual") == 0) {
+                return SDL_AUDIO_OFFLINE_MANUAL;
+            }
+        }
+    }
+    return SDL_AUDIO_OFFLINE_NONE;
+}
+
 static int GetDefaultSampleFramesFromFreq(int freq)
 {
     return SDL_powerof2((freq / 1000) * 46);  // Pick the closest power-of-two to ~46 ms at desired frequency
@@ -1175,8 +1790,11 @@ static int GetDefaultSampleFramesFromFreq(int freq)
 
 void SDL_UpdatedAudioDeviceFormat(SDL_AudioDevice *device)
 {
+    const int sample_size = SDL_AUDIO_BITSIZE(device->spec.format) / 8;
     device->silence_value = SDL_GetSilenceValueForFormat(device->spec.format);
-    device->buffer_size = device->sample_frames * (SDL_AUDIO_BITSIZE(device->spec.format) / 8) * device->spec.channels;
+    device->buffer_size = device->sample_frames * sample_size * device->spec.channels;
+    device->work_buffer_size = device->sample_frames * SDL_max(sample_size, (int) sizeof (float)) * device->spec.channels;
+    device->stats.period_ns = (device->spec.freq > 0) ? ((Uint64) device->sample_frames * SDL_NS_PER_SECOND) / device->spec.freq : 0;
 }
 
 char *SDL_GetAudioThreadName(SDL_AudioDevice *device, char *buf, size_t buflen)
@@ -1209,6 +1827,12 @@ static int OpenPhysicalAudioDevice(SDL_AudioDevice *device, const SDL_AudioSpec
     device->spec.freq = SDL_max(device->default_spec.freq, spec.freq);
     device->spec.channels = SDL_max(device->default_spec.channels, spec.channels);
     device->sample_frames = GetDefaultSampleFramesFromFreq(device->spec.freq);
+    SDL_zero(device->stats);
+    device->last_wakeup_ns = 0;
+    device->frames_played = 0;
+    device->last_period_ns = 0;
+    device->offline_mode = GetOfflineMode();
+    device->group_streams = SDL_GetHintBoolean(SDL_HINT_AUDIO_GROUP_STREAMS, SDL_FALSE);
     SDL_UpdatedAudioDeviceFormat(device);  // start this off sane.
 
     device->is_opened = SDL_TRUE;  // mark this true even if impl.OpenDevice fails, so we know to clean up.
@@ -1219,16 +1843,25 @@ static int OpenPhysicalAudioDevice(SDL_AudioDevice *device, const SDL_AudioSpec
 
     SDL_UpdatedAudioDeviceFormat(device);  // in case the backend changed things and forgot to call this.
 
-    // Allocate a scratch audio buffer
-    device->work_buffer = (Uint8 *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->buffer_size);
+    // Allocate a scratch audio buffer, and the float32 mix buffer for output devices.
+    device->work_buffer = (Uint8 *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->work_buffer_size);
     if (device->work_buffer == NULL) {
         ClosePhysicalAudioDevice(device);
         return SDL_OutOfMemory();
     }
 
-    // Start the audio thread if necessary
+    if (!device->iscapture) {
+        device->mix_buffer = (float *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->work_buffer_size);
+        device->postmix_buffer = (float *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->work_buffer_size);
+        if ((device->mix_buffer == NULL) || (device->postmix_buffer == NULL)) {
+            ClosePhysicalAudioDevice(device);
+            return SDL_OutOfMemory();
+        }
+    }
+
+    // Start the audio thread if necessary. Manually stepped devices are run by SDL_StepAudioDevice instead, from the app's threads.
     SDL_AtomicSet(&device->thread_alive, 1);
-    if (!current_audio.impl.ProvidesOwnCallbackThread) {
+    if (!current_audio.impl.ProvidesOwnCallbackThread && (device->offline_mode != SDL_AUDIO_OFFLINE_MANUAL)) {
         const size_t stacksize = 0;  // just take the system default, since audio streams might have callbacks.
         char threadname[64];
         SDL_GetAudioThreadName(device, threadname, sizeof (threadname));
@@ -1291,6 +1924,7 @@ SDL_AudioDeviceID SDL_OpenAudioDevice(SDL_AudioDeviceID devid, const SDL_AudioSp
             SDL_free(logdev);
         } else {
             SDL_AtomicSet(&logdev->paused, 0);
+            logdev->gain = 1.0f;
             retval = logdev->instance_id = assign_audio_device_instance_id(device->iscapture, /*islogical=*/SDL_TRUE);
             logdev->physical_device = device;
             logdev->is_default = is_default;
@@ -1340,6 +1974,447 @@ SDL_bool SDL_IsAudioDevicePaused(SDL_AudioDeviceID devid)
     return retval;
 }
 
+int SDL_SetAudioDeviceGain(SDL_AudioDeviceID devid, float gain)
+{
+    if (!(gain >= 0.0f)) {  // this catches NaN, too.
+        return SDL_InvalidParamError("gain");
+    }
+
+    SDL_LogicalAudioDevice *logdev = ObtainLogicalAudioDevice(devid);
+    if (!logdev) {
+        return -1;  // ObtainLogicalAudioDevice will have set an error.
+    }
+    logdev->gain = gain;
+    SDL_UnlockMutex(logdev->physical_device->lock);
+    return 0;
+}
+
+float SDL_GetAudioDeviceGain(SDL_AudioDeviceID devid)
+{
+    SDL_LogicalAudioDevice *logdev = ObtainLogicalAudioDevice(devid);
+    float retval = -1.0f;
+    if (logdev) {
+        retval = logdev->gain;
+        SDL_UnlockMutex(logdev->physical_device->lock);
+    }
+    return retval;
+}
+
+int SDL_GetAudioDeviceStats(SDL_AudioDeviceID devid, SDL_AudioDeviceStats *stats)
+{
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_AudioDevice *device = ObtainPhysicalAudioDevice(devid);
+    if (!device) {
+        return -1;
+    } else if (!device->is_opened) {
+        SDL_UnlockMutex(device->lock);
+        return SDL_SetError("Audio device is not opened");
+    }
+    SDL_memcpy(stats, &device->stats, sizeof (*stats));
+    SDL_UnlockMutex(device->lock);
+    return 0;
+}
+
+int SDL_ResetAudioDeviceStats(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = ObtainPhysicalAudioDevice(devid);
+    if (!device) {
+        return -1;
+    }
+
+    const Uint64 period_ns = device->stats.period_ns;
+    SDL_zero(device->stats);
+    device->stats.period_ns = period_ns;
+    device->last_wakeup_ns = 0;
+
+    for (SDL_AudioPostmixEntry *entry = device->postmix; entry != NULL; entry = entry->next) {
+        SDL_zero(entry->stats);
+    }
+
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev != NULL; logdev = logdev->next) {
+        for (SDL_AudioPostmixEntry *entry = logdev->postmix; entry != NULL; entry = entry->next) {
+            SDL_zero(entry->stats);
+        }
+        for (SDL_AudioStream *stream = logdev->bound_streams; stream != NULL; stream = stream->next_binding) {
+            SDL_LockMutex(stream->lock);
+            SDL_zero(stream->stats);
+            SDL_UnlockMutex(stream->lock);
+        }
+    }
+
+    SDL_UnlockMutex(device->lock);
+    return 0;
+}
+
+/* Finds the post-mix chain of a logical device or an opened physical output device.
+   If found, this locks the physical device before returning, and sets `*device` to it. */
+static SDL_AudioPostmixEntry **ObtainAudioPostmixChain(SDL_AudioDeviceID devid, SDL_AudioDevice **device)
+{
+    SDL_AudioPostmixEntry **chain = NULL;
+
+    // bit #1 of devid is set for physical devices and unset for logical.
+    const SDL_bool islogical = (devid & (1<<1)) ? SDL_FALSE : SDL_TRUE;
+    if (islogical) {
+        SDL_LogicalAudioDevice *logdev = ObtainLogicalAudioDevice(devid);
+        if (!logdev) {
+            return NULL;
+        }
+        *device = logdev->physical_device;
+        chain = &logdev->postmix;
+    } else {
+        *device = ObtainPhysicalAudioDevice(devid);
+        if (!*device) {
+            return NULL;
+        } else if (!(*device)->is_opened) {
+            SDL_UnlockMutex((*device)->lock);
+            SDL_SetError("Audio device is not opened");
+            return NULL;
+        }
+        chain = &(*device)->postmix;
+    }
+
+    if ((*device)->iscapture) {
+        SDL_UnlockMutex((*device)->lock);
+        SDL_SetError("Capture devices don't have post-mix callbacks");
+        return NULL;
+    }
+
+    return chain;
+}
+
+int SDL_AddAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallback callback, void *userdata)
+{
+    if (!callback) {
+        return SDL_InvalidParamError("callback");
+    }
+
+    SDL_AudioDevice *device = NULL;
+    SDL_AudioPostmixEntry **chain = ObtainAudioPostmixChain(devid, &device);
+    if (!chain) {
+        return -1;
+    }
+
+    int retval = 0;
+    SDL_AudioPostmixEntry **tail = chain;
+    while (*tail && !(((*tail)->callback == callback) && ((*tail)->userdata == userdata))) {
+        tail = &(*tail)->next;
+    }
+
+    if (*tail) {
+        retval = SDL_SetError("Post-mix callback was already added to this device");
+    } else {
+        SDL_AudioPostmixEntry *entry = (SDL_AudioPostmixEntry *) SDL_calloc(1, sizeof (*entry));
+        if (!entry) {
+            retval = SDL_OutOfMemory();
+        } else {
+            entry->callback = callback;
+            entry->userdata = userdata;
+            *tail = entry;  // the device thread picks this up on its next buffer.
+        }
+    }
+
+    SDL_UnlockMutex(device->lock);
+    return retval;
+}
+
+int SDL_RemoveAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallback callback, void *userdata)
+{
+    SDL_AudioDevice *device = NULL;
+    SDL_AudioPostmixEntry **chain = ObtainAudioPostmixChain(devid, &device);
+    if (!chain) {
+        return -1;
+    }
+
+    int retval = 0;
+    SDL_AudioPostmixEntry **prev = chain;
+    while (*prev && !(((*prev)->callback == callback) && ((*prev)->userdata == userdata))) {
+        prev = &(*prev)->next;
+    }
+
+    if (*prev) {
+        SDL_AudioPostmixEntry *entry = *prev;
+        *prev = entry->next;
+        SDL_free(entry);
+    } else {
+        retval = SDL_SetError("Post-mix callback was not added to this device");
+    }
+
+    SDL_UnlockMutex(device->lock);
+    return retval;
+}
+
+int SDL_GetAudioPostmixStats(SDL_AudioDeviceID devid, SDL_AudioPostmixCallback callback, void *userdata, SDL_AudioPostmixStats *stats)
+{
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_AudioDevice *device = NULL;
+    SDL_AudioPostmixEntry **chain = ObtainAudioPostmixChain(devid, &device);
+    if (!chain) {
+        return -1;
+    }
+
+    int retval = 0;
+    SDL_AudioPostmixEntry *entry = *chain;
+    while (entry && !((entry->callback == callback) && (entry->userdata == userdata))) {
+        entry = entry->next;
+    }
+
+    if (entry) {
+        SDL_memcpy(stats, &entry->stats, sizeof (*stats));
+    } else {
+        retval = SDL_SetError("Post-mix callback was not added to this device");
+    }
+
+    SDL_UnlockMutex(device->lock);
+    return retval;
+}
+
+int SDL_StepAudioDevice(SDL_AudioDeviceID devid, int periods)
+{
+    if (periods < 0) {
+        return SDL_InvalidParamError("periods");
+    }
+
+    SDL_AudioDevice *device = ObtainPhysicalAudioDevice(devid);
+    if (!device) {
+        return -1;
+    }
+    const SDL_bool manual = device->is_opened && (device->offline_mode == SDL_AUDIO_OFFLINE_MANUAL) && !SDL_AtomicGet(&device->shutdown);
+    if (manual) {
+        SDL_AtomicIncRef(&device->steppers);  // holds off ClosePhysicalAudioDevice until we're done with the device's buffers.
+    }
+    SDL_UnlockMutex(device->lock);
+
+    if (!manual) {
+        return SDL_SetError("Audio device is not opened for manual stepping");
+    }
+
+    // Do exactly what the device thread would do, minus the waiting.
+    int frames = 0;
+    for (int i = 0; i < periods; i++) {
+        const SDL_bool keep_going = device->iscapture ? SDL_CaptureAudioThreadIterate(device) : SDL_OutputAudioThreadIterate(device);
+        if (!keep_going) {
+            const SDL_bool lost = SDL_AtomicGet(&device->condemned) || SDL_AtomicGet(&device->zombie);
+            (void)SDL_AtomicDecRef(&device->steppers);
+            if (!lost) {
+                return SDL_SetError("Audio device was closed");
+            }
+            SDL_AudioThreadFinalize(device);  // the device is going away; clean up like the device thread would have.
+            return SDL_SetError("Audio device was lost");
+        }
+        frames += device->sample_frames;
+    }
+    (void)SDL_AtomicDecRef(&device->steppers);
+    return frames;
+}
+
+int SDL_GetAudioDeviceClock(SDL_AudioDeviceID devid, Uint64 *frames, Uint64 *timestamp_ns)
+{
+    SDL_AudioDevice *device = ObtainPhysicalAudioDevice(devid);
+    if (!device) {
+        return -1;
+    } else if (!device->is_opened) {
+        SDL_UnlockMutex(device->lock);
+        return SDL_SetError("Audio device is not opened");
+    }
+
+    if (frames) {
+        *frames = device->frames_played;
+    }
+    if (timestamp_ns) {
+        *timestamp_ns = device->last_period_ns;
+    }
+    SDL_UnlockMutex(device->lock);
+    return 0;
+}
+
+SDL_AudioCaptureReader *SDL_CreateAudioCaptureReader(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = ObtainPhysicalAudioDevice(devid);
+    if (!device) {
+        return NULL;
+    } else if (!device->iscapture) {
+        SDL_UnlockMutex(device->lock);
+        SDL_SetError("Audio capture readers need a capture device");
+        return NULL;
+    } else if (!device->is_opened) {
+        SDL_UnlockMutex(device->lock);
+        SDL_SetError("Audio device is not opened");
+        return NULL;
+    }
+
+    SDL_AudioCaptureReader *reader = (SDL_AudioCaptureReader *) SDL_calloc(1, sizeof (SDL_AudioCaptureReader));
+    if (!reader) {
+        SDL_UnlockMutex(device->lock);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    SDL_AudioCaptureRing *ring = device->capture_ring;
+    if (!ring) {  // first reader? Set up the ring.
+        ring = (SDL_AudioCaptureRing *) SDL_calloc(1, sizeof (SDL_AudioCaptureRing));
+        if (ring) {
+            for (int i = 0; i < SDL_AUDIO_CAPTURE_RING_BUFFERS; i++) {
+                ring->slots[i].sequence = SDL_MAX_UINT64;  // nothing captured into it yet.
+                ring->slots[i].buffer = (Uint8 *) SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->buffer_size);
+                if (!ring->slots[i].buffer) {
+                    FreeAudioCaptureRing(ring);
+                    ring = NULL;
+                    break;
+                }
+                ring->slots[i].allocation = device->buffer_size;
+            }
+        }
+
+        if (!ring) {
+            SDL_UnlockMutex(device->lock);
+            SDL_free(reader);
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        device->capture_ring = ring;
+    }
+
+    reader->devid = device->instance_id;
+    reader->next_sequence = ring->write_sequence;
+    reader->held_slot = -1;
+    reader->next = ring->readers;
+    if (ring->readers) {
+        ring->readers->prev = reader;
+    }
+    ring->readers = reader;
+
+    SDL_UnlockMutex(device->lock);
+    return reader;
+}
+
+// Locks the device `reader` reads from, or sets an error and returns NULL if it can't be used.
+static SDL_AudioDevice *ObtainAudioCaptureReaderDevice(SDL_AudioCaptureReader *reader)
+{
+    if (!reader) {
+        SDL_InvalidParamError("reader");
+        return NULL;
+    }
+
+    SDL_AudioDevice *device = ObtainPhysicalAudioDevice(reader->devid);
+    if (device && SDL_AtomicGet(&reader->detached)) {
+        SDL_UnlockMutex(device->lock);
+        device = NULL;
+    }
+    if (!device) {
+        SDL_SetError("Audio capture reader's device was closed");
+    }
+    return device;
+}
+
+int SDL_AcquireAudioCaptureBuffer(SDL_AudioCaptureReader *reader, const void **buffer)
+{
+    if (!buffer) {
+        return SDL_InvalidParamError("buffer");
+    }
+
+    SDL_AudioDevice *device = ObtainAudioCaptureReaderDevice(reader);
+    if (!device) {
+        return -1;
+    } else if (reader->held_slot >= 0) {
+        SDL_UnlockMutex(device->lock);
+        return SDL_SetError("Audio capture reader already holds a buffer");
+    }
+
+    SDL_AudioCaptureRing *ring = device->capture_ring;
+    SDL_assert(ring != NULL);  // there's a ring as long as there are attached readers.
+
+    // anything older than the ring's length has been overwritten.
+    const Uint64 oldest = (ring->write_sequence > SDL_AUDIO_CAPTURE_RING_BUFFERS) ? (ring->write_sequence - SDL_AUDIO_CAPTURE_RING_BUFFERS) : 0;
+    if (reader->next_sequence < oldest) {
+        reader->stats.dropped += oldest - reader->next_sequence;
+        reader->next_sequence = oldest;
+    }
+
+    int retval = 0;
+    *buffer = NULL;
+    while (reader->next_sequence < ring->write_sequence) {
+        const int i = (int) (reader->next_sequence % SDL_AUDIO_CAPTURE_RING_BUFFERS);
+        SDL_AudioCaptureSlot *slot = &ring->slots[i];
+        reader->next_sequence++;
+        if (slot->sequence == (reader->next_sequence - 1)) {
+            slot->holds++;
+            reader->held_slot = i;
+            reader->stats.buffers++;
+            *buffer = slot->buffer;
+            retval = slot->buflen;
+            break;
+        }
+        reader->stats.dropped++;  // the device couldn't capture into this slot, because someone held it.
+    }
+
+    SDL_UnlockMutex(device->lock);
+    return retval;
+}
+
+int SDL_ReleaseAudioCaptureBuffer(SDL_AudioCaptureReader *reader)
+{
+    SDL_AudioDevice *device = ObtainAudioCaptureReaderDevice(reader);
+    if (!device) {
+        return -1;
+    } else if (reader->held_slot < 0) {
+        SDL_UnlockMutex(device->lock);
+        return SDL_SetError("Audio capture reader doesn't hold a buffer");
+    }
+
+    device->capture_ring->slots[reader->held_slot].holds--;
+    reader->held_slot = -1;
+    SDL_UnlockMutex(device->lock);
+    return 0;
+}
+
+int SDL_GetAudioCaptureReaderStats(SDL_AudioCaptureReader *reader, SDL_AudioCaptureReaderStats *stats)
+{
+    if (!reader) {
+        return SDL_InvalidParamError("reader");
+    } else if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    SDL_copyp(stats, &reader->stats);  // only the reader functions change these, so no lock needed.
+    return 0;
+}
+
+void SDL_DestroyAudioCaptureReader(SDL_AudioCaptureReader *reader)
+{
+    if (!reader) {
+        return;
+    }
+
+    SDL_AudioDevice *device = SDL_AtomicGet(&reader->detached) ? NULL : ObtainPhysicalAudioDevice(reader->devid);
+    if (device) {
+        if (!SDL_AtomicGet(&reader->detached)) {  // check again, now that we hold the lock.
+            SDL_AudioCaptureRing *ring = device->capture_ring;
+            if (reader->held_slot >= 0) {
+                ring->slots[reader->held_slot].holds--;
+            }
+            if (reader->prev) {
+                reader->prev->next = reader->next;
+            } else {
+                ring->readers = reader->next;
+            }
+            if (reader->next) {
+                reader->next->prev = reader->prev;
+            }
+            if (!ring->readers) {  // last one out frees the ring.
+                FreeAudioCaptureRing(ring);
+                device->capture_ring = NULL;
+            }
+        }
+        SDL_UnlockMutex(device->lock);
+    }
+    SDL_free(reader);
+}
+
 
 int SDL_BindAudioStreams(SDL_AudioDeviceID devid, SDL_AudioStream **streams, int num_streams)
 {
@@ -1398,7 +2473,8 @@ int SDL_BindAudioStreams(SDL_AudioDeviceID devid, SDL_AudioStream **streams, int
             if (iscapture) {
                 SDL_SetAudioStreamFormat(stream, &device->spec, &dst_spec);
             } else {
-                SDL_SetAudioStreamFormat(stream, &src_spec, &device->spec);
+                GetOutputStreamSpec(device, &dst_spec);
+                SDL_SetAudioStreamFormat(stream, &src_spec, &dst_spec);
             }
 
             stream->bound_device = logdev;
@@ -1471,6 +2547,11 @@ void SDL_UnbindAudioStreams(SDL_AudioStream **streams, int num_streams)
                 stream->next_binding->prev_binding = stream->prev_binding;
             }
             stream->prev_binding = stream->next_binding = NULL;
+            stream->start_frame = stream->stop_frame = 0;  // frame numbers only make sense on the device they came from.
+            // go back to the app's input format if nothing a capture group converted is still queued; otherwise that data is still read correctly.
+            if ((SDL_GetDataQueueSize(stream->queue) == 0) && (stream->future_buffer_filled_frames == 0)) {
+                SDL_SetAudioStreamGroupInput(stream, NULL);
+            }
         }
     }
 
@@ -1506,6 +2587,52 @@ SDL_AudioDeviceID SDL_GetAudioStreamBinding(SDL_AudioStream *stream)
     return retval;
 }
 
+int SDL_ScheduleAudioStream(SDL_AudioStream *stream, Uint64 start_frame, Uint64 stop_frame)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (stop_frame && (stop_frame <= start_frame)) {
+        return SDL_InvalidParamError("stop_frame");
+    }
+
+    // the device thread only looks at the schedule with the device locked, so it sees a whole buffer with the same one. Lock in the same order it does, like SDL_UnbindAudioStreams.
+    SDL_LogicalAudioDevice *bounddev;
+    while (SDL_TRUE) {
+        SDL_LockMutex(stream->lock);
+        bounddev = stream->bound_device;
+        SDL_UnlockMutex(stream->lock);
+
+        if (bounddev) {
+            SDL_LockMutex(bounddev->physical_device->lock);
+        }
+        SDL_LockMutex(stream->lock);
+
+        if (bounddev == stream->bound_device) {
+            break;  // the binding didn't change in the small window where it could, so we're good.
+        }
+        SDL_UnlockMutex(stream->lock);  // it changed bindings! Try again.
+        if (bounddev) {
+            SDL_UnlockMutex(bounddev->physical_device->lock);
+        }
+    }
+
+    int retval = 0;
+    if (!bounddev) {
+        retval = SDL_SetError("Audio stream is not bound to a device");
+    } else if (bounddev->physical_device->iscapture) {
+        retval = SDL_SetError("Only streams bound to output devices can be scheduled");
+    } else {
+        stream->start_frame = start_frame;
+        stream->stop_frame = stop_frame;
+    }
+
+    SDL_UnlockMutex(stream->lock);
+    if (bounddev) {
+        SDL_UnlockMutex(bounddev->physical_device->lock);
+    }
+    return retval;
+}
+
 SDL_AudioStream *SDL_CreateAndBindAudioStream(SDL_AudioDeviceID devid, const SDL_AudioSpec *spec)
 {
     const SDL_bool islogical = (devid & (1<<1)) ? SDL_FALSE : SDL_TRUE;
@@ -1633,8 +2760,10 @@ void SDL_DefaultAudioDeviceChanged(SDL_AudioDevice *new_default_device)
                 }
 
                 // make sure all our streams are targeting the new device's format.
+                SDL_AudioSpec outspec;
+                GetOutputStreamSpec(new_default_device, &outspec);
                 for (SDL_AudioStream *stream = logdev->bound_streams; stream != NULL; stream = stream->next_binding) {
-                    SDL_SetAudioStreamFormat(stream, iscapture ? &new_default_device->spec : NULL, iscapture ? NULL : &new_default_device->spec);
+                    SDL_SetAudioStreamFormat(stream, iscapture ? &new_default_device->spec : NULL, iscapture ? NULL : &outspec);
                 }
 
                 // now migrate the logical device.
@@ -1677,14 +2806,16 @@ int SDL_AudioDeviceFormatChangedAlreadyLocked(SDL_AudioDevice *device, const SDL
 {
     SDL_bool kill_device = SDL_FALSE;
 
-    const int orig_buffer_size = device->buffer_size;
+    const int orig_work_buffer_size = device->work_buffer_size;
     const SDL_bool iscapture = device->iscapture;
 
     if ((device->spec.format != newspec->format) || (device->spec.channels != newspec->channels) || (device->spec.freq != newspec->freq)) {
+        SDL_AudioSpec outspec;
         SDL_memcpy(&device->spec, newspec, sizeof (*newspec));
+        GetOutputStreamSpec(device, &outspec);
         for (SDL_LogicalAudioDevice *logdev = device->logical_devices; !kill_device && (logdev != NULL); logdev = logdev->next) {
             for (SDL_AudioStream *stream = logdev->bound_streams; !kill_device && (stream != NULL); stream = stream->next_binding) {
-                if (SDL_SetAudioStreamFormat(stream, iscapture ? &device->spec : NULL, iscapture ? NULL : &device->spec) == -1) {
+                if (SDL_SetAudioStreamFormat(stream, iscapture ? &device->spec : NULL, iscapture ? NULL : &outspec) == -1) {
                     kill_device = SDL_TRUE;
                 }
             }
@@ -1694,13 +2825,27 @@ int SDL_AudioDeviceFormatChangedAlreadyLocked(SDL_AudioDevice *device, const SDL
     if (!kill_device) {
         device->sample_frames = new_sample_frames;
         SDL_UpdatedAudioDeviceFormat(device);
-        if (device->work_buffer && (device->buffer_size > orig_buffer_size)) {
+        if (device->work_buffer && (device->work_buffer_size > orig_work_buffer_size)) {
             SDL_aligned_free(device->work_buffer);
-            device->work_buffer = (Uint8 *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->buffer_size);
+            device->work_buffer = (Uint8 *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->work_buffer_size);
             if (!device->work_buffer) {
                 kill_device = SDL_TRUE;
             }
         }
+        if (device->mix_buffer && (device->work_buffer_size > orig_work_buffer_size)) {
+            SDL_aligned_free(device->mix_buffer);
+            device->mix_buffer = (float *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->work_buffer_size);
+            if (!device->mix_buffer) {
+                kill_device = SDL_TRUE;
+            }
+        }
+        if (device->postmix_buffer && (device->work_buffer_size > orig_work_buffer_size)) {
+            SDL_aligned_free(device->postmix_buffer);
+            device->postmix_buffer = (float *)SDL_aligned_alloc(SDL_SIMDGetAlignment(), device->work_buffer_size);
+            if (!device->postmix_buffer) {
+                kill_device = SDL_TRUE;
+            }
+        }
     }
 
     return kill_device ? -1 : 0;
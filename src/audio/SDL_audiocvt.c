@@ -64,6 +64,19 @@ static int GetHistoryBufferSampleFrames(const Sint32 required_resampler_frames)
     return (int) SDL_max(required_resampler_frames, 5000);
 }
 
+// Adds taps `first` to `last` (exclusive) of one wing of the filter to `outsample`. `src` is the input sample for tap `first`, and each tap after it is `step` floats away.
+static float ResampleWing(float outsample, const float *src, const int step, const int filterindex, const float interpolation, const int first, const int last)
+{
+    int j;
+
+    for (j = first; j < last; j++) {
+        const int filt_ind = filterindex + j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
+        outsample += (float) (*src * (ResamplerFilter[filt_ind] + (interpolation * ResamplerFilterDifference[filt_ind])));
+        src += step;
+    }
+    return outsample;
+}
+
 // lpadding and rpadding are expected to be buffers of (GetResamplePadding(inrate, outrate) * chans * sizeof (float)) bytes.
 static void ResampleAudio(const int chans, const int inrate, const int outrate,
                          const float *lpadding, const float *rpadding,
@@ -78,7 +91,7 @@ static void ResampleAudio(const int chans, const int inrate, const int outrate,
      * for these integer divisions. */
     const int paddinglen = GetResamplerPaddingFrames(inrate, outrate);
     float *dst = outbuf;
-    int i, j, chan;
+    int i, chan;
 
     for (i = 0; i < outframes; i++) {
         const int srcindex = (int)((Sint64)i * inrate / outrate);
@@ -93,26 +106,37 @@ static void ResampleAudio(const int chans, const int inrate, const int outrate,
         const int filterindex1 = ((Sint32)srcfraction) * RESAMPLER_SAMPLES_PER_ZERO_CROSSING / outrate;
         const float interpolation2 = 1.0f - interpolation1;
         const int filterindex2 = ((Sint32)(outrate - srcfraction)) * RESAMPLER_SAMPLES_PER_ZERO_CROSSING / outrate;
+        const int lefttaps = (RESAMPLER_FILTER_SIZE - filterindex1 + RESAMPLER_SAMPLES_PER_ZERO_CROSSING - 1) / RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
+        const int righttaps = (RESAMPLER_FILTER_SIZE - filterindex2 + RESAMPLER_SAMPLES_PER_ZERO_CROSSING - 1) / RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
+
+        /* Work out where each wing crosses from one buffer to the next, so the tap loops don't have to check.
+           The left wing walks back from srcindex: the last output frames can land past the end of the input when
+           the rates don't divide evenly, those taps come from the right padding, then the input, then the left padding.
+           The right wing walks forward from srcindex + 1: the input, then the right padding. */
+        const int left_past_end = SDL_clamp(srcindex - inframes + 1, 0, lefttaps);
+        const int left_in_input = SDL_clamp(srcindex + 1, left_past_end, lefttaps);
+        const int right_in_input = SDL_clamp(inframes - srcindex - 1, 0, righttaps);
 
         for (chan = 0; chan < chans; chan++) {
             float outsample = 0.0f;
 
             // do this twice to calculate the sample, once for the "left wing" and then same for the right.
-            for (j = 0; (filterindex1 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) < RESAMPLER_FILTER_SIZE; j++) {
-                const int filt_ind = filterindex1 + j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
-                const int srcframe = srcindex - j;
-                /* !!! FIXME: we can bubble this conditional out of here by doing a pre loop. */
-                const float insample = (srcframe < 0) ? lpadding[((paddinglen + srcframe) * chans) + chan] : inbuf[(srcframe * chans) + chan];
-                outsample += (float) (insample * (ResamplerFilter[filt_ind] + (interpolation1 * ResamplerFilterDifference[filt_ind])));
+            if (left_past_end > 0) {
+                outsample = ResampleWing(outsample, &rpadding[((srcindex - inframes) * chans) + chan], -chans, filterindex1, interpolation1, 0, left_past_end);
+            }
+            if (left_in_input > left_past_end) {
+                outsample = ResampleWing(outsample, &inbuf[((srcindex - left_past_end) * chans) + chan], -chans, filterindex1, interpolation1, left_past_end, left_in_input);
+            }
+            if (lefttaps > left_in_input) {
+                outsample = ResampleWing(outsample, &lpadding[((paddinglen + srcindex - left_in_input) * chans) + chan], -chans, filterindex1, interpolation1, left_in_input, lefttaps);
             }
 
             // Do the right wing!
-            for (j = 0; (filterindex2 + (j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING)) < RESAMPLER_FILTER_SIZE; j++) {
-                const int filt_ind = filterindex2 + j * RESAMPLER_SAMPLES_PER_ZERO_CROSSING;
-                const int srcframe = srcindex + 1 + j;
-                // !!! FIXME: we can bubble this conditional out of here by doing a post loop.
-                const float insample = (srcframe >= inframes) ? rpadding[((srcframe - inframes) * chans) + chan] : inbuf[(srcframe * chans) + chan];
-                outsample += (float) (insample * (ResamplerFilter[filt_ind] + (interpolation2 * ResamplerFilterDifference[filt_ind])));
+            if (right_in_input > 0) {
+                outsample = ResampleWing(outsample, &inbuf[((srcindex + 1) * chans) + chan], chans, filterindex2, interpolation2, 0, right_in_input);
+            }
+            if (righttaps > right_in_input) {
+                outsample = ResampleWing(outsample, &rpadding[((srcindex + 1 + right_in_input - inframes) * chans) + chan], chans, filterindex2, interpolation2, right_in_input, righttaps);
             }
 
             *(dst++) = outsample;
@@ -314,8 +338,8 @@ static SDL_bool SDL_IsSupportedChannelCount(const int channels)
 /* all of this has to function as if src==dst (conversion in-place), but as a convenience
    if you're just going to copy the final output elsewhere, you can specify a different
    output pointer. */
-static void ConvertAudio(int num_frames, const void *src, SDL_AudioFormat src_format, int src_channels,
-                         void *dst, SDL_AudioFormat dst_format, int dst_channels)
+void SDL_ConvertAudio(int num_frames, const void *src, SDL_AudioFormat src_format, int src_channels,
+                      void *dst, SDL_AudioFormat dst_format, int dst_channels)
 {
     SDL_assert(src != NULL);
     SDL_assert(dst != NULL);
@@ -432,13 +456,13 @@ static void ConvertAudio(int num_frames, const void *src, SDL_AudioFormat src_fo
     SDL_assert(src == dst);  // if we got here, we _had_ to have done _something_. Otherwise, we should have memcpy'd!
 }
 
-// figure out the largest thing we might need for ConvertAudio, which might grow data in-place.
+// figure out the largest thing we might need for SDL_ConvertAudio, which might grow data in-place.
 static int CalculateMaxSampleFrameSize(SDL_AudioFormat src_format, int src_channels, SDL_AudioFormat dst_format, int dst_channels)
 {
     const int src_format_size = SDL_AUDIO_BITSIZE(src_format) / 8;
     const int dst_format_size = SDL_AUDIO_BITSIZE(dst_format) / 8;
     const int max_app_format_size = SDL_max(src_format_size, dst_format_size);
-    const int max_format_size = SDL_max(max_app_format_size, sizeof (float));  // ConvertAudio converts to float internally.
+    const int max_format_size = SDL_max(max_app_format_size, sizeof (float));  // SDL_ConvertAudio converts to float internally.
     const int max_channels = SDL_max(src_channels, dst_channels);
     return max_format_size * max_channels;
 }
@@ -519,18 +543,18 @@ static int SetAudioStreamFormat(SDL_AudioStream *stream, const SDL_AudioSpec *sr
 
     // okay, we've done all the things that can fail, now we can change stream state.
 
-    // copy to new buffers and/or convert data; ConvertAudio will do a simple memcpy if format matches, and nothing at all if the buffer hasn't changed
+    // copy to new buffers and/or convert data; SDL_ConvertAudio will do a simple memcpy if format matches, and nothing at all if the buffer hasn't changed
     if (stream->future_buffer) {
-        ConvertAudio(stream->future_buffer_filled_frames, stream->future_buffer, stream->src_spec.format, stream->src_spec.channels, future_buffer, src_format, src_channels);
+        SDL_ConvertAudio(stream->future_buffer_filled_frames, stream->future_buffer, stream->src_spec.format, stream->src_spec.channels, future_buffer, src_format, src_channels);
     } else if (future_buffer != NULL) {
         SDL_memset(future_buffer, SDL_GetSilenceValueForFormat(src_format), future_buffer_allocation);
     }
 
     if (stream->history_buffer) {
         if (history_buffer_frames <= prev_history_buffer_frames) {
-            ConvertAudio(history_buffer_frames, stream->history_buffer, stream->src_spec.format, stream->src_spec.channels, history_buffer, src_format, src_channels);
+            SDL_ConvertAudio(history_buffer_frames, stream->history_buffer, stream->src_spec.format, stream->src_spec.channels, history_buffer, src_format, src_channels);
         } else {
-            ConvertAudio(prev_history_buffer_frames, stream->history_buffer, stream->src_spec.format, stream->src_spec.channels, history_buffer + ((history_buffer_frames - prev_history_buffer_frames) * src_sample_frame_size), src_format, src_channels);
+            SDL_ConvertAudio(prev_history_buffer_frames, stream->history_buffer, stream->src_spec.format, stream->src_spec.channels, history_buffer + ((history_buffer_frames - prev_history_buffer_frames) * src_sample_frame_size), src_format, src_channels);
             SDL_memset(history_buffer, SDL_GetSilenceValueForFormat(src_format), (history_buffer_frames - prev_history_buffer_frames) * src_sample_frame_size);  // silence oldest history samples.
         }
     } else if (history_buffer != NULL) {
@@ -624,6 +648,7 @@ SDL_AudioStream *SDL_CreateAudioStream(const SDL_AudioSpec *src_spec, const SDL_
 
     retval->src_sample_frame_size = (SDL_AUDIO_BITSIZE(src_spec->format) / 8) * src_spec->channels;
     retval->packetlen = packetlen;
+    retval->gain = 1.0f;
     SDL_memcpy(&retval->src_spec, src_spec, sizeof (SDL_AudioSpec));
 
     if (SetAudioStreamFormat(retval, src_spec, dst_spec) == -1) {
@@ -675,7 +700,7 @@ int SDL_GetAudioStreamFormat(SDL_AudioStream *stream, SDL_AudioSpec *src_spec, S
     }
     SDL_LockMutex(stream->lock);
     if (src_spec) {
-        SDL_memcpy(src_spec, &stream->src_spec, sizeof (SDL_AudioSpec));
+        SDL_memcpy(src_spec, stream->group_input ? &stream->app_src_spec : &stream->src_spec, sizeof (SDL_AudioSpec));
     }
     if (dst_spec) {
         SDL_memcpy(dst_spec, &stream->dst_spec, sizeof (SDL_AudioSpec));
@@ -715,12 +740,75 @@ int SDL_SetAudioStreamFormat(SDL_AudioStream *stream, const SDL_AudioSpec *src_s
     }
 
     SDL_LockMutex(stream->lock);
+    if (src_spec) {
+        stream->group_input = SDL_FALSE;  // the app's input format takes over from whatever a capture group was feeding in.
+    }
     const int retval = SetAudioStreamFormat(stream, src_spec ? src_spec : &stream->src_spec, dst_spec ? dst_spec : &stream->dst_spec);
     SDL_UnlockMutex(stream->lock);
 
     return retval;
 }
 
+// You must hold stream->lock! Capture groups convert the device's audio once for all their streams, so the streams take it in their output format.
+int SDL_SetAudioStreamGroupInput(SDL_AudioStream *stream, const SDL_AudioSpec *spec)
+{
+    if (spec) {
+        const SDL_AudioSpec app_src_spec = stream->group_input ? stream->app_src_spec : stream->src_spec;
+        if (SetAudioStreamFormat(stream, spec, &stream->dst_spec) < 0) {
+            return -1;
+        }
+        stream->app_src_spec = app_src_spec;
+        stream->group_input = SDL_TRUE;
+    } else if (stream->group_input) {
+        if (SetAudioStreamFormat(stream, &stream->app_src_spec, &stream->dst_spec) < 0) {
+            return -1;
+        }
+        stream->group_input = SDL_FALSE;
+    }
+    return 0;
+}
+
+int SDL_SetAudioStreamGain(SDL_AudioStream *stream, float gain)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!(gain >= 0.0f)) {  // this catches NaN, too.
+        return SDL_InvalidParamError("gain");
+    }
+
+    SDL_LockMutex(stream->lock);
+    stream->gain = gain;
+    SDL_UnlockMutex(stream->lock);
+    return 0;
+}
+
+float SDL_GetAudioStreamGain(SDL_AudioStream *stream)
+{
+    if (!stream) {
+        SDL_InvalidParamError("stream");
+        return -1.0f;
+    }
+
+    SDL_LockMutex(stream->lock);
+    const float gain = stream->gain;
+    SDL_UnlockMutex(stream->lock);
+    return gain;
+}
+
+int SDL_GetAudioStreamStats(SDL_AudioStream *stream, SDL_AudioStreamStats *stats)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockMutex(stream->lock);
+    SDL_memcpy(stats, &stream->stats, sizeof (*stats));
+    SDL_UnlockMutex(stream->lock);
+    return 0;
+}
+
 int SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
 {
 #if DEBUG_AUDIOSTREAM
@@ -820,6 +908,24 @@ static int CalculateAudioStreamWorkBufSize(const SDL_AudioStream *stream, int le
     return workbuflen;
 }
 
+// You must hold stream->lock! Slides `frames` sample frames of source-format input into the history buffer, shuffling out the oldest.
+static void UpdateAudioStreamHistory(SDL_AudioStream *stream, const Uint8 *data, int frames)
+{
+    const int src_sample_frame_size = stream->src_sample_frame_size;
+    const int history_buffer_frames = stream->history_buffer_frames;
+    const int history_buffer_bytes = history_buffer_frames * src_sample_frame_size;
+    const int request_bytes = frames * src_sample_frame_size;
+    Uint8 *history_buffer = stream->history_buffer;
+
+    if (history_buffer_frames > frames) {
+        const int preserve_bytes = history_buffer_bytes - request_bytes;
+        SDL_memmove(history_buffer, history_buffer + request_bytes, preserve_bytes);
+        SDL_memcpy(history_buffer + preserve_bytes, data, request_bytes);
+    } else {  // are we just replacing the whole thing instead?
+        SDL_memcpy(history_buffer, (data + request_bytes) - history_buffer_bytes, history_buffer_bytes);
+    }
+}
+
 // You must hold stream->lock and validate your parameters before calling this!
 static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int len)
 {
@@ -951,38 +1057,28 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int le
         const int resampler_padding_bytes = resampler_padding_frames * src_sample_frame_size;
         SDL_assert(src_rate != dst_rate);
         SDL_assert(history_buffer_bytes >= resampler_padding_bytes);
-        ConvertAudio(resampler_padding_frames, history_buffer + (history_buffer_bytes - resampler_padding_bytes), src_format, src_channels, stream->left_padding, SDL_AUDIO_F32, pre_resample_channels);
-        ConvertAudio(resampler_padding_frames, future_buffer, src_format, src_channels, stream->right_padding, SDL_AUDIO_F32, pre_resample_channels);
+        SDL_ConvertAudio(resampler_padding_frames, history_buffer + (history_buffer_bytes - resampler_padding_bytes), src_format, src_channels, stream->left_padding, SDL_AUDIO_F32, pre_resample_channels);
+        SDL_ConvertAudio(resampler_padding_frames, future_buffer, src_format, src_channels, stream->right_padding, SDL_AUDIO_F32, pre_resample_channels);
     }
 
     // slide in new data to the history buffer, shuffling out the oldest, for the next run, since we've already updated left_padding with current data.
-    {
-        const int history_buffer_bytes = history_buffer_frames * src_sample_frame_size;
-        const int request_bytes = input_frames * src_sample_frame_size;
-        if (history_buffer_frames > input_frames) {
-            const int preserve_bytes = history_buffer_bytes - request_bytes;
-            SDL_memmove(history_buffer, history_buffer + request_bytes, preserve_bytes);
-            SDL_memcpy(history_buffer + preserve_bytes, workbuf, request_bytes);
-        } else {  // are we just replacing the whole thing instead?
-            SDL_memcpy(history_buffer, (workbuf + request_bytes) - history_buffer_bytes, history_buffer_bytes);
-        }
-    }
+    UpdateAudioStreamHistory(stream, workbuf, input_frames);
 
     // Not resampling? It's an easy conversion (and maybe not even that!)
     if (src_rate == dst_rate) {
         SDL_assert(resampler_padding_frames == 0);
         // see if we can do the conversion in-place (will fit in `buf` while in-progress), or if we need to do it in the workbuf and copy it over
         if (max_sample_frame_size <= dst_sample_frame_size) {
-            ConvertAudio(input_frames, workbuf, src_format, src_channels, buf, dst_format, dst_channels);
+            SDL_ConvertAudio(input_frames, workbuf, src_format, src_channels, buf, dst_format, dst_channels);
         } else {
-            ConvertAudio(input_frames, workbuf, src_format, src_channels, workbuf, dst_format, dst_channels);
+            SDL_ConvertAudio(input_frames, workbuf, src_format, src_channels, workbuf, dst_format, dst_channels);
             SDL_memcpy(buf, workbuf, input_frames * dst_sample_frame_size);
         }
         return input_frames * dst_sample_frame_size;
     }
 
     // Resampling! get the work buffer to float32 format, etc, in-place.
-    ConvertAudio(input_frames, workbuf, src_format, src_channels, workbuf, SDL_AUDIO_F32, pre_resample_channels);
+    SDL_ConvertAudio(input_frames, workbuf, src_format, src_channels, workbuf, SDL_AUDIO_F32, pre_resample_channels);
 
     if ((dst_format == SDL_AUDIO_F32) && (dst_channels == pre_resample_channels)) {
         resample_outbuf = (float *) buf;
@@ -999,9 +1095,9 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int le
     // Get us to the final format!
     // see if we can do the conversion in-place (will fit in `buf` while in-progress), or if we need to do it in the workbuf and copy it over
     if (max_sample_frame_size <= dst_sample_frame_size) {
-        ConvertAudio(output_frames, resample_outbuf, SDL_AUDIO_F32, pre_resample_channels, buf, dst_format, dst_channels);
+        SDL_ConvertAudio(output_frames, resample_outbuf, SDL_AUDIO_F32, pre_resample_channels, buf, dst_format, dst_channels);
     } else {
-        ConvertAudio(output_frames, resample_outbuf, SDL_AUDIO_F32, pre_resample_channels, workbuf, dst_format, dst_channels);
+        SDL_ConvertAudio(output_frames, resample_outbuf, SDL_AUDIO_F32, pre_resample_channels, workbuf, dst_format, dst_channels);
         SDL_memcpy(buf, workbuf, output_frames * dst_sample_frame_size);
     }
 
@@ -1084,6 +1180,66 @@ int SDL_GetAudioStreamData(SDL_AudioStream *stream, void *voidbuf, int len)
     return retval;
 }
 
+// You must hold stream->lock! How many more source sample frames `stream` needs before it can produce `len` bytes without being flushed.
+int SDL_GetAudioStreamInputFramesNeeded(SDL_AudioStream *stream, int len)
+{
+    int frames = len / stream->dst_sample_frame_size;
+    if (stream->src_spec.freq != stream->dst_spec.freq) {
+        /* round up, as SDL_GetAudioStreamAvailable rounds down and would otherwise come up a frame short, and add
+           the padding kept back for the resampler. Use a Uint64 so the multiplication doesn't overflow. */
+        const Uint64 src_rate = (Uint64) stream->src_spec.freq;
+        const Uint64 dst_rate = (Uint64) stream->dst_spec.freq;
+        frames = (int) (((((Uint64) frames) * src_rate) + dst_rate - 1) / dst_rate);
+        frames += stream->resampler_padding_frames;
+    }
+
+    const int have = (int) (SDL_GetDataQueueSize(stream->queue) / stream->src_sample_frame_size) + stream->future_buffer_filled_frames;
+    return (frames > have) ? (frames - have) : 0;
+}
+
+/* You must hold stream->lock! This reads up to `frames` sample frames of the stream's input as float32 at the source
+   channel count, skipping channel conversion and resampling, so several streams with the same source format can be
+   summed and converted once. `buf` needs room for `frames * src_spec.channels` floats. Returns sample frames read. */
+int SDL_GetAudioStreamSourceData(SDL_AudioStream *stream, float *buf, int frames)
+{
+    const int src_sample_frame_size = stream->src_sample_frame_size;
+    int request = frames * src_sample_frame_size;
+    Uint8 *ptr = (Uint8 *) buf;
+    int total = 0;
+
+    if (stream->get_callback) {
+        const int already_have = (int) SDL_GetDataQueueSize(stream->queue) + (stream->future_buffer_filled_frames * src_sample_frame_size);
+        stream->get_callback(stream, request - SDL_min(request, already_have), stream->get_callback_userdata);
+    }
+
+    // anything in the future buffer left the queue first, so it goes first.
+    if (stream->future_buffer_filled_frames > 0) {
+        const int cpyframes = SDL_min(frames, stream->future_buffer_filled_frames);
+        const int cpy = cpyframes * src_sample_frame_size;
+        SDL_memcpy(ptr, stream->future_buffer, cpy);
+        stream->future_buffer_filled_frames -= cpyframes;
+        if (stream->future_buffer_filled_frames > 0) {
+            SDL_memmove(stream->future_buffer, stream->future_buffer + cpy, stream->future_buffer_filled_frames * src_sample_frame_size);
+        }
+        total += cpy;
+        request -= cpy;
+    }
+
+    if (request > 0) {
+        total += (int) SDL_ReadFromDataQueue(stream->queue, ptr + total, request);
+    }
+
+    // keep the history current, so the stream's own resampler picks up where the group left off if it converts on its own again.
+    frames = total / src_sample_frame_size;
+    if (stream->history_buffer) {
+        UpdateAudioStreamHistory(stream, ptr, frames);
+    }
+
+    // float32 is at least as wide as any sample format, so this can convert in place.
+    SDL_ConvertAudio(frames, buf, stream->src_spec.format, stream->src_spec.channels, buf, SDL_AUDIO_F32, stream->src_spec.channels);
+    return frames;
+}
+
 // number of converted/resampled bytes available
 int SDL_GetAudioStreamAvailable(SDL_AudioStream *stream)
 {
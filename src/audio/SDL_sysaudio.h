@@ -73,6 +73,19 @@ const SDL_AudioFormat *SDL_ClosestAudioFormats(SDL_AudioFormat format);
 // Must be called at least once before using converters (SDL_CreateAudioStream will call it !!! FIXME but probably shouldn't).
 extern void SDL_ChooseAudioConverters(void);
 
+// Converts sample format and channel count, but doesn't resample. Works in-place if src == dst. Doesn't check parameters!
+extern void SDL_ConvertAudio(int num_frames, const void *src, SDL_AudioFormat src_format, int src_channels,
+                             void *dst, SDL_AudioFormat dst_format, int dst_channels);
+
+// Source sample frames a stream still needs queued before it can produce `len` bytes. You must hold the stream's lock!
+extern int SDL_GetAudioStreamInputFramesNeeded(SDL_AudioStream *stream, int len);
+
+// Reads up to `frames` sample frames of a stream's input as float32 at its source channel count, without resampling. You must hold the stream's lock!
+extern int SDL_GetAudioStreamSourceData(SDL_AudioStream *stream, float *buf, int frames);
+
+// Makes a stream take input already converted to `spec` (or its own input format again, if NULL), without changing the format the app sees. You must hold the stream's lock!
+extern int SDL_SetAudioStreamGroupInput(SDL_AudioStream *stream, const SDL_AudioSpec *spec);
+
 /* Backends should call this as devices are added to the system (such as
    a USB headset being plugged in), and should also be called for
    for every device found during DetectDevices(). */
@@ -113,6 +126,31 @@ extern SDL_bool SDL_CaptureAudioThreadIterate(SDL_AudioDevice *device);
 extern void SDL_CaptureAudioThreadShutdown(SDL_AudioDevice *device);
 extern void SDL_AudioThreadFinalize(SDL_AudioDevice *device);
 
+// How a device whose driver doesn't need real time (like disk and dummy) paces itself. See SDL_HINT_AUDIO_OFFLINE_MODE.
+typedef enum SDL_AudioOfflineMode
+{
+    SDL_AUDIO_OFFLINE_NONE,    // play in real time, like real hardware.
+    SDL_AUDIO_OFFLINE_FAST,    // the device thread processes buffers as fast as it can.
+    SDL_AUDIO_OFFLINE_MANUAL   // there is no device thread; the app runs buffers with SDL_StepAudioDevice().
+} SDL_AudioOfflineMode;
+
+// Pacing for drivers that stand in for hardware (like disk and dummy). Keep one in the driver's private data.
+typedef struct SDL_SimulatedAudioTiming
+{
+    Uint64 period_ns;       // how long one device buffer lasts.
+    Uint64 next_wakeup_ns;  // when WaitDevice should return next.
+    Uint64 load_ns;         // time to spend on each buffer, for SDL_HINT_AUDIO_SIMULATED_LOAD.
+} SDL_SimulatedAudioTiming;
+
+// Sets up `timing` for one device buffer every `period_ms` milliseconds. Call from OpenDevice.
+extern void SDL_InitSimulatedAudioTiming(SDL_SimulatedAudioTiming *timing, Uint32 period_ms);
+
+// A WaitDevice/WaitCaptureDevice for simulated devices: wakes up once per period, or right away in SDL_AUDIO_OFFLINE_FAST mode.
+extern void SDL_WaitSimulatedAudioDevice(SDL_AudioDevice *device, SDL_SimulatedAudioTiming *timing);
+
+// Call from PlayDevice/CaptureFromDevice, pretends the buffer took as long as SDL_HINT_AUDIO_SIMULATED_LOAD asks for.
+extern void SDL_SimulateAudioDeviceLoad(const SDL_SimulatedAudioTiming *timing);
+
 typedef struct SDL_AudioDriverImpl
 {
     void (*DetectDevices)(SDL_AudioDevice **default_output, SDL_AudioDevice **default_capture);
@@ -135,6 +173,7 @@ typedef struct SDL_AudioDriverImpl
     SDL_bool OnlyHasDefaultOutputDevice;
     SDL_bool OnlyHasDefaultCaptureDevice;
     SDL_bool AllowsArbitraryDeviceNames;
+    SDL_bool SupportsOfflineRendering;  // devices don't depend on real time, so SDL_HINT_AUDIO_OFFLINE_MODE can apply.
 } SDL_AudioDriverImpl;
 
 typedef struct SDL_AudioDriver
@@ -180,9 +219,12 @@ struct SDL_AudioStream
     int history_buffer_frames;
     int future_buffer_filled_frames;
 
-    SDL_AudioSpec src_spec;
+    SDL_AudioSpec src_spec;  // the format of the queued input. While `group_input` is set, this isn't what the app sees.
     SDL_AudioSpec dst_spec;
 
+    SDL_bool group_input;  // SDL_TRUE while a capture group queues audio it already converted, see SDL_SetAudioStreamGroupInput.
+    SDL_AudioSpec app_src_spec;  // the input format the app sees while `group_input` is set.
+
     int src_sample_frame_size;
     int dst_sample_frame_size;
     int max_sample_frame_size;
@@ -190,11 +232,70 @@ struct SDL_AudioStream
     int pre_resample_channels;
     int packetlen;
 
+    float gain;  // multiplier applied while mixing this stream into an output device.
+
+    SDL_AudioStreamStats stats;  // updated by the device thread while bound, protected by `lock`.
+
+    Uint64 start_frame;  // device frame this stream starts playing at, 0 if not scheduled. Changed with the device lock held, too.
+    Uint64 stop_frame;  // device frame this stream stops playing at, 0 if not scheduled. Changed with the device lock held, too.
+
     SDL_LogicalAudioDevice *bound_device;
     SDL_AudioStream *next_binding;
     SDL_AudioStream *prev_binding;
 };
 
+// One callback in a device's chain of post-mix callbacks.
+typedef struct SDL_AudioPostmixEntry
+{
+    SDL_AudioPostmixCallback callback;
+    void *userdata;
+    SDL_AudioPostmixStats stats;
+    struct SDL_AudioPostmixEntry *next;
+} SDL_AudioPostmixEntry;
+
+/* Streams bound to one logical device with the same source format. For output, their input is summed at the source rate and then
+   converted/resampled once. For capture, the captured audio is converted once to the format they all want, and each gets a copy. */
+typedef struct SDL_AudioStreamGroup
+{
+    SDL_AudioSpec src_spec;
+    SDL_AudioStream *stream;  // output: converts the summed input to the device's mixing format. capture: converts the device format to src_spec.
+    float *mix_buffer;  // output: float32 sum of the members' input, at the source rate and channel count. Unused for capture.
+    float *work_buffer;  // output: one member's input, converted to float32. capture: the converted audio, in src_spec's format.
+    int buffer_frames;  // sample frames of src_spec that fit in mix_buffer and work_buffer, counting them as float32.
+    int members;  // bound streams that match src_spec, recounted each buffer.
+    SDL_bool active;  // SDL_TRUE if the group was mixed last buffer, so `stream` has input buffered.
+    struct SDL_AudioStreamGroup *next;
+} SDL_AudioStreamGroup;
+
+// One device buffer in a capture device's ring for SDL_AudioCaptureReader.
+typedef struct SDL_AudioCaptureSlot
+{
+    Uint8 *buffer;
+    int allocation;  // bytes allocated for `buffer`; grown before capturing into it if the device buffer got bigger.
+    int buflen;  // bytes captured into `buffer`.
+    Uint64 sequence;  // which captured buffer this holds, counting from zero. Doesn't match if the slot was skipped.
+    int holds;  // readers that currently have this buffer acquired; the device thread won't capture into it until this is zero.
+} SDL_AudioCaptureSlot;
+
+// The ring of raw buffers a capture device shares with its readers, protected by the device lock.
+typedef struct SDL_AudioCaptureRing
+{
+    SDL_AudioCaptureSlot slots[SDL_AUDIO_CAPTURE_RING_BUFFERS];
+    Uint64 write_sequence;  // how many buffers the device thread has captured since the ring was created.
+    SDL_AudioCaptureReader *readers;  // double-linked list of readers of this ring.
+} SDL_AudioCaptureRing;
+
+struct SDL_AudioCaptureReader
+{
+    SDL_AudioDeviceID devid;  // the physical device this reads from.
+    SDL_AtomicInt detached;  // nonzero once the device was closed; set with the device lock held.
+    Uint64 next_sequence;  // the next captured buffer this reader wants.
+    int held_slot;  // index of the slot this reader has acquired, or -1.
+    SDL_AudioCaptureReaderStats stats;  // only touched by the reader functions, which the app calls one thread at a time.
+    SDL_AudioCaptureReader *prev;
+    SDL_AudioCaptureReader *next;
+};
+
 /* Logical devices are an abstraction in SDL3; you can open the same physical
    device multiple times, and each will result in an object with its own set
    of bound audio streams, etc, even though internally these are all processed
@@ -210,9 +311,18 @@ struct SDL_LogicalAudioDevice
     // If whole logical device is paused (process no streams bound to this device).
     SDL_AtomicInt paused;
 
+    // multiplier applied to every stream bound to this device while mixing.
+    float gain;
+
     // double-linked list of all audio streams currently bound to this opened device.
     SDL_AudioStream *bound_streams;
 
+    // callbacks that process this device's own mix before it's added to the physical device's mix, in order.
+    SDL_AudioPostmixEntry *postmix;
+
+    // groups of bound streams that share a source format, if the physical device groups streams.
+    SDL_AudioStreamGroup *stream_groups;
+
     // SDL_TRUE if this was opened as a default device.
     SDL_bool is_default;
 
@@ -260,12 +370,48 @@ struct SDL_AudioDevice
     // non-zero if this has a thread running (which might be `thread` or something provided by the backend!)
     SDL_AtomicInt thread_alive;
 
+    // number of SDL_StepAudioDevice calls running buffers on a manually stepped device; closing waits for these like it would for a thread.
+    SDL_AtomicInt steppers;
+
     // SDL_TRUE if this is a capture device instead of an output device
     SDL_bool iscapture;
 
+    // How the device is paced, set before the driver's OpenDevice is called. Always SDL_AUDIO_OFFLINE_NONE for real hardware.
+    SDL_AudioOfflineMode offline_mode;
+
+    // SDL_TRUE if bound streams with the same source format are converted together. See SDL_HINT_AUDIO_GROUP_STREAMS.
+    SDL_bool group_streams;
+
     // Scratch buffer used for mixing.
     Uint8 *work_buffer;
 
+    // Size of work_buffer, big enough for a buffer of float32 samples as well as buffer_size.
+    int work_buffer_size;
+
+    // Float32 buffer the output streams are mixed into before converting to the device format.
+    float *mix_buffer;
+
+    // Float32 buffer for the mix of a logical device with post-mix callbacks, before it's added to mix_buffer.
+    float *postmix_buffer;
+
+    // callbacks that process the final mix before it's converted to the device format, in order.
+    SDL_AudioPostmixEntry *postmix;
+
+    // Timing statistics, updated by the device thread while holding `lock`.
+    SDL_AudioDeviceStats stats;
+
+    // When the device thread last woke up for a buffer, for spotting late wakeups. Zero when not yet known.
+    Uint64 last_wakeup_ns;
+
+    // Raw capture buffers shared with SDL_AudioCaptureReaders, NULL if there are none.
+    SDL_AudioCaptureRing *capture_ring;
+
+    // Sample frames the device thread has processed since the device was opened, protected by `lock`.
+    Uint64 frames_played;
+
+    // When the device thread last handed a buffer to (or took one from) the driver. Zero until it has.
+    Uint64 last_period_ns;
+
     // A thread to feed the audio device
     SDL_Thread *thread;
 
@@ -35,6 +35,7 @@
 
 #include "SDL_wave.h"
 #include "SDL_audio_c.h"
+#include "../SDL_utils_c.h"
 
 /* Reads the value stored at the location of the f1 pointer, multiplies it
  * with the second argument and then stores the result to f1.
@@ -495,7 +496,7 @@ static Sint16 MS_ADPCM_ProcessNibble(MS_ADPCM_ChannelState *cstate, Sint32 sampl
     const Sint32 max_audioval = 32767;
     const Sint32 min_audioval = -32768;
     const Uint16 max_deltaval = 65535;
-    const Uint16 adaptive[] = {
+    static const Uint16 adaptive[] = {
         230, 230, 230, 230, 307, 409, 512, 614,
         768, 614, 512, 409, 307, 230, 230, 230
     };
@@ -589,7 +590,7 @@ static int MS_ADPCM_DecodeBlockHeader(ADPCM_DecoderState *state)
 static int MS_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
 {
     Uint16 nybble = 0;
-    Sint16 sample1, sample2;
+    Sint16 sample1[2], sample2[2];
     const Uint32 channels = state->channels;
     Uint32 c;
     MS_ADPCM_ChannelState *cstate = (MS_ADPCM_ChannelState *)state->cstate;
@@ -604,8 +605,19 @@ static int MS_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
         blockframesleft = state->framesleft;
     }
 
+    /* The two previous samples of each channel come from the block header.
+     * Keeping them in locals lets the channels advance side by side without
+     * reading back from the output buffer.
+     */
+    for (c = 0; c < channels; c++) {
+        sample1[c] = state->output.data[outpos - channels + c];
+        sample2[c] = state->output.data[outpos - channels * 2 + c];
+    }
+
     while (blockframesleft > 0) {
         for (c = 0; c < channels; c++) {
+            Sint16 sample;
+
             if (nybble & 0x4000) {
                 nybble <<= 4;
             } else if (blockpos < blocksize) {
@@ -616,12 +628,10 @@ static int MS_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
                 return -1;
             }
 
-            /* Load previous samples which may come from the block header. */
-            sample1 = state->output.data[outpos - channels];
-            sample2 = state->output.data[outpos - channels * 2];
-
-            sample1 = MS_ADPCM_ProcessNibble(cstate + c, sample1, sample2, (nybble >> 4) & 0x0f);
-            state->output.data[outpos++] = sample1;
+            sample = MS_ADPCM_ProcessNibble(cstate + c, sample1[c], sample2[c], (nybble >> 4) & 0x0f);
+            sample2[c] = sample1[c];
+            sample1[c] = sample;
+            state->output.data[outpos++] = sample;
         }
 
         state->framesleft--;
@@ -633,9 +643,126 @@ static int MS_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
     return 0;
 }
 
+typedef struct ADPCM_BlockJob
+{
+    ADPCM_DecoderState state; /* Private copy with its own channel state. */
+    int (*decodeheader)(ADPCM_DecoderState *state);
+    int (*decodedata)(ADPCM_DecoderState *state);
+    size_t firstblock;
+    size_t blockcount;
+    size_t stopblock; /* First block with a problem or the end of the range. */
+    int result;
+    char error[128]; /* The error message, which was set on the job's thread. */
+} ADPCM_BlockJob;
+
+/* Decodes a range of complete blocks. A block can still come up short if its
+ * size doesn't match the samples per block. Decoding stops there and leaves
+ * the block to the caller, which knows how to handle truncated data.
+ */
+static void ADPCM_DecodeBlockJob(void *userdata, int index, int first, int count)
+{
+    ADPCM_BlockJob *job = &((ADPCM_BlockJob *)userdata)[index];
+    ADPCM_DecoderState *state = &job->state;
+    const size_t blocksamples = state->samplesperblock * state->channels;
+    size_t i;
+
+    job->firstblock = (size_t)first;
+    job->blockcount = (size_t)count;
+
+    for (i = job->firstblock; i < job->firstblock + job->blockcount; i++) {
+        state->block.data = state->input.data + i * state->blocksize;
+        state->block.size = state->blocksize;
+        state->block.pos = 0;
+        state->output.pos = i * blocksamples;
+        state->framesleft = state->samplesperblock;
+
+        if (job->decodeheader(state) < 0) {
+            SDL_strlcpy(job->error, SDL_GetError(), sizeof(job->error));
+            job->stopblock = i;
+            job->result = -1;
+            return;
+        } else if (job->decodedata(state) < 0) {
+            job->stopblock = i;
+            job->result = 0;
+            return;
+        }
+    }
+
+    job->stopblock = i;
+    job->result = 0;
+}
+
+/* Decodes the leading blocks that are complete and fully used, splitting them
+ * across several threads if there are enough of them. Every block starts with
+ * a header that resets the decoder, so blocks are independent of each other.
+ * Returns the number of decoded blocks or -1 on error. The caller decodes the
+ * remaining (possibly truncated) blocks.
+ */
+static Sint64 ADPCM_DecodeFullBlocks(ADPCM_DecoderState *state, size_t cstatesize,
+                                     int (*decodeheader)(ADPCM_DecoderState *state),
+                                     int (*decodedata)(ADPCM_DecoderState *state))
+{
+    size_t blockcount = state->input.size / state->blocksize;
+    ADPCM_BlockJob *jobs;
+    Uint8 *cstates;
+    int i, numjobs;
+    Sint64 retval = 0;
+
+    if ((Uint64)state->framestotal / state->samplesperblock < blockcount) {
+        blockcount = (size_t)((Uint64)state->framestotal / state->samplesperblock);
+    }
+    if (blockcount > SDL_MAX_SINT32) {
+        blockcount = SDL_MAX_SINT32; /* The caller decodes the rest. */
+    }
+    if (blockcount == 0) {
+        return 0;
+    }
+
+    numjobs = SDL_GetParallelJobCount((int)blockcount, blockcount * state->samplesperblock * state->channels * sizeof(Sint16));
+    jobs = (ADPCM_BlockJob *)SDL_calloc(numjobs, sizeof(ADPCM_BlockJob));
+    cstates = (Uint8 *)SDL_calloc(numjobs, cstatesize * state->channels);
+    if (jobs == NULL || cstates == NULL) {
+        SDL_free(jobs);
+        SDL_free(cstates);
+        return SDL_OutOfMemory();
+    }
+
+    for (i = 0; i < numjobs; i++) {
+        ADPCM_BlockJob *job = &jobs[i];
+        job->state = *state;
+        job->state.cstate = cstates + i * cstatesize * state->channels;
+        job->decodeheader = decodeheader;
+        job->decodedata = decodedata;
+    }
+
+    SDL_RunParallel(numjobs, (int)blockcount, ADPCM_DecodeBlockJob, jobs);
+
+    /* Like the sequential decoder, stop at the first block with a problem.
+     * Anything the later jobs did past that point gets discarded.
+     */
+    for (i = 0; i < numjobs; i++) {
+        ADPCM_BlockJob *job = &jobs[i];
+        if (job->result < 0) {
+            SDL_SetError("%s", job->error);
+            retval = -1;
+            break;
+        } else if (job->stopblock < job->firstblock + job->blockcount) {
+            retval = (Sint64)job->stopblock;
+            break;
+        }
+        retval = (Sint64)blockcount;
+    }
+
+    SDL_free(jobs);
+    SDL_free(cstates);
+
+    return retval;
+}
+
 static int MS_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     int result;
+    Sint64 fullblocks;
     size_t bytesleft, outputsize;
     WaveChunk *chunk = &file->chunk;
     ADPCM_DecoderState state;
@@ -675,7 +802,7 @@ static int MS_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
     outputsize = (size_t)state.framestotal;
     if (SafeMult(&outputsize, state.framesize)) {
         return SDL_OutOfMemory();
-    } else if (outputsize > SDL_MAX_UINT32 || state.framestotal > SIZE_MAX) {
+    } else if (outputsize > SDL_MAX_UINT32 || (Uint64)state.framestotal > SIZE_MAX) {
         return SDL_SetError("WAVE file too big");
     }
 
@@ -688,7 +815,17 @@ static int MS_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 
     state.cstate = cstate;
 
-    /* Decode block by block. A truncated block will stop the decoding. */
+    /* Decode the complete blocks, possibly in parallel. */
+    fullblocks = ADPCM_DecodeFullBlocks(&state, sizeof(MS_ADPCM_ChannelState), MS_ADPCM_DecodeBlockHeader, MS_ADPCM_DecodeBlockData);
+    if (fullblocks < 0) {
+        SDL_free(state.output.data);
+        return -1;
+    }
+    state.input.pos = (size_t)fullblocks * state.blocksize;
+    state.output.pos = (size_t)fullblocks * state.samplesperblock * state.channels;
+    state.framesleft -= fullblocks * (Sint64)state.samplesperblock;
+
+    /* Decode the rest block by block. A truncated block will stop the decoding. */
     bytesleft = state.input.size - state.input.pos;
     while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
         state.block.data = state.input.data + state.input.pos;
@@ -854,13 +991,13 @@ static Sint16 IMA_ADPCM_ProcessNibble(Sint8 *cindex, Sint16 lastsample, Uint8 ny
 {
     const Sint32 max_audioval = 32767;
     const Sint32 min_audioval = -32768;
-    const Sint8 index_table_4b[16] = {
+    static const Sint8 index_table_4b[16] = {
         -1, -1, -1, -1,
         2, 4, 6, 8,
         -1, -1, -1, -1,
         2, 4, 6, 8
     };
-    const Uint16 step_table[89] = {
+    static const Uint16 step_table[89] = {
         7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
         34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
         143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
@@ -1030,6 +1167,7 @@ static int IMA_ADPCM_DecodeBlockData(ADPCM_DecoderState *state)
 static int IMA_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     int result;
+    Sint64 fullblocks;
     size_t bytesleft, outputsize;
     WaveChunk *chunk = &file->chunk;
     ADPCM_DecoderState state;
@@ -1066,7 +1204,7 @@ static int IMA_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len
     outputsize = (size_t)state.framestotal;
     if (SafeMult(&outputsize, state.framesize)) {
         return SDL_OutOfMemory();
-    } else if (outputsize > SDL_MAX_UINT32 || state.framestotal > SIZE_MAX) {
+    } else if (outputsize > SDL_MAX_UINT32 || (Uint64)state.framestotal > SIZE_MAX) {
         return SDL_SetError("WAVE file too big");
     }
 
@@ -1084,7 +1222,18 @@ static int IMA_ADPCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len
     }
     state.cstate = cstate;
 
-    /* Decode block by block. A truncated block will stop the decoding. */
+    /* Decode the complete blocks, possibly in parallel. */
+    fullblocks = ADPCM_DecodeFullBlocks(&state, sizeof(Sint8), IMA_ADPCM_DecodeBlockHeader, IMA_ADPCM_DecodeBlockData);
+    if (fullblocks < 0) {
+        SDL_free(state.output.data);
+        SDL_free(cstate);
+        return -1;
+    }
+    state.input.pos = (size_t)fullblocks * state.blocksize;
+    state.output.pos = (size_t)fullblocks * state.samplesperblock * state.channels;
+    state.framesleft -= fullblocks * (Sint64)state.samplesperblock;
+
+    /* Decode the rest block by block. A truncated block will stop the decoding. */
     bytesleft = state.input.size - state.input.pos;
     while (state.framesleft > 0 && bytesleft >= state.blockheadersize) {
         state.block.data = state.input.data + state.input.pos;
@@ -1158,7 +1307,10 @@ static int LAW_Init(WaveFile *file, size_t datalength)
     return 0;
 }
 
-static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+/* Expands companded samples to 16-bit PCM. Works backwards, so src and dst
+ * may point to the same buffer for in-place expansion.
+ */
+static int LAW_DecodeSamples(Uint16 encoding, const Uint8 *src, Sint16 *dst, size_t sample_count)
 {
 #ifdef SDL_WAVE_LAW_LUT
     const Sint16 alaw_lut[256] = {
@@ -1199,53 +1351,9 @@ static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
     };
 #endif
 
-    WaveFormat *format = &file->format;
-    WaveChunk *chunk = &file->chunk;
-    size_t i, sample_count, expanded_len;
-    Uint8 *src;
-    Sint16 *dst;
-
-    if (chunk->length != chunk->size) {
-        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
-        if (file->sampleframes < 0) {
-            return -1;
-        }
-    }
-
-    /* Nothing to decode, nothing to return. */
-    if (file->sampleframes == 0) {
-        *audio_buf = NULL;
-        *audio_len = 0;
-        return 0;
-    }
-
-    sample_count = (size_t)file->sampleframes;
-    if (SafeMult(&sample_count, format->channels)) {
-        return SDL_OutOfMemory();
-    }
-
-    expanded_len = sample_count;
-    if (SafeMult(&expanded_len, sizeof(Sint16))) {
-        return SDL_OutOfMemory();
-    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
-        return SDL_SetError("WAVE file too big");
-    }
-
-    /* 1 to avoid allocating zero bytes, to keep static analysis happy. */
-    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
-    if (src == NULL) {
-        return SDL_OutOfMemory();
-    }
-    chunk->data = NULL;
-    chunk->size = 0;
-
-    dst = (Sint16 *)src;
+    size_t i = sample_count;
 
-    /* Work backwards, since we're expanding in-place. `format` will
-     * inform the caller about the byte order.
-     */
-    i = sample_count;
-    switch (file->format.encoding) {
+    switch (encoding) {
 #ifdef SDL_WAVE_LAW_LUT
     case ALAW_CODE:
         while (i--) {
@@ -1290,10 +1398,64 @@ static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
         break;
 #endif
     default:
-        SDL_free(src);
         return SDL_SetError("Unknown companded encoding");
     }
 
+    return 0;
+}
+
+static int LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+    size_t sample_count, expanded_len;
+    Uint8 *src;
+    Sint16 *dst;
+
+    if (chunk->length != chunk->size) {
+        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
+        if (file->sampleframes < 0) {
+            return -1;
+        }
+    }
+
+    /* Nothing to decode, nothing to return. */
+    if (file->sampleframes == 0) {
+        *audio_buf = NULL;
+        *audio_len = 0;
+        return 0;
+    }
+
+    sample_count = (size_t)file->sampleframes;
+    if (SafeMult(&sample_count, format->channels)) {
+        return SDL_OutOfMemory();
+    }
+
+    expanded_len = sample_count;
+    if (SafeMult(&expanded_len, sizeof(Sint16))) {
+        return SDL_OutOfMemory();
+    } else if (expanded_len > SDL_MAX_UINT32 || (Uint64)file->sampleframes > SIZE_MAX) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    /* 1 to avoid allocating zero bytes, to keep static analysis happy. */
+    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
+    if (src == NULL) {
+        return SDL_OutOfMemory();
+    }
+    chunk->data = NULL;
+    chunk->size = 0;
+
+    dst = (Sint16 *)src;
+
+    /* Work backwards, since we're expanding in-place. `format` will
+     * inform the caller about the byte order.
+     */
+    if (LAW_DecodeSamples(format->encoding, src, dst, sample_count) < 0) {
+        SDL_free(src);
+        return -1;
+    }
+
     *audio_buf = src;
     *audio_len = (Uint32)expanded_len;
 
@@ -1343,11 +1505,35 @@ static int PCM_Init(WaveFile *file, size_t datalength)
     return 0;
 }
 
+/* Expands packed 24-bit samples to 32 bits in-place. The buffer must have room
+ * for sample_count 32-bit samples.
+ */
+static void PCM_ExpandSint24ToSint32(Uint8 *ptr, size_t sample_count)
+{
+    size_t i;
+
+    /* work from end to start, since we're expanding in-place. */
+    for (i = sample_count; i > 0; i--) {
+        const size_t o = i - 1;
+        uint8_t b[4];
+
+        b[0] = 0;
+        b[1] = ptr[o * 3];
+        b[2] = ptr[o * 3 + 1];
+        b[3] = ptr[o * 3 + 2];
+
+        ptr[o * 4 + 0] = b[0];
+        ptr[o * 4 + 1] = b[1];
+        ptr[o * 4 + 2] = b[2];
+        ptr[o * 4 + 3] = b[3];
+    }
+}
+
 static int PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
-    size_t i, expanded_len, sample_count;
+    size_t expanded_len, sample_count;
     Uint8 *ptr;
 
     sample_count = (size_t)file->sampleframes;
@@ -1358,7 +1544,7 @@ static int PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *
     expanded_len = sample_count;
     if (SafeMult(&expanded_len, sizeof(Sint32))) {
         return SDL_OutOfMemory();
-    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
+    } else if (expanded_len > SDL_MAX_UINT32 || (Uint64)file->sampleframes > SIZE_MAX) {
         return SDL_SetError("WAVE file too big");
     }
 
@@ -1375,21 +1561,7 @@ static int PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *
     *audio_buf = ptr;
     *audio_len = (Uint32)expanded_len;
 
-    /* work from end to start, since we're expanding in-place. */
-    for (i = sample_count; i > 0; i--) {
-        const size_t o = i - 1;
-        uint8_t b[4];
-
-        b[0] = 0;
-        b[1] = ptr[o * 3];
-        b[2] = ptr[o * 3 + 1];
-        b[3] = ptr[o * 3 + 2];
-
-        ptr[o * 4 + 0] = b[0];
-        ptr[o * 4 + 1] = b[1];
-        ptr[o * 4 + 2] = b[2];
-        ptr[o * 4 + 3] = b[3];
-    }
+    PCM_ExpandSint24ToSint32(ptr, sample_count);
 
     return 0;
 }
@@ -1422,7 +1594,7 @@ static int PCM_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
     outputsize = (size_t)file->sampleframes;
     if (SafeMult(&outputsize, format->blockalign)) {
         return SDL_OutOfMemory();
-    } else if (outputsize > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
+    } else if (outputsize > SDL_MAX_UINT32 || (Uint64)file->sampleframes > SIZE_MAX) {
         return SDL_SetError("WAVE file too big");
     }
 
@@ -1769,7 +1941,11 @@ static int WaveCheckFormat(WaveFile *file, size_t datalength)
     return 0;
 }
 
-static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+/* Parses the RIFF structure and the fmt chunk, initializes the decoder and sets
+ * up the spec. On success, file->chunk describes the data chunk (without any
+ * data loaded) and endposition is the stream position after the WAVE file.
+ */
+static int WaveLoadHeader(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Sint64 *endposition)
 {
     int result;
     Uint32 chunkcount = 0;
@@ -1980,9 +2156,70 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
 
     WaveFreeChunkData(chunk);
 
-    /* Process data chunk. */
+    /* The data chunk is left for the caller to read or stream. */
     *chunk = datachunk;
 
+    /* Setting up the specs. All unsupported formats were filtered out
+     * by checks earlier in this function.
+     */
+    spec->freq = format->frequency;
+    spec->channels = (Uint8)format->channels;
+    spec->format = 0;
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+    case ALAW_CODE:
+    case MULAW_CODE:
+        /* These can be easily stored in the byte order of the system. */
+        spec->format = SDL_AUDIO_S16SYS;
+        break;
+    case IEEE_FLOAT_CODE:
+        spec->format = SDL_AUDIO_F32LSB;
+        break;
+    case PCM_CODE:
+        switch (format->bitspersample) {
+        case 8:
+            spec->format = SDL_AUDIO_U8;
+            break;
+        case 16:
+            spec->format = SDL_AUDIO_S16LSB;
+            break;
+        case 24: /* Has been shifted to 32 bits. */
+        case 32:
+            spec->format = SDL_AUDIO_S32LSB;
+            break;
+        default:
+            /* Just in case something unexpected happened in the checks. */
+            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
+        }
+        break;
+    default:
+        return SDL_SetError("Unexpected data format");
+    }
+
+    /* Report the end position back to the caller. */
+    if (RIFFlengthknown) {
+        *endposition = RIFFend;
+    } else {
+        *endposition = lastchunkpos;
+    }
+
+    return 0;
+}
+
+static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    int result;
+    Sint64 endposition;
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+
+    if (WaveLoadHeader(src, file, spec, &endposition) < 0) {
+        return -1;
+    }
+
+    /* Process data chunk. */
     if (chunk->length > 0) {
         result = WaveReadChunkData(src, chunk);
         if (result == -1) {
@@ -2026,51 +2263,8 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
         break;
     }
 
-    /* Setting up the specs. All unsupported formats were filtered out
-     * by checks earlier in this function.
-     */
-    spec->freq = format->frequency;
-    spec->channels = (Uint8)format->channels;
-    spec->format = 0;
-
-    switch (format->encoding) {
-    case MS_ADPCM_CODE:
-    case IMA_ADPCM_CODE:
-    case ALAW_CODE:
-    case MULAW_CODE:
-        /* These can be easily stored in the byte order of the system. */
-        spec->format = SDL_AUDIO_S16SYS;
-        break;
-    case IEEE_FLOAT_CODE:
-        spec->format = SDL_AUDIO_F32LSB;
-        break;
-    case PCM_CODE:
-        switch (format->bitspersample) {
-        case 8:
-            spec->format = SDL_AUDIO_U8;
-            break;
-        case 16:
-            spec->format = SDL_AUDIO_S16LSB;
-            break;
-        case 24: /* Has been shifted to 32 bits. */
-        case 32:
-            spec->format = SDL_AUDIO_S32LSB;
-            break;
-        default:
-            /* Just in case something unexpected happened in the checks. */
-            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
-        }
-        break;
-    default:
-        return SDL_SetError("Unexpected data format");
-    }
-
     /* Report the end position back to the cleanup code. */
-    if (RIFFlengthknown) {
-        chunk->position = RIFFend;
-    } else {
-        chunk->position = lastchunkpos;
-    }
+    chunk->position = endposition;
 
     return 0;
 }
@@ -2127,3 +2321,430 @@ int SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32
     return SDL_LoadWAV_RW(SDL_RWFromFile(path, "rb"), 1, spec, audio_buf, audio_len);
 }
 
+
+/* Size of the buffer used to feed audio streams from a reader. */
+#define WAVE_READER_FEED_SIZE 4096
+
+struct SDL_WAVReader
+{
+    SDL_RWops *src;
+    SDL_bool freesrc;
+    WaveFile file;
+    SDL_AudioSpec spec;
+
+    Sint64 datastart;     /* Position of the data chunk data in src. */
+    size_t datasize;      /* Bytes of the data chunk that are available in src. */
+    size_t rawframesize;  /* Size of a sample frame in the file (uncompressed formats). */
+    size_t framesize;     /* Size of a decoded sample frame. */
+    Sint64 framestotal;   /* Number of sample frames that can be decoded. */
+    Sint64 framepos;      /* Next sample frame to decode. */
+
+    /* ADPCM decoding works on whole blocks. The current one is cached. */
+    ADPCM_DecoderState adpcm;
+    Uint8 *blockdata;     /* Raw data of the current block. */
+    Sint16 *blockframes;  /* Decoded samples of the current block. */
+    Sint64 blockindex;    /* Index of the cached block, -1 if none. */
+    Sint64 blockcount;    /* Number of valid sample frames in the cached block. */
+
+    Uint8 *feedbuf;       /* Used by the audio stream get callback. */
+    int feedlen;
+};
+
+static int WaveReaderInit(SDL_WAVReader *reader)
+{
+    WaveFile *file = &reader->file;
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+    Sint64 srcsize;
+
+    reader->datastart = chunk->position;
+    reader->datasize = chunk->length;
+
+    /* The data chunk may be truncated. This is what the decoders do when the
+     * data chunk could not be read completely.
+     */
+    srcsize = SDL_RWsize(reader->src);
+    if (srcsize >= 0 && srcsize - reader->datastart < (Sint64)reader->datasize) {
+        reader->datasize = srcsize > reader->datastart ? (size_t)(srcsize - reader->datastart) : 0;
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            return SDL_SetError("Could not read data of WAVE data chunk");
+        }
+
+        switch (format->encoding) {
+        case MS_ADPCM_CODE:
+            if (MS_ADPCM_CalculateSampleFrames(file, reader->datasize) < 0) {
+                return -1;
+            }
+            break;
+        case IMA_ADPCM_CODE:
+            if (IMA_ADPCM_CalculateSampleFrames(file, reader->datasize) < 0) {
+                return -1;
+            }
+            break;
+        default:
+            file->sampleframes = WaveAdjustToFactValue(file, reader->datasize / format->blockalign);
+            if (file->sampleframes < 0) {
+                return -1;
+            }
+            break;
+        }
+    }
+
+    reader->framesize = (size_t)(SDL_AUDIO_BITSIZE(reader->spec.format) / 8) * format->channels;
+    reader->blockindex = -1;
+
+    switch (format->encoding) {
+    case PCM_CODE:
+    case IEEE_FLOAT_CODE:
+        /* sampleframes counts blocks here, which may be smaller than a frame. */
+        reader->rawframesize = ((size_t)format->bitspersample / 8) * format->channels;
+        reader->framestotal = (file->sampleframes * format->blockalign) / (Sint64)reader->rawframesize;
+        break;
+    case ALAW_CODE:
+    case MULAW_CODE:
+        reader->rawframesize = format->channels;
+        reader->framestotal = file->sampleframes;
+        break;
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+    {
+        ADPCM_DecoderState *state = &reader->adpcm;
+        const SDL_bool ms = (format->encoding == MS_ADPCM_CODE) ? SDL_TRUE : SDL_FALSE;
+
+        state->channels = format->channels;
+        state->blocksize = format->blockalign;
+        state->blockheadersize = (size_t)state->channels * (ms ? 7 : 4);
+        state->samplesperblock = format->samplesperblock;
+        state->framesize = state->channels * sizeof(Sint16);
+        state->ddata = file->decoderdata;
+
+        reader->framestotal = file->sampleframes;
+        reader->blockdata = (Uint8 *)SDL_malloc(state->blocksize);
+        reader->blockframes = (Sint16 *)SDL_calloc(state->samplesperblock, state->framesize);
+        state->cstate = SDL_calloc(state->channels, ms ? sizeof(MS_ADPCM_ChannelState) : sizeof(Sint8));
+        if (reader->blockdata == NULL || reader->blockframes == NULL || state->cstate == NULL) {
+            return SDL_OutOfMemory();
+        }
+        break;
+    }
+    default:
+        return SDL_SetError("Unexpected data format");
+    }
+
+    reader->feedlen = (int)(WAVE_READER_FEED_SIZE - (WAVE_READER_FEED_SIZE % reader->framesize));
+    if (reader->feedlen == 0) {
+        reader->feedlen = (int)reader->framesize;
+    }
+
+    return 0;
+}
+
+/* Reads and decodes the ADPCM block with the given index into the cache. */
+static int WaveReaderDecodeBlock(SDL_WAVReader *reader, Sint64 index)
+{
+    ADPCM_DecoderState *state = &reader->adpcm;
+    const Uint64 offset = (Uint64)index * state->blocksize;
+    const Sint64 blockstart = index * (Sint64)state->samplesperblock;
+    Sint64 position;
+    size_t length = 0;
+
+    reader->blockindex = index;
+    reader->blockcount = 0;
+
+    if (offset < reader->datasize) {
+        length = reader->datasize - (size_t)offset;
+        if (length > state->blocksize) {
+            length = state->blocksize;
+        }
+        position = reader->datastart + (Sint64)offset;
+        if (SDL_RWseek(reader->src, position, SDL_RW_SEEK_SET) != position) {
+            return SDL_SetError("Could not seek data of WAVE data chunk");
+        }
+        length = SDL_RWread(reader->src, reader->blockdata, length);
+    }
+
+    if (length < state->blockheadersize) {
+        /* Nothing left to decode in this block. */
+        return 0;
+    }
+
+    state->block.data = reader->blockdata;
+    state->block.size = length;
+    state->block.pos = 0;
+    state->output.data = reader->blockframes;
+    state->output.size = state->samplesperblock * state->channels;
+    state->output.pos = 0;
+    state->framesleft = reader->framestotal - blockstart;
+    if (state->framesleft > (Sint64)state->samplesperblock) {
+        state->framesleft = state->samplesperblock;
+    }
+    state->framestotal = state->framesleft;
+
+    /* A truncated block still returns the sample frames decoded so far. */
+    if (reader->file.format.encoding == MS_ADPCM_CODE) {
+        if (MS_ADPCM_DecodeBlockHeader(state) < 0) {
+            return -1;
+        }
+        MS_ADPCM_DecodeBlockData(state);
+    } else {
+        IMA_ADPCM_DecodeBlockHeader(state);
+        IMA_ADPCM_DecodeBlockData(state);
+    }
+
+    reader->blockcount = (Sint64)(state->output.pos / state->channels);
+    if (reader->blockcount > state->framestotal) {
+        reader->blockcount = state->framestotal;
+    }
+
+    return 0;
+}
+
+static Sint64 WaveReaderReadADPCM(SDL_WAVReader *reader, Uint8 *buf, Sint64 frames)
+{
+    const Sint64 samplesperblock = (Sint64)reader->adpcm.samplesperblock;
+    Sint64 done = 0;
+
+    while (done < frames) {
+        const Sint64 framepos = reader->framepos + done;
+        const Sint64 index = framepos / samplesperblock;
+        const Sint64 offset = framepos % samplesperblock;
+        Sint64 count;
+
+        if (index != reader->blockindex) {
+            if (WaveReaderDecodeBlock(reader, index) < 0) {
+                return done > 0 ? done : -1;
+            }
+        }
+
+        count = reader->blockcount - offset;
+        if (count <= 0) {
+            break; /* Truncated data. */
+        } else if (count > frames - done) {
+            count = frames - done;
+        }
+
+        SDL_memcpy(buf + (size_t)done * reader->framesize,
+                   reader->blockframes + (size_t)offset * reader->adpcm.channels,
+                   (size_t)count * reader->framesize);
+        done += count;
+    }
+
+    return done;
+}
+
+static Sint64 WaveReaderReadRaw(SDL_WAVReader *reader, Uint8 *buf, Sint64 frames)
+{
+    const WaveFormat *format = &reader->file.format;
+    const Sint64 position = reader->datastart + reader->framepos * (Sint64)reader->rawframesize;
+    const size_t length = (size_t)frames * reader->rawframesize;
+    size_t samples;
+
+    if (SDL_RWseek(reader->src, position, SDL_RW_SEEK_SET) != position) {
+        return SDL_SetError("Could not seek data of WAVE data chunk");
+    }
+
+    /* The expansions below work backwards, so the raw data can be read into
+     * the start of the output buffer.
+     */
+    frames = (Sint64)(SDL_RWread(reader->src, buf, length) / reader->rawframesize);
+    samples = (size_t)frames * format->channels;
+
+    switch (format->encoding) {
+    case ALAW_CODE:
+    case MULAW_CODE:
+        if (LAW_DecodeSamples(format->encoding, buf, (Sint16 *)buf, samples) < 0) {
+            return -1;
+        }
+        break;
+    case PCM_CODE:
+        if (format->bitspersample == 24) {
+            PCM_ExpandSint24ToSint32(buf, samples);
+        }
+        break;
+    default:
+        break;
+    }
+
+    return frames;
+}
+
+SDL_WAVReader *SDL_OpenWAVReader_RW(SDL_RWops *src, SDL_bool freesrc, SDL_AudioSpec *spec)
+{
+    SDL_WAVReader *reader = NULL;
+    Sint64 endposition;
+
+    /* Make sure we are passed a valid data source */
+    if (src == NULL) {
+        return NULL; /* Error may come from RWops. */
+    } else if (spec == NULL) {
+        SDL_InvalidParamError("spec");
+        goto failed;
+    }
+
+    reader = (SDL_WAVReader *)SDL_calloc(1, sizeof(SDL_WAVReader));
+    if (reader == NULL) {
+        SDL_OutOfMemory();
+        goto failed;
+    }
+    reader->src = src;
+    reader->freesrc = freesrc;
+    reader->file.riffhint = WaveGetRiffSizeHint();
+    reader->file.trunchint = WaveGetTruncationHint();
+    reader->file.facthint = WaveGetFactChunkHint();
+
+    if (WaveLoadHeader(src, &reader->file, &reader->spec, &endposition) < 0 ||
+        WaveReaderInit(reader) < 0) {
+        goto failed;
+    }
+
+    SDL_copyp(spec, &reader->spec);
+    return reader;
+
+failed:
+    if (reader != NULL) {
+        reader->freesrc = SDL_FALSE;
+        SDL_CloseWAVReader(reader);
+    }
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    return NULL;
+}
+
+SDL_WAVReader *SDL_OpenWAVReader(const char *path, SDL_AudioSpec *spec)
+{
+    return SDL_OpenWAVReader_RW(SDL_RWFromFile(path, "rb"), SDL_TRUE, spec);
+}
+
+int SDL_ReadWAVReader(SDL_WAVReader *reader, void *buf, int len)
+{
+    Sint64 frames;
+
+    if (reader == NULL) {
+        return SDL_InvalidParamError("reader");
+    } else if (buf == NULL) {
+        return SDL_InvalidParamError("buf");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    }
+
+    frames = reader->framestotal - reader->framepos;
+    if (frames > (Sint64)((size_t)len / reader->framesize)) {
+        frames = (Sint64)((size_t)len / reader->framesize);
+    }
+    if (frames <= 0) {
+        return 0;
+    }
+
+    switch (reader->file.format.encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+        frames = WaveReaderReadADPCM(reader, (Uint8 *)buf, frames);
+        break;
+    default:
+        frames = WaveReaderReadRaw(reader, (Uint8 *)buf, frames);
+        break;
+    }
+
+    if (frames < 0) {
+        return -1;
+    }
+
+    reader->framepos += frames;
+    return (int)((size_t)frames * reader->framesize);
+}
+
+int SDL_SeekWAVReader(SDL_WAVReader *reader, Sint64 frame)
+{
+    if (reader == NULL) {
+        return SDL_InvalidParamError("reader");
+    }
+
+    if (frame < 0) {
+        frame = 0;
+    } else if (frame > reader->framestotal) {
+        frame = reader->framestotal;
+    }
+    reader->framepos = frame;
+
+    return 0;
+}
+
+Sint64 SDL_TellWAVReader(SDL_WAVReader *reader)
+{
+    if (reader == NULL) {
+        return SDL_InvalidParamError("reader");
+    }
+    return reader->framepos;
+}
+
+Sint64 SDL_GetWAVReaderLength(SDL_WAVReader *reader)
+{
+    if (reader == NULL) {
+        return SDL_InvalidParamError("reader");
+    }
+    return reader->framestotal;
+}
+
+static void SDLCALL WaveReaderFeedAudioStream(SDL_AudioStream *stream, int approx_request, void *userdata)
+{
+    SDL_WAVReader *reader = (SDL_WAVReader *)userdata;
+
+    while (approx_request > 0) {
+        const int len = SDL_ReadWAVReader(reader, reader->feedbuf, SDL_min(approx_request, reader->feedlen));
+        if (len <= 0) {
+            break;
+        }
+        SDL_PutAudioStreamData(stream, reader->feedbuf, len);
+        approx_request -= len;
+    }
+
+    if (reader->framepos == reader->framestotal) {
+        SDL_FlushAudioStream(stream);
+    }
+}
+
+int SDL_SetAudioStreamWAVReader(SDL_AudioStream *stream, SDL_WAVReader *reader)
+{
+    int retval;
+
+    if (stream == NULL) {
+        return SDL_InvalidParamError("stream");
+    } else if (reader == NULL) {
+        return SDL_SetAudioStreamGetCallback(stream, NULL, NULL);
+    }
+
+    if (reader->feedbuf == NULL) {
+        reader->feedbuf = (Uint8 *)SDL_malloc(reader->feedlen);
+        if (reader->feedbuf == NULL) {
+            return SDL_OutOfMemory();
+        }
+    }
+
+    SDL_LockAudioStream(stream);
+    retval = SDL_SetAudioStreamFormat(stream, &reader->spec, NULL);
+    if (retval == 0) {
+        retval = SDL_SetAudioStreamGetCallback(stream, WaveReaderFeedAudioStream, reader);
+    }
+    SDL_UnlockAudioStream(stream);
+
+    return retval;
+}
+
+void SDL_CloseWAVReader(SDL_WAVReader *reader)
+{
+    if (reader == NULL) {
+        return;
+    }
+
+    if (reader->freesrc) {
+        SDL_RWclose(reader->src);
+    }
+    WaveFreeChunkData(&reader->file.chunk);
+    SDL_free(reader->file.decoderdata);
+    SDL_free(reader->adpcm.cstate);
+    SDL_free(reader->blockdata);
+    SDL_free(reader->blockframes);
+    SDL_free(reader->feedbuf);
+    SDL_free(reader);
+}
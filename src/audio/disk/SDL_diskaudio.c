@@ -37,11 +37,12 @@
 
 static void DISKAUDIO_WaitDevice(SDL_AudioDevice *device)
 {
-    SDL_Delay(device->hidden->io_delay);
+    SDL_WaitSimulatedAudioDevice(device, &device->hidden->timing);
 }
 
 static void DISKAUDIO_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int buffer_size)
 {
+    SDL_SimulateAudioDeviceLoad(&device->hidden->timing);
     const int written = (int)SDL_RWwrite(device->hidden->io, buffer, (size_t)buffer_size);
     if (written != buffer_size) { // If we couldn't write, assume fatal error for now
         SDL_AudioDeviceDisconnected(device);
@@ -61,6 +62,8 @@ static int DISKAUDIO_CaptureFromDevice(SDL_AudioDevice *device, void *buffer, in
     struct SDL_PrivateAudioData *h = device->hidden;
     const int origbuflen = buflen;
 
+    SDL_SimulateAudioDeviceLoad(&device->hidden->timing);
+
     if (h->io) {
         const int br = (int)SDL_RWread(h->io, buffer, (size_t)buflen);
         buflen -= br;
@@ -119,6 +122,7 @@ static int DISKAUDIO_OpenDevice(SDL_AudioDevice *device)
     } else {
         device->hidden->io_delay = ((device->sample_frames * 1000) / device->spec.freq);
     }
+    SDL_InitSimulatedAudioTiming(&device->hidden->timing, device->hidden->io_delay);
 
     // Open the "audio device"
     device->hidden->io = SDL_RWFromFile(fname, iscapture ? "rb" : "wb");
@@ -161,6 +165,7 @@ static SDL_bool DISKAUDIO_Init(SDL_AudioDriverImpl *impl)
 
     impl->AllowsArbitraryDeviceNames = SDL_TRUE;
     impl->HasCaptureSupport = SDL_TRUE;
+    impl->SupportsOfflineRendering = SDL_TRUE;
 
     return SDL_TRUE;
 }
@@ -30,6 +30,7 @@ struct SDL_PrivateAudioData
     /* The file descriptor for the audio device */
     SDL_RWops *io;
     Uint32 io_delay;
+    SDL_SimulatedAudioTiming timing;
     Uint8 *mixbuf;
 };
 
@@ -30,7 +30,12 @@
 
 static void DUMMYAUDIO_WaitDevice(SDL_AudioDevice *device)
 {
-    SDL_Delay(device->hidden->io_delay);
+    SDL_WaitSimulatedAudioDevice(device, &device->hidden->timing);
+}
+
+static void DUMMYAUDIO_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int buffer_size)
+{
+    SDL_SimulateAudioDeviceLoad(&device->hidden->timing);
 }
 
 static int DUMMYAUDIO_OpenDevice(SDL_AudioDevice *device)
@@ -50,6 +55,7 @@ static int DUMMYAUDIO_OpenDevice(SDL_AudioDevice *device)
     }
 
     device->hidden->io_delay = (Uint32) (envr ? SDL_atoi(envr) : ((device->sample_frames * 1000) / device->spec.freq));
+    SDL_InitSimulatedAudioTiming(&device->hidden->timing, device->hidden->io_delay);
 
     return 0; // we're good; don't change reported device format.
 }
@@ -70,6 +76,7 @@ static Uint8 *DUMMYAUDIO_GetDeviceBuf(SDL_AudioDevice *device, int *buffer_size)
 
 static int DUMMYAUDIO_CaptureFromDevice(SDL_AudioDevice *device, void *buffer, int buflen)
 {
+    SDL_SimulateAudioDeviceLoad(&device->hidden->timing);
     // always return a full buffer of silence.
     SDL_memset(buffer, device->silence_value, buflen);
     return buflen;
@@ -80,6 +87,7 @@ static SDL_bool DUMMYAUDIO_Init(SDL_AudioDriverImpl *impl)
     impl->OpenDevice = DUMMYAUDIO_OpenDevice;
     impl->CloseDevice = DUMMYAUDIO_CloseDevice;
     impl->WaitDevice = DUMMYAUDIO_WaitDevice;
+    impl->PlayDevice = DUMMYAUDIO_PlayDevice;
     impl->GetDeviceBuf = DUMMYAUDIO_GetDeviceBuf;
     impl->WaitCaptureDevice = DUMMYAUDIO_WaitDevice;
     impl->CaptureFromDevice = DUMMYAUDIO_CaptureFromDevice;
@@ -87,6 +95,7 @@ static SDL_bool DUMMYAUDIO_Init(SDL_AudioDriverImpl *impl)
     impl->OnlyHasDefaultOutputDevice = SDL_TRUE;
     impl->OnlyHasDefaultCaptureDevice = SDL_TRUE;
     impl->HasCaptureSupport = SDL_TRUE;
+    impl->SupportsOfflineRendering = SDL_TRUE;
 
     return SDL_TRUE;
 }
@@ -29,6 +29,7 @@ struct SDL_PrivateAudioData
 {
     Uint8 *mixbuf;   // The file descriptor for the audio device
     Uint32 io_delay; // miliseconds to sleep in WaitDevice.
+    SDL_SimulatedAudioTiming timing; // pacing and simulated load.
 };
 
 #endif // SDL_dummyaudio_h_
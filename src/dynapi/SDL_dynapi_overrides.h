@@ -924,3 +924,41 @@
 #define SDL_WriteS32LE SDL_WriteS32LE_REAL
 #define SDL_WriteS32BE SDL_WriteS32BE_REAL
 #define SDL_WriteS64LE SDL_WriteS64LE_REAL
+#define SDL_OpenWAVReader_RW SDL_OpenWAVReader_RW_REAL
+#define SDL_OpenWAVReader SDL_OpenWAVReader_REAL
+#define SDL_ReadWAVReader SDL_ReadWAVReader_REAL
+#define SDL_SeekWAVReader SDL_SeekWAVReader_REAL
+#define SDL_TellWAVReader SDL_TellWAVReader_REAL
+#define SDL_GetWAVReaderLength SDL_GetWAVReaderLength_REAL
+#define SDL_SetAudioStreamWAVReader SDL_SetAudioStreamWAVReader_REAL
+#define SDL_CloseWAVReader SDL_CloseWAVReader_REAL
+#define SDL_GetHintHandle SDL_GetHintHandle_REAL
+#define SDL_GetHintHandleValue SDL_GetHintHandleValue_REAL
+#define SDL_GetHintHandleBoolean SDL_GetHintHandleBoolean_REAL
+#define SDL_LogSetAsync SDL_LogSetAsync_REAL
+#define SDL_LogGetDroppedMessages SDL_LogGetDroppedMessages_REAL
+#define SDL_GetJoystickInputStats SDL_GetJoystickInputStats_REAL
+#define SDL_GetJoystickRumbleStats SDL_GetJoystickRumbleStats_REAL
+#define SDL_GetJoystickState SDL_GetJoystickState_REAL
+#define SDL_StartRenderCapture SDL_StartRenderCapture_REAL
+#define SDL_StopRenderCapture SDL_StopRenderCapture_REAL
+#define SDL_GetRenderCaptureStats SDL_GetRenderCaptureStats_REAL
+#define SDL_SetAudioDeviceGain SDL_SetAudioDeviceGain_REAL
+#define SDL_GetAudioDeviceGain SDL_GetAudioDeviceGain_REAL
+#define SDL_SetAudioStreamGain SDL_SetAudioStreamGain_REAL
+#define SDL_GetAudioStreamGain SDL_GetAudioStreamGain_REAL
+#define SDL_GetAudioDeviceStats SDL_GetAudioDeviceStats_REAL
+#define SDL_ResetAudioDeviceStats SDL_ResetAudioDeviceStats_REAL
+#define SDL_GetAudioStreamStats SDL_GetAudioStreamStats_REAL
+#define SDL_StepAudioDevice SDL_StepAudioDevice_REAL
+#define SDL_AddAudioPostmixCallback SDL_AddAudioPostmixCallback_REAL
+#define SDL_RemoveAudioPostmixCallback SDL_RemoveAudioPostmixCallback_REAL
+#define SDL_GetAudioPostmixStats SDL_GetAudioPostmixStats_REAL
+#define SDL_GetAudioDeviceClock SDL_GetAudioDeviceClock_REAL
+#define SDL_ScheduleAudioStream SDL_ScheduleAudioStream_REAL
+#define SDL_CreateAudioCaptureReader SDL_CreateAudioCaptureReader_REAL
+#define SDL_AcquireAudioCaptureBuffer SDL_AcquireAudioCaptureBuffer_REAL
+#define SDL_ReleaseAudioCaptureBuffer SDL_ReleaseAudioCaptureBuffer_REAL
+#define SDL_GetAudioCaptureReaderStats SDL_GetAudioCaptureReaderStats_REAL
+#define SDL_DestroyAudioCaptureReader SDL_DestroyAudioCaptureReader_REAL
+#define SDL_UnpremultiplyAlpha SDL_UnpremultiplyAlpha_REAL
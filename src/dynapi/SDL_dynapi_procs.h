@@ -968,3 +968,41 @@ SDL_DYNAPI_PROC(SDL_bool,SDL_WriteS16BE,(SDL_RWops *a, Sint16 b),(a,b),return)
 SDL_DYNAPI_PROC(SDL_bool,SDL_WriteS32LE,(SDL_RWops *a, Sint32 b),(a,b),return)
 SDL_DYNAPI_PROC(SDL_bool,SDL_WriteS32BE,(SDL_RWops *a, Sint32 b),(a,b),return)
 SDL_DYNAPI_PROC(SDL_bool,SDL_WriteS64LE,(SDL_RWops *a, Sint64 b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_WAVReader*,SDL_OpenWAVReader_RW,(SDL_RWops *a, SDL_bool b, SDL_AudioSpec *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_WAVReader*,SDL_OpenWAVReader,(const char *a, SDL_AudioSpec *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_ReadWAVReader,(SDL_WAVReader *a, void *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_SeekWAVReader,(SDL_WAVReader *a, Sint64 b),(a,b),return)
+SDL_DYNAPI_PROC(Sint64,SDL_TellWAVReader,(SDL_WAVReader *a),(a),return)
+SDL_DYNAPI_PROC(Sint64,SDL_GetWAVReaderLength,(SDL_WAVReader *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioStreamWAVReader,(SDL_AudioStream *a, SDL_WAVReader *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_CloseWAVReader,(SDL_WAVReader *a),(a),)
+SDL_DYNAPI_PROC(SDL_HintHandle*,SDL_GetHintHandle,(const char *a),(a),return)
+SDL_DYNAPI_PROC(const char*,SDL_GetHintHandleValue,(SDL_HintHandle *a),(a),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_GetHintHandleBoolean,(SDL_HintHandle *a, SDL_bool b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_LogSetAsync,(SDL_bool a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_LogGetDroppedMessages,(void),(),return)
+SDL_DYNAPI_PROC(int,SDL_GetJoystickInputStats,(SDL_Joystick *a, Uint64 *b, Uint64 *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_GetJoystickRumbleStats,(SDL_Joystick *a, int *b, Uint64 *c, Uint64 *d, Uint64 *e, Uint64 *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_GetJoystickState,(SDL_Joystick *a, SDL_JoystickState *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_StartRenderCapture,(SDL_Renderer *a, const char *b, SDL_RenderCaptureFormat c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_StopRenderCapture,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderCaptureStats,(SDL_Renderer *a, Uint64 *b, Uint64 *c, Uint64 *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioDeviceGain,(SDL_AudioDeviceID a, float b),(a,b),return)
+SDL_DYNAPI_PROC(float,SDL_GetAudioDeviceGain,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioStreamGain,(SDL_AudioStream *a, float b),(a,b),return)
+SDL_DYNAPI_PROC(float,SDL_GetAudioStreamGain,(SDL_AudioStream *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceStats,(SDL_AudioDeviceID a, SDL_AudioDeviceStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_ResetAudioDeviceStats,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioStreamStats,(SDL_AudioStream *a, SDL_AudioStreamStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_StepAudioDevice,(SDL_AudioDeviceID a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_AddAudioPostmixCallback,(SDL_AudioDeviceID a, SDL_AudioPostmixCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RemoveAudioPostmixCallback,(SDL_AudioDeviceID a, SDL_AudioPostmixCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioPostmixStats,(SDL_AudioDeviceID a, SDL_AudioPostmixCallback b, void *c, SDL_AudioPostmixStats *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceClock,(SDL_AudioDeviceID a, Uint64 *b, Uint64 *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_ScheduleAudioStream,(SDL_AudioStream *a, Uint64 b, Uint64 c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_AudioCaptureReader*,SDL_CreateAudioCaptureReader,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_AcquireAudioCaptureBuffer,(SDL_AudioCaptureReader *a, const void **b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_ReleaseAudioCaptureBuffer,(SDL_AudioCaptureReader *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioCaptureReaderStats,(SDL_AudioCaptureReader *a, SDL_AudioCaptureReaderStats *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyAudioCaptureReader,(SDL_AudioCaptureReader *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_UnpremultiplyAlpha,(int a, int b, Uint32 c, const void *d, int e, Uint32 f, void *g, int h),(a,b,c,d,e,f,g,h),return)
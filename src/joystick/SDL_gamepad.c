@@ -41,6 +41,9 @@
 /* Many gamepads turn the center button into an instantaneous button press */
 #define SDL_MINIMUM_GUIDE_BUTTON_DELAY_MS 250
 
+/* The mappings are indexed by GUID, without the CRC and version */
+#define SDL_GAMEPAD_MAPPING_HASH_SIZE 256 /* must be a power of two */
+
 #define SDL_GAMEPAD_CRC_FIELD           "crc:"
 #define SDL_GAMEPAD_CRC_FIELD_SIZE      4 /* hard-coded for speed */
 #define SDL_GAMEPAD_TYPE_FIELD          "type:"
@@ -113,13 +116,20 @@ typedef enum
 
 #define _guarded SDL_GUARDED_BY(SDL_joystick_lock)
 
+/* The name and mapping are extracted from the mapping string the first time
+   they're needed, most of the mappings in the database are never used.
+ */
 typedef struct GamepadMapping_t
 {
     SDL_JoystickGUID guid _guarded;
+    Uint16 crc _guarded;
+    const char *source _guarded;
+    SDL_bool free_source _guarded;
     char *name _guarded;
     char *mapping _guarded;
     SDL_GamepadMappingPriority priority _guarded;
     struct GamepadMapping_t *next _guarded;
+    struct GamepadMapping_t *hash_next _guarded;
 } GamepadMapping_t;
 
 typedef struct
@@ -137,6 +147,8 @@ typedef struct
 
 static SDL_JoystickGUID s_zeroGUID;
 static GamepadMapping_t *s_pSupportedGamepads SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static GamepadMapping_t *s_pSupportedGamepadsTail SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static GamepadMapping_t *s_pGamepadMappingHash[SDL_GAMEPAD_MAPPING_HASH_SIZE] SDL_GUARDED_BY(SDL_joystick_lock);
 static GamepadMapping_t *s_pDefaultMapping SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static GamepadMapping_t *s_pXInputMapping SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static MappingChangeTracker *s_mappingChangeTracker SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
@@ -186,7 +198,9 @@ static void SDLCALL SDL_GamepadIgnoreDevicesExceptChanged(void *userdata, const
     SDL_LoadVIDPIDListFromHint(hint, &SDL_allowed_gamepads);
 }
 
-static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString, SDL_bool *existing, SDL_GamepadMappingPriority priority);
+static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString, SDL_bool static_string, SDL_bool *existing, SDL_GamepadMappingPriority priority);
+static int SDL_PrivateParseMappingSource(GamepadMapping_t *pGamepadMapping);
+static int SDL_PrivateAddGamepadMapping(const char *mappingString, SDL_bool static_string, SDL_GamepadMappingPriority priority);
 static void SDL_PrivateLoadButtonMapping(SDL_Gamepad *gamepad, GamepadMapping_t *pGamepadMapping);
 static GamepadMapping_t *SDL_PrivateGetGamepadMapping(SDL_JoystickID instance_id);
 static int SDL_SendGamepadAxis(Uint64 timestamp, SDL_Gamepad *gamepad, SDL_GamepadAxis axis, Sint16 value);
@@ -715,7 +729,7 @@ static GamepadMapping_t *SDL_CreateMappingForAndroidGamepad(SDL_JoystickGUID gui
         SDL_strlcat(mapping_string, "righttrigger:a5,", sizeof(mapping_string));
     }
 
-    return SDL_PrivateAddMappingForGUID(guid, mapping_string, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
+    return SDL_PrivateAddMappingForGUID(guid, mapping_string, SDL_FALSE, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
 }
 #endif /* __ANDROID__ */
 
@@ -859,7 +873,7 @@ static GamepadMapping_t *SDL_CreateMappingForHIDAPIGamepad(SDL_JoystickGUID guid
         }
     }
 
-    return SDL_PrivateAddMappingForGUID(guid, mapping_string, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
+    return SDL_PrivateAddMappingForGUID(guid, mapping_string, SDL_FALSE, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
 }
 
 /*
@@ -873,7 +887,7 @@ static GamepadMapping_t *SDL_CreateMappingForRAWINPUTGamepad(SDL_JoystickGUID gu
     SDL_strlcpy(mapping_string, "none,*,", sizeof(mapping_string));
     SDL_strlcat(mapping_string, "a:b0,b:b1,x:b2,y:b3,back:b6,guide:b10,start:b7,leftstick:b8,rightstick:b9,leftshoulder:b4,rightshoulder:b5,dpup:h0.1,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,leftx:a0,lefty:a1,rightx:a2,righty:a3,lefttrigger:a4,righttrigger:a5,", sizeof(mapping_string));
 
-    return SDL_PrivateAddMappingForGUID(guid, mapping_string, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
+    return SDL_PrivateAddMappingForGUID(guid, mapping_string, SDL_FALSE, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
 }
 
 /*
@@ -891,7 +905,25 @@ static GamepadMapping_t *SDL_CreateMappingForWGIGamepad(SDL_JoystickGUID guid)
     SDL_strlcpy(mapping_string, "none,*,", sizeof(mapping_string));
     SDL_strlcat(mapping_string, "a:b0,b:b1,x:b2,y:b3,back:b6,start:b7,leftstick:b8,rightstick:b9,leftshoulder:b4,rightshoulder:b5,dpup:b10,dpdown:b12,dpleft:b13,dpright:b11,leftx:a1,lefty:a0~,rightx:a3,righty:a2~,lefttrigger:a4,righttrigger:a5,", sizeof(mapping_string));
 
-    return SDL_PrivateAddMappingForGUID(guid, mapping_string, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
+    return SDL_PrivateAddMappingForGUID(guid, mapping_string, SDL_FALSE, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
+}
+
+/*
+ * Helper function to find the hash bucket for a GUID, ignoring the CRC and version
+ */
+static Uint32 SDL_PrivateHashGamepadGUID(SDL_JoystickGUID guid)
+{
+    Uint32 hash = 2166136261u;
+    size_t i;
+
+    SDL_SetJoystickGUIDCRC(&guid, 0);
+    SDL_SetJoystickGUIDVersion(&guid, 0);
+
+    for (i = 0; i < sizeof(guid.data); ++i) {
+        hash ^= guid.data[i];
+        hash *= 16777619u;
+    }
+    return hash & (SDL_GAMEPAD_MAPPING_HASH_SIZE - 1);
 }
 
 /*
@@ -915,7 +947,7 @@ static GamepadMapping_t *SDL_PrivateMatchGamepadMappingForGUID(SDL_JoystickGUID
         SDL_SetJoystickGUIDVersion(&guid, 0);
     }
 
-    for (mapping = s_pSupportedGamepads; mapping; mapping = mapping->next) {
+    for (mapping = s_pGamepadMappingHash[SDL_PrivateHashGamepadGUID(guid)]; mapping; mapping = mapping->hash_next) {
         SDL_JoystickGUID mapping_guid;
 
         if (SDL_memcmp(&mapping->guid, &s_zeroGUID, sizeof(mapping->guid)) == 0) {
@@ -928,14 +960,8 @@ static GamepadMapping_t *SDL_PrivateMatchGamepadMappingForGUID(SDL_JoystickGUID
         }
 
         if (SDL_memcmp(&guid, &mapping_guid, sizeof(guid)) == 0) {
-            Uint16 mapping_crc = 0;
+            const Uint16 mapping_crc = match_crc ? mapping->crc : 0;
 
-            if (match_crc) {
-                const char *crc_string = SDL_strstr(mapping->mapping, SDL_GAMEPAD_CRC_FIELD);
-                if (crc_string) {
-                    mapping_crc = (Uint16)SDL_strtol(crc_string + SDL_GAMEPAD_CRC_FIELD_SIZE, NULL, 16);
-                }
-            }
             if (crc == mapping_crc) {
                 return mapping;
             }
@@ -1312,13 +1338,19 @@ static void SDL_PrivateLoadButtonMapping(SDL_Gamepad *gamepad, GamepadMapping_t
 
     SDL_AssertJoysticksLocked();
 
-    gamepad->name = pGamepadMapping->name;
     gamepad->num_bindings = 0;
     gamepad->mapping = pGamepadMapping;
     if (gamepad->joystick->naxes != 0 && gamepad->last_match_axis != NULL) {
         SDL_memset(gamepad->last_match_axis, 0, gamepad->joystick->naxes * sizeof(*gamepad->last_match_axis));
     }
 
+    if (SDL_PrivateParseMappingSource(pGamepadMapping) < 0) {
+        /* Fall back to the joystick name and no bindings */
+        gamepad->name = "*";
+        return;
+    }
+    gamepad->name = pGamepadMapping->name;
+
     SDL_PrivateParseGamepadConfigString(gamepad, pGamepadMapping->mapping);
 
     /* Set the zero point for triggers */
@@ -1427,10 +1459,14 @@ static char *SDL_PrivateGetGamepadMappingFromMappingString(const char *pMapping)
     }
 
     result = SDL_strdup(pSecondComma + 1); /* mapping is everything after the 3rd comma */
+    if (result == NULL) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
 
     /* Trim whitespace */
     length = SDL_strlen(result);
-    while (SDL_isspace(result[length - 1])) {
+    while (length > 0 && SDL_isspace(result[length - 1])) {
         --length;
     }
     result[length] = '\0';
@@ -1439,39 +1475,103 @@ static char *SDL_PrivateGetGamepadMappingFromMappingString(const char *pMapping)
 }
 
 /*
- * Helper function to add a mapping for a guid
+ * Helper function to extract the name and mapping from a mapping string, if that hasn't been done yet
  */
-static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString, SDL_bool *existing, SDL_GamepadMappingPriority priority)
+static int SDL_PrivateParseMappingSource(GamepadMapping_t *pGamepadMapping)
 {
     char *pchName;
     char *pchMapping;
-    GamepadMapping_t *pGamepadMapping;
-    Uint16 crc;
 
     SDL_AssertJoysticksLocked();
 
-    pchName = SDL_PrivateGetGamepadNameFromMappingString(mappingString);
+    if (pGamepadMapping->source == NULL) {
+        return 0;
+    }
+
+    pchName = SDL_PrivateGetGamepadNameFromMappingString(pGamepadMapping->source);
     if (pchName == NULL) {
-        SDL_SetError("Couldn't parse name from %s", mappingString);
-        return NULL;
+        return -1;
     }
 
-    pchMapping = SDL_PrivateGetGamepadMappingFromMappingString(mappingString);
+    pchMapping = SDL_PrivateGetGamepadMappingFromMappingString(pGamepadMapping->source);
     if (pchMapping == NULL) {
         SDL_free(pchName);
-        SDL_SetError("Couldn't parse %s", mappingString);
+        return -1;
+    }
+
+    pGamepadMapping->name = pchName;
+    pGamepadMapping->mapping = pchMapping;
+    if (pGamepadMapping->free_source) {
+        SDL_free((void *)pGamepadMapping->source);
+    }
+    pGamepadMapping->source = NULL;
+    pGamepadMapping->free_source = SDL_FALSE;
+    return 0;
+}
+
+/*
+ * Helper function to release the strings held by a mapping
+ */
+static void SDL_PrivateFreeMappingStrings(GamepadMapping_t *pGamepadMapping)
+{
+    SDL_free(pGamepadMapping->name);
+    pGamepadMapping->name = NULL;
+    SDL_free(pGamepadMapping->mapping);
+    pGamepadMapping->mapping = NULL;
+    if (pGamepadMapping->free_source) {
+        SDL_free((void *)pGamepadMapping->source);
+    }
+    pGamepadMapping->source = NULL;
+    pGamepadMapping->free_source = SDL_FALSE;
+}
+
+/*
+ * Helper function to add a mapping for a guid
+ *
+ * If static_string is SDL_TRUE, mappingString stays valid until the mappings are freed and doesn't need to be copied.
+ */
+static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString, SDL_bool static_string, SDL_bool *existing, SDL_GamepadMappingPriority priority)
+{
+    GamepadMapping_t parsed;
+    GamepadMapping_t *pGamepadMapping;
+    const char *pFirstComma, *pSecondComma;
+    Uint16 crc;
+
+    SDL_AssertJoysticksLocked();
+
+    pFirstComma = SDL_strchr(mappingString, ',');
+    pSecondComma = pFirstComma ? SDL_strchr(pFirstComma + 1, ',') : NULL;
+    if (pSecondComma == NULL) {
+        SDL_SetError("Couldn't parse name from %s", mappingString);
         return NULL;
     }
 
+    SDL_zero(parsed);
+
     /* Fix up the GUID and the mapping with the CRC, if needed */
     SDL_GetJoystickGUIDInfo(jGUID, NULL, NULL, NULL, &crc);
     if (crc) {
-        /* Make sure the mapping has the CRC */
+        /* Make sure the mapping has the CRC, which means parsing it now */
         char *new_mapping;
         const char *optional_comma;
         size_t mapping_length;
         char *crc_end = "";
-        char *crc_string = SDL_strstr(pchMapping, SDL_GAMEPAD_CRC_FIELD);
+        char *crc_string;
+
+        parsed.name = SDL_PrivateGetGamepadNameFromMappingString(mappingString);
+        if (parsed.name == NULL) {
+            SDL_SetError("Couldn't parse name from %s", mappingString);
+            return NULL;
+        }
+
+        parsed.mapping = SDL_PrivateGetGamepadMappingFromMappingString(mappingString);
+        if (parsed.mapping == NULL) {
+            SDL_free(parsed.name);
+            SDL_SetError("Couldn't parse %s", mappingString);
+            return NULL;
+        }
+
+        crc_string = SDL_strstr(parsed.mapping, SDL_GAMEPAD_CRC_FIELD);
         if (crc_string) {
             crc_end = SDL_strchr(crc_string, ',');
             if (crc_end) {
@@ -1483,27 +1583,40 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, co
         }
 
         /* Make sure there's a comma before the CRC */
-        mapping_length = SDL_strlen(pchMapping);
-        if (mapping_length == 0 || pchMapping[mapping_length - 1] == ',') {
+        mapping_length = SDL_strlen(parsed.mapping);
+        if (mapping_length == 0 || parsed.mapping[mapping_length - 1] == ',') {
             optional_comma = "";
         } else {
             optional_comma = ",";
         }
 
-        if (SDL_asprintf(&new_mapping, "%s%s%s%.4x,%s", pchMapping, optional_comma, SDL_GAMEPAD_CRC_FIELD, crc, crc_end) >= 0) {
-            SDL_free(pchMapping);
-            pchMapping = new_mapping;
+        if (SDL_asprintf(&new_mapping, "%s%s%s%.4x,%s", parsed.mapping, optional_comma, SDL_GAMEPAD_CRC_FIELD, crc, crc_end) >= 0) {
+            SDL_free(parsed.mapping);
+            parsed.mapping = new_mapping;
         }
     } else {
         /* Make sure the GUID has the CRC, for matching purposes */
-        char *crc_string = SDL_strstr(pchMapping, SDL_GAMEPAD_CRC_FIELD);
+        const char *crc_string = SDL_strstr(pSecondComma, SDL_GAMEPAD_CRC_FIELD);
         if (crc_string) {
             crc = (Uint16)SDL_strtol(crc_string + SDL_GAMEPAD_CRC_FIELD_SIZE, NULL, 16);
             if (crc) {
                 SDL_SetJoystickGUIDCRC(&jGUID, crc);
             }
         }
+
+        /* The name and mapping will be extracted when they're first used */
+        if (static_string) {
+            parsed.source = mappingString;
+        } else {
+            parsed.source = SDL_strdup(mappingString);
+            if (parsed.source == NULL) {
+                SDL_OutOfMemory();
+                return NULL;
+            }
+            parsed.free_source = SDL_TRUE;
+        }
     }
+    parsed.crc = crc;
 
     PushMappingChangeTracking();
 
@@ -1512,25 +1625,27 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, co
         /* Only overwrite the mapping if the priority is the same or higher. */
         if (pGamepadMapping->priority <= priority) {
             /* Update existing mapping */
-            SDL_free(pGamepadMapping->name);
-            pGamepadMapping->name = pchName;
-            SDL_free(pGamepadMapping->mapping);
-            pGamepadMapping->mapping = pchMapping;
+            SDL_PrivateFreeMappingStrings(pGamepadMapping);
+            pGamepadMapping->crc = parsed.crc;
+            pGamepadMapping->source = parsed.source;
+            pGamepadMapping->free_source = parsed.free_source;
+            pGamepadMapping->name = parsed.name;
+            pGamepadMapping->mapping = parsed.mapping;
             pGamepadMapping->priority = priority;
         } else {
-            SDL_free(pchName);
-            SDL_free(pchMapping);
+            SDL_PrivateFreeMappingStrings(&parsed);
         }
         if (existing) {
             *existing = SDL_TRUE;
         }
         AddMappingChangeTracking(pGamepadMapping);
     } else {
+        GamepadMapping_t **pBucket;
+
         pGamepadMapping = SDL_malloc(sizeof(*pGamepadMapping));
         if (pGamepadMapping == NULL) {
             PopMappingChangeTracking();
-            SDL_free(pchName);
-            SDL_free(pchMapping);
+            SDL_PrivateFreeMappingStrings(&parsed);
             SDL_OutOfMemory();
             return NULL;
         }
@@ -1538,25 +1653,24 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, co
         if (crc) {
             SDL_SetJoystickGUIDCRC(&jGUID, 0);
         }
+        *pGamepadMapping = parsed;
         pGamepadMapping->guid = jGUID;
-        pGamepadMapping->name = pchName;
-        pGamepadMapping->mapping = pchMapping;
-        pGamepadMapping->next = NULL;
         pGamepadMapping->priority = priority;
 
-        if (s_pSupportedGamepads) {
-            /* Add the mapping to the end of the list */
-            GamepadMapping_t *pCurrMapping, *pPrevMapping;
-
-            for (pPrevMapping = s_pSupportedGamepads, pCurrMapping = pPrevMapping->next;
-                 pCurrMapping;
-                 pPrevMapping = pCurrMapping, pCurrMapping = pCurrMapping->next) {
-                /* continue; */
-            }
-            pPrevMapping->next = pGamepadMapping;
+        /* Add the mapping to the end of the list and of its hash bucket, earlier mappings take precedence */
+        if (s_pSupportedGamepadsTail) {
+            s_pSupportedGamepadsTail->next = pGamepadMapping;
         } else {
             s_pSupportedGamepads = pGamepadMapping;
         }
+        s_pSupportedGamepadsTail = pGamepadMapping;
+
+        pBucket = &s_pGamepadMappingHash[SDL_PrivateHashGamepadGUID(jGUID)];
+        while (*pBucket) {
+            pBucket = &(*pBucket)->hash_next;
+        }
+        *pBucket = pGamepadMapping;
+
         if (existing) {
             *existing = SDL_FALSE;
         }
@@ -1584,7 +1698,7 @@ static GamepadMapping_t *SDL_PrivateGetGamepadMappingForNameAndGUID(const char *
             SDL_bool existing;
             mapping = SDL_PrivateAddMappingForGUID(guid,
                                                    "none,X360 Wireless Controller,a:b0,b:b1,back:b6,dpdown:b14,dpleft:b11,dpright:b12,dpup:b13,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,",
-                                                   &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
+                                                   SDL_TRUE, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
         }
     }
 #endif /* __LINUX__ */
@@ -1673,7 +1787,7 @@ static GamepadMapping_t *SDL_PrivateGenerateAutomaticGamepadMapping(const char *
     SDL_PrivateAppendToMappingString(mapping, sizeof(mapping), "lefttrigger", &raw_map->lefttrigger);
     SDL_PrivateAppendToMappingString(mapping, sizeof(mapping), "righttrigger", &raw_map->righttrigger);
 
-    return SDL_PrivateAddMappingForGUID(guid, mapping, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
+    return SDL_PrivateAddMappingForGUID(guid, mapping, SDL_FALSE, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
 }
 
 static GamepadMapping_t *SDL_PrivateGetGamepadMapping(SDL_JoystickID instance_id)
@@ -1716,6 +1830,8 @@ int SDL_AddGamepadMappingsFromRW(SDL_RWops *src, SDL_bool freesrc)
     }
     line = buf;
 
+    SDL_LockJoysticks();
+
     PushMappingChangeTracking();
 
     while (line < buf + db_size) {
@@ -1736,7 +1852,7 @@ int SDL_AddGamepadMappingsFromRW(SDL_RWops *src, SDL_bool freesrc)
                 if (platform_len + 1 < SDL_arraysize(line_platform)) {
                     SDL_strlcpy(line_platform, tmp, platform_len);
                     if (SDL_strncasecmp(line_platform, platform, platform_len) == 0 &&
-                        SDL_AddGamepadMapping(line) > 0) {
+                        SDL_PrivateAddGamepadMapping(line, SDL_FALSE, SDL_GAMEPAD_MAPPING_PRIORITY_API) > 0) {
                         gamepads++;
                     }
                 }
@@ -1748,6 +1864,8 @@ int SDL_AddGamepadMappingsFromRW(SDL_RWops *src, SDL_bool freesrc)
 
     PopMappingChangeTracking();
 
+    SDL_UnlockJoysticks();
+
     SDL_free(buf);
     return gamepads;
 }
@@ -1782,7 +1900,7 @@ int SDL_ReloadGamepadMappings(void)
 /*
  * Add or update an entry into the Mappings Database with a priority
  */
-static int SDL_PrivateAddGamepadMapping(const char *mappingString, SDL_GamepadMappingPriority priority)
+static int SDL_PrivateAddGamepadMapping(const char *mappingString, SDL_bool static_string, SDL_GamepadMappingPriority priority)
 {
     char *pchGUID;
     SDL_JoystickGUID jGUID;
@@ -1871,7 +1989,7 @@ static int SDL_PrivateAddGamepadMapping(const char *mappingString, SDL_GamepadMa
     jGUID = SDL_GetJoystickGUIDFromString(pchGUID);
     SDL_free(pchGUID);
 
-    pGamepadMapping = SDL_PrivateAddMappingForGUID(jGUID, mappingString, &existing, priority);
+    pGamepadMapping = SDL_PrivateAddMappingForGUID(jGUID, mappingString, static_string, &existing, priority);
     if (pGamepadMapping == NULL) {
         return -1;
     }
@@ -1897,7 +2015,7 @@ int SDL_AddGamepadMapping(const char *mapping)
 
     SDL_LockJoysticks();
     {
-        retval = SDL_PrivateAddGamepadMapping(mapping, SDL_GAMEPAD_MAPPING_PRIORITY_API);
+        retval = SDL_PrivateAddGamepadMapping(mapping, SDL_FALSE, SDL_GAMEPAD_MAPPING_PRIORITY_API);
     }
     SDL_UnlockJoysticks();
 
@@ -1940,6 +2058,10 @@ static char *CreateMappingString(GamepadMapping_t *mapping, SDL_JoystickGUID gui
 
     SDL_AssertJoysticksLocked();
 
+    if (SDL_PrivateParseMappingSource(mapping) < 0) {
+        return NULL;
+    }
+
     SDL_GetJoystickGUIDString(guid, pchGUID, sizeof(pchGUID));
 
     /* allocate enough memory for GUID + ',' + name + ',' + mapping + \0 */
@@ -2071,7 +2193,7 @@ int SDL_SetGamepadMapping(SDL_JoystickID instance_id, const char *mapping)
 
     SDL_LockJoysticks();
     {
-        if (SDL_PrivateAddMappingForGUID(guid, mapping, NULL, SDL_GAMEPAD_MAPPING_PRIORITY_API)) {
+        if (SDL_PrivateAddMappingForGUID(guid, mapping, SDL_FALSE, NULL, SDL_GAMEPAD_MAPPING_PRIORITY_API)) {
             retval = 0;
         }
     }
@@ -2097,7 +2219,7 @@ static void SDL_LoadGamepadHints(void)
                 *pchNewLine = '\0';
             }
 
-            SDL_PrivateAddGamepadMapping(pUserMappings, SDL_GAMEPAD_MAPPING_PRIORITY_USER);
+            SDL_PrivateAddGamepadMapping(pUserMappings, SDL_FALSE, SDL_GAMEPAD_MAPPING_PRIORITY_USER);
 
             if (pchNewLine) {
                 pUserMappings = pchNewLine + 1;
@@ -2146,7 +2268,7 @@ int SDL_InitGamepadMappings(void)
 
     pMappingString = s_GamepadMappings[i];
     while (pMappingString) {
-        SDL_PrivateAddGamepadMapping(pMappingString, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
+        SDL_PrivateAddGamepadMapping(pMappingString, SDL_TRUE, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
 
         i++;
         pMappingString = s_GamepadMappings[i];
@@ -2221,7 +2343,7 @@ const char *SDL_GetGamepadInstanceName(SDL_JoystickID instance_id)
     SDL_LockJoysticks();
     {
         GamepadMapping_t *mapping = SDL_PrivateGetGamepadMapping(instance_id);
-        if (mapping != NULL) {
+        if (mapping != NULL && SDL_PrivateParseMappingSource(mapping) == 0) {
             if (SDL_strcmp(mapping->name, "*") == 0) {
                 retval = SDL_GetJoystickInstanceName(instance_id);
             } else {
@@ -2271,7 +2393,7 @@ SDL_GamepadType SDL_GetGamepadInstanceType(SDL_JoystickID instance_id)
     SDL_LockJoysticks();
     {
         GamepadMapping_t *mapping = SDL_PrivateGetGamepadMapping(instance_id);
-        if (mapping != NULL) {
+        if (mapping != NULL && SDL_PrivateParseMappingSource(mapping) == 0) {
             char *type_string, *comma;
 
             type_string = SDL_strstr(mapping->mapping, SDL_GAMEPAD_TYPE_FIELD);
@@ -2307,7 +2429,7 @@ char *SDL_GetGamepadInstanceMapping(SDL_JoystickID instance_id)
     SDL_LockJoysticks();
     {
         GamepadMapping_t *mapping = SDL_PrivateGetGamepadMapping(instance_id);
-        if (mapping != NULL) {
+        if (mapping != NULL && SDL_PrivateParseMappingSource(mapping) == 0) {
             SDL_JoystickGUID guid;
             char pchGUID[33];
             size_t needed;
@@ -2468,6 +2590,10 @@ SDL_Gamepad *SDL_OpenGamepad(SDL_JoystickID instance_id)
         SDL_UnlockJoysticks();
         return NULL;
     }
+    if (SDL_PrivateParseMappingSource(pSupportedGamepad) < 0) {
+        SDL_UnlockJoysticks();
+        return NULL;
+    }
 
     /* Create and initialize the gamepad */
     gamepad = (SDL_Gamepad *)SDL_calloc(1, sizeof(*gamepad));
@@ -3328,10 +3454,11 @@ void SDL_QuitGamepadMappings(void)
     while (s_pSupportedGamepads) {
         pGamepadMap = s_pSupportedGamepads;
         s_pSupportedGamepads = s_pSupportedGamepads->next;
-        SDL_free(pGamepadMap->name);
-        SDL_free(pGamepadMap->mapping);
+        SDL_PrivateFreeMappingStrings(pGamepadMap);
         SDL_free(pGamepadMap);
     }
+    s_pSupportedGamepadsTail = NULL;
+    SDL_zeroa(s_pGamepadMappingHash);
 
     SDL_DelHintCallback(SDL_HINT_GAMECONTROLLER_IGNORE_DEVICES,
                         SDL_GamepadIgnoreDevicesChanged, NULL);
@@ -111,6 +111,8 @@ static
 #endif
 SDL_Mutex *SDL_joystick_lock = NULL; /* This needs to support recursive locks */
 static SDL_AtomicInt SDL_joystick_lock_pending;
+static SDL_AtomicInt SDL_joystick_lock_waiters;
+static SDL_Semaphore *SDL_joystick_lock_released = NULL;
 static int SDL_joysticks_locked;
 static SDL_bool SDL_joysticks_initialized;
 static SDL_bool SDL_joysticks_quitting;
@@ -148,12 +150,44 @@ void SDL_LockJoysticks(void)
     ++SDL_joysticks_locked;
 }
 
+int SDL_WaitLockJoysticks(SDL_AtomicInt *cancel)
+{
+    int retval = 0;
+
+    /* Unlocking posts the semaphore while anyone is waiting here, so count
+       ourselves before trying the lock to make sure we can't miss it */
+    (void)SDL_AtomicIncRef(&SDL_joystick_lock_waiters);
+    while (SDL_TryLockMutex(SDL_joystick_lock) != 0) {
+        if (SDL_AtomicGet(cancel)) {
+            retval = -1;
+            break;
+        }
+        SDL_WaitSemaphore(SDL_joystick_lock_released);
+    }
+    (void)SDL_AtomicDecRef(&SDL_joystick_lock_waiters);
+
+    if (retval == 0) {
+        ++SDL_joysticks_locked;
+    }
+    return retval;
+}
+
+void SDL_WakeJoystickLockWaiters(void)
+{
+    if (SDL_joystick_lock_released) {
+        SDL_PostSemaphore(SDL_joystick_lock_released);
+    }
+}
+
 void SDL_UnlockJoysticks(void)
 {
     SDL_bool last_unlock = SDL_FALSE;
+    SDL_bool wake_waiters;
 
     --SDL_joysticks_locked;
 
+    wake_waiters = (!SDL_joysticks_locked && SDL_AtomicGet(&SDL_joystick_lock_waiters) > 0) ? SDL_TRUE : SDL_FALSE;
+
     if (!SDL_joysticks_initialized) {
         /* NOTE: There's a small window here where another thread could lock the mutex after we've checked for pending locks */
         if (!SDL_joysticks_locked && SDL_AtomicGet(&SDL_joystick_lock_pending) == 0) {
@@ -178,6 +212,10 @@ void SDL_UnlockJoysticks(void)
     } else {
         SDL_UnlockMutex(SDL_joystick_lock);
     }
+
+    if (wake_waiters) {
+        SDL_WakeJoystickLockWaiters();
+    }
 }
 
 SDL_bool SDL_JoysticksLocked(void)
@@ -322,6 +360,9 @@ int SDL_InitJoysticks(void)
     if (SDL_joystick_lock == NULL) {
         SDL_joystick_lock = SDL_CreateMutex();
     }
+    if (SDL_joystick_lock_released == NULL) {
+        SDL_joystick_lock_released = SDL_CreateSemaphore(0);
+    }
 
 #ifndef SDL_EVENTS_DISABLED
     if (SDL_InitSubSystem(SDL_INIT_EVENTS) < 0) {
@@ -723,6 +764,59 @@ static void CleanupSensorFusion(SDL_Joystick *joystick)
     }
 }
 
+/* The state snapshot is protected by a sequence lock, readers retry if the
+ * sequence was odd or changed while they were copying the snapshot.
+ */
+static void SDL_BeginJoystickStateUpdate(SDL_Joystick *joystick)
+{
+    SDL_AtomicAdd(&joystick->state_sequence, 1);
+    SDL_MemoryBarrierRelease();
+}
+
+static void SDL_EndJoystickStateUpdate(SDL_Joystick *joystick, Uint64 timestamp)
+{
+    joystick->state.timestamp = timestamp;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicAdd(&joystick->state_sequence, 1);
+}
+
+/* Touchpad fingers are stored one touchpad after another in the snapshot */
+static SDL_JoystickStateFinger *SDL_GetJoystickStateFinger(SDL_Joystick *joystick, int touchpad, int finger)
+{
+    int i, index = finger;
+
+    for (i = 0; i < touchpad; ++i) {
+        index += joystick->touchpads[i].nfingers;
+    }
+    if (index >= joystick->state.num_fingers) {
+        return NULL;
+    }
+    return &joystick->state.fingers[index];
+}
+
+static void SDL_InitJoystickState(SDL_Joystick *joystick)
+{
+    SDL_JoystickState *state = &joystick->state;
+    int i, j;
+
+    SDL_zerop(state);
+    state->num_axes = SDL_min(joystick->naxes, SDL_JOYSTICK_STATE_MAX_AXES);
+    state->num_buttons = SDL_min(joystick->nbuttons, SDL_JOYSTICK_STATE_MAX_BUTTONS);
+    state->num_hats = SDL_min(joystick->nhats, SDL_JOYSTICK_STATE_MAX_HATS);
+    for (i = 0; i < joystick->ntouchpads; ++i) {
+        for (j = 0; j < joystick->touchpads[i].nfingers && state->num_fingers < SDL_JOYSTICK_STATE_MAX_FINGERS; ++j) {
+            SDL_JoystickStateFinger *finger = &state->fingers[state->num_fingers++];
+
+            finger->touchpad = (Uint8)i;
+            finger->finger = (Uint8)j;
+        }
+    }
+    state->num_sensors = SDL_min(joystick->nsensors, SDL_JOYSTICK_STATE_MAX_SENSORS);
+    for (i = 0; i < state->num_sensors; ++i) {
+        state->sensors[i].type = joystick->sensors[i].type;
+    }
+}
+
 /*
  * Open a joystick for use - the index passed as an argument refers to
  * the N'th joystick on the system.  This index is the value which will
@@ -771,6 +865,7 @@ SDL_Joystick *SDL_OpenJoystick(SDL_JoystickID instance_id)
     }
     joystick->magic = &SDL_joystick_magic;
     joystick->driver = driver;
+    joystick->input_stats = &joystick->own_input_stats;
     joystick->instance_id = instance_id;
     joystick->attached = SDL_TRUE;
     joystick->epowerlevel = SDL_JOYSTICK_POWER_UNKNOWN;
@@ -830,6 +925,8 @@ SDL_Joystick *SDL_OpenJoystick(SDL_JoystickID instance_id)
         AttemptSensorFusion(joystick, invert_sensors);
     }
 
+    SDL_InitJoystickState(joystick);
+
     /* Add joystick to list */
     ++joystick->ref_count;
     /* Link the joystick in the list */
@@ -1140,6 +1237,35 @@ Uint8 SDL_GetJoystickButton(SDL_Joystick *joystick, int button)
     return state;
 }
 
+int SDL_GetJoystickState(SDL_Joystick *joystick, SDL_JoystickState *state)
+{
+    int sequence;
+
+    /* This doesn't take the joystick lock, the caller must keep the joystick open until this returns */
+    if (!joystick || joystick->magic != &SDL_joystick_magic) {
+        return SDL_InvalidParamError("joystick");
+    }
+    if (!state) {
+        return SDL_InvalidParamError("state");
+    }
+
+    for (;;) {
+        sequence = SDL_AtomicGet(&joystick->state_sequence);
+        if (sequence & 1) {
+            /* The joystick state is being updated */
+            SDL_CPUPauseInstruction();
+            continue;
+        }
+        SDL_MemoryBarrierAcquire();
+        SDL_memcpy(state, &joystick->state, sizeof(*state));
+        SDL_MemoryBarrierAcquire();
+        if (SDL_AtomicGet(&joystick->state_sequence) == sequence) {
+            break;
+        }
+    }
+    return 0;
+}
+
 /*
  * Return if the joystick in question is currently attached to the system,
  *  \return SDL_FALSE if not plugged in, SDL_TRUE if still present.
@@ -1539,6 +1665,10 @@ void SDL_QuitJoysticks(void)
         SDL_joystick_drivers[i]->Quit();
     }
 
+    /* Nothing waits for the lock once the drivers are gone */
+    SDL_DestroySemaphore(SDL_joystick_lock_released);
+    SDL_joystick_lock_released = NULL;
+
     if (SDL_joystick_players) {
         SDL_free(SDL_joystick_players);
         SDL_joystick_players = NULL;
@@ -1746,7 +1876,7 @@ void SDL_PrivateJoystickRemoved(SDL_JoystickID instance_id)
     }
 }
 
-int SDL_SendJoystickAxis(Uint64 timestamp, SDL_Joystick *joystick, Uint8 axis, Sint16 value)
+static int SDL_PrivateSendJoystickAxis(Uint64 timestamp, SDL_Joystick *joystick, Uint8 axis, Sint16 value)
 {
     int posted;
     SDL_JoystickAxisInfo *info;
@@ -1765,6 +1895,12 @@ int SDL_SendJoystickAxis(Uint64 timestamp, SDL_Joystick *joystick, Uint8 axis, S
         info->value = value;
         info->zero = value;
         info->has_initial_value = SDL_TRUE;
+
+        if (axis < joystick->state.num_axes) {
+            SDL_BeginJoystickStateUpdate(joystick);
+            joystick->state.axes[axis] = value;
+            SDL_EndJoystickStateUpdate(joystick, timestamp);
+        }
     } else if (value == info->value && !info->sending_initial_value) {
         return 0;
     } else {
@@ -1779,7 +1915,7 @@ int SDL_SendJoystickAxis(Uint64 timestamp, SDL_Joystick *joystick, Uint8 axis, S
         }
         info->sent_initial_value = SDL_TRUE;
         info->sending_initial_value = SDL_TRUE;
-        SDL_SendJoystickAxis(timestamp, joystick, axis, info->initial_value);
+        SDL_PrivateSendJoystickAxis(timestamp, joystick, axis, info->initial_value);
         info->sending_initial_value = SDL_FALSE;
     }
 
@@ -1798,6 +1934,13 @@ int SDL_SendJoystickAxis(Uint64 timestamp, SDL_Joystick *joystick, Uint8 axis, S
     SDL_assert(timestamp != 0);
     info->value = value;
     joystick->update_complete = timestamp;
+    ++joystick->input_stats->events_sent;
+
+    if (axis < joystick->state.num_axes) {
+        SDL_BeginJoystickStateUpdate(joystick);
+        joystick->state.axes[axis] = value;
+        SDL_EndJoystickStateUpdate(joystick, timestamp);
+    }
 
     /* Post the event, if desired */
     posted = 0;
@@ -1815,6 +1958,56 @@ int SDL_SendJoystickAxis(Uint64 timestamp, SDL_Joystick *joystick, Uint8 axis, S
     return posted;
 }
 
+/* Send the final position of the axes that moved during the input batch */
+static void SDL_FlushJoystickAxes(SDL_Joystick *joystick)
+{
+    int i;
+
+    joystick->axes_pending = SDL_FALSE;
+
+    for (i = 0; i < joystick->naxes; ++i) {
+        SDL_JoystickAxisInfo *info = &joystick->axes[i];
+
+        if (info->has_pending_value) {
+            info->has_pending_value = SDL_FALSE;
+            SDL_PrivateSendJoystickAxis(info->pending_timestamp, joystick, (Uint8)i, info->pending_value);
+        }
+    }
+}
+
+int SDL_SendJoystickAxis(Uint64 timestamp, SDL_Joystick *joystick, Uint8 axis, Sint16 value)
+{
+    SDL_AssertJoysticksLocked();
+
+    if (joystick->batching && axis < joystick->naxes) {
+        SDL_JoystickAxisInfo *info = &joystick->axes[axis];
+
+        info->has_pending_value = SDL_TRUE;
+        info->pending_value = value;
+        info->pending_timestamp = timestamp;
+        joystick->axes_pending = SDL_TRUE;
+        return 0;
+    }
+    return SDL_PrivateSendJoystickAxis(timestamp, joystick, axis, value);
+}
+
+void SDL_BeginJoystickBatch(SDL_Joystick *joystick)
+{
+    SDL_AssertJoysticksLocked();
+
+    joystick->batching = SDL_TRUE;
+}
+
+void SDL_EndJoystickBatch(SDL_Joystick *joystick)
+{
+    SDL_AssertJoysticksLocked();
+
+    if (joystick->axes_pending) {
+        SDL_FlushJoystickAxes(joystick);
+    }
+    joystick->batching = SDL_FALSE;
+}
+
 int SDL_SendJoystickHat(Uint64 timestamp, SDL_Joystick *joystick, Uint8 hat, Uint8 value)
 {
     int posted;
@@ -1838,10 +2031,22 @@ int SDL_SendJoystickHat(Uint64 timestamp, SDL_Joystick *joystick, Uint8 hat, Uin
         }
     }
 
+    /* Keep the axis motion before this change in order */
+    if (joystick->axes_pending) {
+        SDL_FlushJoystickAxes(joystick);
+    }
+
     /* Update internal joystick state */
     SDL_assert(timestamp != 0);
     joystick->hats[hat] = value;
     joystick->update_complete = timestamp;
+    ++joystick->input_stats->events_sent;
+
+    if (hat < joystick->state.num_hats) {
+        SDL_BeginJoystickStateUpdate(joystick);
+        joystick->state.hats[hat] = value;
+        SDL_EndJoystickStateUpdate(joystick, timestamp);
+    }
 
     /* Post the event, if desired */
     posted = 0;
@@ -1898,10 +2103,22 @@ int SDL_SendJoystickButton(Uint64 timestamp, SDL_Joystick *joystick, Uint8 butto
         }
     }
 
+    /* Keep the axis motion before this change in order */
+    if (joystick->axes_pending) {
+        SDL_FlushJoystickAxes(joystick);
+    }
+
     /* Update internal joystick state */
     SDL_assert(timestamp != 0);
     joystick->buttons[button] = state;
     joystick->update_complete = timestamp;
+    ++joystick->input_stats->events_sent;
+
+    if (button < joystick->state.num_buttons) {
+        SDL_BeginJoystickStateUpdate(joystick);
+        joystick->state.buttons[button] = state;
+        SDL_EndJoystickStateUpdate(joystick, timestamp);
+    }
 
     /* Post the event, if desired */
     posted = 0;
@@ -3174,10 +3391,51 @@ SDL_JoystickPowerLevel SDL_GetJoystickPowerLevel(SDL_Joystick *joystick)
     return retval;
 }
 
+int SDL_GetJoystickInputStats(SDL_Joystick *joystick, Uint64 *reports, Uint64 *events)
+{
+    SDL_LockJoysticks();
+    {
+        CHECK_JOYSTICK_MAGIC(joystick, -1);
+
+        if (reports) {
+            *reports = joystick->input_stats->reports_read;
+        }
+        if (events) {
+            *events = joystick->input_stats->events_sent;
+        }
+    }
+    SDL_UnlockJoysticks();
+
+    return 0;
+}
+
+int SDL_GetJoystickRumbleStats(SDL_Joystick *joystick, int *pending, Uint64 *sent, Uint64 *coalesced, Uint64 *average_latency_ns, Uint64 *max_latency_ns)
+{
+    int retval;
+
+    SDL_LockJoysticks();
+    {
+        CHECK_JOYSTICK_MAGIC(joystick, -1);
+
+#ifdef SDL_JOYSTICK_HIDAPI
+        if (joystick->driver == &SDL_HIDAPI_JoystickDriver) {
+            retval = HIDAPI_GetJoystickRumbleStats(joystick, pending, sent, coalesced, average_latency_ns, max_latency_ns);
+        } else
+#endif
+        {
+            retval = SDL_Unsupported();
+        }
+    }
+    SDL_UnlockJoysticks();
+
+    return retval;
+}
+
 int SDL_SendJoystickTouchpad(Uint64 timestamp, SDL_Joystick *joystick, int touchpad, int finger, Uint8 state, float x, float y, float pressure)
 {
     SDL_JoystickTouchpadInfo *touchpad_info;
     SDL_JoystickTouchpadFingerInfo *finger_info;
+    SDL_JoystickStateFinger *state_finger;
     int posted;
     Uint32 event_type;
 
@@ -3240,6 +3498,11 @@ int SDL_SendJoystickTouchpad(Uint64 timestamp, SDL_Joystick *joystick, int touch
         }
     }
 
+    /* Keep the axis motion before this change in order */
+    if (joystick->axes_pending) {
+        SDL_FlushJoystickAxes(joystick);
+    }
+
     /* Update internal joystick state */
     SDL_assert(timestamp != 0);
     finger_info->state = state;
@@ -3247,6 +3510,17 @@ int SDL_SendJoystickTouchpad(Uint64 timestamp, SDL_Joystick *joystick, int touch
     finger_info->y = y;
     finger_info->pressure = pressure;
     joystick->update_complete = timestamp;
+    ++joystick->input_stats->events_sent;
+
+    state_finger = SDL_GetJoystickStateFinger(joystick, touchpad, finger);
+    if (state_finger) {
+        SDL_BeginJoystickStateUpdate(joystick);
+        state_finger->state = state;
+        state_finger->x = x;
+        state_finger->y = y;
+        state_finger->pressure = pressure;
+        SDL_EndJoystickStateUpdate(joystick, timestamp);
+    }
 
     /* Post the event, if desired */
     posted = 0;
@@ -3286,9 +3560,22 @@ int SDL_SendJoystickSensor(Uint64 timestamp, SDL_Joystick *joystick, SDL_SensorT
             if (sensor->enabled) {
                 num_values = SDL_min(num_values, SDL_arraysize(sensor->data));
 
+                /* Keep the axis motion before this change in order */
+                if (joystick->axes_pending) {
+                    SDL_FlushJoystickAxes(joystick);
+                }
+
                 /* Update internal sensor state */
                 SDL_memcpy(sensor->data, data, num_values * sizeof(*data));
                 joystick->update_complete = timestamp;
+                ++joystick->input_stats->events_sent;
+
+                if (i < joystick->state.num_sensors) {
+                    SDL_BeginJoystickStateUpdate(joystick);
+                    SDL_memcpy(joystick->state.sensors[i].data, data, num_values * sizeof(*data));
+                    joystick->state.sensors[i].sensor_timestamp = sensor_timestamp;
+                    SDL_EndJoystickStateUpdate(joystick, timestamp);
+                }
 
                 /* Post the event, if desired */
 #ifndef SDL_EVENTS_DISABLED
@@ -47,6 +47,13 @@ extern SDL_bool SDL_JoysticksQuitting(void);
 /* Return whether the joysticks are currently locked */
 extern SDL_bool SDL_JoysticksLocked(void);
 
+/* Lock the joysticks, sleeping until other threads unlock them, returns 0 on
+   success or -1 without taking the lock if cancel is set while waiting */
+extern int SDL_WaitLockJoysticks(SDL_AtomicInt *cancel) SDL_TRY_ACQUIRE(0, SDL_joystick_lock);
+
+/* Wake up threads in SDL_WaitLockJoysticks() so they check their cancel flag */
+extern void SDL_WakeJoystickLockWaiters(void);
+
 /* Make sure we currently have the joysticks locked */
 extern void SDL_AssertJoysticksLocked(void) SDL_ASSERT_CAPABILITY(SDL_joystick_lock);
 
@@ -161,6 +168,10 @@ extern int SDL_SendJoystickSensor(Uint64 timestamp, SDL_Joystick *joystick,
 extern void SDL_SendJoystickBatteryLevel(SDL_Joystick *joystick,
                                             SDL_JoystickPowerLevel ePowerLevel);
 
+/* Functions to coalesce axis motion while a driver processes a batch of input reports */
+extern void SDL_BeginJoystickBatch(SDL_Joystick *joystick);
+extern void SDL_EndJoystickBatch(SDL_Joystick *joystick);
+
 /* Internal sanity checking functions */
 extern SDL_bool SDL_IsJoystickValid(SDL_Joystick *joystick);
 
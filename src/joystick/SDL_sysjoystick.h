@@ -41,8 +41,17 @@ typedef struct SDL_JoystickAxisInfo
     SDL_bool has_second_value;      /* Whether we've seen a second value on the axis yet */
     SDL_bool sent_initial_value;    /* Whether we've sent the initial axis value */
     SDL_bool sending_initial_value; /* Whether we are sending the initial axis value */
+    SDL_bool has_pending_value;     /* Whether a value is waiting for the end of the input batch */
+    Sint16 pending_value;           /* Latest axis state in the input batch */
+    Uint64 pending_timestamp;       /* Timestamp of the latest axis state in the input batch */
 } SDL_JoystickAxisInfo;
 
+typedef struct SDL_JoystickInputStats
+{
+    Uint64 reports_read; /* Number of input reports read from the device */
+    Uint64 events_sent;  /* Number of input state changes sent */
+} SDL_JoystickInputStats;
+
 typedef struct SDL_JoystickTouchpadFingerInfo
 {
     Uint8 state;
@@ -121,6 +130,14 @@ struct SDL_Joystick
 
     Uint64 update_complete _guarded;
 
+    SDL_bool batching _guarded;     /* SDL_TRUE while the driver processes a batch of input reports */
+    SDL_bool axes_pending _guarded; /* SDL_TRUE if axis motion is waiting for the end of the batch */
+    SDL_JoystickInputStats *input_stats _guarded; /* Counters for the device, shared by all its joysticks */
+    SDL_JoystickInputStats own_input_stats _guarded; /* Counters used when the driver doesn't share them */
+
+    SDL_AtomicInt state_sequence; /* Odd while the state snapshot is being updated */
+    SDL_JoystickState state;      /* Snapshot of the joystick state, read without the joystick lock */
+
     struct SDL_JoystickDriver *driver _guarded;
 
     struct joystick_hwdata *hwdata _guarded; /* Driver dependent information */
@@ -169,7 +169,7 @@ static SDL_bool HIDAPI_DriverGameCube_InitDevice(SDL_HIDAPI_Device *device)
         SDL_Delay(10);
 
         /* Add all the applicable joysticks */
-        while ((size = SDL_hid_read_timeout(device->dev, packet, sizeof(packet), 0)) > 0) {
+        while ((size = HIDAPI_ReadDeviceReport(device, packet, sizeof(packet))) > 0) {
 #ifdef DEBUG_GAMECUBE_PROTOCOL
             HIDAPI_DumpPacket("Nintendo GameCube packet: size = %d", packet, size);
 #endif
@@ -384,7 +384,7 @@ static SDL_bool HIDAPI_DriverGameCube_UpdateDevice(SDL_HIDAPI_Device *device)
     int size;
 
     /* Read input packet */
-    while ((size = SDL_hid_read_timeout(device->dev, packet, sizeof(packet), 0)) > 0) {
+    while ((size = HIDAPI_ReadDeviceReport(device, packet, sizeof(packet))) > 0) {
 #ifdef DEBUG_GAMECUBE_PROTOCOL
         // HIDAPI_DumpPacket("Nintendo GameCube packet: size = %d", packet, size);
 #endif
@@ -35,18 +35,26 @@ typedef struct SDL_HIDAPI_RumbleRequest
     int size;
     SDL_HIDAPI_RumbleSentCallback callback;
     void *userdata;
+    Uint64 queued;
     struct SDL_HIDAPI_RumbleRequest *prev;
 
 } SDL_HIDAPI_RumbleRequest;
 
+/* Requests are added at the head and sent from the tail */
+typedef struct SDL_HIDAPI_RumbleQueue
+{
+    SDL_HIDAPI_RumbleRequest *head;
+    SDL_HIDAPI_RumbleRequest *tail;
+} SDL_HIDAPI_RumbleQueue;
+
 typedef struct SDL_HIDAPI_RumbleContext
 {
     SDL_AtomicInt initialized;
     SDL_AtomicInt running;
     SDL_Thread *thread;
     SDL_Semaphore *request_sem;
-    SDL_HIDAPI_RumbleRequest *requests_head;
-    SDL_HIDAPI_RumbleRequest *requests_tail;
+    SDL_HIDAPI_RumbleQueue priority_requests; /* Requests to stop rumbling and the requests queued before them for the same device, sent first */
+    SDL_HIDAPI_RumbleQueue requests;
 } SDL_HIDAPI_RumbleContext;
 
 #ifndef SDL_THREAD_SAFETY_ANALYSIS
@@ -55,6 +63,109 @@ static
 SDL_Mutex *SDL_HIDAPI_rumble_lock;
 static SDL_HIDAPI_RumbleContext rumble_context SDL_GUARDED_BY(SDL_HIDAPI_rumble_lock);
 
+static void SDL_HIDAPI_PushRumbleRequest(SDL_HIDAPI_RumbleQueue *queue, SDL_HIDAPI_RumbleRequest *request)
+{
+    request->prev = NULL;
+    if (queue->head) {
+        queue->head->prev = request;
+    } else {
+        queue->tail = request;
+    }
+    queue->head = request;
+}
+
+static SDL_HIDAPI_RumbleRequest *SDL_HIDAPI_PopRumbleRequest(SDL_HIDAPI_RumbleQueue *queue)
+{
+    SDL_HIDAPI_RumbleRequest *request = queue->tail;
+
+    if (request) {
+        if (request == queue->head) {
+            queue->head = NULL;
+        }
+        queue->tail = request->prev;
+    }
+    return request;
+}
+
+static void SDL_HIDAPI_RemoveRumbleRequest(SDL_HIDAPI_RumbleQueue *queue, SDL_HIDAPI_RumbleRequest *request)
+{
+    SDL_HIDAPI_RumbleRequest *next = NULL, *entry;
+
+    /* The list is linked from the tail, find the entry that was queued right before this one */
+    for (entry = queue->tail; entry && entry != request; entry = entry->prev) {
+        next = entry;
+    }
+    if (entry == NULL) {
+        return;
+    }
+
+    if (next) {
+        next->prev = request->prev;
+    } else {
+        queue->tail = request->prev;
+    }
+    if (request == queue->head) {
+        queue->head = next;
+    }
+    request->prev = NULL;
+}
+
+static SDL_HIDAPI_RumbleRequest *SDL_HIDAPI_FindRumbleRequest(SDL_HIDAPI_RumbleQueue *queue, SDL_HIDAPI_Device *device)
+{
+    SDL_HIDAPI_RumbleRequest *request, *found = NULL;
+
+    /* Return the most recent request for the device */
+    for (request = queue->tail; request; request = request->prev) {
+        if (request->device == device) {
+            found = request;
+        }
+    }
+    return found;
+}
+
+static void SDL_HIDAPI_FinishRumbleRequest(SDL_HIDAPI_RumbleRequest *request)
+{
+    if (request->callback) {
+        request->callback(request->userdata);
+    }
+    (void)SDL_AtomicDecRef(&request->device->rumble_pending);
+    SDL_free(request);
+}
+
+/* Whether an unsent request can be replaced by newer data: same device, same report, no callback */
+static SDL_bool SDL_HIDAPI_IsReplaceableRumbleRequest(SDL_HIDAPI_RumbleRequest *request, SDL_HIDAPI_Device *device, const Uint8 *data, int size)
+{
+    return (request->device == device && request->size == size && request->data[0] == data[0] && !request->callback);
+}
+
+/* Queue a request to stop rumbling ahead of the other devices' rumble.
+   The device's own packets are never reordered, so its unsent requests move
+   to the priority lane ahead of the new one, except those it replaces, which
+   are dropped.
+ */
+static void SDL_HIDAPI_PushPriorityRumbleRequest(SDL_HIDAPI_RumbleContext *ctx, SDL_HIDAPI_RumbleRequest *request)
+{
+    SDL_HIDAPI_Device *device = request->device;
+    SDL_HIDAPI_RumbleRequest *entry, *newer;
+
+    /* The list is linked from the tail, so this goes from the oldest request to the newest */
+    for (entry = ctx->requests.tail; entry; entry = newer) {
+        newer = entry->prev;
+        if (entry->device != device) {
+            continue;
+        }
+
+        SDL_HIDAPI_RemoveRumbleRequest(&ctx->requests, entry);
+        if (SDL_HIDAPI_IsReplaceableRumbleRequest(entry, device, request->data, request->size)) {
+            ++device->rumble_coalesced;
+            SDL_HIDAPI_FinishRumbleRequest(entry);
+        } else {
+            SDL_HIDAPI_PushRumbleRequest(&ctx->priority_requests, entry);
+        }
+    }
+    SDL_HIDAPI_PushRumbleRequest(&ctx->priority_requests, request);
+}
+
 static int SDLCALL SDL_HIDAPI_RumbleThread(void *data)
 {
     SDL_HIDAPI_RumbleContext *ctx = (SDL_HIDAPI_RumbleContext *)data;
@@ -67,29 +178,33 @@ static int SDLCALL SDL_HIDAPI_RumbleThread(void *data)
         SDL_WaitSemaphore(ctx->request_sem);
 
         SDL_LockMutex(SDL_HIDAPI_rumble_lock);
-        request = ctx->requests_tail;
-        if (request) {
-            if (request == ctx->requests_head) {
-                ctx->requests_head = NULL;
-            }
-            ctx->requests_tail = request->prev;
+        request = SDL_HIDAPI_PopRumbleRequest(&ctx->priority_requests);
+        if (request == NULL) {
+            request = SDL_HIDAPI_PopRumbleRequest(&ctx->requests);
         }
         SDL_UnlockMutex(SDL_HIDAPI_rumble_lock);
 
         if (request) {
-            SDL_LockMutex(request->device->dev_lock);
-            if (request->device->dev) {
+            SDL_HIDAPI_Device *device = request->device;
+            Uint64 latency;
+
+            SDL_LockMutex(device->dev_lock);
+            if (device->dev) {
 #ifdef DEBUG_RUMBLE
                 HIDAPI_DumpPacket("Rumble packet: size = %d", request->data, request->size);
 #endif
-                SDL_hid_write(request->device->dev, request->data, request->size);
-            }
-            SDL_UnlockMutex(request->device->dev_lock);
-            if (request->callback) {
-                request->callback(request->userdata);
+                SDL_hid_write(device->dev, request->data, request->size);
             }
-            (void)SDL_AtomicDecRef(&request->device->rumble_pending);
-            SDL_free(request);
+            SDL_UnlockMutex(device->dev_lock);
+
+            latency = SDL_GetTicksNS() - request->queued;
+            SDL_LockMutex(SDL_HIDAPI_rumble_lock);
+            ++device->rumble_sent;
+            device->rumble_total_latency += latency;
+            device->rumble_max_latency = SDL_max(device->rumble_max_latency, latency);
+            SDL_UnlockMutex(SDL_HIDAPI_rumble_lock);
+
+            SDL_HIDAPI_FinishRumbleRequest(request);
 
             /* Make sure we're not starving report reads when there's lots of rumble */
             SDL_Delay(10);
@@ -113,18 +228,11 @@ static void SDL_HIDAPI_StopRumbleThread(SDL_HIDAPI_RumbleContext *ctx)
     }
 
     SDL_LockMutex(SDL_HIDAPI_rumble_lock);
-    while (ctx->requests_tail) {
-        request = ctx->requests_tail;
-        if (request == ctx->requests_head) {
-            ctx->requests_head = NULL;
-        }
-        ctx->requests_tail = request->prev;
-
-        if (request->callback) {
-            request->callback(request->userdata);
-        }
-        (void)SDL_AtomicDecRef(&request->device->rumble_pending);
-        SDL_free(request);
+    while ((request = SDL_HIDAPI_PopRumbleRequest(&ctx->priority_requests)) != NULL) {
+        SDL_HIDAPI_FinishRumbleRequest(request);
+    }
+    while ((request = SDL_HIDAPI_PopRumbleRequest(&ctx->requests)) != NULL) {
+        SDL_HIDAPI_FinishRumbleRequest(request);
     }
     SDL_UnlockMutex(SDL_HIDAPI_rumble_lock);
 
@@ -181,13 +289,11 @@ int SDL_HIDAPI_LockRumble(void)
 SDL_bool SDL_HIDAPI_GetPendingRumbleLocked(SDL_HIDAPI_Device *device, Uint8 **data, int **size, int *maximum_size)
 {
     SDL_HIDAPI_RumbleContext *ctx = &rumble_context;
-    SDL_HIDAPI_RumbleRequest *request, *found;
+    SDL_HIDAPI_RumbleRequest *found;
 
-    found = NULL;
-    for (request = ctx->requests_tail; request; request = request->prev) {
-        if (request->device == device) {
-            found = request;
-        }
+    found = SDL_HIDAPI_FindRumbleRequest(&ctx->requests, device);
+    if (found == NULL) {
+        found = SDL_HIDAPI_FindRumbleRequest(&ctx->priority_requests, device);
     }
     if (found) {
         *data = found->data;
@@ -223,15 +329,17 @@ int SDL_HIDAPI_SendRumbleWithCallbackAndUnlock(SDL_HIDAPI_Device *device, const
     request->size = size;
     request->callback = callback;
     request->userdata = userdata;
+    request->queued = SDL_GetTicksNS();
 
     SDL_AtomicIncRef(&device->rumble_pending);
 
-    if (ctx->requests_head) {
-        ctx->requests_head->prev = request;
+    if (device->rumble_priority) {
+        /* Only the request that stops the rumble is sent early, anything else the driver sends goes in order */
+        device->rumble_priority = SDL_FALSE;
+        SDL_HIDAPI_PushPriorityRumbleRequest(ctx, request);
     } else {
-        ctx->requests_tail = request;
+        SDL_HIDAPI_PushRumbleRequest(&ctx->requests, request);
     }
-    ctx->requests_head = request;
 
     /* Make sure we unlock before posting the semaphore so the rumble thread can run immediately */
     SDL_HIDAPI_UnlockRumble();
@@ -246,11 +354,29 @@ void SDL_HIDAPI_UnlockRumble(void)
     SDL_UnlockMutex(SDL_HIDAPI_rumble_lock);
 }
 
+/* Find an unsent request that the new data would replace.
+   Only the device's most recent request is replaced, updating an older one
+   would send the new data ahead of packets the device queued after it.
+ */
+static SDL_HIDAPI_RumbleRequest *SDL_HIDAPI_FindReplaceableRumbleRequest(SDL_HIDAPI_RumbleContext *ctx, SDL_HIDAPI_Device *device, const Uint8 *data, int size)
+{
+    SDL_HIDAPI_RumbleRequest *request;
+
+    /* Requests in the normal queue are sent after the priority lane, so they're the newer ones */
+    request = SDL_HIDAPI_FindRumbleRequest(&ctx->requests, device);
+    if (request == NULL) {
+        request = SDL_HIDAPI_FindRumbleRequest(&ctx->priority_requests, device);
+    }
+    if (request && SDL_HIDAPI_IsReplaceableRumbleRequest(request, device, data, size)) {
+        return request;
+    }
+    return NULL;
+}
+
 int SDL_HIDAPI_SendRumble(SDL_HIDAPI_Device *device, const Uint8 *data, int size)
 {
-    Uint8 *pending_data;
-    int *pending_size;
-    int maximum_size;
+    SDL_HIDAPI_RumbleContext *ctx = &rumble_context;
+    SDL_HIDAPI_RumbleRequest *request;
 
     if (size <= 0) {
         return SDL_SetError("Tried to send rumble with invalid size");
@@ -260,17 +386,53 @@ int SDL_HIDAPI_SendRumble(SDL_HIDAPI_Device *device, const Uint8 *data, int size
         return -1;
     }
 
-    /* check if there is a pending request for the device and update it */
-    if (SDL_HIDAPI_GetPendingRumbleLocked(device, &pending_data, &pending_size, &maximum_size) &&
-        size == *pending_size && data[0] == pending_data[0]) {
-        SDL_memcpy(pending_data, data, size);
-        SDL_HIDAPI_UnlockRumble();
-        return size;
+    /* check if the device's last pending request is for the same report and update it, only the latest state needs to be sent.
+       A request to stop rumbling is queued as a new request instead, which drops the pending ones it replaces.
+     */
+    if (!device->rumble_priority) {
+        request = SDL_HIDAPI_FindReplaceableRumbleRequest(ctx, device, data, size);
+        if (request) {
+            SDL_memcpy(request->data, data, size);
+            ++device->rumble_coalesced;
+            SDL_HIDAPI_UnlockRumble();
+            return size;
+        }
     }
 
     return SDL_HIDAPI_SendRumbleAndUnlock(device, data, size);
 }
 
+void SDL_HIDAPI_GetRumbleStats(SDL_HIDAPI_Device *device, int *pending, Uint64 *sent, Uint64 *coalesced, Uint64 *average_latency_ns, Uint64 *max_latency_ns)
+{
+    SDL_HIDAPI_RumbleContext *ctx = &rumble_context;
+    SDL_bool locked = SDL_FALSE;
+
+    /* Don't start the rumble thread just to read the statistics */
+    if (SDL_AtomicGet(&ctx->initialized) && SDL_HIDAPI_LockRumble() == 0) {
+        locked = SDL_TRUE;
+    }
+
+    if (pending) {
+        *pending = SDL_AtomicGet(&device->rumble_pending);
+    }
+    if (sent) {
+        *sent = device->rumble_sent;
+    }
+    if (coalesced) {
+        *coalesced = device->rumble_coalesced;
+    }
+    if (average_latency_ns) {
+        *average_latency_ns = device->rumble_sent ? (device->rumble_total_latency / device->rumble_sent) : 0;
+    }
+    if (max_latency_ns) {
+        *max_latency_ns = device->rumble_max_latency;
+    }
+
+    if (locked) {
+        SDL_HIDAPI_UnlockRumble();
+    }
+}
+
 void SDL_HIDAPI_QuitRumble(void)
 {
     SDL_HIDAPI_RumbleContext *ctx = &rumble_context;
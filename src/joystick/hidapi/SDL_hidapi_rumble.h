@@ -37,6 +37,7 @@ void SDL_HIDAPI_UnlockRumble(void) SDL_RELEASE(SDL_HIDAPI_rumble_lock);
 
 /* Simple API, will replace any pending rumble with the new data */
 int SDL_HIDAPI_SendRumble(SDL_HIDAPI_Device *device, const Uint8 *data, int size);
+void SDL_HIDAPI_GetRumbleStats(SDL_HIDAPI_Device *device, int *pending, Uint64 *sent, Uint64 *coalesced, Uint64 *average_latency_ns, Uint64 *max_latency_ns);
 void SDL_HIDAPI_QuitRumble(void);
 
 #endif /* SDL_JOYSTICK_HIDAPI */
@@ -585,11 +585,11 @@ static bool ResetSteamController(SDL_hid_device *dev, bool bSuppressErrorSpew, u
 //---------------------------------------------------------------------------
 // Read from a Steam Controller
 //---------------------------------------------------------------------------
-static int ReadSteamController(SDL_hid_device *dev, uint8_t *pData, int nDataSize)
+static int ReadSteamController(SDL_HIDAPI_Device *device, uint8_t *pData, int nDataSize)
 {
     SDL_memset(pData, 0, nDataSize);
     pData[0] = BLE_REPORT_NUMBER; // hid_read will also overwrite this with the same value, 0x03
-    return SDL_hid_read(dev, pData, nDataSize);
+    return HIDAPI_ReadDeviceReport(device, pData, nDataSize);
 }
 
 //---------------------------------------------------------------------------
@@ -1100,7 +1100,7 @@ static SDL_bool HIDAPI_DriverSteam_UpdateDevice(SDL_HIDAPI_Device *device)
         int r, nPacketLength;
         const Uint8 *pPacket;
 
-        r = ReadSteamController(device->dev, data, sizeof(data));
+        r = ReadSteamController(device, data, sizeof(data));
         if (r == 0) {
             break;
         }
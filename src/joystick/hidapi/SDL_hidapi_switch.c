@@ -331,7 +331,7 @@ static int ReadInput(SDL_DriverSwitch_Context *ctx)
         return 0;
     }
 
-    return SDL_hid_read_timeout(ctx->device->dev, ctx->m_rgucReadBuffer, sizeof(ctx->m_rgucReadBuffer), 0);
+    return HIDAPI_ReadDeviceReport(ctx->device, ctx->m_rgucReadBuffer, sizeof(ctx->m_rgucReadBuffer));
 }
 
 static int WriteOutput(SDL_DriverSwitch_Context *ctx, const Uint8 *data, int size)
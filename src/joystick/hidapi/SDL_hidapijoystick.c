@@ -90,6 +90,7 @@ static SDL_HIDAPI_Device *SDL_HIDAPI_devices SDL_GUARDED_BY(SDL_joystick_lock);
 static char SDL_HIDAPI_device_magic;
 static int SDL_HIDAPI_numjoysticks = 0;
 static SDL_bool SDL_HIDAPI_combine_joycons = SDL_TRUE;
+static SDL_bool SDL_HIDAPI_coalesce_axes = SDL_FALSE;
 static SDL_bool initialized = SDL_FALSE;
 static SDL_bool shutting_down = SDL_FALSE;
 
@@ -556,6 +557,11 @@ static void SDLCALL SDL_HIDAPIDriverHintChanged(void *userdata, const char *name
     SDL_HIDAPI_change_count = 0;
 }
 
+static void SDLCALL SDL_HIDAPICoalesceAxesChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_HIDAPI_coalesce_axes = SDL_GetStringBoolean(hint, SDL_FALSE);
+}
+
 static int HIDAPI_JoystickInit(void)
 {
     int i;
@@ -594,6 +600,8 @@ static int HIDAPI_JoystickInit(void)
                         SDL_HIDAPIDriverHintChanged, NULL);
     SDL_AddHintCallback(SDL_HINT_JOYSTICK_HIDAPI,
                         SDL_HIDAPIDriverHintChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_JOYSTICK_HIDAPI_COALESCE_AXES,
+                        SDL_HIDAPICoalesceAxesChanged, NULL);
 
     SDL_HIDAPI_change_count = SDL_hid_device_change_count();
     HIDAPI_UpdateDeviceList();
@@ -1310,6 +1318,63 @@ static void HIDAPI_JoystickDetect(void)
     }
 }
 
+int HIDAPI_ReadDeviceReport(SDL_HIDAPI_Device *device, Uint8 *data, size_t size)
+{
+    int result = SDL_hid_read_timeout(device->dev, data, size, 0);
+    if (result > 0) {
+        ++device->reports_read;
+    }
+    return result;
+}
+
+static int HIDAPI_TakeDeviceReports(SDL_HIDAPI_Device *device)
+{
+    int i;
+    int reports = device->reports_read;
+
+    device->reports_read = 0;
+    for (i = 0; i < device->num_children; ++i) {
+        reports += HIDAPI_TakeDeviceReports(device->children[i]);
+    }
+    return reports;
+}
+
+static void HIDAPI_BatchDeviceJoysticks(SDL_HIDAPI_Device *device, SDL_bool begin)
+{
+    int i;
+
+    for (i = 0; i < device->num_joysticks; ++i) {
+        SDL_Joystick *joystick = SDL_GetJoystickFromInstanceID(device->joysticks[i]);
+        if (joystick) {
+            if (begin) {
+                SDL_BeginJoystickBatch(joystick);
+            } else {
+                SDL_EndJoystickBatch(joystick);
+            }
+        }
+    }
+    for (i = 0; i < device->num_children; ++i) {
+        HIDAPI_BatchDeviceJoysticks(device->children[i], begin);
+    }
+}
+
+/* All the reports that arrived since the last update are processed as one batch,
+   and if SDL_HINT_JOYSTICK_HIDAPI_COALESCE_AXES is enabled the axis motion is
+   coalesced so only the final position of each axis is sent.
+ */
+static void HIDAPI_UpdateDevice(SDL_HIDAPI_Device *device)
+{
+    HIDAPI_TakeDeviceReports(device);
+    if (SDL_HIDAPI_coalesce_axes) {
+        HIDAPI_BatchDeviceJoysticks(device, SDL_TRUE);
+    }
+
+    device->driver->UpdateDevice(device);
+
+    device->input_stats.reports_read += HIDAPI_TakeDeviceReports(device);
+    HIDAPI_BatchDeviceJoysticks(device, SDL_FALSE);
+}
+
 void HIDAPI_UpdateDevices(void)
 {
     SDL_HIDAPI_Device *device;
@@ -1327,7 +1392,7 @@ void HIDAPI_UpdateDevices(void)
             if (device->driver) {
                 if (SDL_TryLockMutex(device->dev_lock) == 0) {
                     device->updating = SDL_TRUE;
-                    device->driver->UpdateDevice(device);
+                    HIDAPI_UpdateDevice(device);
                     device->updating = SDL_FALSE;
                     SDL_UnlockMutex(device->dev_lock);
                 }
@@ -1449,6 +1514,12 @@ static int HIDAPI_JoystickOpen(SDL_Joystick *joystick, int device_index)
         joystick->serial = SDL_strdup(device->serial);
     }
 
+    /* Joysticks on the same device share its counters, reports are read for the whole device */
+    while (device->parent) {
+        device = device->parent;
+    }
+    joystick->input_stats = &device->input_stats;
+
     joystick->hwdata = hwdata;
     return 0;
 }
@@ -1472,7 +1543,10 @@ static int HIDAPI_JoystickRumble(SDL_Joystick *joystick, Uint16 low_frequency_ru
     SDL_HIDAPI_Device *device = NULL;
 
     if (HIDAPI_GetJoystickDevice(joystick, &device)) {
+        /* Requests to stop rumbling are sent ahead of any other pending rumble */
+        device->rumble_priority = (low_frequency_rumble == 0 && high_frequency_rumble == 0);
         result = device->driver->RumbleJoystick(device, joystick, low_frequency_rumble, high_frequency_rumble);
+        device->rumble_priority = SDL_FALSE;
     } else {
         result = SDL_SetError("Rumble failed, device disconnected");
     }
@@ -1486,7 +1560,9 @@ static int HIDAPI_JoystickRumbleTriggers(SDL_Joystick *joystick, Uint16 left_rum
     SDL_HIDAPI_Device *device = NULL;
 
     if (HIDAPI_GetJoystickDevice(joystick, &device)) {
+        device->rumble_priority = (left_rumble == 0 && right_rumble == 0);
         result = device->driver->RumbleJoystickTriggers(device, joystick, left_rumble, right_rumble);
+        device->rumble_priority = SDL_FALSE;
     } else {
         result = SDL_SetError("Rumble failed, device disconnected");
     }
@@ -1494,6 +1570,18 @@ static int HIDAPI_JoystickRumbleTriggers(SDL_Joystick *joystick, Uint16 left_rum
     return result;
 }
 
+int HIDAPI_GetJoystickRumbleStats(SDL_Joystick *joystick, int *pending, Uint64 *sent, Uint64 *coalesced, Uint64 *average_latency_ns, Uint64 *max_latency_ns)
+{
+    SDL_HIDAPI_Device *device = NULL;
+
+    if (!HIDAPI_GetJoystickDevice(joystick, &device)) {
+        return SDL_SetError("Device disconnected");
+    }
+
+    SDL_HIDAPI_GetRumbleStats(device, pending, sent, coalesced, average_latency_ns, max_latency_ns);
+    return 0;
+}
+
 static Uint32 HIDAPI_JoystickGetCapabilities(SDL_Joystick *joystick)
 {
     Uint32 result = 0;
@@ -1578,6 +1666,10 @@ static void HIDAPI_JoystickClose(SDL_Joystick *joystick) SDL_NO_THREAD_SAFETY_AN
 
         device->driver->CloseJoystick(device, joystick);
 
+        /* Keep the last counters, the device may go away before the joystick is closed */
+        joystick->own_input_stats = *joystick->input_stats;
+        joystick->input_stats = &joystick->own_input_stats;
+
         SDL_free(joystick->hwdata);
         joystick->hwdata = NULL;
     }
@@ -1618,6 +1710,8 @@ static void HIDAPI_JoystickQuit(void)
                         SDL_HIDAPIDriverHintChanged, NULL);
     SDL_DelHintCallback(SDL_HINT_JOYSTICK_HIDAPI,
                         SDL_HIDAPIDriverHintChanged, NULL);
+    SDL_DelHintCallback(SDL_HINT_JOYSTICK_HIDAPI_COALESCE_AXES,
+                        SDL_HIDAPICoalesceAxesChanged, NULL);
 
     SDL_hid_exit();
 
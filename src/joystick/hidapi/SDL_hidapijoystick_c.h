@@ -23,6 +23,7 @@
 #ifndef SDL_JOYSTICK_HIDAPI_H
 #define SDL_JOYSTICK_HIDAPI_H
 
+#include "../SDL_sysjoystick.h"
 #include "../usb_ids.h"
 
 /* This is the full set of HIDAPI drivers available */
@@ -73,6 +74,14 @@ typedef struct SDL_HIDAPI_Device
     SDL_Mutex *dev_lock;
     SDL_hid_device *dev;
     SDL_AtomicInt rumble_pending;
+    SDL_bool rumble_priority; /* Set while sending a request to stop rumbling, until it's queued */
+
+    /* Rumble statistics, protected by the rumble lock */
+    Uint64 rumble_sent;
+    Uint64 rumble_coalesced;
+    Uint64 rumble_total_latency;
+    Uint64 rumble_max_latency;
+
     int num_joysticks;
     SDL_JoystickID *joysticks;
 
@@ -82,6 +91,12 @@ typedef struct SDL_HIDAPI_Device
     /* Used to flag that the device is being updated */
     SDL_bool updating;
 
+    /* Number of input reports read since the last update */
+    int reports_read;
+
+    /* Input statistics for the device, shared by all its joysticks */
+    SDL_JoystickInputStats input_stats;
+
     struct SDL_HIDAPI_Device *parent;
     int num_children;
     struct SDL_HIDAPI_Device **children;
@@ -145,6 +160,8 @@ extern SDL_JoystickType HIDAPI_GetJoystickTypeFromGUID(SDL_JoystickGUID guid);
 extern SDL_GamepadType HIDAPI_GetGamepadTypeFromGUID(SDL_JoystickGUID guid);
 
 extern void HIDAPI_UpdateDevices(void);
+extern int HIDAPI_ReadDeviceReport(SDL_HIDAPI_Device *device, Uint8 *data, size_t size);
+extern int HIDAPI_GetJoystickRumbleStats(SDL_Joystick *joystick, int *pending, Uint64 *sent, Uint64 *coalesced, Uint64 *average_latency_ns, Uint64 *max_latency_ns);
 extern void HIDAPI_SetDeviceName(SDL_HIDAPI_Device *device, const char *name);
 extern void HIDAPI_SetDeviceProduct(SDL_HIDAPI_Device *device, Uint16 vendor_id, Uint16 product_id);
 extern void HIDAPI_SetDeviceSerial(SDL_HIDAPI_Device *device, const char *serial);
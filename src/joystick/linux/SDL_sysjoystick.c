@@ -37,12 +37,15 @@
 #include <string.h> /* strerror */
 #endif
 #include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 #include <dirent.h>
 #include <linux/joystick.h>
 
 #include "../../SDL_utils_c.h"
 #include "../../events/SDL_events_c.h"
+#include "../../thread/SDL_systhread.h"
 #include "../../core/linux/SDL_evdev.h"
 #include "../SDL_sysjoystick.h"
 #include "../SDL_joystick_c.h"
@@ -185,6 +188,46 @@ static int inotify_fd = -1;
 static Uint64 last_joy_detect_time;
 static time_t last_input_dir_mtime;
 
+/* The optional input thread waits on the open devices and the inotify
+   descriptor with epoll, and handles input as soon as it arrives instead of
+   when the application pumps events. Devices are identified by instance ID,
+   the IDs below can't collide with those since they're 32-bit.
+ */
+#define INPUT_THREAD_WAKEUP_ID  ((Uint64)1 << 32)
+#define INPUT_THREAD_INOTIFY_ID (((Uint64)1 << 32) + 1)
+
+static int input_epoll_fd = -1;
+static int input_wakeup_fd = -1;
+static SDL_Thread *input_thread = NULL;
+static SDL_AtomicInt input_thread_quit;
+
+static void LINUX_JoystickUpdate(SDL_Joystick *joystick);
+
+static void InputThreadWatch(int fd, Uint64 id)
+{
+    struct epoll_event event;
+
+    if (input_epoll_fd < 0 || fd < 0) {
+        return;
+    }
+
+    SDL_zero(event);
+    event.events = EPOLLIN;
+    event.data.u64 = id;
+    if (epoll_ctl(input_epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_INPUT, "Couldn't add fd %d to the input thread: %s", fd, strerror(errno));
+    }
+}
+
+static void InputThreadUnwatch(int fd)
+{
+    if (input_epoll_fd < 0 || fd < 0) {
+        return;
+    }
+
+    epoll_ctl(input_epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+}
+
 static void FixupDeviceInfoForMapping(int fd, struct input_id *inpid)
 {
     if (inpid->vendor == 0x045e && inpid->product == 0x0b05 && inpid->version == 0x0903) {
@@ -871,6 +914,118 @@ static void LINUX_JoystickDetect(void)
     SDL_UpdateSteamControllers();
 }
 
+static int SDLCALL LINUX_JoystickInputThread(void *data)
+{
+    struct epoll_event events[16];
+
+    while (!SDL_AtomicGet(&input_thread_quit)) {
+        int i, count;
+
+        count = epoll_wait(input_epoll_fd, events, SDL_arraysize(events), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            SDL_LogError(SDL_LOG_CATEGORY_INPUT, "Joystick input thread failed: %s", strerror(errno));
+            break;
+        }
+
+        /* Joysticks are locked while this thread is stopped, so give up waiting when asked to quit */
+        if (SDL_WaitLockJoysticks(&input_thread_quit) < 0) {
+            break;
+        }
+        if (SDL_AtomicGet(&input_thread_quit)) {
+            SDL_UnlockJoysticks();
+            break;
+        }
+
+        for (i = 0; i < count; ++i) {
+            const Uint64 id = events[i].data.u64;
+            SDL_Joystick *joystick;
+
+            if (id == INPUT_THREAD_WAKEUP_ID) {
+                continue;
+            }
+            if (id == INPUT_THREAD_INOTIFY_ID) {
+                LINUX_JoystickDetect();
+                continue;
+            }
+
+            joystick = SDL_GetJoystickFromInstanceID((SDL_JoystickID)id);
+            if (joystick == NULL || joystick->hwdata == NULL) {
+                continue;
+            }
+            LINUX_JoystickUpdate(joystick);
+
+            /* Stop waiting on devices that went away, they'd never stop being readable */
+            if (joystick->hwdata->gone) {
+                InputThreadUnwatch(joystick->hwdata->fd);
+            }
+            if (joystick->hwdata->sensor_gone) {
+                InputThreadUnwatch(joystick->hwdata->fd_sensor);
+            }
+        }
+        SDL_UnlockJoysticks();
+    }
+    return 0;
+}
+
+static void LINUX_StartInputThread(void)
+{
+    input_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (input_epoll_fd < 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_INPUT, "Couldn't create epoll instance, not using an input thread: %s", strerror(errno));
+        return;
+    }
+
+    input_wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (input_wakeup_fd < 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_INPUT, "Couldn't create eventfd, not using an input thread: %s", strerror(errno));
+        close(input_epoll_fd);
+        input_epoll_fd = -1;
+        return;
+    }
+
+    InputThreadWatch(input_wakeup_fd, INPUT_THREAD_WAKEUP_ID);
+    InputThreadWatch(inotify_fd, INPUT_THREAD_INOTIFY_ID);
+
+    SDL_AtomicSet(&input_thread_quit, 0);
+    input_thread = SDL_CreateThreadInternal(LINUX_JoystickInputThread, "SDLJoystickInput", 0, NULL);
+    if (input_thread == NULL) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_INPUT, "Couldn't create input thread: %s", SDL_GetError());
+        close(input_wakeup_fd);
+        input_wakeup_fd = -1;
+        close(input_epoll_fd);
+        input_epoll_fd = -1;
+    }
+}
+
+static void LINUX_StopInputThread(void)
+{
+    if (input_thread) {
+        const Uint64 value = 1;
+
+        SDL_AtomicSet(&input_thread_quit, 1);
+        if (write(input_wakeup_fd, &value, sizeof(value)) < 0) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_INPUT, "Couldn't wake up the input thread: %s", strerror(errno));
+        }
+        SDL_WakeJoystickLockWaiters();
+
+        /* The input thread stops without taking the joystick lock */
+        SDL_WaitThread(input_thread, NULL);
+        input_thread = NULL;
+    }
+
+    if (input_wakeup_fd >= 0) {
+        close(input_wakeup_fd);
+        input_wakeup_fd = -1;
+    }
+    if (input_epoll_fd >= 0) {
+        close(input_epoll_fd);
+        input_epoll_fd = -1;
+    }
+}
+
 static int LINUX_JoystickInit(void)
 {
     const char *devices = SDL_GetHint(SDL_HINT_JOYSTICK_DEVICE);
@@ -964,6 +1119,10 @@ static int LINUX_JoystickInit(void)
 #endif /* HAVE_INOTIFY */
     }
 
+    if (SDL_GetHintBoolean(SDL_HINT_JOYSTICK_THREAD, SDL_FALSE)) {
+        LINUX_StartInputThread();
+    }
+
     return 0;
 }
 
@@ -1477,6 +1636,10 @@ static int LINUX_JoystickOpen(SDL_Joystick *joystick, int device_index)
         joystick->hwdata->fd_sensor = -1;
     }
 
+    if (!joystick->hwdata->m_bSteamController) {
+        InputThreadWatch(joystick->hwdata->fd, joystick->instance_id);
+    }
+
     return 0;
 }
 
@@ -1569,8 +1732,10 @@ static int LINUX_JoystickSetSensorsEnabled(SDL_Joystick *joystick, SDL_bool enab
             return SDL_SetError("Couldn't open sensor file %s.", joystick->hwdata->item_sensor->path);
         }
         fcntl(joystick->hwdata->fd_sensor, F_SETFL, O_NONBLOCK);
+        InputThreadWatch(joystick->hwdata->fd_sensor, joystick->instance_id);
     } else {
         SDL_assert(joystick->hwdata->fd_sensor >= 0);
+        InputThreadUnwatch(joystick->hwdata->fd_sensor);
         close(joystick->hwdata->fd_sensor);
         joystick->hwdata->fd_sensor = -1;
     }
@@ -2020,9 +2185,11 @@ static void LINUX_JoystickClose(SDL_Joystick *joystick)
             joystick->hwdata->effect.id = -1;
         }
         if (joystick->hwdata->fd >= 0) {
+            InputThreadUnwatch(joystick->hwdata->fd);
             close(joystick->hwdata->fd);
         }
         if (joystick->hwdata->fd_sensor >= 0) {
+            InputThreadUnwatch(joystick->hwdata->fd_sensor);
             close(joystick->hwdata->fd_sensor);
         }
         if (joystick->hwdata->item) {
@@ -2047,6 +2214,8 @@ static void LINUX_JoystickQuit(void)
     SDL_sensorlist_item *item_sensor = NULL;
     SDL_sensorlist_item *next_sensor = NULL;
 
+    LINUX_StopInputThread();
+
     if (inotify_fd >= 0) {
         close(inotify_fd);
         inotify_fd = -1;
@@ -23,6 +23,7 @@
 /* The SDL 2D rendering system */
 
 #include "SDL_sysrender.h"
+#include "SDL_rendercapture_c.h"
 #include "software/SDL_render_sw_c.h"
 #include "../video/SDL_pixels_c.h"
 #include "../video/SDL_video_c.h"
@@ -3954,6 +3955,86 @@ int SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect, Uint32 fo
                                       format, pixels, pitch);
 }
 
+int SDL_StartRenderCapture(SDL_Renderer *renderer, const char *prefix, SDL_RenderCaptureFormat format, int max_queued_frames)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (prefix == NULL) {
+        return SDL_InvalidParamError("prefix");
+    }
+    if (format != SDL_RENDER_CAPTURE_BMP && format != SDL_RENDER_CAPTURE_RAW) {
+        return SDL_InvalidParamError("format");
+    }
+    if (max_queued_frames < 1) {
+        return SDL_InvalidParamError("max_queued_frames");
+    }
+    if (!renderer->RenderReadPixels) {
+        return SDL_Unsupported();
+    }
+
+    SDL_StopRenderCapture(renderer);
+
+    renderer->capture = SDL_CreateRenderCapture(prefix, format, max_queued_frames);
+    if (renderer->capture == NULL) {
+        return -1;
+    }
+    renderer->capture_captured = 0;
+    renderer->capture_written = 0;
+    renderer->capture_dropped = 0;
+    return 0;
+}
+
+int SDL_StopRenderCapture(SDL_Renderer *renderer)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (renderer->capture) {
+        SDL_RenderCapture *capture = renderer->capture;
+
+        renderer->capture = NULL;
+
+        /* Keep the final counters around after all the frames are written */
+        SDL_FlushRenderCapture(capture);
+        SDL_GetRenderCaptureCounters(capture, &renderer->capture_captured, &renderer->capture_written, &renderer->capture_dropped);
+        SDL_DestroyRenderCapture(capture);
+    }
+    return 0;
+}
+
+int SDL_GetRenderCaptureStats(SDL_Renderer *renderer, Uint64 *captured, Uint64 *written, Uint64 *dropped)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (renderer->capture) {
+        SDL_GetRenderCaptureCounters(renderer->capture, &renderer->capture_captured, &renderer->capture_written, &renderer->capture_dropped);
+    }
+    if (captured) {
+        *captured = renderer->capture_captured;
+    }
+    if (written) {
+        *written = renderer->capture_written;
+    }
+    if (dropped) {
+        *dropped = renderer->capture_dropped;
+    }
+    return 0;
+}
+
+/* Read the frame back into a capture surface, the capture thread writes it out */
+static void SDL_CaptureRenderFrame(SDL_Renderer *renderer)
+{
+    SDL_Rect viewport;
+    SDL_Surface *surface;
+
+    GetRenderViewportInPixels(renderer, &viewport);
+    surface = SDL_AcquireRenderCaptureSurface(renderer->capture, viewport.w, viewport.h);
+    if (surface) {
+        const int result = SDL_RenderReadPixels(renderer, NULL, surface->format->format, surface->pixels, surface->pitch);
+
+        SDL_SubmitRenderCaptureSurface(renderer->capture, surface, result == 0);
+    }
+}
+
 static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
 {
     Uint64 now, elapsed;
@@ -3994,6 +4075,10 @@ int SDL_RenderPresent(SDL_Renderer *renderer)
 
     FlushRenderCommands(renderer); /* time to send everything to the GPU! */
 
+    if (renderer->capture) {
+        SDL_CaptureRenderFrame(renderer);
+    }
+
 #if DONT_DRAW_WHILE_HIDDEN
     /* Don't present while we're hidden */
     if (renderer->hidden) {
@@ -4105,6 +4190,8 @@ void SDL_DestroyRenderer(SDL_Renderer *renderer)
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
 
+    SDL_StopRenderCapture(renderer);
+
     SDL_DiscardAllCommands(renderer);
 
     /* Free existing textures for this renderer */
@@ -0,0 +1,295 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_rendercapture_c.h"
+#include "../thread/SDL_systhread.h"
+
+typedef struct SDL_RenderCaptureFrame
+{
+    SDL_Surface *surface;
+    int frame_number;
+    struct SDL_RenderCaptureFrame *next;
+} SDL_RenderCaptureFrame;
+
+struct SDL_RenderCapture
+{
+    char *prefix;
+    SDL_RenderCaptureFormat format;
+    SDL_Mutex *lock;
+    SDL_Condition *cond;
+    SDL_Thread *thread;
+    SDL_bool quit;
+
+    int num_frames;
+    SDL_RenderCaptureFrame *frames;
+    SDL_RenderCaptureFrame *free_frames;
+    SDL_RenderCaptureFrame *queued_head;
+    SDL_RenderCaptureFrame *queued_tail;
+    SDL_RenderCaptureFrame *acquired; /* The frame being read back on the render thread */
+    SDL_bool writing;                 /* SDL_TRUE while the capture thread writes a frame */
+
+    int frame_number;
+    Uint64 captured;
+    Uint64 written;
+    Uint64 dropped;
+};
+
+static int SDL_WriteRenderCaptureFrame(SDL_RenderCapture *capture, SDL_RenderCaptureFrame *frame)
+{
+    SDL_Surface *surface = frame->surface;
+    char *path = NULL;
+    int retval;
+
+    if (SDL_asprintf(&path, "%s%8.8d.%s", capture->prefix, frame->frame_number,
+                     capture->format == SDL_RENDER_CAPTURE_BMP ? "bmp" : "raw") < 0) {
+        return SDL_OutOfMemory();
+    }
+
+    if (capture->format == SDL_RENDER_CAPTURE_BMP) {
+        retval = SDL_SaveBMP(surface, path);
+    } else {
+        SDL_RWops *dst = SDL_RWFromFile(path, "wb");
+        if (dst == NULL) {
+            retval = -1;
+        } else {
+            const size_t size = (size_t)surface->h * surface->pitch;
+
+            /* The surfaces are created without row padding, so this is just the pixels */
+            if (SDL_RWwrite(dst, surface->pixels, size) != size) {
+                retval = -1;
+            } else {
+                retval = 0;
+            }
+            if (SDL_RWclose(dst) < 0) {
+                retval = -1;
+            }
+        }
+    }
+    if (retval < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Couldn't write captured frame %s: %s", path, SDL_GetError());
+    }
+    SDL_free(path);
+
+    return retval;
+}
+
+static int SDLCALL SDL_RenderCaptureThread(void *data)
+{
+    SDL_RenderCapture *capture = (SDL_RenderCapture *)data;
+    int result;
+
+    SDL_LockMutex(capture->lock);
+    for (;;) {
+        SDL_RenderCaptureFrame *frame;
+
+        while (!capture->queued_head && !capture->quit) {
+            SDL_WaitCondition(capture->cond, capture->lock);
+        }
+
+        frame = capture->queued_head;
+        if (frame == NULL) {
+            /* We're quitting and all the frames have been written */
+            break;
+        }
+        capture->queued_head = frame->next;
+        if (capture->queued_head == NULL) {
+            capture->queued_tail = NULL;
+        }
+        capture->writing = SDL_TRUE;
+        SDL_UnlockMutex(capture->lock);
+
+        result = SDL_WriteRenderCaptureFrame(capture, frame);
+
+        SDL_LockMutex(capture->lock);
+        if (result == 0) {
+            ++capture->written;
+        } else {
+            ++capture->dropped;
+        }
+        capture->writing = SDL_FALSE;
+        frame->next = capture->free_frames;
+        capture->free_frames = frame;
+
+        /* Wake up SDL_FlushRenderCapture() */
+        SDL_BroadcastCondition(capture->cond);
+    }
+    SDL_UnlockMutex(capture->lock);
+
+    return 0;
+}
+
+SDL_RenderCapture *SDL_CreateRenderCapture(const char *prefix, SDL_RenderCaptureFormat format, int max_queued_frames)
+{
+    SDL_RenderCapture *capture;
+    int i;
+
+    capture = (SDL_RenderCapture *)SDL_calloc(1, sizeof(*capture));
+    if (capture == NULL) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    capture->format = format;
+    capture->num_frames = max_queued_frames;
+
+    capture->prefix = SDL_strdup(prefix);
+    capture->frames = (SDL_RenderCaptureFrame *)SDL_calloc(max_queued_frames, sizeof(*capture->frames));
+    if (capture->prefix == NULL || capture->frames == NULL) {
+        SDL_OutOfMemory();
+        SDL_DestroyRenderCapture(capture);
+        return NULL;
+    }
+    for (i = max_queued_frames; i--;) {
+        capture->frames[i].next = capture->free_frames;
+        capture->free_frames = &capture->frames[i];
+    }
+
+    capture->lock = SDL_CreateMutex();
+    capture->cond = SDL_CreateCondition();
+    if (capture->lock == NULL || capture->cond == NULL) {
+        SDL_DestroyRenderCapture(capture);
+        return NULL;
+    }
+
+    capture->thread = SDL_CreateThreadInternal(SDL_RenderCaptureThread, "SDLRenderCapture", 0, capture);
+    if (capture->thread == NULL) {
+        SDL_DestroyRenderCapture(capture);
+        return NULL;
+    }
+    return capture;
+}
+
+SDL_Surface *SDL_AcquireRenderCaptureSurface(SDL_RenderCapture *capture, int w, int h)
+{
+    SDL_RenderCaptureFrame *frame;
+
+    SDL_assert(capture->acquired == NULL);
+
+    SDL_LockMutex(capture->lock);
+    ++capture->frame_number;
+    frame = capture->free_frames;
+    if (frame) {
+        capture->free_frames = frame->next;
+        frame->next = NULL;
+        frame->frame_number = capture->frame_number;
+    } else {
+        ++capture->dropped;
+    }
+    SDL_UnlockMutex(capture->lock);
+
+    if (frame == NULL) {
+        return NULL;
+    }
+
+    /* The surfaces are reused until the output size changes */
+    if (frame->surface && (frame->surface->w != w || frame->surface->h != h)) {
+        SDL_DestroySurface(frame->surface);
+        frame->surface = NULL;
+    }
+    if (frame->surface == NULL) {
+        frame->surface = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_XRGB8888);
+        if (frame->surface == NULL) {
+            SDL_LockMutex(capture->lock);
+            ++capture->dropped;
+            frame->next = capture->free_frames;
+            capture->free_frames = frame;
+            SDL_UnlockMutex(capture->lock);
+            return NULL;
+        }
+    }
+
+    capture->acquired = frame;
+    return frame->surface;
+}
+
+void SDL_SubmitRenderCaptureSurface(SDL_RenderCapture *capture, SDL_Surface *surface, SDL_bool valid)
+{
+    SDL_RenderCaptureFrame *frame = capture->acquired;
+
+    SDL_assert(frame && frame->surface == surface);
+    capture->acquired = NULL;
+
+    SDL_LockMutex(capture->lock);
+    if (valid) {
+        ++capture->captured;
+        if (capture->queued_tail) {
+            capture->queued_tail->next = frame;
+        } else {
+            capture->queued_head = frame;
+        }
+        capture->queued_tail = frame;
+        SDL_BroadcastCondition(capture->cond);
+    } else {
+        ++capture->dropped;
+        frame->next = capture->free_frames;
+        capture->free_frames = frame;
+    }
+    SDL_UnlockMutex(capture->lock);
+}
+
+void SDL_GetRenderCaptureCounters(SDL_RenderCapture *capture, Uint64 *captured, Uint64 *written, Uint64 *dropped)
+{
+    SDL_LockMutex(capture->lock);
+    if (captured) {
+        *captured = capture->captured;
+    }
+    if (written) {
+        *written = capture->written;
+    }
+    if (dropped) {
+        *dropped = capture->dropped;
+    }
+    SDL_UnlockMutex(capture->lock);
+}
+
+void SDL_FlushRenderCapture(SDL_RenderCapture *capture)
+{
+    SDL_LockMutex(capture->lock);
+    while (capture->queued_head || capture->writing) {
+        SDL_WaitCondition(capture->cond, capture->lock);
+    }
+    SDL_UnlockMutex(capture->lock);
+}
+
+void SDL_DestroyRenderCapture(SDL_RenderCapture *capture)
+{
+    int i;
+
+    if (capture->thread) {
+        SDL_LockMutex(capture->lock);
+        capture->quit = SDL_TRUE;
+        SDL_BroadcastCondition(capture->cond);
+        SDL_UnlockMutex(capture->lock);
+
+        SDL_WaitThread(capture->thread, NULL);
+    }
+
+    SDL_DestroyCondition(capture->cond);
+    SDL_DestroyMutex(capture->lock);
+    if (capture->frames) {
+        for (i = 0; i < capture->num_frames; ++i) {
+            SDL_DestroySurface(capture->frames[i].surface);
+        }
+        SDL_free(capture->frames);
+    }
+    SDL_free(capture->prefix);
+    SDL_free(capture);
+}
@@ -0,0 +1,47 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_rendercapture_c_h_
+#define SDL_rendercapture_c_h_
+
+#include "SDL_internal.h"
+
+/* Background writing of frames captured by SDL_RenderPresent() */
+
+typedef struct SDL_RenderCapture SDL_RenderCapture;
+
+extern SDL_RenderCapture *SDL_CreateRenderCapture(const char *prefix, SDL_RenderCaptureFormat format, int max_queued_frames);
+
+/* Returns a free surface of the given size to read the frame into, or NULL if the frame should be dropped */
+extern SDL_Surface *SDL_AcquireRenderCaptureSurface(SDL_RenderCapture *capture, int w, int h);
+
+/* Queues the surface for writing, or returns it to the pool if the frame couldn't be read */
+extern void SDL_SubmitRenderCaptureSurface(SDL_RenderCapture *capture, SDL_Surface *surface, SDL_bool valid);
+
+extern void SDL_GetRenderCaptureCounters(SDL_RenderCapture *capture, Uint64 *captured, Uint64 *written, Uint64 *dropped);
+
+/* Waits for the queued frames to be written */
+extern void SDL_FlushRenderCapture(SDL_RenderCapture *capture);
+
+/* Writes the remaining queued frames and frees the capture */
+extern void SDL_DestroyRenderCapture(SDL_RenderCapture *capture);
+
+#endif /* SDL_rendercapture_c_h_ */
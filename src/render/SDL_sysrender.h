@@ -270,6 +270,12 @@ struct SDL_Renderer
     size_t vertex_data_used;
     size_t vertex_data_allocation;
 
+    /* Frame capture, see SDL_StartRenderCapture() */
+    struct SDL_RenderCapture *capture;
+    Uint64 capture_captured;
+    Uint64 capture_written;
+    Uint64 capture_dropped;
+
     void *driverdata;
 };
 
@@ -43,12 +43,103 @@ typedef struct
     SDL_bool surface_cliprect_dirty;
 } SW_DrawStateCache;
 
+/* The most areas of the window surface tracked separately between presents */
+#define SW_MAX_DAMAGE_RECTS 8
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    /* The areas of the window surface drawn since the last present */
+    int num_damage_rects;
+    SDL_Rect damage_rects[SW_MAX_DAMAGE_RECTS];
 } SW_RenderData;
 
+static void SW_DamageWindow(SW_RenderData *data)
+{
+    if (data->window) {
+        data->damage_rects[0].x = 0;
+        data->damage_rects[0].y = 0;
+        data->damage_rects[0].w = data->window->w;
+        data->damage_rects[0].h = data->window->h;
+        data->num_damage_rects = 1;
+    }
+}
+
+static void SW_AddDamage(SW_RenderData *data, SDL_Surface *surface, const SDL_Rect *rect)
+{
+    SDL_Rect damage;
+    int i;
+
+    /* Only drawing to the window surface needs to be presented */
+    if (surface != data->window) {
+        return;
+    }
+    if (!SDL_GetRectIntersection(rect, &surface->clip_rect, &damage)) {
+        return;
+    }
+
+    /* Merge with every area it touches, restarting since the union may now touch earlier ones */
+    i = 0;
+    while (i < data->num_damage_rects) {
+        if (SDL_HasRectIntersection(&damage, &data->damage_rects[i])) {
+            SDL_GetRectUnion(&damage, &data->damage_rects[i], &damage);
+            data->damage_rects[i] = data->damage_rects[--data->num_damage_rects];
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+
+    /* Out of room, merge with the area that grows the least */
+    if (data->num_damage_rects == SW_MAX_DAMAGE_RECTS) {
+        Sint64 best_growth = 0;
+        int best = 0;
+
+        for (i = 0; i < data->num_damage_rects; ++i) {
+            const SDL_Rect *other = &data->damage_rects[i];
+            SDL_Rect merged;
+            Sint64 growth;
+
+            SDL_GetRectUnion(&damage, other, &merged);
+            growth = (Sint64)merged.w * merged.h - (Sint64)other->w * other->h;
+            if (i == 0 || growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        SDL_GetRectUnion(&damage, &data->damage_rects[best], &damage);
+        data->damage_rects[best] = data->damage_rects[--data->num_damage_rects];
+    }
+
+    data->damage_rects[data->num_damage_rects++] = damage;
+}
+
+static void SW_AddPointsDamage(SW_RenderData *data, SDL_Surface *surface, const SDL_Point *points, int count)
+{
+    SDL_Rect bounds;
+    int i;
+
+    if (surface != data->window || count <= 0) {
+        return;
+    }
+
+    bounds.x = points[0].x;
+    bounds.y = points[0].y;
+    bounds.w = points[0].x;
+    bounds.h = points[0].y;
+    for (i = 1; i < count; ++i) {
+        bounds.x = SDL_min(bounds.x, points[i].x);
+        bounds.y = SDL_min(bounds.y, points[i].y);
+        bounds.w = SDL_max(bounds.w, points[i].x);
+        bounds.h = SDL_max(bounds.h, points[i].y);
+    }
+    bounds.w = bounds.w - bounds.x + 1;
+    bounds.h = bounds.h - bounds.y + 1;
+    SW_AddDamage(data, surface, &bounds);
+}
+
 static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
 {
     SW_RenderData *data = (SW_RenderData *)renderer->driverdata;
@@ -60,6 +151,9 @@ static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
         SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
         if (surface) {
             data->surface = data->window = surface;
+
+            /* Nothing of the new surface has been shown yet */
+            SW_DamageWindow(data);
         }
     }
     return data->surface;
@@ -72,6 +166,9 @@ static void SW_WindowEvent(SDL_Renderer *renderer, const SDL_WindowEvent *event)
     if (event->type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
         data->surface = NULL;
         data->window = NULL;
+        data->num_damage_rects = 0;
+    } else if (event->type == SDL_EVENT_WINDOW_EXPOSED) {
+        SW_DamageWindow(data);
     }
 }
 
@@ -660,6 +757,7 @@ static void SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
 
 static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SW_DrawStateCache drawstate;
 
@@ -702,6 +800,9 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             SDL_SetSurfaceClipRect(surface, NULL);
             SDL_FillSurfaceRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
             drawstate.surface_cliprect_dirty = SDL_TRUE;
+            if (surface == data->window) {
+                SW_DamageWindow(data);
+            }
             break;
         }
 
@@ -725,6 +826,8 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 }
             }
 
+            SW_AddPointsDamage(data, surface, verts, count);
+
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
             } else {
@@ -753,6 +856,8 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 }
             }
 
+            SW_AddPointsDamage(data, surface, verts, count);
+
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
             } else {
@@ -781,6 +886,13 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 }
             }
 
+            if (surface == data->window) {
+                int i;
+                for (i = 0; i < count; i++) {
+                    SW_AddDamage(data, surface, &verts[i]);
+                }
+            }
+
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_FillSurfaceRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
             } else {
@@ -807,6 +919,8 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 dstrect->y += drawstate.viewport->y;
             }
 
+            SW_AddDamage(data, surface, dstrect);
+
             if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
                 SDL_BlitSurface(src, srcrect, surface, dstrect);
             } else {
@@ -866,6 +980,9 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                 copydata->dstrect.y += drawstate.viewport->y;
             }
 
+            /* Rotation and scaling can reach anywhere in the clip rect */
+            SW_AddDamage(data, surface, &surface->clip_rect);
+
             SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
                             &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
                             copydata->scale_x, copydata->scale_y);
@@ -901,6 +1018,14 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                     }
                 }
 
+                if (surface == data->window) {
+                    for (i = 0; i + 2 < count; i += 3) {
+                        SDL_Rect bounds;
+                        SDL_SW_GetTriangleBounds(&ptr[i].dst, &ptr[i + 1].dst, &ptr[i + 2].dst, &bounds);
+                        SW_AddDamage(data, surface, &bounds);
+                    }
+                }
+
                 for (i = 0; i < count; i += 3, ptr += 3) {
                     SDL_SW_BlitTriangle(
                         src,
@@ -924,6 +1049,14 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
                     }
                 }
 
+                if (surface == data->window) {
+                    for (i = 0; i + 2 < count; i += 3) {
+                        SDL_Rect bounds;
+                        SDL_SW_GetTriangleBounds(&ptr[i].dst, &ptr[i + 1].dst, &ptr[i + 2].dst, &bounds);
+                        SW_AddDamage(data, surface, &bounds);
+                    }
+                }
+
                 for (i = 0; i < count; i += 3, ptr += 3) {
                     SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
                 }
@@ -973,12 +1106,25 @@ static int SW_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect,
 
 static int SW_RenderPresent(SDL_Renderer *renderer)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->driverdata;
     SDL_Window *window = renderer->window;
+    int retval;
 
     if (window == NULL) {
         return -1;
     }
-    return SDL_UpdateWindowSurface(window);
+    if (data->window == NULL) {
+        return SDL_UpdateWindowSurface(window);
+    }
+    if (data->num_damage_rects == 0) {
+        /* Nothing was drawn, the window already shows this frame */
+        return 0;
+    }
+
+    /* Only upload the areas that changed since the last present */
+    retval = SDL_UpdateWindowSurfaceRects(window, data->damage_rects, data->num_damage_rects);
+    data->num_damage_rects = 0;
+    return retval;
 }
 
 static void SW_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
@@ -1113,6 +1259,7 @@ SDL_Renderer *SW_CreateRendererForSurface(SDL_Surface *surface)
     }
     data->surface = surface;
     data->window = surface;
+    SW_DamageWindow(data);
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
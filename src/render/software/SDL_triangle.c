@@ -118,6 +118,20 @@ void trianglepoint_2_fixedpoint(SDL_Point *a)
     a->y <<= FP_BITS;
 }
 
+/* pixels possibly touched by a triangle (in fixed point), rounded outwards */
+void SDL_SW_GetTriangleBounds(const SDL_Point *d0, const SDL_Point *d1, const SDL_Point *d2, SDL_Rect *r)
+{
+    const int round = (1 << FP_BITS) - 1;
+    int min_x = SDL_min(d0->x, SDL_min(d1->x, d2->x));
+    int max_x = SDL_max(d0->x, SDL_max(d1->x, d2->x));
+    int min_y = SDL_min(d0->y, SDL_min(d1->y, d2->y));
+    int max_y = SDL_max(d0->y, SDL_max(d1->y, d2->y));
+    r->x = min_x >> FP_BITS;
+    r->y = min_y >> FP_BITS;
+    r->w = ((max_x + round) >> FP_BITS) - r->x + 1;
+    r->h = ((max_y + round) >> FP_BITS) - r->y + 1;
+}
+
 /* bounding rect of three points (in fixed point) */
 static void bounding_rect_fixedpoint(const SDL_Point *a, const SDL_Point *b, const SDL_Point *c, SDL_Rect *r)
 {
@@ -5184,17 +5184,199 @@ History:
 
 #endif /* !HAVE_MALLOC */
 
+#include "SDL_malloc_c.h"
+
 #ifdef HAVE_MALLOC
 static void* SDLCALL real_malloc(size_t s) { return malloc(s); }
 static void* SDLCALL real_calloc(size_t n, size_t s) { return calloc(n, s); }
 static void* SDLCALL real_realloc(void *p, size_t s) { return realloc(p,s); }
 static void  SDLCALL real_free(void *p) { free(p); }
+
+void SDL_FlushThreadMemoryCache(void)
+{
+}
+#else
+
+#if defined(_MSC_VER)
+#define SDL_MALLOC_THREAD_LOCAL __declspec(thread)
+#elif (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__LINUX__) || defined(__MACOS__) || defined(__WIN32__) || defined(__FREEBSD__))
+#define SDL_MALLOC_THREAD_LOCAL __thread
+#endif
+
+#ifdef SDL_MALLOC_THREAD_LOCAL
+/* Small blocks are cached per thread in front of dlmalloc, so most small
+   allocations don't need to take the global heap lock.
+
+   Size classes are 16 bytes apart up to 128 bytes, and four per power of
+   two above that. Requests are rounded up to their class and freed blocks
+   are filed by their usable size rounded down to a class, so any block in a
+   class can satisfy any request for that class.
+
+   The first block a thread caches registers the cache in the thread's SDL
+   thread local storage, so the blocks are returned to the heap when the
+   storage is destroyed as the thread exits. The thread doesn't cache any
+   more blocks after that.
+ */
+#define SDL_MALLOC_CACHE_CLASSES    16
+#define SDL_MALLOC_CACHE_MAX_BLOCKS 16
+#define SDL_MALLOC_CACHE_MAX_SIZE   512
+
+typedef struct SDL_MallocCacheBlock
+{
+    struct SDL_MallocCacheBlock *next;
+} SDL_MallocCacheBlock;
+
+typedef struct SDL_MallocCache
+{
+    SDL_MallocCacheBlock *blocks[SDL_MALLOC_CACHE_CLASSES];
+    int counts[SDL_MALLOC_CACHE_CLASSES];
+    int state; /* 0 if not registered yet, 1 if registered, -1 if blocks aren't cached */
+} SDL_MallocCache;
+
+static SDL_MALLOC_THREAD_LOCAL SDL_MallocCache SDL_malloc_cache;
+static SDL_AtomicInt SDL_malloc_cache_tls;
+
+/* Returns the smallest class that can hold size bytes, from 1 to SDL_MALLOC_CACHE_MAX_SIZE */
+static int SDL_GetMallocCacheClass(size_t size)
+{
+    int shift;
+
+    if (size <= 128) {
+        return (int)((size - 1) >> 4);
+    }
+    shift = SDL_MostSignificantBitIndex32((Uint32)(size - 1)) - 2;
+    return 4 + ((shift - 5) * 4) + (int)((size - 1) >> shift);
+}
+
+static size_t SDL_GetMallocCacheClassSize(int index)
+{
+    if (index < 8) {
+        return (size_t)(index + 1) << 4;
+    }
+    index -= 8;
+    return (size_t)(5 + (index & 3)) << (5 + (index >> 2));
+}
+
+static void SDLCALL SDL_StopMallocCache(void *value)
+{
+    /* SDL_FlushThreadMemoryCache() is called once the thread's storage is freed */
+    ((SDL_MallocCache *)value)->state = -1;
+}
+
+static SDL_bool SDL_RegisterMallocCache(SDL_MallocCache *cache)
+{
+    if (cache->state == 0) {
+        SDL_TLSID id = (SDL_TLSID)SDL_AtomicGet(&SDL_malloc_cache_tls);
+
+        if (id == 0) {
+            id = SDL_CreateTLS();
+            if (!SDL_AtomicCAS(&SDL_malloc_cache_tls, 0, (int)id)) {
+                id = (SDL_TLSID)SDL_AtomicGet(&SDL_malloc_cache_tls);
+            }
+        }
+
+        /* SDL_SetTLS() may allocate and free memory, don't cache it meanwhile */
+        cache->state = -1;
+        if (SDL_SetTLS(id, cache, SDL_StopMallocCache) == 0) {
+            cache->state = 1;
+        }
+    }
+    return (cache->state > 0);
+}
+
+static void *SDL_GetCachedBlock(size_t size)
+{
+    const int index = SDL_GetMallocCacheClass(size);
+    SDL_MallocCache *cache = &SDL_malloc_cache;
+    SDL_MallocCacheBlock *block = cache->blocks[index];
+
+    if (block) {
+        cache->blocks[index] = block->next;
+        --cache->counts[index];
+    }
+    return block;
+}
+
+static void* SDLCALL real_malloc(size_t s)
+{
+    if (s > 0 && s <= SDL_MALLOC_CACHE_MAX_SIZE) {
+        void *mem = SDL_GetCachedBlock(s);
+        if (mem) {
+            return mem;
+        }
+        /* Allocate the whole class, so the block can be cached later */
+        s = SDL_GetMallocCacheClassSize(SDL_GetMallocCacheClass(s));
+    }
+    return dlmalloc(s);
+}
+
+static void* SDLCALL real_calloc(size_t n, size_t s)
+{
+    size_t size;
+
+    if (SDL_size_mul_overflow(n, s, &size) == 0 && size > 0 && size <= SDL_MALLOC_CACHE_MAX_SIZE) {
+        void *mem = SDL_GetCachedBlock(size);
+        if (mem) {
+            SDL_memset(mem, 0, size);
+            return mem;
+        }
+    }
+    return dlcalloc(n, s);
+}
+
+static void* SDLCALL real_realloc(void *p, size_t s)
+{
+    if (p == NULL) {
+        return real_malloc(s);
+    }
+    return dlrealloc(p, s);
+}
+
+static void SDLCALL real_free(void *p)
+{
+    const size_t usable = p ? dlmalloc_usable_size(p) : 0;
+
+    if (usable >= 16 && usable < SDL_MALLOC_CACHE_MAX_SIZE * 2) {
+        const int index = (usable >= SDL_MALLOC_CACHE_MAX_SIZE) ? (SDL_MALLOC_CACHE_CLASSES - 1) : (SDL_GetMallocCacheClass(usable + 1) - 1);
+        SDL_MallocCache *cache = &SDL_malloc_cache;
+
+        if (cache->counts[index] < SDL_MALLOC_CACHE_MAX_BLOCKS && SDL_RegisterMallocCache(cache)) {
+            SDL_MallocCacheBlock *block = (SDL_MallocCacheBlock *)p;
+            block->next = cache->blocks[index];
+            cache->blocks[index] = block;
+            ++cache->counts[index];
+            return;
+        }
+    }
+    dlfree(p);
+}
+
+void SDL_FlushThreadMemoryCache(void)
+{
+    SDL_MallocCache *cache = &SDL_malloc_cache;
+    int i;
+
+    for (i = 0; i < SDL_MALLOC_CACHE_CLASSES; ++i) {
+        while (cache->blocks[i]) {
+            SDL_MallocCacheBlock *block = cache->blocks[i];
+            cache->blocks[i] = block->next;
+            dlfree(block);
+        }
+        cache->counts[i] = 0;
+    }
+}
 #else
 #define real_malloc dlmalloc
 #define real_calloc dlcalloc
 #define real_realloc dlrealloc
 #define real_free dlfree
-#endif
+
+void SDL_FlushThreadMemoryCache(void)
+{
+}
+#endif /* SDL_MALLOC_THREAD_LOCAL */
+#endif /* HAVE_MALLOC */
 
 /* Memory functions used by SDL that can be replaced by the application */
 static struct
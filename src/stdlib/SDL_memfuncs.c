@@ -0,0 +1,714 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* This file contains the memory and string functions used when SDL is built
+   without a C runtime. The first call picks the fastest version for the CPU. */
+
+#include "SDL_memfuncs_c.h"
+
+#if !defined(HAVE_MEMCPY) || !defined(HAVE_MEMMOVE) || !defined(HAVE_MEMSET) || !defined(HAVE_STRLEN)
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_LowestBitIndex(Uint32 mask)
+{
+#ifdef __GNUC__
+    return __builtin_ctz(mask);
+#else
+    int index = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+static void *SDL_memcpy_Scalar(void *dst, const void *src, size_t len)
+{
+    /* GCC 4.9.0 with -O3 will generate movaps instructions with the loop
+       using Uint32* pointers, so we need to make sure the pointers are
+       aligned before we loop using them.
+     */
+    if (((uintptr_t)src & 0x3) || ((uintptr_t)dst & 0x3)) {
+        /* Do an unaligned byte copy */
+        Uint8 *srcp1 = (Uint8 *)src;
+        Uint8 *dstp1 = (Uint8 *)dst;
+
+        while (len--) {
+            *dstp1++ = *srcp1++;
+        }
+    } else {
+        size_t left = (len % 4);
+        Uint32 *srcp4, *dstp4;
+        Uint8 *srcp1, *dstp1;
+
+        srcp4 = (Uint32 *)src;
+        dstp4 = (Uint32 *)dst;
+        len /= 4;
+        while (len--) {
+            *dstp4++ = *srcp4++;
+        }
+
+        srcp1 = (Uint8 *)srcp4;
+        dstp1 = (Uint8 *)dstp4;
+        switch (left) {
+        case 3:
+            *dstp1++ = *srcp1++;
+        case 2:
+            *dstp1++ = *srcp1++;
+        case 1:
+            *dstp1++ = *srcp1++;
+        }
+    }
+    return dst;
+}
+
+static void *SDL_memmove_Scalar(void *dst, const void *src, size_t len)
+{
+    char *srcp = (char *)src;
+    char *dstp = (char *)dst;
+
+    if (src < dst) {
+        srcp += len - 1;
+        dstp += len - 1;
+        while (len--) {
+            *dstp-- = *srcp--;
+        }
+    } else {
+        while (len--) {
+            *dstp++ = *srcp++;
+        }
+    }
+    return dst;
+}
+
+static void *SDL_memset_Scalar(void *dst, int c, size_t len)
+{
+    size_t left;
+    Uint32 *dstp4;
+    Uint8 *dstp1 = (Uint8 *)dst;
+    Uint8 value1;
+    Uint32 value4;
+
+    /* The value used in memset() is a byte, passed as an int */
+    c &= 0xff;
+
+    /* The destination pointer needs to be aligned on a 4-byte boundary to
+     * execute a 32-bit set. Set first bytes manually if needed until it is
+     * aligned. */
+    value1 = (Uint8)c;
+    while ((uintptr_t)dstp1 & 0x3) {
+        if (len--) {
+            *dstp1++ = value1;
+        } else {
+            return dst;
+        }
+    }
+
+    value4 = ((Uint32)c | ((Uint32)c << 8) | ((Uint32)c << 16) | ((Uint32)c << 24));
+    dstp4 = (Uint32 *)dstp1;
+    left = (len % 4);
+    len /= 4;
+    while (len--) {
+        *dstp4++ = value4;
+    }
+
+    dstp1 = (Uint8 *)dstp4;
+    switch (left) {
+    case 3:
+        *dstp1++ = value1;
+    case 2:
+        *dstp1++ = value1;
+    case 1:
+        *dstp1++ = value1;
+    }
+
+    return dst;
+}
+
+static size_t SDL_strlen_Scalar(const char *string)
+{
+    size_t len = 0;
+    while (*string++) {
+        ++len;
+    }
+    return len;
+}
+
+/* The vector versions below share the same approach:
+   - the first and last vector of a buffer are loaded and stored unaligned,
+     which lets the loop in between use aligned stores on the destination.
+   - the head and tail are loaded before anything is stored and are stored
+     last, and each loop iteration loads everything it stores, so the copy
+     loops work for overlapping buffers in the direction they walk in.
+   - strlen() only does aligned loads, starting with the vector holding the
+     first byte. An aligned load never crosses into a page the string doesn't
+     touch, even when it reads bytes before or after the string.
+ */
+
+#ifdef SDL_SSE2_INTRINSICS
+static void *SDL_TARGETING("sse2") SDL_memcpy_SSE2(void *dst, const void *src, size_t len)
+{
+    Uint8 *d = (Uint8 *)dst;
+    const Uint8 *s = (const Uint8 *)src;
+    __m128i head, tail;
+    size_t skip, left;
+
+    if (len < 16) {
+        if (len >= 8) {
+            head = _mm_loadl_epi64((const __m128i *)s);
+            tail = _mm_loadl_epi64((const __m128i *)(s + len - 8));
+            _mm_storel_epi64((__m128i *)d, head);
+            _mm_storel_epi64((__m128i *)(d + len - 8), tail);
+            return dst;
+        }
+        return SDL_memmove_Scalar(dst, src, len);
+    }
+
+    head = _mm_loadu_si128((const __m128i *)s);
+    tail = _mm_loadu_si128((const __m128i *)(s + len - 16));
+    skip = 16 - ((uintptr_t)d & 15);
+    left = len - skip;
+    d += skip;
+    s += skip;
+    while (left >= 64) {
+        const __m128i a = _mm_loadu_si128((const __m128i *)s);
+        const __m128i b = _mm_loadu_si128((const __m128i *)(s + 16));
+        const __m128i c = _mm_loadu_si128((const __m128i *)(s + 32));
+        const __m128i e = _mm_loadu_si128((const __m128i *)(s + 48));
+        _mm_store_si128((__m128i *)d, a);
+        _mm_store_si128((__m128i *)(d + 16), b);
+        _mm_store_si128((__m128i *)(d + 32), c);
+        _mm_store_si128((__m128i *)(d + 48), e);
+        d += 64;
+        s += 64;
+        left -= 64;
+    }
+    while (left >= 16) {
+        _mm_store_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+        d += 16;
+        s += 16;
+        left -= 16;
+    }
+    _mm_storeu_si128((__m128i *)dst, head);
+    _mm_storeu_si128((__m128i *)((Uint8 *)dst + len - 16), tail);
+    return dst;
+}
+
+/* Copies from the end, for a destination that overlaps the end of the source */
+static void *SDL_TARGETING("sse2") SDL_memmove_SSE2_Backwards(void *dst, const void *src, size_t len)
+{
+    Uint8 *d = (Uint8 *)dst;
+    const Uint8 *s = (const Uint8 *)src;
+    __m128i head, tail;
+    size_t left;
+
+    if (len < 16) {
+        return SDL_memmove_Scalar(dst, src, len);
+    }
+
+    head = _mm_loadu_si128((const __m128i *)s);
+    tail = _mm_loadu_si128((const __m128i *)(s + len - 16));
+    left = len - ((uintptr_t)(d + len) & 15);
+    while (left >= 64) {
+        __m128i a, b, c, e;
+        left -= 64;
+        a = _mm_loadu_si128((const __m128i *)(s + left));
+        b = _mm_loadu_si128((const __m128i *)(s + left + 16));
+        c = _mm_loadu_si128((const __m128i *)(s + left + 32));
+        e = _mm_loadu_si128((const __m128i *)(s + left + 48));
+        _mm_store_si128((__m128i *)(d + left), a);
+        _mm_store_si128((__m128i *)(d + left + 16), b);
+        _mm_store_si128((__m128i *)(d + left + 32), c);
+        _mm_store_si128((__m128i *)(d + left + 48), e);
+    }
+    while (left >= 16) {
+        left -= 16;
+        _mm_store_si128((__m128i *)(d + left), _mm_loadu_si128((const __m128i *)(s + left)));
+    }
+    _mm_storeu_si128((__m128i *)d, head);
+    _mm_storeu_si128((__m128i *)(d + len - 16), tail);
+    return dst;
+}
+
+static void *SDL_TARGETING("sse2") SDL_memmove_SSE2(void *dst, const void *src, size_t len)
+{
+    if ((const Uint8 *)src < (Uint8 *)dst && (Uint8 *)dst < (const Uint8 *)src + len) {
+        return SDL_memmove_SSE2_Backwards(dst, src, len);
+    }
+    return SDL_memcpy_SSE2(dst, src, len);
+}
+
+static void *SDL_TARGETING("sse2") SDL_memset_SSE2(void *dst, int c, size_t len)
+{
+    Uint8 *d = (Uint8 *)dst;
+    __m128i value;
+    size_t skip, left;
+
+    value = _mm_set1_epi8((char)c);
+    if (len < 16) {
+        if (len >= 8) {
+            _mm_storel_epi64((__m128i *)d, value);
+            _mm_storel_epi64((__m128i *)(d + len - 8), value);
+            return dst;
+        }
+        return SDL_memset_Scalar(dst, c, len);
+    }
+
+    _mm_storeu_si128((__m128i *)d, value);
+    _mm_storeu_si128((__m128i *)(d + len - 16), value);
+    skip = 16 - ((uintptr_t)d & 15);
+    left = len - skip;
+    d += skip;
+    while (left >= 64) {
+        _mm_store_si128((__m128i *)d, value);
+        _mm_store_si128((__m128i *)(d + 16), value);
+        _mm_store_si128((__m128i *)(d + 32), value);
+        _mm_store_si128((__m128i *)(d + 48), value);
+        d += 64;
+        left -= 64;
+    }
+    while (left >= 16) {
+        _mm_store_si128((__m128i *)d, value);
+        d += 16;
+        left -= 16;
+    }
+    return dst;
+}
+
+static size_t SDL_TARGETING("sse2") SDL_strlen_SSE2(const char *string)
+{
+    const char *p = (const char *)((uintptr_t)string & ~(uintptr_t)15);
+    const __m128i zero = _mm_setzero_si128();
+    Uint32 mask;
+
+    /* Bytes before the string in the first vector are ignored */
+    mask = (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *)p), zero));
+    mask >>= (string - p);
+    if (mask) {
+        return SDL_LowestBitIndex(mask);
+    }
+    p += 16;
+    if ((uintptr_t)p & 16) {
+        mask = (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i *)p), zero));
+        if (mask) {
+            return (size_t)(p - string) + SDL_LowestBitIndex(mask);
+        }
+        p += 16;
+    }
+
+    /* Two vectors at a time, both always in the same page */
+    for (;;) {
+        const __m128i a = _mm_load_si128((const __m128i *)p);
+        const __m128i b = _mm_load_si128((const __m128i *)(p + 16));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(a, b), zero))) {
+            mask = (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(a, zero));
+            mask |= (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(b, zero)) << 16;
+            return (size_t)(p - string) + SDL_LowestBitIndex(mask);
+        }
+        p += 32;
+    }
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#if defined(SDL_AVX2_INTRINSICS) && defined(SDL_SSE2_INTRINSICS)
+static void *SDL_TARGETING("avx2") SDL_memcpy_AVX2(void *dst, const void *src, size_t len)
+{
+    Uint8 *d = (Uint8 *)dst;
+    const Uint8 *s = (const Uint8 *)src;
+    __m256i head, tail;
+    size_t skip, left;
+
+    if (len < 32) {
+        return SDL_memcpy_SSE2(dst, src, len);
+    }
+
+    head = _mm256_loadu_si256((const __m256i *)s);
+    tail = _mm256_loadu_si256((const __m256i *)(s + len - 32));
+    skip = 32 - ((uintptr_t)d & 31);
+    left = len - skip;
+    d += skip;
+    s += skip;
+    while (left >= 128) {
+        const __m256i a = _mm256_loadu_si256((const __m256i *)s);
+        const __m256i b = _mm256_loadu_si256((const __m256i *)(s + 32));
+        const __m256i c = _mm256_loadu_si256((const __m256i *)(s + 64));
+        const __m256i e = _mm256_loadu_si256((const __m256i *)(s + 96));
+        _mm256_store_si256((__m256i *)d, a);
+        _mm256_store_si256((__m256i *)(d + 32), b);
+        _mm256_store_si256((__m256i *)(d + 64), c);
+        _mm256_store_si256((__m256i *)(d + 96), e);
+        d += 128;
+        s += 128;
+        left -= 128;
+    }
+    while (left >= 32) {
+        _mm256_store_si256((__m256i *)d, _mm256_loadu_si256((const __m256i *)s));
+        d += 32;
+        s += 32;
+        left -= 32;
+    }
+    _mm256_storeu_si256((__m256i *)dst, head);
+    _mm256_storeu_si256((__m256i *)((Uint8 *)dst + len - 32), tail);
+    return dst;
+}
+
+static void *SDL_TARGETING("avx2") SDL_memmove_AVX2(void *dst, const void *src, size_t len)
+{
+    Uint8 *d = (Uint8 *)dst;
+    const Uint8 *s = (const Uint8 *)src;
+    __m256i head, tail;
+    size_t left;
+
+    if (!(s < d && d < s + len)) {
+        return SDL_memcpy_AVX2(dst, src, len);
+    }
+    if (len < 32) {
+        return SDL_memmove_SSE2_Backwards(dst, src, len);
+    }
+
+    /* Copy from the end, the destination overlaps the end of the source */
+    head = _mm256_loadu_si256((const __m256i *)s);
+    tail = _mm256_loadu_si256((const __m256i *)(s + len - 32));
+    left = len - ((uintptr_t)(d + len) & 31);
+    while (left >= 128) {
+        __m256i a, b, c, e;
+        left -= 128;
+        a = _mm256_loadu_si256((const __m256i *)(s + left));
+        b = _mm256_loadu_si256((const __m256i *)(s + left + 32));
+        c = _mm256_loadu_si256((const __m256i *)(s + left + 64));
+        e = _mm256_loadu_si256((const __m256i *)(s + left + 96));
+        _mm256_store_si256((__m256i *)(d + left), a);
+        _mm256_store_si256((__m256i *)(d + left + 32), b);
+        _mm256_store_si256((__m256i *)(d + left + 64), c);
+        _mm256_store_si256((__m256i *)(d + left + 96), e);
+    }
+    while (left >= 32) {
+        left -= 32;
+        _mm256_store_si256((__m256i *)(d + left), _mm256_loadu_si256((const __m256i *)(s + left)));
+    }
+    _mm256_storeu_si256((__m256i *)d, head);
+    _mm256_storeu_si256((__m256i *)(d + len - 32), tail);
+    return dst;
+}
+
+static void *SDL_TARGETING("avx2") SDL_memset_AVX2(void *dst, int c, size_t len)
+{
+    Uint8 *d = (Uint8 *)dst;
+    __m256i value;
+    size_t skip, left;
+
+    if (len < 32) {
+        return SDL_memset_SSE2(dst, c, len);
+    }
+
+    value = _mm256_set1_epi8((char)c);
+    _mm256_storeu_si256((__m256i *)d, value);
+    _mm256_storeu_si256((__m256i *)(d + len - 32), value);
+    skip = 32 - ((uintptr_t)d & 31);
+    left = len - skip;
+    d += skip;
+    while (left >= 128) {
+        _mm256_store_si256((__m256i *)d, value);
+        _mm256_store_si256((__m256i *)(d + 32), value);
+        _mm256_store_si256((__m256i *)(d + 64), value);
+        _mm256_store_si256((__m256i *)(d + 96), value);
+        d += 128;
+        left -= 128;
+    }
+    while (left >= 32) {
+        _mm256_store_si256((__m256i *)d, value);
+        d += 32;
+        left -= 32;
+    }
+    return dst;
+}
+
+static size_t SDL_TARGETING("avx2") SDL_strlen_AVX2(const char *string)
+{
+    const char *p = (const char *)((uintptr_t)string & ~(uintptr_t)31);
+    const __m256i zero = _mm256_setzero_si256();
+    Uint32 mask;
+
+    /* Bytes before the string in the first vector are ignored */
+    mask = (Uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *)p), zero));
+    mask >>= (string - p);
+    if (mask) {
+        return SDL_LowestBitIndex(mask);
+    }
+    p += 32;
+    if ((uintptr_t)p & 32) {
+        mask = (Uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *)p), zero));
+        if (mask) {
+            return (size_t)(p - string) + SDL_LowestBitIndex(mask);
+        }
+        p += 32;
+    }
+
+    /* Two vectors at a time, both always in the same page */
+    for (;;) {
+        const __m256i a = _mm256_load_si256((const __m256i *)p);
+        const __m256i b = _mm256_load_si256((const __m256i *)(p + 32));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(a, b), zero))) {
+            mask = (Uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, zero));
+            if (mask) {
+                return (size_t)(p - string) + SDL_LowestBitIndex(mask);
+            }
+            mask = (Uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, zero));
+            return (size_t)(p + 32 - string) + SDL_LowestBitIndex(mask);
+        }
+        p += 64;
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS && SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static void *SDL_memcpy_NEON(void *dst, const void *src, size_t len)
+{
+    Uint8 *d = (Uint8 *)dst;
+    const Uint8 *s = (const Uint8 *)src;
+    uint8x16_t head, tail;
+    size_t skip, left;
+
+    if (len < 16) {
+        return SDL_memmove_Scalar(dst, src, len);
+    }
+
+    head = vld1q_u8(s);
+    tail = vld1q_u8(s + len - 16);
+    skip = 16 - ((uintptr_t)d & 15);
+    left = len - skip;
+    d += skip;
+    s += skip;
+    while (left >= 64) {
+        const uint8x16_t a = vld1q_u8(s);
+        const uint8x16_t b = vld1q_u8(s + 16);
+        const uint8x16_t c = vld1q_u8(s + 32);
+        const uint8x16_t e = vld1q_u8(s + 48);
+        vst1q_u8(d, a);
+        vst1q_u8(d + 16, b);
+        vst1q_u8(d + 32, c);
+        vst1q_u8(d + 48, e);
+        d += 64;
+        s += 64;
+        left -= 64;
+    }
+    while (left >= 16) {
+        vst1q_u8(d, vld1q_u8(s));
+        d += 16;
+        s += 16;
+        left -= 16;
+    }
+    vst1q_u8((Uint8 *)dst, head);
+    vst1q_u8((Uint8 *)dst + len - 16, tail);
+    return dst;
+}
+
+static void *SDL_memmove_NEON(void *dst, const void *src, size_t len)
+{
+    Uint8 *d = (Uint8 *)dst;
+    const Uint8 *s = (const Uint8 *)src;
+    uint8x16_t head, tail;
+    size_t left;
+
+    if (!(s < d && d < s + len)) {
+        return SDL_memcpy_NEON(dst, src, len);
+    }
+    if (len < 16) {
+        return SDL_memmove_Scalar(dst, src, len);
+    }
+
+    /* Copy from the end, the destination overlaps the end of the source */
+    head = vld1q_u8(s);
+    tail = vld1q_u8(s + len - 16);
+    left = len - ((uintptr_t)(d + len) & 15);
+    while (left >= 64) {
+        uint8x16_t a, b, c, e;
+        left -= 64;
+        a = vld1q_u8(s + left);
+        b = vld1q_u8(s + left + 16);
+        c = vld1q_u8(s + left + 32);
+        e = vld1q_u8(s + left + 48);
+        vst1q_u8(d + left, a);
+        vst1q_u8(d + left + 16, b);
+        vst1q_u8(d + left + 32, c);
+        vst1q_u8(d + left + 48, e);
+    }
+    while (left >= 16) {
+        left -= 16;
+        vst1q_u8(d + left, vld1q_u8(s + left));
+    }
+    vst1q_u8(d, head);
+    vst1q_u8(d + len - 16, tail);
+    return dst;
+}
+
+static void *SDL_memset_NEON(void *dst, int c, size_t len)
+{
+    Uint8 *d = (Uint8 *)dst;
+    uint8x16_t value;
+    size_t skip, left;
+
+    if (len < 16) {
+        return SDL_memset_Scalar(dst, c, len);
+    }
+
+    value = vdupq_n_u8((Uint8)c);
+    vst1q_u8(d, value);
+    vst1q_u8(d + len - 16, value);
+    skip = 16 - ((uintptr_t)d & 15);
+    left = len - skip;
+    d += skip;
+    while (left >= 64) {
+        vst1q_u8(d, value);
+        vst1q_u8(d + 16, value);
+        vst1q_u8(d + 32, value);
+        vst1q_u8(d + 48, value);
+        d += 64;
+        left -= 64;
+    }
+    while (left >= 16) {
+        vst1q_u8(d, value);
+        d += 16;
+        left -= 16;
+    }
+    return dst;
+}
+
+static size_t SDL_strlen_NEON(const char *string)
+{
+    const char *p = string;
+    const uint8x16_t zero = vdupq_n_u8(0);
+
+    while ((uintptr_t)p & 15) {
+        if (!*p) {
+            return (size_t)(p - string);
+        }
+        ++p;
+    }
+    for (;;) {
+        const uint64x2_t found = vreinterpretq_u64_u8(vceqq_u8(vld1q_u8((const Uint8 *)p), zero));
+        if (vgetq_lane_u64(found, 0) | vgetq_lane_u64(found, 1)) {
+            while (*p) {
+                ++p;
+            }
+            return (size_t)(p - string);
+        }
+        p += 16;
+    }
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+static void *SDL_memcpy_Choose(void *dst, const void *src, size_t len);
+static void *SDL_memmove_Choose(void *dst, const void *src, size_t len);
+static void *SDL_memset_Choose(void *dst, int c, size_t len);
+static size_t SDL_strlen_Choose(const char *string);
+
+static void *(*SDL_memcpy_Impl)(void *dst, const void *src, size_t len) = SDL_memcpy_Choose;
+static void *(*SDL_memmove_Impl)(void *dst, const void *src, size_t len) = SDL_memmove_Choose;
+static void *(*SDL_memset_Impl)(void *dst, int c, size_t len) = SDL_memset_Choose;
+static size_t (*SDL_strlen_Impl)(const char *string) = SDL_strlen_Choose;
+
+static void SDL_ChooseMemFuncs(void)
+{
+    /* Querying the CPU might use these functions itself, so make sure that
+       works before asking. Threads racing here all pick the same functions. */
+    SDL_memcpy_Impl = SDL_memcpy_Scalar;
+    SDL_memmove_Impl = SDL_memmove_Scalar;
+    SDL_memset_Impl = SDL_memset_Scalar;
+    SDL_strlen_Impl = SDL_strlen_Scalar;
+
+#if defined(SDL_AVX2_INTRINSICS) && defined(SDL_SSE2_INTRINSICS)
+    if (SDL_HasAVX2()) {
+        SDL_memcpy_Impl = SDL_memcpy_AVX2;
+        SDL_memmove_Impl = SDL_memmove_AVX2;
+        SDL_memset_Impl = SDL_memset_AVX2;
+        SDL_strlen_Impl = SDL_strlen_AVX2;
+        return;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SDL_memcpy_Impl = SDL_memcpy_SSE2;
+        SDL_memmove_Impl = SDL_memmove_SSE2;
+        SDL_memset_Impl = SDL_memset_SSE2;
+        SDL_strlen_Impl = SDL_strlen_SSE2;
+        return;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SDL_memcpy_Impl = SDL_memcpy_NEON;
+        SDL_memmove_Impl = SDL_memmove_NEON;
+        SDL_memset_Impl = SDL_memset_NEON;
+        SDL_strlen_Impl = SDL_strlen_NEON;
+        return;
+    }
+#endif
+}
+
+static void *SDL_memcpy_Choose(void *dst, const void *src, size_t len)
+{
+    SDL_ChooseMemFuncs();
+    return SDL_memcpy_Impl(dst, src, len);
+}
+
+static void *SDL_memmove_Choose(void *dst, const void *src, size_t len)
+{
+    SDL_ChooseMemFuncs();
+    return SDL_memmove_Impl(dst, src, len);
+}
+
+static void *SDL_memset_Choose(void *dst, int c, size_t len)
+{
+    SDL_ChooseMemFuncs();
+    return SDL_memset_Impl(dst, c, len);
+}
+
+static size_t SDL_strlen_Choose(const char *string)
+{
+    SDL_ChooseMemFuncs();
+    return SDL_strlen_Impl(string);
+}
+
+void *SDL_memcpy_NoLibc(void *dst, const void *src, size_t len)
+{
+    return SDL_memcpy_Impl(dst, src, len);
+}
+
+void *SDL_memmove_NoLibc(void *dst, const void *src, size_t len)
+{
+    return SDL_memmove_Impl(dst, src, len);
+}
+
+void *SDL_memset_NoLibc(void *dst, int c, size_t len)
+{
+    return SDL_memset_Impl(dst, c, len);
+}
+
+size_t SDL_strlen_NoLibc(const char *string)
+{
+    return SDL_strlen_Impl(string);
+}
+
+#endif /* !HAVE_MEMCPY || !HAVE_MEMMOVE || !HAVE_MEMSET || !HAVE_STRLEN */
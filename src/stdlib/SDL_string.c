@@ -23,6 +23,7 @@
 /* This file contains portable string manipulation functions for SDL */
 
 #include "SDL_vacopy.h"
+#include "SDL_memfuncs_c.h"
 
 #ifdef __vita__
 #include <psp2/kernel/clib.h>
@@ -330,21 +331,7 @@ void *SDL_memmove(SDL_OUT_BYTECAP(len) void *dst, SDL_IN_BYTECAP(len) const void
 #ifdef HAVE_MEMMOVE
     return memmove(dst, src, len);
 #else
-    char *srcp = (char *)src;
-    char *dstp = (char *)dst;
-
-    if (src < dst) {
-        srcp += len - 1;
-        dstp += len - 1;
-        while (len--) {
-            *dstp-- = *srcp--;
-        }
-    } else {
-        while (len--) {
-            *dstp++ = *srcp++;
-        }
-    }
-    return dst;
+    return SDL_memmove_NoLibc(dst, src, len);
 #endif /* HAVE_MEMMOVE */
 }
 
@@ -382,11 +369,7 @@ size_t SDL_strlen(const char *string)
 #ifdef HAVE_STRLEN
     return strlen(string);
 #else
-    size_t len = 0;
-    while (*string++) {
-        ++len;
-    }
-    return len;
+    return SDL_strlen_NoLibc(string);
 #endif /* HAVE_STRLEN */
 }
 
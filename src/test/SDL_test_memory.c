@@ -48,6 +48,17 @@ static SDL_realloc_func SDL_realloc_orig = NULL;
 static SDL_free_func SDL_free_orig = NULL;
 static int s_previous_allocations = 0;
 static SDL_tracked_allocation *s_tracked_allocations[256];
+static SDLTest_MemoryStats s_stats;
+static SDL_SpinLock s_tracker_lock;
+
+#define LOCK_ALLOCATOR()                    \
+    do {                                    \
+        SDL_AtomicLock(&s_tracker_lock);    \
+    } while (0)
+#define UNLOCK_ALLOCATOR()                  \
+    do {                                    \
+        SDL_AtomicUnlock(&s_tracker_lock);  \
+    } while (0)
 
 static unsigned int get_allocation_bucket(void *mem)
 {
@@ -62,11 +73,15 @@ static SDL_bool SDL_IsAllocationTracked(void *mem)
 {
     SDL_tracked_allocation *entry;
     int index = get_allocation_bucket(mem);
+
+    LOCK_ALLOCATOR();
     for (entry = s_tracked_allocations[index]; entry; entry = entry->next) {
         if (mem == entry->mem) {
+            UNLOCK_ALLOCATOR();
             return SDL_TRUE;
         }
     }
+    UNLOCK_ALLOCATOR();
     return SDL_FALSE;
 }
 
@@ -116,8 +131,43 @@ static void SDL_TrackAllocation(void *mem, size_t size)
     }
 #endif /* HAVE_LIBUNWIND_H */
 
+    LOCK_ALLOCATOR();
     entry->next = s_tracked_allocations[index];
     s_tracked_allocations[index] = entry;
+
+    ++s_stats.allocations;
+    ++s_stats.total_allocations;
+    s_stats.bytes_in_use += size;
+    if (s_stats.bytes_in_use > s_stats.peak_bytes_in_use) {
+        s_stats.peak_bytes_in_use = s_stats.bytes_in_use;
+    }
+    for (index = 0; index < SDLTEST_MEMORY_SIZE_CLASSES - 1; ++index) {
+        if (size <= ((size_t)16 << index)) {
+            break;
+        }
+    }
+    ++s_stats.size_classes[index];
+    UNLOCK_ALLOCATOR();
+}
+
+static void SDL_ResizeTrackedAllocation(void *mem, size_t size)
+{
+    SDL_tracked_allocation *entry;
+    int index = get_allocation_bucket(mem);
+
+    LOCK_ALLOCATOR();
+    for (entry = s_tracked_allocations[index]; entry; entry = entry->next) {
+        if (mem == entry->mem) {
+            s_stats.bytes_in_use -= entry->size;
+            s_stats.bytes_in_use += size;
+            if (s_stats.bytes_in_use > s_stats.peak_bytes_in_use) {
+                s_stats.peak_bytes_in_use = s_stats.bytes_in_use;
+            }
+            entry->size = size;
+            break;
+        }
+    }
+    UNLOCK_ALLOCATOR();
 }
 
 static void SDL_UntrackAllocation(void *mem)
@@ -125,6 +175,7 @@ static void SDL_UntrackAllocation(void *mem)
     SDL_tracked_allocation *entry, *prev;
     int index = get_allocation_bucket(mem);
 
+    LOCK_ALLOCATOR();
     prev = NULL;
     for (entry = s_tracked_allocations[index]; entry; entry = entry->next) {
         if (mem == entry->mem) {
@@ -133,11 +184,15 @@ static void SDL_UntrackAllocation(void *mem)
             } else {
                 s_tracked_allocations[index] = entry->next;
             }
+            --s_stats.allocations;
+            s_stats.bytes_in_use -= entry->size;
+            UNLOCK_ALLOCATOR();
             SDL_free_orig(entry);
             return;
         }
         prev = entry;
     }
+    UNLOCK_ALLOCATOR();
 }
 
 static void *SDLCALL SDLTest_TrackedMalloc(size_t size)
@@ -168,7 +223,10 @@ static void *SDLCALL SDLTest_TrackedRealloc(void *ptr, size_t size)
 
     SDL_assert(ptr == NULL || SDL_IsAllocationTracked(ptr));
     mem = SDL_realloc_orig(ptr, size);
-    if (mem && mem != ptr) {
+    if (mem && mem == ptr) {
+        /* Keep the original stack trace, only the size changed */
+        SDL_ResizeTrackedAllocation(mem, size);
+    } else if (mem) {
         if (ptr) {
             SDL_UntrackAllocation(ptr);
         }
@@ -215,6 +273,17 @@ int SDLTest_TrackAllocations(void)
     return 0;
 }
 
+void SDLTest_GetMemoryStats(SDLTest_MemoryStats *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    LOCK_ALLOCATOR();
+    *stats = s_stats;
+    UNLOCK_ALLOCATOR();
+}
+
 void SDLTest_LogAllocations(void)
 {
     char *message = NULL;
@@ -268,6 +337,8 @@ void SDLTest_LogAllocations(void)
     }
     (void)SDL_snprintf(line, sizeof(line), "Total: %.2f Kb in %d allocations\n", total_allocated / 1024.0, count);
     ADD_LINE();
+    (void)SDL_snprintf(line, sizeof(line), "Peak: %.2f Kb, %" SDL_PRIu64 " allocations made\n", s_stats.peak_bytes_in_use / 1024.0, s_stats.total_allocations);
+    ADD_LINE();
 #undef ADD_LINE
 
     SDL_Log("%s", message);
@@ -25,6 +25,7 @@
 #include "SDL_thread_c.h"
 #include "SDL_systhread.h"
 #include "../SDL_error_c.h"
+#include "../stdlib/SDL_malloc_c.h"
 
 SDL_TLSID SDL_CreateTLS(void)
 {
@@ -76,20 +77,29 @@ int SDL_SetTLS(SDL_TLSID id, const void *value, void(SDLCALL *destructor)(void *
     return 0;
 }
 
+void SDL_DestroyTLSData(SDL_TLSData *storage)
+{
+    unsigned int i;
+
+    for (i = 0; i < storage->limit; ++i) {
+        if (storage->array[i].destructor) {
+            storage->array[i].destructor(storage->array[i].data);
+        }
+    }
+    SDL_free(storage);
+
+    /* Return any small blocks cached by this thread to the heap */
+    SDL_FlushThreadMemoryCache();
+}
+
 void SDL_CleanupTLS(void)
 {
     SDL_TLSData *storage;
 
     storage = SDL_SYS_GetTLSData();
     if (storage) {
-        unsigned int i;
-        for (i = 0; i < storage->limit; ++i) {
-            if (storage->array[i].destructor) {
-                storage->array[i].destructor(storage->array[i].data);
-            }
-        }
         SDL_SYS_SetTLSData(NULL);
-        SDL_free(storage);
+        SDL_DestroyTLSData(storage);
     }
 }
 
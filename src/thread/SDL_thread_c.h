@@ -89,6 +89,11 @@ typedef struct
 /* This is how many TLS entries we allocate at once */
 #define TLS_ALLOC_CHUNKSIZE 4
 
+/* Call the destructors for a thread's storage and free it.
+   This is used when a thread that SDL didn't create exits.
+ */
+extern void SDL_DestroyTLSData(SDL_TLSData *storage);
+
 /* Get cross-platform, slow, thread local storage for this thread.
    This is only intended as a fallback if getting real thread-local
    storage fails or isn't supported on this platform.
@@ -29,6 +29,12 @@
 static pthread_key_t thread_local_storage = INVALID_PTHREAD_KEY;
 static SDL_bool generic_local_storage = SDL_FALSE;
 
+static void SDL_SYS_DestroyTLSData(void *data)
+{
+    /* SDL threads clean up before exiting, so this is a thread SDL didn't create */
+    SDL_DestroyTLSData((SDL_TLSData *)data);
+}
+
 SDL_TLSData *SDL_SYS_GetTLSData(void)
 {
     if (thread_local_storage == INVALID_PTHREAD_KEY && !generic_local_storage) {
@@ -36,7 +42,7 @@ SDL_TLSData *SDL_SYS_GetTLSData(void)
         SDL_AtomicLock(&lock);
         if (thread_local_storage == INVALID_PTHREAD_KEY && !generic_local_storage) {
             pthread_key_t storage;
-            if (pthread_key_create(&storage, NULL) == 0) {
+            if (pthread_key_create(&storage, SDL_SYS_DestroyTLSData) == 0) {
                 SDL_MemoryBarrierRelease();
                 thread_local_storage = storage;
             } else {
@@ -33,6 +33,7 @@
 */
 
 #include "SDL_pixels_c.h"
+#include "../SDL_utils_c.h"
 
 #define SAVE_32BIT_BMP
 
@@ -164,35 +165,234 @@ static SDL_bool readRlePixels(SDL_Surface *surface, SDL_RWops *src, int isRle8)
     }
 }
 
-static void CorrectAlphaChannel(SDL_Surface *surface)
+/* Large images are flipped and converted on several threads, a band of rows each */
+
+/* Results of processing rows, or'ed together across all the threads */
+#define BMP_ROWS_HAVE_ALPHA 0x01
+#define BMP_ROWS_BAD_PIXEL  0x02
+#define BMP_ROWS_FAILED     0x04
+
+typedef struct BMP_RowJob
+{
+    void (*process)(struct BMP_RowJob *job);
+    const void *userdata;
+    int first_row;
+    int num_rows;
+    int result;
+} BMP_RowJob;
+
+static void BMP_RunRowJob(void *userdata, int index, int first, int count)
+{
+    BMP_RowJob *job = &((BMP_RowJob *)userdata)[index];
+    job->first_row = first;
+    job->num_rows = count;
+    job->process(job);
+}
+
+/* Runs process on every row, returns the results of all the jobs */
+static int BMP_ProcessRows(void (*process)(BMP_RowJob *job), const void *userdata, int rows, size_t bytes)
+{
+    BMP_RowJob jobs[SDL_PARALLEL_MAX_JOBS];
+    const int numjobs = SDL_GetParallelJobCount(rows, bytes);
+    int i, result = 0;
+
+    for (i = 0; i < numjobs; ++i) {
+        jobs[i].process = process;
+        jobs[i].userdata = userdata;
+        jobs[i].result = 0;
+    }
+    SDL_RunParallel(numjobs, rows, BMP_RunRowJob, jobs);
+    for (i = 0; i < numjobs; ++i) {
+        result |= jobs[i].result;
+    }
+    return result;
+}
+
+static void BMP_SwapRows(Uint8 *a, Uint8 *b, size_t len)
+{
+    Uint8 tmp[256];
+
+    while (len > 0) {
+        const size_t n = SDL_min(len, sizeof(tmp));
+        SDL_memcpy(tmp, a, n);
+        SDL_memcpy(a, b, n);
+        SDL_memcpy(b, tmp, n);
+        a += n;
+        b += n;
+        len -= n;
+    }
+}
+
+static void BMP_ReverseRows(Uint8 *bits, int rows, int pitch, int bw)
+{
+    int i;
+
+    for (i = 0; i < rows / 2; ++i) {
+        BMP_SwapRows(bits + (size_t)i * pitch, bits + (size_t)(rows - 1 - i) * pitch, bw);
+    }
+}
+
+/* Bottom-up images are read in bands that stay in the cache while they're flipped */
+#define BMP_LOAD_BAND_BYTES (64 * 1024)
+
+typedef struct
 {
-    /* Check to see if there is any alpha channel data */
-    SDL_bool hasAlpha = SDL_FALSE;
+    SDL_Surface *surface;
+    const Uint8 *packed;   /* The 1, 2 or 4 bpp pixel array, NULL if it was read into the surface */
+    int packed_pitch;
+    int expand;            /* Bits per packed pixel */
+    SDL_bool flip;         /* The packed image is stored bottom-up */
+    Uint32 ncolors;        /* Pixels must be below this, 0 if they can't be out of the palette */
+    SDL_bool check_alpha;  /* 32-bit image that may or may not have an alpha channel */
+} BMP_LoadRows;
+
+/* Byte swaps, validates and checks the alpha channel of a row in one pass,
+ * the alpha channel only needs to be checked until some alpha is found.
+ */
+static int BMP_FixRow(const BMP_LoadRows *load, Uint8 *bits, SDL_bool check_alpha)
+{
+    const int w = load->surface->w;
+    int i, result = 0;
+
+    if (load->ncolors) {
+        for (i = 0; i < w; ++i) {
+            if (bits[i] >= load->ncolors) {
+                return BMP_ROWS_BAD_PIXEL;
+            }
+        }
+    }
+
 #if SDL_BYTEORDER == SDL_BIG_ENDIAN
-    int alphaChannelOffset = 0;
-#else
-    int alphaChannelOffset = 3;
-#endif
-    Uint8 *alpha = ((Uint8 *)surface->pixels) + alphaChannelOffset;
-    Uint8 *end = alpha + surface->h * surface->pitch;
+    /* Byte-swap the pixels if needed. Note that the 24bpp
+       case has already been taken care of above. */
+    if (!load->packed) {
+        switch (load->surface->format->BitsPerPixel) {
+        case 15:
+        case 16:
+        {
+            Uint16 *pix = (Uint16 *)bits;
+            for (i = 0; i < w; i++) {
+                pix[i] = SDL_Swap16(pix[i]);
+            }
+            break;
+        }
 
-    while (alpha < end) {
-        if (*alpha != 0) {
-            hasAlpha = SDL_TRUE;
+        case 32:
+        {
+            Uint32 *pix = (Uint32 *)bits;
+            for (i = 0; i < w; i++) {
+                pix[i] = SDL_Swap32(pix[i]);
+            }
             break;
         }
-        alpha += 4;
+        }
+    }
+#endif
+
+    if (check_alpha) {
+        /* The pixels are ARGB8888 in native byte order by now */
+        const Uint32 *pix = (const Uint32 *)bits;
+        Uint32 any = 0;
+        for (i = 0; i < w; ++i) {
+            any |= pix[i];
+        }
+        if (any & 0xFF000000) {
+            result |= BMP_ROWS_HAVE_ALPHA;
+        }
     }
+    return result;
+}
 
-    if (!hasAlpha) {
-        alpha = ((Uint8 *)surface->pixels) + alphaChannelOffset;
-        while (alpha < end) {
-            *alpha = SDL_ALPHA_OPAQUE;
-            alpha += 4;
+static void BMP_LoadRowsJob(BMP_RowJob *job)
+{
+    const BMP_LoadRows *load = (const BMP_LoadRows *)job->userdata;
+    SDL_Surface *surface = load->surface;
+    Uint8 *pixels = (Uint8 *)surface->pixels;
+    const int h = surface->h;
+    const int pitch = surface->pitch;
+    const SDL_bool check_alpha = load->check_alpha;
+    int y, i;
+
+    for (y = job->first_row; y < job->first_row + job->num_rows; ++y) {
+        Uint8 *bits = pixels + (size_t)y * pitch;
+
+        if (load->packed) {
+            const Uint8 *src = load->packed + (size_t)(load->flip ? (h - 1 - y) : y) * load->packed_pitch;
+            const int shift = (8 - load->expand);
+            Uint8 pixel = 0;
+
+            for (i = 0; i < surface->w; ++i) {
+                if (i % (8 / load->expand) == 0) {
+                    pixel = *src++;
+                }
+                bits[i] = (pixel >> shift);
+                pixel <<= load->expand;
+            }
+        }
+        job->result |= BMP_FixRow(load, bits, check_alpha && !(job->result & BMP_ROWS_HAVE_ALPHA));
+    }
+}
+
+static void BMP_SetOpaqueJob(BMP_RowJob *job)
+{
+    const SDL_Surface *surface = (const SDL_Surface *)job->userdata;
+    int y, i;
+
+    for (y = job->first_row; y < job->first_row + job->num_rows; ++y) {
+        Uint32 *pix = (Uint32 *)((Uint8 *)surface->pixels + (size_t)y * surface->pitch);
+        for (i = 0; i < surface->w; ++i) {
+            pix[i] |= 0xFF000000;
         }
     }
 }
 
+typedef struct
+{
+    SDL_Surface *surface; /* Locked */
+    Uint32 format;        /* The format of the file */
+    Uint8 *bits;          /* The pixel array of the file */
+    int pitch;            /* The row size in the file, including padding */
+    int bw;               /* The row size in the file, without padding */
+} BMP_SaveRows;
+
+/* Rows are converted in small chunks that stay in the cache while they're flipped */
+#define BMP_SAVE_CHUNK_ROWS 16
+
+static void BMP_SaveRowsJob(BMP_RowJob *job)
+{
+    const BMP_SaveRows *save = (const BMP_SaveRows *)job->userdata;
+    SDL_Surface *surface = save->surface;
+    const int last = job->first_row + job->num_rows;
+    int y = job->first_row;
+    int i;
+
+    while (y < last) {
+        const int n = SDL_min(BMP_SAVE_CHUNK_ROWS, last - y);
+        const Uint8 *src = (const Uint8 *)surface->pixels + (size_t)y * surface->pitch;
+        /* The file is bottom-up, convert the chunk to where it ends up and reverse it there */
+        Uint8 *dst = save->bits + (size_t)(surface->h - y - n) * save->pitch;
+
+        if (surface->format->format == save->format) {
+            for (i = 0; i < n; ++i) {
+                SDL_memcpy(dst + (size_t)(n - 1 - i) * save->pitch, src + (size_t)i * surface->pitch, save->bw);
+            }
+        } else {
+            if (SDL_ConvertPixels(surface->w, n, surface->format->format, src, surface->pitch,
+                                  save->format, dst, save->pitch) < 0) {
+                job->result |= BMP_ROWS_FAILED;
+                return;
+            }
+            BMP_ReverseRows(dst, n, save->pitch, save->bw);
+        }
+        if (save->pitch > save->bw) {
+            for (i = 0; i < n; ++i) {
+                SDL_memset(dst + (size_t)i * save->pitch + save->bw, 0, save->pitch - save->bw);
+            }
+        }
+        y += n;
+    }
+}
+
 SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
 {
     SDL_bool was_error = SDL_TRUE;
@@ -205,8 +405,10 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
     Uint32 Bmask = 0;
     Uint32 Amask = 0;
     SDL_Palette *palette;
-    Uint8 *bits;
-    Uint8 *top, *end;
+    BMP_LoadRows load;
+    Uint8 *packed = NULL;
+    size_t imageSize;
+    int result;
     SDL_bool topDown;
     int ExpandBMP;
     SDL_bool haveRGBMasks = SDL_FALSE;
@@ -472,23 +674,18 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
             }
         }
 
-        if (biSize == 12) {
-            for (i = 0; i < (int)biClrUsed; ++i) {
-                if (!SDL_ReadU8(src, &palette->colors[i].b) ||
-                    !SDL_ReadU8(src, &palette->colors[i].g) ||
-                    !SDL_ReadU8(src, &palette->colors[i].r)) {
-                    goto done;
-                }
-                palette->colors[i].a = SDL_ALPHA_OPAQUE;
+        /* Read the whole color table at once, BITMAPCOREHEADER entries don't have the reserved byte */
+        {
+            const int entrysize = (biSize == 12) ? 3 : 4;
+            Uint8 entries[256 * 4];
+
+            if (SDL_RWread(src, entries, biClrUsed * entrysize) != biClrUsed * entrysize) {
+                goto done;
             }
-        } else {
             for (i = 0; i < (int)biClrUsed; ++i) {
-                if (!SDL_ReadU8(src, &palette->colors[i].b) ||
-                    !SDL_ReadU8(src, &palette->colors[i].g) ||
-                    !SDL_ReadU8(src, &palette->colors[i].r) ||
-                    !SDL_ReadU8(src, &palette->colors[i].a)) {
-                    goto done;
-                }
+                palette->colors[i].b = entries[i * entrysize + 0];
+                palette->colors[i].g = entries[i * entrysize + 1];
+                palette->colors[i].r = entries[i * entrysize + 2];
 
                 /* According to Microsoft documentation, the fourth element
                    is reserved and must be zero, so we shouldn't treat it as
@@ -512,113 +709,74 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
         }
         goto done;
     }
-    top = (Uint8 *)surface->pixels;
-    end = (Uint8 *)surface->pixels + (surface->h * surface->pitch);
-    switch (ExpandBMP) {
-    case 1:
-        bmpPitch = (biWidth + 7) >> 3;
-        pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
-        break;
-    case 2:
-        bmpPitch = (biWidth + 3) >> 2;
-        pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
-        break;
-    case 4:
-        bmpPitch = (biWidth + 1) >> 1;
-        pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
-        break;
-    default:
-        pad = ((surface->pitch % 4) ? (4 - (surface->pitch % 4)) : 0);
-        break;
-    }
-    if (topDown) {
-        bits = top;
-    } else {
-        bits = end - surface->pitch;
-    }
-    while (bits >= top && bits < end) {
+    /* Read the pixel array with as few reads as possible, then expand and validate it in one pass */
+    SDL_zero(load);
+    load.surface = surface;
+    load.flip = !topDown;
+    load.check_alpha = correctAlpha;
+    imageSize = (size_t)surface->h * surface->pitch;
+    if (ExpandBMP) {
         switch (ExpandBMP) {
         case 1:
+            bmpPitch = (biWidth + 7) >> 3;
+            break;
         case 2:
-        case 4:
-        {
-            Uint8 pixel = 0;
-            int shift = (8 - ExpandBMP);
-            for (i = 0; i < surface->w; ++i) {
-                if (i % (8 / ExpandBMP) == 0) {
-                    if (!SDL_ReadU8(src, &pixel)) {
-                        goto done;
-                    }
-                }
-                bits[i] = (pixel >> shift);
-                if (bits[i] >= biClrUsed) {
-                    SDL_SetError("A BMP image contains a pixel with a color out of the palette");
-                    goto done;
-                }
-                pixel <<= ExpandBMP;
-            }
-        } break;
-
+            bmpPitch = (biWidth + 3) >> 2;
+            break;
         default:
-            if (SDL_RWread(src, bits, surface->pitch) != surface->pitch) {
+            bmpPitch = (biWidth + 1) >> 1;
+            break;
+        }
+        pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
+        packed = (Uint8 *)SDL_malloc((size_t)surface->h * (bmpPitch + pad));
+        if (packed == NULL) {
+            SDL_OutOfMemory();
+            goto done;
+        }
+        if (SDL_RWread(src, packed, (size_t)surface->h * (bmpPitch + pad)) != (size_t)surface->h * (bmpPitch + pad)) {
+            goto done;
+        }
+        load.packed = packed;
+        load.packed_pitch = bmpPitch + pad;
+        load.expand = ExpandBMP;
+        load.ncolors = biClrUsed;
+    } else {
+        /* Surface rows are padded to 4 bytes, just like the rows in the file */
+        if (topDown) {
+            if (SDL_RWread(src, surface->pixels, imageSize) != imageSize) {
                 goto done;
             }
-            if (biBitCount == 8 && palette && biClrUsed < (1u << biBitCount)) {
-                for (i = 0; i < surface->w; ++i) {
-                    if (bits[i] >= biClrUsed) {
-                        SDL_SetError("A BMP image contains a pixel with a color out of the palette");
-                        goto done;
-                    }
-                }
-            }
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-            /* Byte-swap the pixels if needed. Note that the 24bpp
-               case has already been taken care of above. */
-            switch (biBitCount) {
-            case 15:
-            case 16:
-            {
-                Uint16 *pix = (Uint16 *)bits;
-                for (i = 0; i < surface->w; i++) {
-                    pix[i] = SDL_Swap16(pix[i]);
-                }
-                break;
-            }
+        } else {
+            const int band = SDL_max(BMP_LOAD_BAND_BYTES / surface->pitch, 1);
+            int y, n;
 
-            case 32:
-            {
-                Uint32 *pix = (Uint32 *)bits;
-                for (i = 0; i < surface->w; i++) {
-                    pix[i] = SDL_Swap32(pix[i]);
-                }
-                break;
-            }
-            }
-#endif
-            break;
-        }
-        /* Skip padding bytes, ugh */
-        if (pad) {
-            Uint8 padbyte;
-            for (i = 0; i < pad; ++i) {
-                if (!SDL_ReadU8(src, &padbyte)) {
+            for (y = surface->h; y > 0; y -= n) {
+                Uint8 *bits = (Uint8 *)surface->pixels + (size_t)(y - SDL_min(band, y)) * surface->pitch;
+                n = SDL_min(band, y);
+                if (SDL_RWread(src, bits, (size_t)n * surface->pitch) != (size_t)n * surface->pitch) {
                     goto done;
                 }
+                BMP_ReverseRows(bits, n, surface->pitch, surface->pitch);
             }
         }
-        if (topDown) {
-            bits += surface->pitch;
-        } else {
-            bits -= surface->pitch;
+        if (biBitCount == 8 && palette && biClrUsed < (1u << biBitCount)) {
+            load.ncolors = biClrUsed;
         }
     }
-    if (correctAlpha) {
-        CorrectAlphaChannel(surface);
+    result = BMP_ProcessRows(BMP_LoadRowsJob, &load, surface->h, imageSize);
+    if (result & BMP_ROWS_BAD_PIXEL) {
+        SDL_SetError("A BMP image contains a pixel with a color out of the palette");
+        goto done;
+    }
+    if (correctAlpha && !(result & BMP_ROWS_HAVE_ALPHA)) {
+        /* The alpha channel is all zero, so it isn't actually used */
+        BMP_ProcessRows(BMP_SetOpaqueJob, surface, surface->h, imageSize);
     }
 
     was_error = SDL_FALSE;
 
 done:
+    SDL_free(packed);
     if (was_error) {
         if (src) {
             SDL_RWseek(src, fp_offset, SDL_RW_SEEK_SET);
@@ -641,9 +799,13 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
 {
     SDL_bool was_error = SDL_TRUE;
     Sint64 fp_offset, new_offset;
-    int i, pad;
+    int i;
     SDL_Surface *intermediate_surface;
-    Uint8 *bits;
+    Uint32 pixel_format = SDL_PIXELFORMAT_UNKNOWN;
+    SDL_Palette *palette;
+    BMP_SaveRows save;
+    Uint8 *bits = NULL;
+    SDL_bool locked = SDL_FALSE;
     SDL_bool save32bit = SDL_FALSE;
     SDL_bool saveLegacyBMP = SDL_FALSE;
 
@@ -698,6 +860,7 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
         if (surface->format->palette != NULL && !save32bit) {
             if (surface->format->BitsPerPixel == 8) {
                 intermediate_surface = surface;
+                pixel_format = surface->format->format;
             } else {
                 SDL_SetError("%d bpp BMP files not supported",
                              surface->format->BitsPerPixel);
@@ -715,9 +878,8 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
 #endif
         ) {
             intermediate_surface = surface;
+            pixel_format = surface->format->format;
         } else {
-            Uint32 pixel_format;
-
             /* If the surface has a colorkey or alpha channel we'll save a
                32-bit BMP with alpha channel, otherwise save a 24-bit BMP. */
             if (save32bit) {
@@ -725,11 +887,19 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
             } else {
                 pixel_format = SDL_PIXELFORMAT_BGR24;
             }
-            intermediate_surface = SDL_ConvertSurfaceFormat(surface, pixel_format);
-            if (intermediate_surface == NULL) {
-                SDL_SetError("Couldn't convert image to %d bpp",
-                             (int)SDL_BITSPERPIXEL(pixel_format));
-                goto done;
+
+            /* The pixels are converted while they're written, unless the
+               colorkey or the palette has to be turned into alpha first. */
+            if (surface->format->palette != NULL ||
+                surface->map->info.flags & SDL_COPY_COLORKEY) {
+                intermediate_surface = SDL_ConvertSurfaceFormat(surface, pixel_format);
+                if (intermediate_surface == NULL) {
+                    SDL_SetError("Couldn't convert image to %d bpp",
+                                 (int)SDL_BITSPERPIXEL(pixel_format));
+                    goto done;
+                }
+            } else {
+                intermediate_surface = surface;
             }
         }
     } else {
@@ -742,8 +912,14 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
         saveLegacyBMP = SDL_GetHintBoolean(SDL_HINT_BMP_SAVE_LEGACY_FORMAT, SDL_FALSE);
     }
 
+    palette = SDL_ISPIXELFORMAT_INDEXED(pixel_format) ? intermediate_surface->format->palette : NULL;
+
     if (SDL_LockSurface(intermediate_surface) == 0) {
-        const int bw = intermediate_surface->w * intermediate_surface->format->BytesPerPixel;
+        const int bw = intermediate_surface->w * SDL_BYTESPERPIXEL(pixel_format);
+        const int bmpPitch = (bw + 3) & ~3;
+        const size_t imageSize = (size_t)intermediate_surface->h * bmpPitch;
+
+        locked = SDL_TRUE;
 
         /* Set the BMP file header values */
         bfSize = 0; /* We'll write this when we're done */
@@ -769,13 +945,13 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
         biWidth = intermediate_surface->w;
         biHeight = intermediate_surface->h;
         biPlanes = 1;
-        biBitCount = intermediate_surface->format->BitsPerPixel;
+        biBitCount = SDL_BITSPERPIXEL(pixel_format);
         biCompression = BI_RGB;
-        biSizeImage = intermediate_surface->h * intermediate_surface->pitch;
+        biSizeImage = (Uint32)imageSize;
         biXPelsPerMeter = 0;
         biYPelsPerMeter = 0;
-        if (intermediate_surface->format->palette) {
-            biClrUsed = intermediate_surface->format->palette->ncolors;
+        if (palette) {
+            biClrUsed = palette->ncolors;
         } else {
             biClrUsed = 0;
         }
@@ -833,12 +1009,12 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
         }
 
         /* Write the palette (in BGR color order) */
-        if (intermediate_surface->format->palette) {
+        if (palette) {
             SDL_Color *colors;
             int ncolors;
 
-            colors = intermediate_surface->format->palette->colors;
-            ncolors = intermediate_surface->format->palette->ncolors;
+            colors = palette->colors;
+            ncolors = palette->ncolors;
             for (i = 0; i < ncolors; ++i) {
                 if (!SDL_WriteU8(dst, colors[i].b) ||
                     !SDL_WriteU8(dst, colors[i].g) ||
@@ -861,22 +1037,24 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
             goto done;
         }
 
-        /* Write the bitmap image upside down */
-        bits = (Uint8 *)intermediate_surface->pixels + (intermediate_surface->h * intermediate_surface->pitch);
-        pad = ((bw % 4) ? (4 - (bw % 4)) : 0);
-        while (bits > (Uint8 *)intermediate_surface->pixels) {
-            bits -= intermediate_surface->pitch;
-            if (SDL_RWwrite(dst, bits, bw) != bw) {
-                goto done;
-            }
-            if (pad) {
-                const Uint8 padbyte = 0;
-                for (i = 0; i < pad; ++i) {
-                    if (!SDL_WriteU8(dst, padbyte)) {
-                        goto done;
-                    }
-                }
-            }
+        /* Convert and flip the whole bitmap into file order, then write it at once */
+        bits = (Uint8 *)SDL_malloc(imageSize);
+        if (bits == NULL) {
+            SDL_OutOfMemory();
+            goto done;
+        }
+        save.surface = intermediate_surface;
+        save.format = pixel_format;
+        save.bits = bits;
+        save.pitch = bmpPitch;
+        save.bw = bw;
+        if (BMP_ProcessRows(BMP_SaveRowsJob, &save, intermediate_surface->h, imageSize) & BMP_ROWS_FAILED) {
+            SDL_SetError("Couldn't convert image to %d bpp",
+                         (int)SDL_BITSPERPIXEL(pixel_format));
+            goto done;
+        }
+        if (SDL_RWwrite(dst, bits, imageSize) != imageSize) {
+            goto done;
         }
 
         /* Write the BMP file size */
@@ -895,13 +1073,14 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
             goto done;
         }
 
-        /* Close it up.. */
-        SDL_UnlockSurface(intermediate_surface);
-
         was_error = SDL_FALSE;
     }
 
 done:
+    SDL_free(bits);
+    if (locked) {
+        SDL_UnlockSurface(intermediate_surface);
+    }
     if (intermediate_surface && intermediate_surface != surface) {
         SDL_DestroySurface(intermediate_surface);
     }
@@ -652,8 +652,47 @@ void SDL_DestroyPixelFormat(SDL_PixelFormat *format)
     return;
 }
 
+/* Palettes made by SDL_CreatePalette(), with room for the SDL_FindColor() cache.
+ * They're kept in a table so SDL_FindColor() can tell them apart from palettes
+ * the application set up itself, which aren't cached because SDL can't tell
+ * when they go away.
+ */
+typedef struct SDL_PaletteInternal
+{
+    SDL_Palette palette;
+    void *cache; /* The SDL_PaletteCache, made the first time it's needed */
+    struct SDL_PaletteInternal *next;
+} SDL_PaletteInternal;
+
+#define SDL_PALETTE_BUCKETS 64
+
+static SDL_PaletteInternal *palettes[SDL_PALETTE_BUCKETS];
+static SDL_SpinLock palettes_lock = 0;
+
+static SDL_PaletteInternal **SDL_GetPaletteBucket(const SDL_Palette *palette)
+{
+    return &palettes[((uintptr_t)palette >> 4) % SDL_PALETTE_BUCKETS];
+}
+
+static SDL_PaletteInternal *SDL_GetPaletteInternal(const SDL_Palette *palette)
+{
+    SDL_PaletteInternal *internal;
+
+    SDL_AtomicLock(&palettes_lock);
+    for (internal = *SDL_GetPaletteBucket(palette); internal; internal = internal->next) {
+        if (&internal->palette == palette) {
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&palettes_lock);
+
+    return internal;
+}
+
 SDL_Palette *SDL_CreatePalette(int ncolors)
 {
+    SDL_PaletteInternal *internal;
+    SDL_PaletteInternal **bucket;
     SDL_Palette *palette;
 
     /* Input validation */
@@ -662,24 +701,32 @@ SDL_Palette *SDL_CreatePalette(int ncolors)
         return NULL;
     }
 
-    palette = (SDL_Palette *)SDL_malloc(sizeof(*palette));
-    if (palette == NULL) {
+    internal = (SDL_PaletteInternal *)SDL_malloc(sizeof(*internal));
+    if (internal == NULL) {
         SDL_OutOfMemory();
         return NULL;
     }
+    palette = &internal->palette;
     palette->colors =
         (SDL_Color *)SDL_malloc(ncolors * sizeof(*palette->colors));
     if (!palette->colors) {
-        SDL_free(palette);
+        SDL_free(internal);
         SDL_OutOfMemory();
         return NULL;
     }
     palette->ncolors = ncolors;
     palette->version = 1;
     palette->refcount = 1;
+    internal->cache = NULL;
 
     SDL_memset(palette->colors, 0xFF, ncolors * sizeof(*palette->colors));
 
+    SDL_AtomicLock(&palettes_lock);
+    bucket = SDL_GetPaletteBucket(palette);
+    internal->next = *bucket;
+    *bucket = internal;
+    SDL_AtomicUnlock(&palettes_lock);
+
     return palette;
 }
 
@@ -738,12 +785,29 @@ int SDL_SetPaletteColors(SDL_Palette *palette, const SDL_Color *colors,
 
 void SDL_DestroyPalette(SDL_Palette *palette)
 {
+    SDL_PaletteInternal *internal = NULL;
+    SDL_PaletteInternal **prev;
+
     if (palette == NULL) {
         return;
     }
     if (--palette->refcount > 0) {
         return;
     }
+
+    SDL_AtomicLock(&palettes_lock);
+    for (prev = SDL_GetPaletteBucket(palette); *prev; prev = &(*prev)->next) {
+        if (&(*prev)->palette == palette) {
+            internal = *prev;
+            *prev = internal->next;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&palettes_lock);
+
+    if (internal) {
+        SDL_free(internal->cache);
+    }
     SDL_free(palette->colors);
     SDL_free(palette);
 }
@@ -776,10 +840,18 @@ void SDL_DitherColors(SDL_Color *colors, int bpp)
     }
 }
 
-/*
- * Match an RGB value to a particular palette index
- */
-Uint8 SDL_FindColor(SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+/* Remembers what SDL_FindColor() found for opaque colors, so mapping an image doesn't search the palette for every pixel */
+#define SDL_PALETTE_CACHE_BITS       12
+#define SDL_PALETTE_CACHE_SIZE       (1 << SDL_PALETTE_CACHE_BITS)
+#define SDL_PALETTE_CACHE_MIN_COLORS 16 /* smaller palettes are quicker to search than to cache */
+
+typedef struct SDL_PaletteCache
+{
+    Uint32 version; /* the palette version the entries were found with */
+    Uint32 entries[SDL_PALETTE_CACHE_SIZE]; /* The low bits of the hashed RGB above the palette index + 1 in the low 9 bits, or 0 if empty */
+} SDL_PaletteCache;
+
+static Uint8 SDL_FindColorScalar(const SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
     /* Do colorspace distance matching */
     unsigned int smallest;
@@ -806,6 +878,138 @@ Uint8 SDL_FindColor(SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
     return pixel;
 }
 
+#ifdef SDL_SSE2_INTRINSICS
+/* Same result as SDL_FindColorScalar(): the lowest index of the closest colors */
+static Uint8 SDL_TARGETING("sse2") SDL_FindColorSSE2(const SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i target = _mm_set_epi16(a, b, g, r, a, b, g, r);
+    const __m128i four = _mm_set1_epi32(4);
+    const int count = pal->ncolors & ~3;
+    __m128i index = _mm_set_epi32(3, 2, 1, 0);
+    __m128i best_distance = _mm_set1_epi32(0x7FFFFFFF);
+    __m128i best_index = zero;
+    int distances[4], indices[4];
+    int smallest, i;
+    Uint8 pixel;
+
+    /* Four palette entries at a time; SDL_Color is four bytes, r, g, b, a */
+    for (i = 0; i < count; i += 4) {
+        const __m128i colors = _mm_loadu_si128((const __m128i *)&pal->colors[i]);
+        __m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(colors, zero), target);
+        __m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(colors, zero), target);
+        __m128i distance, closer;
+
+        /* r*r+g*g and b*b+a*a for each entry, then add the halves together */
+        lo = _mm_madd_epi16(lo, lo);
+        hi = _mm_madd_epi16(hi, hi);
+        distance = _mm_add_epi32(
+            _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0))),
+            _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(3, 1, 3, 1))));
+
+        /* Strictly closer, so each lane keeps the first of equally close entries */
+        closer = _mm_cmplt_epi32(distance, best_distance);
+        best_distance = _mm_or_si128(_mm_and_si128(closer, distance), _mm_andnot_si128(closer, best_distance));
+        best_index = _mm_or_si128(_mm_and_si128(closer, index), _mm_andnot_si128(closer, best_index));
+        index = _mm_add_epi32(index, four);
+    }
+    _mm_storeu_si128((__m128i *)distances, best_distance);
+    _mm_storeu_si128((__m128i *)indices, best_index);
+
+    smallest = distances[0];
+    pixel = (Uint8)indices[0];
+    for (i = 1; i < 4; ++i) {
+        if (distances[i] < smallest || (distances[i] == smallest && indices[i] < pixel)) {
+            smallest = distances[i];
+            pixel = (Uint8)indices[i];
+        }
+    }
+
+    /* The leftover entries come after everything above, so they only win if they're closer */
+    for (i = count; i < pal->ncolors; ++i) {
+        const int rd = pal->colors[i].r - r;
+        const int gd = pal->colors[i].g - g;
+        const int bd = pal->colors[i].b - b;
+        const int ad = pal->colors[i].a - a;
+        const int distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+        if (distance < smallest) {
+            smallest = distance;
+            pixel = (Uint8)i;
+        }
+    }
+    return pixel;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+static Uint8 SDL_SearchPalette(const SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (pal->ncolors >= 8 && SDL_HasSSE2()) {
+        return SDL_FindColorSSE2(pal, r, g, b, a);
+    }
+#endif
+    return SDL_FindColorScalar(pal, r, g, b, a);
+}
+
+/*
+ * Match an RGB value to a particular palette index
+ */
+Uint8 SDL_FindColor(SDL_Palette *pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    SDL_PaletteInternal *internal;
+    SDL_PaletteCache *cache;
+    Uint32 hash, cached, *entry;
+    Uint8 pixel;
+
+    if (a != SDL_ALPHA_OPAQUE || pal->ncolors <= SDL_PALETTE_CACHE_MIN_COLORS) {
+        return SDL_SearchPalette(pal, r, g, b, a);
+    }
+
+    internal = SDL_GetPaletteInternal(pal);
+    if (internal == NULL) {
+        return SDL_SearchPalette(pal, r, g, b, a);
+    }
+
+    /* Several threads can map colors with the same palette, so the first one to make a cache publishes it */
+    cache = (SDL_PaletteCache *)SDL_AtomicGetPtr(&internal->cache);
+    if (cache == NULL) {
+        SDL_PaletteCache *new_cache = (SDL_PaletteCache *)SDL_malloc(sizeof(*new_cache));
+        if (new_cache == NULL) {
+            return SDL_SearchPalette(pal, r, g, b, a); /* no cache, but still a right answer */
+        }
+        new_cache->version = 0; /* palette versions start at 1, so this gets cleared below */
+        if (SDL_AtomicCASPtr(&internal->cache, NULL, new_cache)) {
+            cache = new_cache;
+        } else {
+            SDL_free(new_cache);
+            cache = (SDL_PaletteCache *)SDL_AtomicGetPtr(&internal->cache);
+        }
+    }
+    if (cache->version != pal->version) {
+        SDL_memset(cache->entries, 0, sizeof(cache->entries));
+        SDL_MemoryBarrierRelease(); /* the entries are cleared before anyone sees the new version */
+        cache->version = pal->version;
+    } else {
+        SDL_MemoryBarrierAcquire();
+    }
+
+    /* Entries are a single Uint32, so a reader on another thread sees a whole entry or none.
+     * Multiplying by an odd number can be undone, so the slot holding the top
+     * bits of the hash and the entry holding the rest tell exactly which RGB
+     * it is, leaving room to store the index + 1 and keep 0 for empty entries. */
+    hash = (((Uint32)r << 16) | ((Uint32)g << 8) | b) * 2654435761u;
+    entry = &cache->entries[hash >> (32 - SDL_PALETTE_CACHE_BITS)];
+    hash &= (1u << (32 - SDL_PALETTE_CACHE_BITS)) - 1;
+    cached = *entry;
+    if (cached && (cached >> 9) == hash) {
+        return (Uint8)((cached & 0x1FF) - 1);
+    }
+
+    pixel = SDL_SearchPalette(pal, r, g, b, a);
+    *entry = (hash << 9) | (pixel + 1u);
+    return pixel;
+}
+
 /* Tell whether palette is opaque, and if it has an alpha_channel */
 void SDL_DetectPalette(SDL_Palette *pal, SDL_bool *is_opaque, SDL_bool *has_alpha_channel)
 {
@@ -27,6 +27,7 @@
 #include "SDL_yuv_c.h"
 #include "../render/SDL_sysrender.h"
 #include "../video/SDL_yuv_c.h"
+#include "../SDL_utils_c.h"
 
 /* Check to make sure we can safely check multiplication of surface w and pitch and it won't overflow size_t */
 SDL_COMPILE_TIME_ASSERT(surface_size_assumptions,
@@ -354,7 +355,351 @@ int SDL_GetSurfaceColorKey(SDL_Surface *surface, Uint32 *key)
     return 0;
 }
 
-/* This is a fairly slow function to switch from colorkey to alpha
+/* Large alpha conversions are done on several threads, a band of rows each */
+
+/* Where the channels of a 32-bit pixel with 8 bits of alpha are */
+typedef struct
+{
+    Uint8 Rshift;
+    Uint8 Gshift;
+    Uint8 Bshift;
+    Uint8 Ashift;
+    Uint8 alpha_byte; /* The offset of the alpha byte in memory */
+} SDL_Alpha8888Layout;
+
+typedef struct SDL_AlphaRowJob SDL_AlphaRowJob;
+
+/* Converts one row, returns how many pixels were converted */
+typedef int (*SDL_AlphaRowFunc)(const SDL_AlphaRowJob *job, const Uint32 *src, Uint32 *dst);
+
+struct SDL_AlphaRowJob
+{
+    SDL_AlphaRowFunc process;
+    SDL_AlphaRowFunc kernel; /* Converts the start of a row with SIMD, may be NULL */
+    int width;
+    const Uint8 *src;
+    int src_pitch;
+    Uint8 *dst;
+    int dst_pitch;
+    SDL_Alpha8888Layout src_layout;
+    SDL_Alpha8888Layout dst_layout;
+    Uint32 key;          /* The color key, already masked with compare_mask */
+    Uint32 compare_mask; /* The bits of a pixel compared with the color key */
+    Uint32 alpha_mask;
+};
+
+static SDL_bool SDL_GetAlpha8888Layout(Uint32 format, SDL_Alpha8888Layout *layout)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+        layout->Ashift = 24;
+        layout->Rshift = 16;
+        layout->Gshift = 8;
+        layout->Bshift = 0;
+        break;
+    case SDL_PIXELFORMAT_RGBA8888:
+        layout->Rshift = 24;
+        layout->Gshift = 16;
+        layout->Bshift = 8;
+        layout->Ashift = 0;
+        break;
+    case SDL_PIXELFORMAT_ABGR8888:
+        layout->Ashift = 24;
+        layout->Bshift = 16;
+        layout->Gshift = 8;
+        layout->Rshift = 0;
+        break;
+    case SDL_PIXELFORMAT_BGRA8888:
+        layout->Bshift = 24;
+        layout->Gshift = 16;
+        layout->Rshift = 8;
+        layout->Ashift = 0;
+        break;
+    default:
+        return SDL_FALSE;
+    }
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    layout->alpha_byte = layout->Ashift / 8;
+#else
+    layout->alpha_byte = 3 - layout->Ashift / 8;
+#endif
+    return SDL_TRUE;
+}
+
+static void SDL_RunAlphaRowJob(void *userdata, int index, int first, int count)
+{
+    const SDL_AlphaRowJob *job = (const SDL_AlphaRowJob *)userdata;
+    const Uint8 *src = job->src + (Sint64)first * job->src_pitch;
+    Uint8 *dst = job->dst + (Sint64)first * job->dst_pitch;
+    int y;
+
+    for (y = 0; y < count; ++y) {
+        job->process(job, (const Uint32 *)src, (Uint32 *)dst);
+        src += job->src_pitch;
+        dst += job->dst_pitch;
+    }
+}
+
+/* Runs job->process on every row, splitting them across threads */
+static void SDL_ProcessAlphaRows(const SDL_AlphaRowJob *job, int rows)
+{
+    const int numjobs = SDL_GetParallelJobCount(rows, (size_t)rows * job->width * 4);
+    SDL_RunParallel(numjobs, rows, SDL_RunAlphaRowJob, (void *)job);
+}
+
+/* The SIMD kernels only run when the source and destination layouts match,
+ * so they only need to know which byte of each pixel is alpha. They divide
+ * by 255 as (x + (x >> 8) + 1) >> 8, which is exact for every product of
+ * two bytes, so they give the same results as the scalar code.
+ */
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") SDL_PremultiplyAlphaRow_SSE2(const SDL_AlphaRowJob *job, const Uint32 *src, Uint32 *dst)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i byte_mask = _mm_set1_epi32(0xFF);
+    const __m128i shift = _mm_cvtsi32_si128(job->src_layout.alpha_byte * 8);
+    const __m128i alpha_mask = _mm_sll_epi32(byte_mask, shift);
+    int x;
+
+    for (x = 0; x + 4 <= job->width; x += 4) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)(src + x));
+        __m128i alpha = _mm_and_si128(_mm_srl_epi32(pixels, shift), byte_mask);
+        __m128i alpha_lo, alpha_hi, lo, hi, result;
+
+        /* Spread the alpha of each pixel over its four 16-bit channels */
+        alpha = _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16));
+        alpha_lo = _mm_unpacklo_epi32(alpha, alpha);
+        alpha_hi = _mm_unpackhi_epi32(alpha, alpha);
+
+        lo = _mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), alpha_lo);
+        hi = _mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), alpha_hi);
+        lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), one), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), one), 8);
+        result = _mm_packus_epi16(lo, hi);
+
+        /* Keep the original alpha */
+        result = _mm_or_si128(_mm_andnot_si128(alpha_mask, result), _mm_and_si128(alpha_mask, pixels));
+        _mm_storeu_si128((__m128i *)(dst + x), result);
+    }
+    return x;
+}
+
+static int SDL_TARGETING("sse2") SDL_ColorkeyToAlphaRow_SSE2(const SDL_AlphaRowJob *job, const Uint32 *src, Uint32 *dst)
+{
+    const __m128i key = _mm_set1_epi32((int)job->key);
+    const __m128i compare_mask = _mm_set1_epi32((int)job->compare_mask);
+    const __m128i alpha_mask = _mm_set1_epi32((int)job->alpha_mask);
+    int x;
+
+    for (x = 0; x + 4 <= job->width; x += 4) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)(src + x));
+        const __m128i match = _mm_cmpeq_epi32(_mm_and_si128(pixels, compare_mask), key);
+        _mm_storeu_si128((__m128i *)(dst + x), _mm_andnot_si128(_mm_and_si128(match, alpha_mask), pixels));
+    }
+    return x;
+}
+#endif /* SDL_SSE2_INTRINSICS */
+
+#if defined(SDL_AVX2_INTRINSICS) && defined(SDL_SSE2_INTRINSICS)
+static int SDL_TARGETING("avx2") SDL_PremultiplyAlphaRow_AVX2(const SDL_AlphaRowJob *job, const Uint32 *src, Uint32 *dst)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i byte_mask = _mm256_set1_epi32(0xFF);
+    const __m128i shift = _mm_cvtsi32_si128(job->src_layout.alpha_byte * 8);
+    const __m256i alpha_mask = _mm256_sll_epi32(byte_mask, shift);
+    int x;
+
+    /* The unpacks and the pack all work within 128-bit lanes, so the pixels stay in order */
+    for (x = 0; x + 8 <= job->width; x += 8) {
+        const __m256i pixels = _mm256_loadu_si256((const __m256i *)(src + x));
+        __m256i alpha = _mm256_and_si256(_mm256_srl_epi32(pixels, shift), byte_mask);
+        __m256i alpha_lo, alpha_hi, lo, hi, result;
+
+        alpha = _mm256_or_si256(alpha, _mm256_slli_epi32(alpha, 16));
+        alpha_lo = _mm256_unpacklo_epi32(alpha, alpha);
+        alpha_hi = _mm256_unpackhi_epi32(alpha, alpha);
+
+        lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(pixels, zero), alpha_lo);
+        hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(pixels, zero), alpha_hi);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), one), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), one), 8);
+        result = _mm256_packus_epi16(lo, hi);
+
+        result = _mm256_or_si256(_mm256_andnot_si256(alpha_mask, result), _mm256_and_si256(alpha_mask, pixels));
+        _mm256_storeu_si256((__m256i *)(dst + x), result);
+    }
+    return x;
+}
+
+static int SDL_TARGETING("avx2") SDL_ColorkeyToAlphaRow_AVX2(const SDL_AlphaRowJob *job, const Uint32 *src, Uint32 *dst)
+{
+    const __m256i key = _mm256_set1_epi32((int)job->key);
+    const __m256i compare_mask = _mm256_set1_epi32((int)job->compare_mask);
+    const __m256i alpha_mask = _mm256_set1_epi32((int)job->alpha_mask);
+    int x;
+
+    for (x = 0; x + 8 <= job->width; x += 8) {
+        const __m256i pixels = _mm256_loadu_si256((const __m256i *)(src + x));
+        const __m256i match = _mm256_cmpeq_epi32(_mm256_and_si256(pixels, compare_mask), key);
+        _mm256_storeu_si256((__m256i *)(dst + x), _mm256_andnot_si256(_mm256_and_si256(match, alpha_mask), pixels));
+    }
+    return x;
+}
+#endif /* SDL_AVX2_INTRINSICS && SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+static uint8x16_t SDL_MultiplyAlpha_NEON(uint8x16_t color, uint8x16_t alpha)
+{
+    const uint16x8_t one = vdupq_n_u16(1);
+    uint16x8_t lo = vmull_u8(vget_low_u8(color), vget_low_u8(alpha));
+    uint16x8_t hi = vmull_u8(vget_high_u8(color), vget_high_u8(alpha));
+
+    lo = vaddq_u16(vsraq_n_u16(lo, lo, 8), one);
+    hi = vaddq_u16(vsraq_n_u16(hi, hi, 8), one);
+    return vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+}
+
+static int SDL_PremultiplyAlphaRow_NEON(const SDL_AlphaRowJob *job, const Uint32 *src, Uint32 *dst)
+{
+    const int alpha_byte = job->src_layout.alpha_byte;
+    int x, i;
+
+    for (x = 0; x + 16 <= job->width; x += 16) {
+        uint8x16x4_t pixels = vld4q_u8((const Uint8 *)(src + x));
+        const uint8x16_t alpha = pixels.val[alpha_byte];
+
+        for (i = 0; i < 4; ++i) {
+            if (i != alpha_byte) {
+                pixels.val[i] = SDL_MultiplyAlpha_NEON(pixels.val[i], alpha);
+            }
+        }
+        vst4q_u8((Uint8 *)(dst + x), pixels);
+    }
+    return x;
+}
+
+static int SDL_ColorkeyToAlphaRow_NEON(const SDL_AlphaRowJob *job, const Uint32 *src, Uint32 *dst)
+{
+    const uint32x4_t key = vdupq_n_u32(job->key);
+    const uint32x4_t compare_mask = vdupq_n_u32(job->compare_mask);
+    const uint32x4_t alpha_mask = vdupq_n_u32(job->alpha_mask);
+    int x;
+
+    for (x = 0; x + 4 <= job->width; x += 4) {
+        const uint32x4_t pixels = vld1q_u32(src + x);
+        const uint32x4_t match = vceqq_u32(vandq_u32(pixels, compare_mask), key);
+        vst1q_u32(dst + x, vbicq_u32(pixels, vandq_u32(match, alpha_mask)));
+    }
+    return x;
+}
+#endif /* SDL_NEON_INTRINSICS */
+
+static SDL_AlphaRowFunc SDL_GetPremultiplyAlphaKernel(void)
+{
+#if defined(SDL_AVX2_INTRINSICS) && defined(SDL_SSE2_INTRINSICS)
+    if (SDL_HasAVX2()) {
+        return SDL_PremultiplyAlphaRow_AVX2;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_PremultiplyAlphaRow_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_PremultiplyAlphaRow_NEON;
+    }
+#endif
+    return NULL;
+}
+
+static SDL_AlphaRowFunc SDL_GetColorkeyToAlphaKernel(void)
+{
+#if defined(SDL_AVX2_INTRINSICS) && defined(SDL_SSE2_INTRINSICS)
+    if (SDL_HasAVX2()) {
+        return SDL_ColorkeyToAlphaRow_AVX2;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return SDL_ColorkeyToAlphaRow_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return SDL_ColorkeyToAlphaRow_NEON;
+    }
+#endif
+    return NULL;
+}
+
+static int SDL_PremultiplyAlphaRow(const SDL_AlphaRowJob *job, const Uint32 *src, Uint32 *dst)
+{
+    const SDL_Alpha8888Layout *s = &job->src_layout;
+    const SDL_Alpha8888Layout *d = &job->dst_layout;
+    int x = 0;
+
+    if (job->kernel) {
+        x = job->kernel(job, src, dst);
+    }
+    for (; x < job->width; ++x) {
+        const Uint32 pixel = src[x];
+        const Uint32 a = (pixel >> s->Ashift) & 0xFF;
+        const Uint32 r = (((pixel >> s->Rshift) & 0xFF) * a) / 255;
+        const Uint32 g = (((pixel >> s->Gshift) & 0xFF) * a) / 255;
+        const Uint32 b = (((pixel >> s->Bshift) & 0xFF) * a) / 255;
+
+        dst[x] = (r << d->Rshift) | (g << d->Gshift) | (b << d->Bshift) | (a << d->Ashift);
+    }
+    return x;
+}
+
+static int SDL_UnpremultiplyAlphaRow(const SDL_AlphaRowJob *job, const Uint32 *src, Uint32 *dst)
+{
+    const SDL_Alpha8888Layout *s = &job->src_layout;
+    const SDL_Alpha8888Layout *d = &job->dst_layout;
+    int x;
+
+    for (x = 0; x < job->width; ++x) {
+        const Uint32 pixel = src[x];
+        const Uint32 a = (pixel >> s->Ashift) & 0xFF;
+        Uint32 r, g, b;
+
+        if (a == 0) {
+            dst[x] = 0;
+            continue;
+        }
+        r = (((pixel >> s->Rshift) & 0xFF) * 255 + a / 2) / a;
+        g = (((pixel >> s->Gshift) & 0xFF) * 255 + a / 2) / a;
+        b = (((pixel >> s->Bshift) & 0xFF) * 255 + a / 2) / a;
+        r = SDL_min(r, 255);
+        g = SDL_min(g, 255);
+        b = SDL_min(b, 255);
+
+        dst[x] = (r << d->Rshift) | (g << d->Gshift) | (b << d->Bshift) | (a << d->Ashift);
+    }
+    return x;
+}
+
+static int SDL_ColorkeyToAlphaRow(const SDL_AlphaRowJob *job, const Uint32 *src, Uint32 *dst)
+{
+    int x = 0;
+
+    if (job->kernel) {
+        x = job->kernel(job, src, dst);
+    }
+    for (; x < job->width; ++x) {
+        if ((src[x] & job->compare_mask) == job->key) {
+            dst[x] = src[x] & ~job->alpha_mask;
+        }
+    }
+    return x;
+}
+
+/* Switch from colorkey to alpha. 32-bit surfaces use SIMD and row threads.
    NB: it doesn't handle bpp 1 or 3, because they have no alpha channel */
 static void SDL_ConvertColorkeyToAlpha(SDL_Surface *surface, SDL_bool ignore_alpha)
 {
@@ -406,37 +751,23 @@ static void SDL_ConvertColorkeyToAlpha(SDL_Surface *surface, SDL_bool ignore_alp
             }
         }
     } else if (bpp == 4) {
-        Uint32 *row, *spot;
-        Uint32 ckey = surface->map->info.colorkey;
-        Uint32 mask = ~surface->format->Amask;
+        SDL_AlphaRowJob job;
+
+        SDL_zero(job);
+        job.process = SDL_ColorkeyToAlphaRow;
+        job.kernel = SDL_GetColorkeyToAlphaKernel();
+        job.width = surface->w;
+        job.src = (const Uint8 *)surface->pixels;
+        job.src_pitch = surface->pitch;
+        job.dst = (Uint8 *)surface->pixels;
+        job.dst_pitch = surface->pitch;
+        job.alpha_mask = surface->format->Amask;
 
         /* Ignore, or not, alpha in colorkey comparison */
-        if (ignore_alpha) {
-            ckey &= mask;
-            row = (Uint32 *)surface->pixels;
-            for (y = surface->h; y--;) {
-                spot = row;
-                for (x = surface->w; x--;) {
-                    if ((*spot & mask) == ckey) {
-                        *spot &= mask;
-                    }
-                    ++spot;
-                }
-                row += surface->pitch / 4;
-            }
-        } else {
-            row = (Uint32 *)surface->pixels;
-            for (y = surface->h; y--;) {
-                spot = row;
-                for (x = surface->w; x--;) {
-                    if (*spot == ckey) {
-                        *spot &= mask;
-                    }
-                    ++spot;
-                }
-                row += surface->pitch / 4;
-            }
-        }
+        job.compare_mask = ignore_alpha ? ~job.alpha_mask : 0xFFFFFFFF;
+        job.key = surface->map->info.colorkey & job.compare_mask;
+
+        SDL_ProcessAlphaRows(&job, surface->h);
     }
 
     SDL_UnlockSurface(surface);
@@ -1089,6 +1420,110 @@ SDL_Surface *SDL_DuplicateSurface(SDL_Surface *surface)
 /*
  * Convert a surface into the specified pixel format.
  */
+typedef enum
+{
+    SDL_DITHER_NONE,
+    SDL_DITHER_ORDERED,
+    SDL_DITHER_FLOYD_STEINBERG
+} SDL_DitherMode;
+
+static SDL_DitherMode SDL_GetDitherMode(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_SURFACE_DITHER);
+
+    if (hint) {
+        if (SDL_strcasecmp(hint, "ordered") == 0) {
+            return SDL_DITHER_ORDERED;
+        } else if (SDL_strcasecmp(hint, "floyd-steinberg") == 0) {
+            return SDL_DITHER_FLOYD_STEINBERG;
+        }
+    }
+    return SDL_DITHER_NONE;
+}
+
+/*
+ * Convert a surface without a palette to an 8-bit palettized surface of the same size,
+ * matching each pixel to the closest palette color after dithering it.
+ */
+static int SDL_DitherSurface(SDL_Surface *src, SDL_Surface *dst, SDL_DitherMode mode)
+{
+    static const int bayer[4][4] = {
+        { 0, 8, 2, 10 },
+        { 12, 4, 14, 6 },
+        { 3, 11, 1, 9 },
+        { 15, 7, 13, 5 }
+    };
+    SDL_Palette *palette = dst->format->palette;
+    const int w = src->w;
+    const int stride = (w + 2) * 3; /* one error row, with a spare pixel on each side */
+    Uint8 *row;
+    int *errors = NULL;
+    int spread, x, y, c;
+
+    row = (Uint8 *)SDL_malloc((size_t)w * 4);
+    if (mode == SDL_DITHER_FLOYD_STEINBERG) {
+        errors = (int *)SDL_calloc((size_t)stride * 2, sizeof(int));
+    }
+    if (row == NULL || (mode == SDL_DITHER_FLOYD_STEINBERG && errors == NULL)) {
+        SDL_free(row);
+        SDL_free(errors);
+        return SDL_OutOfMemory();
+    }
+
+    /* Spread ordered dithering over about one step between palette colors, as if they filled the RGB cube evenly */
+    spread = (int)(256.0 / SDL_pow((double)palette->ncolors, 1.0 / 3.0));
+
+    for (y = 0; y < src->h; ++y) {
+        Uint8 *out = (Uint8 *)dst->pixels + y * dst->pitch;
+        int *current = errors + (y & 1) * stride;
+        int *next = errors + ((y + 1) & 1) * stride;
+
+        if (SDL_ConvertPixels(w, 1, src->format->format, (Uint8 *)src->pixels + y * src->pitch, src->pitch,
+                              SDL_PIXELFORMAT_RGBA32, row, w * 4) < 0) {
+            SDL_free(row);
+            SDL_free(errors);
+            return -1;
+        }
+        if (errors) {
+            SDL_memset(next, 0, stride * sizeof(int));
+        }
+
+        for (x = 0; x < w; ++x) {
+            int rgb[3];
+            Uint8 pixel;
+
+            for (c = 0; c < 3; ++c) {
+                rgb[c] = row[x * 4 + c];
+                if (mode == SDL_DITHER_ORDERED) {
+                    rgb[c] += ((bayer[y & 3][x & 3] * 2 + 1 - 16) * spread) / 32;
+                } else {
+                    rgb[c] += current[(x + 1) * 3 + c] / 16;
+                }
+                rgb[c] = SDL_clamp(rgb[c], 0, 255);
+            }
+
+            pixel = SDL_FindColor(palette, (Uint8)rgb[0], (Uint8)rgb[1], (Uint8)rgb[2], row[x * 4 + 3]);
+            out[x] = pixel;
+
+            if (errors) {
+                /* Floyd-Steinberg weights, in sixteenths: 7 to the right, 3, 5 and 1 below */
+                const int found[3] = { palette->colors[pixel].r, palette->colors[pixel].g, palette->colors[pixel].b };
+                for (c = 0; c < 3; ++c) {
+                    const int error = rgb[c] - found[c];
+                    current[(x + 2) * 3 + c] += error * 7;
+                    next[x * 3 + c] += error * 3;
+                    next[(x + 1) * 3 + c] += error * 5;
+                    next[(x + 2) * 3 + c] += error;
+                }
+            }
+        }
+    }
+
+    SDL_free(row);
+    SDL_free(errors);
+    return 0;
+}
+
 SDL_Surface *SDL_ConvertSurface(SDL_Surface *surface, const SDL_PixelFormat *format)
 {
     SDL_Surface *convert;
@@ -1101,6 +1536,7 @@ SDL_Surface *SDL_ConvertSurface(SDL_Surface *surface, const SDL_PixelFormat *for
     SDL_bool palette_has_alpha = SDL_FALSE;
     Uint8 *palette_saved_alpha = NULL;
     int palette_saved_alpha_ncolors = 0;
+    SDL_DitherMode dither;
 
     if (surface == NULL) {
         SDL_InvalidParamError("surface");
@@ -1214,7 +1650,17 @@ SDL_Surface *SDL_ConvertSurface(SDL_Surface *surface, const SDL_PixelFormat *for
         }
     }
 
-    ret = SDL_BlitSurfaceUnchecked(surface, &bounds, convert, &bounds);
+    dither = SDL_DITHER_NONE;
+    if (!surface->format->palette && convert->format->format == SDL_PIXELFORMAT_INDEX8 &&
+        !(copy_flags & SDL_COPY_COLORKEY) && !SDL_MUSTLOCK(surface)) {
+        dither = SDL_GetDitherMode();
+    }
+
+    if (dither != SDL_DITHER_NONE) {
+        ret = SDL_DitherSurface(surface, convert, dither);
+    } else {
+        ret = SDL_BlitSurfaceUnchecked(surface, &bounds, convert, &bounds);
+    }
 
     /* Restore colorkey alpha value */
     if (palette_ck_transform) {
@@ -1470,24 +1916,12 @@ int SDL_ConvertPixels(int width, int height,
     return ret;
 }
 
-/*
- * Premultiply the alpha on a block of pixels
- *
- * This is currently only implemented for SDL_PIXELFORMAT_ARGB8888
- *
- * Here are some ideas for optimization:
- * https://github.com/Wizermil/premultiply_alpha/tree/master/premultiply_alpha
- * https://developer.arm.com/documentation/101964/0201/Pre-multiplied-alpha-channel-data
- */
-int SDL_PremultiplyAlpha(int width, int height,
-                         Uint32 src_format, const void *src, int src_pitch,
-                         Uint32 dst_format, void *dst, int dst_pitch)
+static int SDL_ConvertAlpha(int width, int height,
+                            Uint32 src_format, const void *src, int src_pitch,
+                            Uint32 dst_format, void *dst, int dst_pitch,
+                            SDL_AlphaRowFunc process, SDL_AlphaRowFunc kernel)
 {
-    int c;
-    Uint32 srcpixel;
-    Uint32 srcR, srcG, srcB, srcA;
-    Uint32 dstpixel;
-    Uint32 dstR, dstG, dstB, dstA;
+    SDL_AlphaRowJob job;
 
     if (src == NULL) {
         return SDL_InvalidParamError("src");
@@ -1501,37 +1935,61 @@ int SDL_PremultiplyAlpha(int width, int height,
     if (!dst_pitch) {
         return SDL_InvalidParamError("dst_pitch");
     }
-    if (src_format != SDL_PIXELFORMAT_ARGB8888) {
+
+    SDL_zero(job);
+    if (!SDL_GetAlpha8888Layout(src_format, &job.src_layout)) {
         return SDL_InvalidParamError("src_format");
     }
-    if (dst_format != SDL_PIXELFORMAT_ARGB8888) {
+    if (!SDL_GetAlpha8888Layout(dst_format, &job.dst_layout)) {
         return SDL_InvalidParamError("dst_format");
     }
+    if (width <= 0 || height <= 0) {
+        return 0;
+    }
 
-    while (height--) {
-        const Uint32 *src_px = (const Uint32 *)src;
-        Uint32 *dst_px = (Uint32 *)dst;
-        for (c = width; c; --c) {
-            /* Component bytes extraction. */
-            srcpixel = *src_px++;
-            RGBA_FROM_ARGB8888(srcpixel, srcR, srcG, srcB, srcA);
-
-            /* Alpha pre-multiplication of each component. */
-            dstA = srcA;
-            dstR = (srcA * srcR) / 255;
-            dstG = (srcA * srcG) / 255;
-            dstB = (srcA * srcB) / 255;
-
-            /* ARGB8888 pixel recomposition. */
-            ARGB8888_FROM_RGBA(dstpixel, dstR, dstG, dstB, dstA);
-            *dst_px++ = dstpixel;
-        }
-        src = (const Uint8 *)src + src_pitch;
-        dst = (Uint8 *)dst + dst_pitch;
+    job.process = process;
+    if (src_format == dst_format) {
+        job.kernel = kernel;
     }
+    job.width = width;
+    job.src = (const Uint8 *)src;
+    job.src_pitch = src_pitch;
+    job.dst = (Uint8 *)dst;
+    job.dst_pitch = dst_pitch;
+
+    SDL_ProcessAlphaRows(&job, height);
     return 0;
 }
 
+/*
+ * Premultiply the alpha on a block of pixels
+ *
+ * When the source and destination formats match, most of each row is done
+ * with SIMD, and large blocks are split across threads.
+ */
+int SDL_PremultiplyAlpha(int width, int height,
+                         Uint32 src_format, const void *src, int src_pitch,
+                         Uint32 dst_format, void *dst, int dst_pitch)
+{
+    return SDL_ConvertAlpha(width, height,
+                            src_format, src, src_pitch,
+                            dst_format, dst, dst_pitch,
+                            SDL_PremultiplyAlphaRow, SDL_GetPremultiplyAlphaKernel());
+}
+
+/*
+ * Undo the alpha premultiplication on a block of pixels
+ */
+int SDL_UnpremultiplyAlpha(int width, int height,
+                           Uint32 src_format, const void *src, int src_pitch,
+                           Uint32 dst_format, void *dst, int dst_pitch)
+{
+    return SDL_ConvertAlpha(width, height,
+                            src_format, src, src_pitch,
+                            dst_format, dst, dst_pitch,
+                            SDL_UnpremultiplyAlphaRow, NULL);
+}
+
 /*
  * Free a surface created by the above function.
  */
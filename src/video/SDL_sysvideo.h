@@ -61,6 +61,7 @@ struct SDL_ShapeDriver
 typedef struct SDL_WindowUserData
 {
     char *name;
+    Uint32 hash; /* Hash of name, compared before the name itself */
     void *data;
     struct SDL_WindowUserData *next;
 } SDL_WindowUserData;
@@ -117,6 +118,7 @@ struct SDL_Window
 
     SDL_Window *prev;
     SDL_Window *next;
+    SDL_Window *hash_next; /* Next window in the same SDL_VideoDevice::window_hash bucket */
 
     SDL_Window *parent;
     SDL_Window *first_child;
@@ -368,6 +370,9 @@ struct SDL_VideoDevice
     int num_displays;
     SDL_VideoDisplay **displays;
     SDL_Window *windows;
+    SDL_Window **window_hash; /* Windows by id, bucket is id & (num_window_hash_buckets - 1) */
+    int num_window_hash_buckets; /* Always a power of two */
+    int num_windows;
     SDL_Window *grabbed_window;
     Uint8 window_magic;
     SDL_WindowID next_object_id;
@@ -1820,6 +1820,58 @@ static int SDL_DllNotSupported(const char *name)
     return SDL_SetError("No dynamic %s support in current SDL video driver (%s)", name, _this->name);
 }
 
+/* Window ids are handed out in order, so the low bits spread windows evenly over the buckets */
+static int SDL_AddWindowToHash(SDL_Window *window)
+{
+    if (_this->num_windows >= _this->num_window_hash_buckets) {
+        const int num_buckets = _this->num_window_hash_buckets ? (_this->num_window_hash_buckets * 2) : 16;
+        SDL_Window **buckets = (SDL_Window **)SDL_calloc(num_buckets, sizeof(*buckets));
+
+        if (buckets != NULL) {
+            int i;
+
+            for (i = 0; i < _this->num_window_hash_buckets; ++i) {
+                SDL_Window *entry = _this->window_hash[i];
+                while (entry) {
+                    SDL_Window *next = entry->hash_next;
+                    SDL_Window **bucket = &buckets[entry->id & (num_buckets - 1)];
+                    entry->hash_next = *bucket;
+                    *bucket = entry;
+                    entry = next;
+                }
+            }
+            SDL_free(_this->window_hash);
+            _this->window_hash = buckets;
+            _this->num_window_hash_buckets = num_buckets;
+        } else if (_this->window_hash == NULL) {
+            return SDL_OutOfMemory();
+        }
+        /* else keep the table we have, the chains just get a bit longer */
+    }
+
+    window->hash_next = _this->window_hash[window->id & (_this->num_window_hash_buckets - 1)];
+    _this->window_hash[window->id & (_this->num_window_hash_buckets - 1)] = window;
+    ++_this->num_windows;
+    return 0;
+}
+
+static void SDL_RemoveWindowFromHash(SDL_Window *window)
+{
+    SDL_Window **entry;
+
+    if (_this->window_hash == NULL) {
+        return;
+    }
+    for (entry = &_this->window_hash[window->id & (_this->num_window_hash_buckets - 1)]; *entry; entry = &(*entry)->hash_next) {
+        if (*entry == window) {
+            *entry = window->hash_next;
+            window->hash_next = NULL;
+            --_this->num_windows;
+            return;
+        }
+    }
+}
+
 static SDL_Window *SDL_CreateWindowInternal(const char *title, int x, int y, int w, int h, SDL_Window *parent, Uint32 flags)
 {
     SDL_Window *window;
@@ -1949,6 +2001,10 @@ static SDL_Window *SDL_CreateWindowInternal(const char *title, int x, int y, int
     }
     window->magic = &_this->window_magic;
     window->id = _this->next_object_id++;
+    if (SDL_AddWindowToHash(window) < 0) {
+        SDL_free(window);
+        return NULL;
+    }
     window->windowed.x = window->x = x;
     window->windowed.y = window->y = y;
     window->windowed.w = window->w = w;
@@ -2115,6 +2171,10 @@ SDL_Window *SDL_CreateWindowFrom(const void *data)
     }
     window->magic = &_this->window_magic;
     window->id = _this->next_object_id++;
+    if (SDL_AddWindowToHash(window) < 0) {
+        SDL_free(window);
+        return NULL;
+    }
     window->flags = flags;
     window->is_destroying = SDL_FALSE;
     window->display_scale = 1.0f;
@@ -2287,10 +2347,10 @@ SDL_Window *SDL_GetWindowFromID(SDL_WindowID id)
 {
     SDL_Window *window;
 
-    if (_this == NULL) {
+    if (_this == NULL || _this->window_hash == NULL) {
         return NULL;
     }
-    for (window = _this->windows; window; window = window->next) {
+    for (window = _this->window_hash[id & (_this->num_window_hash_buckets - 1)]; window; window = window->hash_next) {
         if (window->id == id) {
             return window;
         }
@@ -2360,9 +2420,22 @@ int SDL_SetWindowIcon(SDL_Window *window, SDL_Surface *icon)
     return _this->SetWindowIcon(_this, window, window->icon);
 }
 
+static Uint32 SDL_HashWindowDataName(const char *name)
+{
+    /* FNV-1a, same as hint names */
+    Uint32 hash = 2166136261u;
+
+    while (*name) {
+        hash ^= (Uint8)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 void *SDL_SetWindowData(SDL_Window *window, const char *name, void *userdata)
 {
     SDL_WindowUserData *prev, *data;
+    Uint32 hash;
 
     CHECK_WINDOW_MAGIC(window, NULL);
 
@@ -2373,9 +2446,10 @@ void *SDL_SetWindowData(SDL_Window *window, const char *name, void *userdata)
     }
 
     /* See if the named data already exists */
+    hash = SDL_HashWindowDataName(name);
     prev = NULL;
     for (data = window->data; data; prev = data, data = data->next) {
-        if (data->name && SDL_strcmp(data->name, name) == 0) {
+        if (data->hash == hash && data->name && SDL_strcmp(data->name, name) == 0) {
             void *last_value = data->data;
 
             if (userdata) {
@@ -2399,6 +2473,7 @@ void *SDL_SetWindowData(SDL_Window *window, const char *name, void *userdata)
     if (userdata) {
         data = (SDL_WindowUserData *)SDL_malloc(sizeof(*data));
         data->name = SDL_strdup(name);
+        data->hash = hash;
         data->data = userdata;
         data->next = window->data;
         window->data = data;
@@ -2409,6 +2484,7 @@ void *SDL_SetWindowData(SDL_Window *window, const char *name, void *userdata)
 void *SDL_GetWindowData(SDL_Window *window, const char *name)
 {
     SDL_WindowUserData *data;
+    Uint32 hash;
 
     CHECK_WINDOW_MAGIC(window, NULL);
 
@@ -2418,8 +2494,9 @@ void *SDL_GetWindowData(SDL_Window *window, const char *name)
         return NULL;
     }
 
+    hash = SDL_HashWindowDataName(name);
     for (data = window->data; data; data = data->next) {
-        if (data->name && SDL_strcmp(data->name, name) == 0) {
+        if (data->hash == hash && data->name && SDL_strcmp(data->name, name) == 0) {
             return data->data;
         }
     }
@@ -3651,6 +3728,7 @@ void SDL_DestroyWindow(SDL_Window *window)
     }
 
     /* Unlink the window from the list */
+    SDL_RemoveWindowFromHash(window);
     if (window->next) {
         window->next->prev = window->prev;
     }
@@ -3726,6 +3804,9 @@ void SDL_VideoQuit(void)
     while (_this->windows) {
         SDL_DestroyWindow(_this->windows);
     }
+    SDL_free(_this->window_hash);
+    _this->window_hash = NULL;
+    _this->num_window_hash_buckets = 0;
     _this->VideoQuit(_this);
 
     for (i = _this->num_displays; i--; ) {
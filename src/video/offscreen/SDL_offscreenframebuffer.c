@@ -25,19 +25,251 @@
 #include "../SDL_sysvideo.h"
 #include "SDL_offscreenframebuffer_c.h"
 
-#define OFFSCREEN_SURFACE "_SDL_DummySurface"
+#ifdef HAVE_MEMFD_CREATE
+#include <SDL3/SDL_offscreen.h>
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#define OFFSCREEN_SURFACE    "_SDL_DummySurface"
+#define OFFSCREEN_FRAME_RING "_SDL_OffscreenFrameRing"
+
+#ifdef HAVE_MEMFD_CREATE
+
+typedef struct SDL_OffscreenFrameRing
+{
+    int fd;
+    Uint8 *mem;
+    size_t size;
+    SDL_OffscreenFrameRingHeader *header;
+    int current;        /* The frame the window surface draws into */
+    int frame_number;
+    SDL_Rect *stale;    /* For each frame, the area presented since it was last drawn */
+} SDL_OffscreenFrameRing;
+
+static SDL_OffscreenFrameHeader *SDL_OFFSCREEN_GetFrame(SDL_OffscreenFrameRing *ring, int index)
+{
+    return (SDL_OffscreenFrameHeader *)(ring->mem + ring->header->frame_offset + (size_t)index * ring->header->frame_stride);
+}
+
+static Uint8 *SDL_OFFSCREEN_GetFramePixels(SDL_OffscreenFrameRing *ring, int index)
+{
+    return (Uint8 *)SDL_OFFSCREEN_GetFrame(ring, index) + ring->header->pixels_offset;
+}
+
+static void SDL_OFFSCREEN_DestroyFrameRing(SDL_OffscreenFrameRing *ring)
+{
+    if (ring->mem) {
+        /* Let readers know that this ring won't get any more frames */
+        SDL_AtomicSet(&ring->header->closed, 1);
+        munmap(ring->mem, ring->size);
+    }
+    if (ring->fd >= 0) {
+        close(ring->fd);
+    }
+    SDL_free(ring->stale);
+    SDL_free(ring);
+}
+
+static SDL_OffscreenFrameRing *SDL_OFFSCREEN_CreateFrameRing(SDL_Window *window, int num_frames, Uint32 format, int w, int h)
+{
+    const Uint32 page_size = 4096;
+    const int pitch = w * SDL_BYTESPERPIXEL(format);
+    const Uint32 frame_offset = (sizeof(SDL_OffscreenFrameRingHeader) + page_size - 1) & ~(page_size - 1);
+    const Uint32 pixels_offset = (sizeof(SDL_OffscreenFrameHeader) + 63) & ~63;
+    const Uint64 frame_stride = ((Uint64)pixels_offset + (Uint64)pitch * h + page_size - 1) & ~(Uint64)(page_size - 1);
+    const Uint64 size = frame_offset + frame_stride * num_frames;
+    SDL_OffscreenFrameRing *ring;
+    SDL_OffscreenFrameRingHeader *header;
+    char name[64];
+
+    if (frame_stride > SDL_MAX_UINT32 || size > SDL_MAX_SINT32) {
+        SDL_SetError("Window framebuffer is too large for a frame ring");
+        return NULL;
+    }
+
+    ring = (SDL_OffscreenFrameRing *)SDL_calloc(1, sizeof(*ring));
+    if (ring == NULL) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    ring->fd = -1;
+
+    ring->stale = (SDL_Rect *)SDL_calloc(num_frames, sizeof(*ring->stale));
+    if (ring->stale == NULL) {
+        SDL_OutOfMemory();
+        SDL_OFFSCREEN_DestroyFrameRing(ring);
+        return NULL;
+    }
+
+    (void)SDL_snprintf(name, sizeof(name), "SDL window %" SDL_PRIu32 " frames", SDL_GetWindowID(window));
+    ring->fd = memfd_create(name, MFD_CLOEXEC);
+    if (ring->fd < 0) {
+        SDL_SetError("memfd_create() failed: %s", strerror(errno));
+        SDL_OFFSCREEN_DestroyFrameRing(ring);
+        return NULL;
+    }
+    if (ftruncate(ring->fd, (off_t)size) < 0) {
+        SDL_SetError("ftruncate() failed: %s", strerror(errno));
+        SDL_OFFSCREEN_DestroyFrameRing(ring);
+        return NULL;
+    }
+
+    ring->mem = (Uint8 *)mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED, ring->fd, 0);
+    if (ring->mem == MAP_FAILED) {
+        ring->mem = NULL;
+        SDL_SetError("mmap() failed: %s", strerror(errno));
+        SDL_OFFSCREEN_DestroyFrameRing(ring);
+        return NULL;
+    }
+    ring->size = (size_t)size;
+
+    /* The memfd starts out zeroed, so all the frames are black and haven't been presented */
+    header = (SDL_OffscreenFrameRingHeader *)ring->mem;
+    header->magic = SDL_OFFSCREEN_FRAME_RING_MAGIC;
+    header->version = SDL_OFFSCREEN_FRAME_RING_VERSION;
+    header->format = format;
+    header->w = w;
+    header->h = h;
+    header->pitch = pitch;
+    header->num_frames = num_frames;
+    header->frame_offset = frame_offset;
+    header->frame_stride = (Uint32)frame_stride;
+    header->pixels_offset = pixels_offset;
+    ring->header = header;
+
+    return ring;
+}
+
+static void SDL_OFFSCREEN_PresentFrame(SDL_Window *window, SDL_OffscreenFrameRing *ring, const SDL_Rect *rects, int numrects)
+{
+    const int num_frames = (int)ring->header->num_frames;
+    SDL_OffscreenFrameHeader *frame = SDL_OFFSCREEN_GetFrame(ring, ring->current);
+    SDL_Rect full_rect, changed;
+    int i, next;
+
+    full_rect.x = 0;
+    full_rect.y = 0;
+    full_rect.w = ring->header->w;
+    full_rect.h = ring->header->h;
+
+    /* Record what changed since the previous frame */
+    SDL_zero(changed);
+    frame->num_rects = 0;
+    for (i = 0; i < numrects; ++i) {
+        SDL_Rect rect;
+
+        if (!SDL_GetRectIntersection(&rects[i], &full_rect, &rect)) {
+            continue;
+        }
+        if (SDL_RectEmpty(&changed)) {
+            changed = rect;
+        } else {
+            SDL_GetRectUnion(&changed, &rect, &changed);
+        }
+        if (numrects <= SDL_OFFSCREEN_FRAME_RING_MAX_RECTS) {
+            frame->rects[frame->num_rects++] = rect;
+        }
+    }
+    if (SDL_RectEmpty(&changed)) {
+        changed = full_rect;
+    }
+    if (frame->num_rects == 0 || SDL_RectsEqual(&changed, &full_rect)) {
+        frame->num_rects = 0;
+    }
+    frame->timestamp = SDL_GetTicksNS();
+
+    /* Publish the frame, frame numbers skip 0 when they wrap around */
+    if (++ring->frame_number == 0) {
+        ++ring->frame_number;
+    }
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&frame->frame_number, ring->frame_number);
+    SDL_AtomicSet(&ring->header->latest_frame, ring->frame_number);
+
+    /* The other frames are now behind in the area that was just presented */
+    for (i = 0; i < num_frames; ++i) {
+        if (i == ring->current) {
+            continue;
+        }
+        if (SDL_RectEmpty(&ring->stale[i])) {
+            ring->stale[i] = changed;
+        } else {
+            SDL_GetRectUnion(&ring->stale[i], &changed, &ring->stale[i]);
+        }
+    }
+
+    /* Start drawing into the oldest frame, bringing over only what was
+     * presented since that frame was last drawn */
+    next = (ring->current + 1) % num_frames;
+    SDL_AtomicSet(&SDL_OFFSCREEN_GetFrame(ring, next)->frame_number, 0);
+    SDL_MemoryBarrierRelease();
+    if (!SDL_RectEmpty(&ring->stale[next])) {
+        const SDL_Rect *stale = &ring->stale[next];
+        const int pitch = ring->header->pitch;
+        const size_t offset = (size_t)stale->y * pitch + (size_t)stale->x * SDL_BYTESPERPIXEL(ring->header->format);
+        const size_t length = (size_t)stale->w * SDL_BYTESPERPIXEL(ring->header->format);
+        const Uint8 *src = SDL_OFFSCREEN_GetFramePixels(ring, ring->current) + offset;
+        Uint8 *dst = SDL_OFFSCREEN_GetFramePixels(ring, next) + offset;
+
+        if (stale->w == full_rect.w) {
+            SDL_memcpy(dst, src, (size_t)pitch * stale->h);
+        } else {
+            for (i = 0; i < stale->h; ++i) {
+                SDL_memcpy(dst, src, length);
+                src += pitch;
+                dst += pitch;
+            }
+        }
+        SDL_zero(ring->stale[next]);
+    }
+    ring->current = next;
+
+    if (window->surface) {
+        window->surface->pixels = SDL_OFFSCREEN_GetFramePixels(ring, next);
+    }
+}
+
+#endif /* HAVE_MEMFD_CREATE */
 
 int SDL_OFFSCREEN_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, Uint32 *format, void **pixels, int *pitch)
 {
     SDL_Surface *surface;
     const Uint32 surface_format = SDL_PIXELFORMAT_XRGB8888;
     int w, h;
+#ifdef HAVE_MEMFD_CREATE
+    const char *hint;
+    int num_frames = 0;
+#endif
 
     /* Free the old framebuffer surface */
     SDL_OFFSCREEN_DestroyWindowFramebuffer(_this, window);
 
-    /* Create a new one */
     SDL_GetWindowSizeInPixels(window, &w, &h);
+
+#ifdef HAVE_MEMFD_CREATE
+    hint = SDL_GetHint(SDL_HINT_VIDEO_OFFSCREEN_FRAME_RING);
+    if (hint) {
+        num_frames = SDL_atoi(hint);
+    }
+    if (num_frames > 0) {
+        SDL_OffscreenFrameRing *ring = SDL_OFFSCREEN_CreateFrameRing(window, SDL_max(num_frames, 2), surface_format, w, h);
+        if (ring == NULL) {
+            return -1;
+        }
+
+        SDL_SetWindowData(window, OFFSCREEN_FRAME_RING, ring);
+        SDL_SetWindowData(window, SDL_WINDOW_DATA_OFFSCREEN_FRAME_RING_FD, &ring->fd);
+        *format = surface_format;
+        *pixels = SDL_OFFSCREEN_GetFramePixels(ring, ring->current);
+        *pitch = ring->header->pitch;
+        return 0;
+    }
+#endif
+
+    /* Create a new one */
     surface = SDL_CreateSurface(w, h, surface_format);
     if (surface == NULL) {
         return -1;
@@ -52,29 +284,59 @@ int SDL_OFFSCREEN_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *wi
     return 0;
 }
 
-int SDL_OFFSCREEN_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, const SDL_Rect *rects, int numrects)
+/* Writing the frames to disk is a debugging aid, so it stays on the present
+ * path: each file holds exactly the frame that was presented. Readers that
+ * need frames without blocking SDL should map the frame ring instead. */
+static void SDL_OFFSCREEN_SaveFrame(SDL_Window *window, SDL_Surface *surface)
 {
     static int frame_number;
+
+    if (SDL_getenv("SDL_VIDEO_OFFSCREEN_SAVE_FRAMES")) {
+        char file[128];
+        (void)SDL_snprintf(file, sizeof(file), "SDL_window%" SDL_PRIu32 "-%8.8d.bmp",
+                           SDL_GetWindowID(window), ++frame_number);
+        SDL_SaveBMP(surface, file);
+    }
+}
+
+int SDL_OFFSCREEN_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, const SDL_Rect *rects, int numrects)
+{
     SDL_Surface *surface;
 
     surface = (SDL_Surface *)SDL_GetWindowData(window, OFFSCREEN_SURFACE);
+#ifdef HAVE_MEMFD_CREATE
+    if (surface == NULL) {
+        SDL_OffscreenFrameRing *ring = (SDL_OffscreenFrameRing *)SDL_GetWindowData(window, OFFSCREEN_FRAME_RING);
+        if (ring) {
+            if (window->surface) {
+                SDL_OFFSCREEN_SaveFrame(window, window->surface);
+            }
+            SDL_OFFSCREEN_PresentFrame(window, ring, rects, numrects);
+            return 0;
+        }
+    }
+#endif
     if (surface == NULL) {
         return SDL_SetError("Couldn't find offscreen surface for window");
     }
 
     /* Send the data to the display */
-    if (SDL_getenv("SDL_VIDEO_OFFSCREEN_SAVE_FRAMES")) {
-        char file[128];
-        (void)SDL_snprintf(file, sizeof(file), "SDL_window%" SDL_PRIu32 "-%8.8d.bmp",
-                           SDL_GetWindowID(window), ++frame_number);
-        SDL_SaveBMP(surface, file);
-    }
+    SDL_OFFSCREEN_SaveFrame(window, surface);
     return 0;
 }
 
 void SDL_OFFSCREEN_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window)
 {
     SDL_Surface *surface;
+#ifdef HAVE_MEMFD_CREATE
+    SDL_OffscreenFrameRing *ring;
+
+    ring = (SDL_OffscreenFrameRing *)SDL_SetWindowData(window, OFFSCREEN_FRAME_RING, NULL);
+    if (ring) {
+        SDL_SetWindowData(window, SDL_WINDOW_DATA_OFFSCREEN_FRAME_RING_FD, NULL);
+        SDL_OFFSCREEN_DestroyFrameRing(ring);
+    }
+#endif
 
     surface = (SDL_Surface *)SDL_SetWindowData(window, OFFSCREEN_SURFACE, NULL);
     SDL_DestroySurface(surface);
@@ -0,0 +1,173 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how long the audio device thread takes to mix a buffer as the
+ * number of bound streams grows, with every stream converted on its own and
+ * with streams of the same source format grouped (SDL_HINT_AUDIO_GROUP_STREAMS).
+ * The streams are 22050Hz mono sound effects on a 48000Hz stereo device.
+ * The dummy driver is stepped by hand, so this runs as fast as it can.
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define SOURCE_FRAMES 4096
+
+static Sint16 source_data[SOURCE_FRAMES];
+
+/* Keeps every stream fed, so none of them ever runs dry */
+static void SDLCALL feed_stream(SDL_AudioStream *stream, int approx_amount, void *userdata)
+{
+    while (approx_amount > 0) {
+        const int len = SDL_min(approx_amount, (int)sizeof(source_data));
+        SDL_PutAudioStreamData(stream, source_data, len);
+        approx_amount -= len;
+    }
+}
+
+/* Returns the average microseconds per device buffer, or a negative value on error */
+static double measure(int num_streams, SDL_bool grouped, int periods)
+{
+    SDL_AudioSpec src_spec, dst_spec;
+    SDL_AudioStream **streams;
+    SDL_AudioDeviceID devid;
+    Uint64 start, elapsed;
+    double result = -1.0;
+    int i;
+
+    SDL_SetHint(SDL_HINT_AUDIO_GROUP_STREAMS, grouped ? "1" : "0");
+    SDL_zero(dst_spec);
+    dst_spec.format = SDL_AUDIO_F32SYS;
+    dst_spec.channels = 2;
+    dst_spec.freq = 48000;
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &dst_spec);
+    if (!devid) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open audio device: %s", SDL_GetError());
+        return -1.0;
+    }
+
+    streams = (SDL_AudioStream **)SDL_calloc(num_streams, sizeof(SDL_AudioStream *));
+    if (streams == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        SDL_CloseAudioDevice(devid);
+        return -1.0;
+    }
+
+    SDL_zero(src_spec);
+    src_spec.format = SDL_AUDIO_S16SYS;
+    src_spec.channels = 1;
+    src_spec.freq = 22050;
+    for (i = 0; i < num_streams; ++i) {
+        streams[i] = SDL_CreateAudioStream(&src_spec, &src_spec);
+        if (streams[i] == NULL) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create audio stream: %s", SDL_GetError());
+            goto done;
+        }
+        SDL_SetAudioStreamGetCallback(streams[i], feed_stream, NULL);
+    }
+    if (SDL_BindAudioStreams(devid, streams, num_streams) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't bind audio streams: %s", SDL_GetError());
+        goto done;
+    }
+
+    /* The first buffer allocates the groups and work buffers, leave it out */
+    SDL_StepAudioDevice(devid, 1);
+
+    start = SDL_GetPerformanceCounter();
+    if (SDL_StepAudioDevice(devid, periods) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't step audio device: %s", SDL_GetError());
+        goto done;
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+    result = ((double)elapsed * 1000000.0) / SDL_GetPerformanceFrequency() / periods;
+
+done:
+    SDL_CloseAudioDevice(devid);
+    for (i = 0; i < num_streams; ++i) {
+        SDL_DestroyAudioStream(streams[i]);
+    }
+    SDL_free(streams);
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    static const int stream_counts[] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+    SDLTest_CommonState *state;
+    int periods = 50;
+    int result = 0;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (state == NULL) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--periods") == 0 && argv[i + 1]) {
+                periods = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--periods N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (periods <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "The number of buffers per measurement must be positive.");
+        return 1;
+    }
+
+    for (i = 0; i < SOURCE_FRAMES; ++i) {
+        source_data[i] = (Sint16)(((i * 131) % 16384) - 8192);
+    }
+
+    /* The dummy driver doesn't need real time, so there's no device thread and we mix buffers when we like */
+    SDL_SetHint("SDL_AUDIO_DRIVER", "dummy");
+    SDL_SetHint(SDL_HINT_AUDIO_OFFLINE_MODE, "manual");
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize audio: %s", SDL_GetError());
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+
+    SDL_Log("%8s %16s %16s %8s", "streams", "separate us/buf", "grouped us/buf", "speedup");
+    for (i = 0; i < (int)SDL_arraysize(stream_counts); ++i) {
+        const double separate = measure(stream_counts[i], SDL_FALSE, periods);
+        const double grouped = measure(stream_counts[i], SDL_TRUE, periods);
+
+        if (separate < 0.0 || grouped < 0.0) {
+            result = 1;
+            break;
+        }
+        SDL_Log("%8d %16.1f %16.1f %7.2fx", stream_counts[i], separate, grouped, separate / grouped);
+    }
+
+    SDL_ResetHint(SDL_HINT_AUDIO_GROUP_STREAMS);
+    SDL_ResetHint(SDL_HINT_AUDIO_OFFLINE_MODE);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return result;
+}
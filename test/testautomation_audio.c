@@ -34,6 +34,7 @@ static void audioTearDown(void *arg)
 {
     /* Remove a possibly created file from SDL disk writer audio driver; ignore errors */
     (void)remove("sdlaudio.raw");
+    (void)remove("sdlaudio-in.raw");
 
     SDLTest_AssertPass("Cleanup of test files completed");
 }
@@ -913,6 +914,1311 @@ static int audio_resampleLoss(void *arg)
 
   return TEST_COMPLETED;
 }
+
+/**
+ * \brief Check that streaming decoding matches loading the whole WAVE file.
+ *
+ * \sa SDL_OpenWAVReader
+ * \sa SDL_ReadWAVReader
+ * \sa SDL_SeekWAVReader
+ * \sa SDL_SetAudioStreamWAVReader
+ */
+static int audio_wavReader(void *arg)
+{
+    const char *filename = "sample.wav";
+    SDL_AudioSpec loadspec, readspec;
+    Uint8 *loadbuf = NULL;
+    Uint32 loadlen = 0;
+    Uint8 *readbuf = NULL;
+    SDL_WAVReader *reader;
+    SDL_AudioStream *stream;
+    Sint64 frames, seekframe;
+    int framesize, total, len, ret;
+
+    ret = SDL_LoadWAV(filename, &loadspec, &loadbuf, &loadlen);
+    SDLTest_AssertPass("Call to SDL_LoadWAV(\"%s\", ...)", filename);
+    SDLTest_AssertCheck(ret == 0, "Validate return value; expected: 0 got: %i", ret);
+    if (ret != 0) {
+        return TEST_ABORTED;
+    }
+
+    reader = SDL_OpenWAVReader(filename, &readspec);
+    SDLTest_AssertPass("Call to SDL_OpenWAVReader(\"%s\", ...)", filename);
+    SDLTest_AssertCheck(reader != NULL, "Validate result is not NULL");
+    if (reader == NULL) {
+        SDL_free(loadbuf);
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(readspec.format == loadspec.format && readspec.channels == loadspec.channels && readspec.freq == loadspec.freq,
+                        "Validate spec matches SDL_LoadWAV");
+
+    framesize = (SDL_AUDIO_BITSIZE(readspec.format) / 8) * readspec.channels;
+    frames = SDL_GetWAVReaderLength(reader);
+    SDLTest_AssertCheck(frames * framesize == (Sint64)loadlen, "Validate length; expected: %d got: %d", (int)(loadlen / framesize), (int)frames);
+
+    /* Decode in odd-sized pieces so reads straddle block boundaries. */
+    readbuf = (Uint8 *)SDL_malloc(loadlen);
+    SDLTest_AssertCheck(readbuf != NULL, "Validate read buffer is not NULL");
+    if (readbuf == NULL) {
+        SDL_CloseWAVReader(reader);
+        SDL_free(loadbuf);
+        return TEST_ABORTED;
+    }
+    total = 0;
+    while ((len = SDL_ReadWAVReader(reader, readbuf + total, SDL_min(333 * framesize, (int)loadlen - total))) > 0) {
+        total += len;
+    }
+    SDLTest_AssertCheck(len == 0, "Validate end of data; expected: 0 got: %d", len);
+    SDLTest_AssertCheck(total == (int)loadlen, "Validate total bytes read; expected: %d got: %d", (int)loadlen, total);
+    SDLTest_AssertCheck(SDL_memcmp(readbuf, loadbuf, total) == 0, "Validate decoded data matches SDL_LoadWAV");
+
+    /* Seek into the middle of a block and read back. */
+    seekframe = frames / 3 + 7;
+    ret = SDL_SeekWAVReader(reader, seekframe);
+    SDLTest_AssertCheck(ret == 0, "Validate SDL_SeekWAVReader result; expected: 0 got: %d", ret);
+    SDLTest_AssertCheck(SDL_TellWAVReader(reader) == seekframe, "Validate SDL_TellWAVReader result");
+    len = SDL_ReadWAVReader(reader, readbuf, 100 * framesize);
+    SDLTest_AssertCheck(len == 100 * framesize, "Validate bytes read after seek; expected: %d got: %d", 100 * framesize, len);
+    SDLTest_AssertCheck(SDL_memcmp(readbuf, loadbuf + seekframe * framesize, len) == 0, "Validate decoded data after seek matches SDL_LoadWAV");
+
+    /* Feed an audio stream on demand. */
+    SDL_SeekWAVReader(reader, 0);
+    stream = SDL_CreateAudioStream(&readspec, &readspec);
+    SDLTest_AssertCheck(stream != NULL, "Validate SDL_CreateAudioStream result is not NULL");
+    if (stream != NULL) {
+        ret = SDL_SetAudioStreamWAVReader(stream, reader);
+        SDLTest_AssertCheck(ret == 0, "Validate SDL_SetAudioStreamWAVReader result; expected: 0 got: %d", ret);
+        total = 0;
+        while ((len = SDL_GetAudioStreamData(stream, readbuf + total, SDL_min(1000, (int)loadlen - total))) > 0) {
+            total += len;
+        }
+        SDLTest_AssertCheck(total == (int)loadlen, "Validate total bytes from stream; expected: %d got: %d", (int)loadlen, total);
+        SDLTest_AssertCheck(SDL_memcmp(readbuf, loadbuf, total) == 0, "Validate stream data matches SDL_LoadWAV");
+        SDL_DestroyAudioStream(stream);
+    }
+
+    SDL_CloseWAVReader(reader);
+    SDL_free(readbuf);
+    SDL_free(loadbuf);
+
+    return TEST_COMPLETED;
+}
+
+/* Restarts audio with the given driver. The harness holds audio open as well,
+   so this shuts it down all the way. Returns how many times audio was
+   initialized, for audioRestoreDriver(), or -1 if the driver isn't available. */
+static int audioSwitchDriver(const char *driver)
+{
+    int inits = 0;
+
+    while (SDL_WasInit(SDL_INIT_AUDIO)) {
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        ++inits;
+    }
+    SDL_SetHintWithPriority("SDL_AUDIO_DRIVER", driver, SDL_HINT_OVERRIDE);
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+        SDLTest_Log("Audio driver '%s' not available, skipping: %s", driver, SDL_GetError());
+        SDL_ResetHint("SDL_AUDIO_DRIVER");
+        while (inits-- > 0) {
+            audioSetUp(NULL);
+        }
+        return -1;
+    }
+    return inits;
+}
+
+static void audioRestoreDriver(int inits)
+{
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    SDL_ResetHint("SDL_AUDIO_DRIVER");
+    while (inits-- > 0) {
+        audioSetUp(NULL);
+    }
+}
+
+/**
+ * \brief Check that bound streams are mixed in float32 with per-stream and per-device gain
+ *
+ * \sa SDL_SetAudioStreamGain
+ * \sa SDL_GetAudioStreamGain
+ * \sa SDL_SetAudioDeviceGain
+ * \sa SDL_GetAudioDeviceGain
+ */
+static int audio_mixGain(void *arg)
+{
+    const int num_frames = 4096;
+    const float values[3] = { 0.8f, 0.8f, -0.8f };
+    SDL_AudioSpec desired, spec;
+    SDL_AudioStream *streams[3] = { NULL, NULL, NULL };
+    SDL_AudioDeviceID devid;
+    float *data;
+    Sint16 *output = NULL;
+    size_t output_len = 0;
+    int i, expected, first, count, wrong;
+    int inits;
+
+    /* Argument checks, no device needed */
+    SDLTest_AssertCheck(SDL_SetAudioStreamGain(NULL, 1.0f) < 0, "Validate SDL_SetAudioStreamGain(NULL) fails");
+    SDLTest_AssertCheck(SDL_GetAudioStreamGain(NULL) == -1.0f, "Validate SDL_GetAudioStreamGain(NULL) returns -1.0f");
+    SDLTest_AssertCheck(SDL_SetAudioDeviceGain(0, 1.0f) < 0, "Validate SDL_SetAudioDeviceGain(0) fails");
+    SDLTest_AssertCheck(SDL_GetAudioDeviceGain(0) == -1.0f, "Validate SDL_GetAudioDeviceGain(0) returns -1.0f");
+
+    /* The disk driver writes exactly what was mixed to sdlaudio.raw */
+    inits = audioSwitchDriver("disk");
+    if (inits < 0) {
+        return TEST_SKIPPED;
+    }
+
+    SDL_zero(desired);
+    desired.format = SDL_AUDIO_S16SYS;
+    desired.channels = 2;
+    desired.freq = 44100;
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &desired);
+    SDLTest_AssertCheck(devid > 0, "Validate SDL_OpenAudioDevice result; expected: > 0 got: %d", (int)devid);
+    if (devid == 0) {
+        goto done;
+    }
+    SDL_GetAudioDeviceFormat(devid, &spec);
+    SDLTest_AssertCheck(spec.format == SDL_AUDIO_S16SYS, "Validate device format is S16");
+    if (spec.format != SDL_AUDIO_S16SYS) {
+        SDL_CloseAudioDevice(devid);
+        goto done;
+    }
+
+    SDLTest_AssertCheck(SDL_GetAudioDeviceGain(devid) == 1.0f, "Validate default device gain is 1.0f");
+    SDLTest_AssertCheck(SDL_SetAudioDeviceGain(devid, -1.0f) < 0, "Validate negative device gain is rejected");
+    SDLTest_AssertCheck(SDL_SetAudioDeviceGain(devid, 0.5f) == 0, "Validate SDL_SetAudioDeviceGain(0.5f) succeeds");
+    SDLTest_AssertCheck(SDL_GetAudioDeviceGain(devid) == 0.5f, "Validate device gain is 0.5f");
+
+    /* Hold the device while the streams are filled, so they start in the same buffer */
+    SDL_PauseAudioDevice(devid);
+
+    data = (float *)SDL_malloc(num_frames * spec.channels * sizeof(float));
+    SDLTest_AssertCheck(data != NULL, "Validate data buffer is not NULL");
+    desired.format = SDL_AUDIO_F32SYS;
+    desired.channels = spec.channels;
+    desired.freq = spec.freq;
+    for (i = 2; data != NULL && i >= 0; --i) {
+        int j;
+        for (j = 0; j < num_frames * spec.channels; ++j) {
+            data[j] = values[i];
+        }
+        streams[i] = SDL_CreateAudioStream(&desired, &desired);
+        SDLTest_AssertCheck(streams[i] != NULL, "Validate SDL_CreateAudioStream result is not NULL");
+        if (streams[i] == NULL) {
+            break;
+        }
+        SDLTest_AssertCheck(SDL_GetAudioStreamGain(streams[i]) == 1.0f, "Validate default stream gain is 1.0f");
+        SDL_PutAudioStreamData(streams[i], data, num_frames * spec.channels * (int)sizeof(float));
+        SDL_FlushAudioStream(streams[i]);
+        /* Bound last to first, so streams 0 and 1 are mixed first and add up past full scale */
+        SDLTest_AssertCheck(SDL_BindAudioStream(devid, streams[i]) == 0, "Validate SDL_BindAudioStream succeeds");
+    }
+    SDL_free(data);
+
+    SDLTest_AssertCheck(SDL_SetAudioStreamGain(streams[0], -0.5f) < 0, "Validate negative stream gain is rejected");
+    SDLTest_AssertCheck(SDL_SetAudioStreamGain(streams[0], 2.0f) == 0, "Validate SDL_SetAudioStreamGain(2.0f) succeeds");
+    SDLTest_AssertCheck(SDL_GetAudioStreamGain(streams[0]) == 2.0f, "Validate stream gain is 2.0f");
+
+    SDL_ResumeAudioDevice(devid);
+    for (i = 0; i < 200 && streams[0] && SDL_GetAudioStreamAvailable(streams[0]) > 0; ++i) {
+        SDL_Delay(10);
+    }
+    SDL_Delay(200); /* let the last buffer get written */
+    SDL_CloseAudioDevice(devid);
+    for (i = 0; i < 3; ++i) {
+        SDL_DestroyAudioStream(streams[i]);
+    }
+
+    /* 0.8 * 2.0 * 0.5 + 0.8 * 0.5 - 0.8 * 0.5 == 0.8; the first two add up to 1.2 before the third is mixed in */
+    output = (Sint16 *)SDL_LoadFile("sdlaudio.raw", &output_len);
+    SDLTest_AssertCheck(output != NULL, "Validate the disk driver output could be loaded");
+    if (output != NULL) {
+        expected = (int)(0.8f * 32767.0f);
+        first = -1;
+        count = 0;
+        wrong = 0;
+        for (i = 0; i < (int)(output_len / sizeof(Sint16)); ++i) {
+            if (output[i] == 0) {
+                continue;
+            }
+            if (first < 0) {
+                first = i;
+            }
+            if (SDL_abs(output[i] - expected) <= 2) {
+                ++count;
+            } else {
+                ++wrong;
+            }
+        }
+        SDLTest_AssertCheck(count == num_frames * spec.channels, "Validate mixed sample count; expected: %d got: %d", num_frames * spec.channels, count);
+        SDLTest_AssertCheck(wrong == 0, "Validate all mixed samples are %d; %d were not (first is %d)", expected, wrong, first >= 0 ? (int)output[first] : 0);
+        SDL_free(output);
+    }
+
+done:
+    audioRestoreDriver(inits);
+
+    return TEST_COMPLETED;
+}
+
+/* Opens the default output device with the dummy driver, plays a short stream for a while and returns the device statistics */
+static SDL_bool audioRunWithLoad(const char *load, SDL_AudioDeviceStats *stats, SDL_AudioStreamStats *stream_stats)
+{
+    const int num_frames = 11025;
+    SDL_AudioSpec spec;
+    SDL_AudioStream *stream;
+    SDL_AudioDeviceID devid;
+    float *data;
+    SDL_bool retval = SDL_FALSE;
+
+    SDL_SetHint(SDL_HINT_AUDIO_SIMULATED_LOAD, load);
+
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_F32SYS;
+    spec.channels = 2;
+    spec.freq = 44100;
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &spec);
+    SDLTest_AssertCheck(devid > 0, "Validate SDL_OpenAudioDevice result; expected: > 0 got: %d", (int)devid);
+    if (devid == 0) {
+        return SDL_FALSE;
+    }
+
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    data = (float *)SDL_calloc(num_frames * spec.channels, sizeof(float));
+    SDLTest_AssertCheck(stream != NULL && data != NULL, "Validate stream and data were created");
+    if (stream != NULL && data != NULL) {
+        SDL_PutAudioStreamData(stream, data, num_frames * spec.channels * (int)sizeof(float));
+        SDL_FlushAudioStream(stream);
+        SDLTest_AssertCheck(SDL_BindAudioStream(devid, stream) == 0, "Validate SDL_BindAudioStream succeeds");
+
+        SDL_Delay(600);
+
+        SDLTest_AssertCheck(SDL_GetAudioDeviceStats(devid, stats) == 0, "Validate SDL_GetAudioDeviceStats succeeds");
+        SDLTest_AssertCheck(SDL_GetAudioStreamStats(stream, stream_stats) == 0, "Validate SDL_GetAudioStreamStats succeeds");
+        retval = SDL_TRUE;
+    }
+
+    SDL_CloseAudioDevice(devid);
+    SDL_DestroyAudioStream(stream);
+    SDL_free(data);
+    return retval;
+}
+
+/**
+ * \brief Check the device thread statistics, with and without simulated load
+ *
+ * \sa SDL_GetAudioDeviceStats
+ * \sa SDL_ResetAudioDeviceStats
+ * \sa SDL_GetAudioStreamStats
+ */
+static int audio_deviceStats(void *arg)
+{
+    SDL_AudioDeviceStats stats;
+    SDL_AudioStreamStats stream_stats;
+    Uint64 total;
+    int i, inits;
+
+    /* Argument checks, no device needed */
+    SDLTest_AssertCheck(SDL_GetAudioDeviceStats(0, &stats) < 0, "Validate SDL_GetAudioDeviceStats(0) fails");
+    SDLTest_AssertCheck(SDL_ResetAudioDeviceStats(0) < 0, "Validate SDL_ResetAudioDeviceStats(0) fails");
+    SDLTest_AssertCheck(SDL_GetAudioStreamStats(NULL, &stream_stats) < 0, "Validate SDL_GetAudioStreamStats(NULL) fails");
+
+    /* The load hint is read when the physical device opens */
+    inits = audioSwitchDriver("dummy");
+    if (inits < 0) {
+        return TEST_SKIPPED;
+    }
+
+    SDLTest_AssertCheck(SDL_GetAudioDeviceStats(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, NULL) < 0, "Validate SDL_GetAudioDeviceStats(NULL) fails");
+
+    /* An idle device thread keeps up easily */
+    if (audioRunWithLoad("0", &stats, &stream_stats)) {
+        SDLTest_AssertCheck(stats.period_ns > 0, "Validate period_ns; expected: > 0 got: %" SDL_PRIu64, stats.period_ns);
+        SDLTest_AssertCheck(stats.periods >= 3, "Validate periods; expected: >= 3 got: %" SDL_PRIu64, stats.periods);
+        SDLTest_AssertCheck(stats.xruns == 0, "Validate xruns; expected: 0 got: %" SDL_PRIu64, stats.xruns);
+        SDLTest_AssertCheck(stats.process_ns_max <= stats.process_ns_total, "Validate process_ns_max <= process_ns_total");
+        total = 0;
+        for (i = 0; i < SDL_AUDIO_STATS_HISTOGRAM_BUCKETS; ++i) {
+            total += stats.process_histogram[i];
+        }
+        SDLTest_AssertCheck(total == stats.periods, "Validate histogram covers every period; expected: %" SDL_PRIu64 " got: %" SDL_PRIu64, stats.periods, total);
+        SDLTest_AssertCheck(stream_stats.device_transfers == stats.periods, "Validate stream transfers; expected: %" SDL_PRIu64 " got: %" SDL_PRIu64, stats.periods, stream_stats.device_transfers);
+        SDLTest_AssertCheck(stream_stats.starved > 0, "Validate the stream ran dry; got: %" SDL_PRIu64, stream_stats.starved);
+        SDLTest_AssertCheck(stream_stats.queued_frames == 0, "Validate queued_frames; expected: 0 got: %d", stream_stats.queued_frames);
+    }
+
+    /* A device thread that needs 1.5 periods per buffer falls behind every time */
+    if (audioRunWithLoad("150", &stats, &stream_stats)) {
+        SDLTest_AssertCheck(stats.periods >= 2, "Validate periods; expected: >= 2 got: %" SDL_PRIu64, stats.periods);
+        SDLTest_AssertCheck(stats.xruns == stats.periods, "Validate xruns; expected: %" SDL_PRIu64 " got: %" SDL_PRIu64, stats.periods, stats.xruns);
+        SDLTest_AssertCheck(stats.process_histogram[SDL_AUDIO_STATS_HISTOGRAM_BUCKETS - 1] == stats.periods, "Validate every period is in the last histogram bucket");
+        SDLTest_AssertCheck(stats.process_ns_max > stats.period_ns, "Validate process_ns_max is longer than a period");
+    }
+
+    /* Resetting clears the counters but keeps the period */
+    SDL_SetHint(SDL_HINT_AUDIO_SIMULATED_LOAD, "0");
+    {
+        SDL_AudioSpec spec;
+        SDL_AudioDeviceID devid;
+
+        SDL_zero(spec);
+        spec.format = SDL_AUDIO_F32SYS;
+        spec.channels = 2;
+        spec.freq = 44100;
+        devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &spec);
+        if (devid > 0) {
+            SDL_Delay(200);
+            SDLTest_AssertCheck(SDL_ResetAudioDeviceStats(devid) == 0, "Validate SDL_ResetAudioDeviceStats succeeds");
+            SDLTest_AssertCheck(SDL_GetAudioDeviceStats(devid, &stats) == 0, "Validate SDL_GetAudioDeviceStats succeeds");
+            /* the device thread might have finished another buffer in between */
+            SDLTest_AssertCheck(stats.periods <= 1, "Validate periods after reset; expected: <= 1 got: %" SDL_PRIu64, stats.periods);
+            SDLTest_AssertCheck(stats.period_ns > 0, "Validate period_ns is kept after reset");
+            SDL_CloseAudioDevice(devid);
+        }
+    }
+
+    SDL_ResetHint(SDL_HINT_AUDIO_SIMULATED_LOAD);
+    audioRestoreDriver(inits);
+
+    return TEST_COMPLETED;
+}
+
+/* Fills the buffer with a sawtooth that continues from where the last call left off */
+static void SDLCALL audio_offlineCallback(SDL_AudioStream *stream, int approx_amount, void *userdata)
+{
+    int *position = (int *)userdata;
+    float samples[256];
+    int i;
+
+    while (approx_amount >= (int)sizeof(float)) {
+        const int count = SDL_min(approx_amount / (int)sizeof(float), (int)SDL_arraysize(samples));
+        for (i = 0; i < count; ++i) {
+            samples[i] = (float)(((*position)++ % 2000) - 1000) / 1024.0f;
+        }
+        SDL_PutAudioStreamData(stream, samples, count * (int)sizeof(float));
+        approx_amount -= count * (int)sizeof(float);
+    }
+}
+
+static int SDLCALL audio_offlineStepThread(void *arg)
+{
+    const SDL_AudioDeviceID devid = *(const SDL_AudioDeviceID *)arg;
+    int steps = 0;
+
+    /* Keep stepping until the device goes away under us */
+    while (SDL_StepAudioDevice(devid, 1) > 0) {
+        ++steps;
+    }
+    return steps;
+}
+
+/**
+ * \brief Check that the disk driver renders sample-exact output when stepped manually, and faster than real time
+ *
+ * \sa SDL_StepAudioDevice
+ */
+static int audio_offlineRendering(void *arg)
+{
+    const int periods = 50;
+    SDL_AudioSpec spec;
+    SDL_AudioDeviceStats stats;
+    SDL_AudioStream *stream = NULL;
+    SDL_AudioDeviceID devid;
+    float *output;
+    size_t output_len = 0;
+    int position = 0;
+    int i, frames, mismatches, inits;
+
+    SDLTest_AssertCheck(SDL_StepAudioDevice(0, 1) < 0, "Validate SDL_StepAudioDevice(0) fails");
+
+    inits = audioSwitchDriver("disk");
+    if (inits < 0) {
+        return TEST_SKIPPED;
+    }
+
+    /* Float32 in the device's own format is mixed and written without any rounding,
+       so the file holds exactly what the callback produced */
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_F32SYS;
+    spec.channels = 1;
+    spec.freq = 22050;
+
+    /* A real time device can't be stepped */
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &spec);
+    SDLTest_AssertCheck(devid > 0, "Validate SDL_OpenAudioDevice result; expected: > 0 got: %d", (int)devid);
+    SDLTest_AssertCheck(SDL_StepAudioDevice(devid, 1) < 0, "Validate stepping a real time device fails");
+    SDL_CloseAudioDevice(devid);
+
+    SDL_SetHint(SDL_HINT_AUDIO_OFFLINE_MODE, "manual");
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &spec);
+    SDLTest_AssertCheck(devid > 0, "Validate SDL_OpenAudioDevice result; expected: > 0 got: %d", (int)devid);
+    if (devid == 0) {
+        goto done;
+    }
+    SDL_GetAudioDeviceFormat(devid, &spec);
+    if (spec.format != SDL_AUDIO_F32SYS) {
+        SDLTest_Log("Device opened as a different format, skipping the output check");
+        SDL_CloseAudioDevice(devid);
+        goto done;
+    }
+
+    stream = SDL_CreateAudioStream(&spec, &spec);
+    SDLTest_AssertCheck(stream != NULL, "Validate SDL_CreateAudioStream result is not NULL");
+    if (stream == NULL) {
+        SDL_CloseAudioDevice(devid);
+        goto done;
+    }
+    SDL_SetAudioStreamGetCallback(stream, audio_offlineCallback, &position);
+    SDL_BindAudioStream(devid, stream);
+
+    SDLTest_AssertCheck(SDL_StepAudioDevice(devid, -1) < 0, "Validate SDL_StepAudioDevice(-1) fails");
+    SDLTest_AssertCheck(SDL_StepAudioDevice(devid, 0) == 0, "Validate SDL_StepAudioDevice(0) processes nothing");
+    frames = SDL_StepAudioDevice(devid, periods);
+    SDLTest_AssertCheck(frames > 0 && (frames % periods) == 0, "Validate SDL_StepAudioDevice result; got: %d", frames);
+    SDL_GetAudioDeviceStats(devid, &stats);
+    SDLTest_AssertCheck(stats.periods == (Uint64)periods, "Validate every step was one period; expected: %d got: %" SDL_PRIu64, periods, stats.periods);
+    SDL_CloseAudioDevice(devid);
+    SDL_DestroyAudioStream(stream);
+
+    output = (float *)SDL_LoadFile("sdlaudio.raw", &output_len);
+    SDLTest_AssertCheck(output != NULL, "Validate the disk driver output could be loaded");
+    if (output != NULL) {
+        const int expected_len = frames * spec.channels * (int)sizeof(float);
+        SDLTest_AssertCheck(output_len == (size_t)expected_len, "Validate output size; expected: %d got: %d", expected_len, (int)output_len);
+        mismatches = 0;
+        for (i = 0; i < (int)(output_len / sizeof(float)); ++i) {
+            if (output[i] != (float)((i % 2000) - 1000) / 1024.0f) {
+                ++mismatches;
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Validate output is sample-exact; %d samples differ", mismatches);
+        SDL_free(output);
+    }
+
+    /* Closing a device while another thread steps it waits for the step to finish */
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &spec);
+    SDLTest_AssertCheck(devid > 0, "Validate SDL_OpenAudioDevice result; expected: > 0 got: %d", (int)devid);
+    if (devid > 0) {
+        SDL_Thread *thread = SDL_CreateThread(audio_offlineStepThread, "audio_offlineStepThread", &devid);
+        SDLTest_AssertCheck(thread != NULL, "Validate SDL_CreateThread result is not NULL");
+        if (thread != NULL) {
+            int steps = 0;
+            SDL_Delay(10);
+            SDL_CloseAudioDevice(devid);
+            SDL_WaitThread(thread, &steps);
+            SDLTest_AssertCheck(steps > 0, "Validate the device was stepped before it was closed; got %d steps", steps);
+        } else {
+            SDL_CloseAudioDevice(devid);
+        }
+        SDLTest_AssertCheck(SDL_StepAudioDevice(devid, 1) < 0, "Validate stepping a closed device fails");
+    }
+
+    /* Fast mode keeps its own thread, but doesn't wait for the "hardware" */
+    SDL_SetHint(SDL_HINT_AUDIO_OFFLINE_MODE, "fast");
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &spec);
+    SDLTest_AssertCheck(devid > 0, "Validate SDL_OpenAudioDevice result; expected: > 0 got: %d", (int)devid);
+    if (devid > 0) {
+        SDLTest_AssertCheck(SDL_StepAudioDevice(devid, 1) < 0, "Validate stepping a device with a thread fails");
+        SDL_Delay(500);
+        SDL_GetAudioDeviceStats(devid, &stats);
+        SDLTest_AssertCheck(stats.periods * stats.period_ns > SDL_NS_PER_SECOND, "Validate more than a second of audio was rendered in half a second; got %" SDL_PRIu64 " ms", (stats.periods * stats.period_ns) / SDL_NS_PER_MS);
+        SDL_CloseAudioDevice(devid);
+    }
+
+done:
+    SDL_ResetHint(SDL_HINT_AUDIO_OFFLINE_MODE);
+    audioRestoreDriver(inits);
+
+    return TEST_COMPLETED;
+}
+
+static void SDLCALL audio_postmixScale(void *userdata, const SDL_AudioSpec *spec, float *buffer, int buflen)
+{
+    const float scale = *(const float *)userdata;
+    int i;
+
+    for (i = 0; i < buflen / (int)sizeof(float); ++i) {
+        buffer[i] *= scale;
+    }
+}
+
+static void SDLCALL audio_postmixOffset(void *userdata, const SDL_AudioSpec *spec, float *buffer, int buflen)
+{
+    const float offset = *(const float *)userdata;
+    int i;
+
+    for (i = 0; i < buflen / (int)sizeof(float); ++i) {
+        buffer[i] += offset;
+    }
+}
+
+/* Counts the samples in a range of the output that aren't the expected value */
+static int audio_countMismatches(const float *output, int first, int count, float expected)
+{
+    int i, mismatches = 0;
+
+    for (i = first; i < first + count; ++i) {
+        if (output[i] != expected) {
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * \brief Check post-mix callback chains on logical and physical devices
+ *
+ * \sa SDL_AddAudioPostmixCallback
+ * \sa SDL_RemoveAudioPostmixCallback
+ * \sa SDL_GetAudioPostmixStats
+ */
+static int audio_postmixCallbacks(void *arg)
+{
+    const int num_frames = 44100;
+    float two = 2.0f, eighth = 0.125f;
+    SDL_AudioSpec spec;
+    SDL_AudioDeviceStats stats;
+    SDL_AudioPostmixStats postmix_stats;
+    SDL_AudioStream *streams[2] = { NULL, NULL };
+    SDL_AudioDeviceID logdevs[2] = { 0, 0 };
+    SDL_AudioDeviceID *physical = NULL;
+    float *data = NULL, *output;
+    size_t output_len = 0;
+    int i, j, frames, samples_per_period, inits;
+
+    SDLTest_AssertCheck(SDL_AddAudioPostmixCallback(0, audio_postmixScale, &two) < 0, "Validate SDL_AddAudioPostmixCallback(0) fails");
+
+    inits = audioSwitchDriver("disk");
+    if (inits < 0) {
+        return TEST_SKIPPED;
+    }
+    SDL_SetHint(SDL_HINT_AUDIO_OFFLINE_MODE, "manual");
+
+    /* Two logical devices on the same hardware, each playing a constant 0.25 */
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_F32SYS;
+    spec.channels = 2;
+    spec.freq = 44100;
+    for (i = 0; i < 2; ++i) {
+        logdevs[i] = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &spec);
+        SDLTest_AssertCheck(logdevs[i] > 0, "Validate SDL_OpenAudioDevice result; expected: > 0 got: %d", (int)logdevs[i]);
+        if (logdevs[i] == 0) {
+            goto done;
+        }
+    }
+    SDL_GetAudioDeviceFormat(logdevs[0], &spec);
+    if (spec.format != SDL_AUDIO_F32SYS) {
+        SDLTest_Log("Device opened as a different format, skipping");
+        goto done;
+    }
+    physical = SDL_GetAudioOutputDevices(NULL);
+    SDLTest_AssertCheck(physical != NULL && physical[0] != 0, "Validate the disk driver has an output device");
+    if (physical == NULL || physical[0] == 0) {
+        goto done;
+    }
+
+    data = (float *)SDL_malloc(num_frames * spec.channels * sizeof(float));
+    SDLTest_AssertCheck(data != NULL, "Validate data buffer is not NULL");
+    if (data == NULL) {
+        goto done;
+    }
+    for (j = 0; j < num_frames * spec.channels; ++j) {
+        data[j] = 0.25f;
+    }
+    for (i = 0; i < 2; ++i) {
+        streams[i] = SDL_CreateAudioStream(&spec, &spec);
+        SDLTest_AssertCheck(streams[i] != NULL, "Validate SDL_CreateAudioStream result is not NULL");
+        if (streams[i] == NULL) {
+            goto done;
+        }
+        SDL_PutAudioStreamData(streams[i], data, num_frames * spec.channels * (int)sizeof(float));
+        SDL_BindAudioStream(logdevs[i], streams[i]);
+    }
+
+    /* Logical device 0 doubles its own mix; the final mix gets 0.125 added, then is doubled */
+    SDLTest_AssertCheck(SDL_AddAudioPostmixCallback(logdevs[0], NULL, NULL) < 0, "Validate adding a NULL callback fails");
+    SDLTest_AssertCheck(SDL_AddAudioPostmixCallback(logdevs[0], audio_postmixScale, &two) == 0, "Validate adding a callback to a logical device succeeds");
+    SDLTest_AssertCheck(SDL_AddAudioPostmixCallback(logdevs[0], audio_postmixScale, &two) < 0, "Validate adding the same callback twice fails");
+    SDLTest_AssertCheck(SDL_AddAudioPostmixCallback(physical[0], audio_postmixOffset, &eighth) == 0, "Validate adding a callback to a physical device succeeds");
+    SDLTest_AssertCheck(SDL_AddAudioPostmixCallback(physical[0], audio_postmixScale, &two) == 0, "Validate adding a second callback to a physical device succeeds");
+
+    /* (0.25 * 2 + 0.25 + 0.125) * 2 */
+    frames = SDL_StepAudioDevice(logdevs[0], 2);
+    SDLTest_AssertCheck(frames > 0, "Validate SDL_StepAudioDevice result; got: %d", frames);
+    samples_per_period = frames / 2 * spec.channels;
+
+    SDLTest_AssertCheck(SDL_GetAudioPostmixStats(logdevs[0], audio_postmixScale, &two, &postmix_stats) == 0, "Validate SDL_GetAudioPostmixStats succeeds");
+    SDLTest_AssertCheck(postmix_stats.calls == 2, "Validate the callback ran once per period; expected: 2 got: %" SDL_PRIu64, postmix_stats.calls);
+    SDLTest_AssertCheck(postmix_stats.ns_max <= postmix_stats.ns_total, "Validate ns_max <= ns_total");
+    SDLTest_AssertCheck(SDL_GetAudioPostmixStats(logdevs[1], audio_postmixScale, &two, &postmix_stats) < 0, "Validate other logical devices don't have the callback");
+    SDL_GetAudioDeviceStats(logdevs[0], &stats);
+    SDLTest_AssertCheck(stats.postmix_ns_total <= stats.process_ns_total, "Validate post-mix time is part of the processing time");
+
+    /* (0.25 + 0.25 + 0.125) * 2 */
+    SDLTest_AssertCheck(SDL_RemoveAudioPostmixCallback(logdevs[0], audio_postmixScale, &two) == 0, "Validate SDL_RemoveAudioPostmixCallback succeeds");
+    SDLTest_AssertCheck(SDL_RemoveAudioPostmixCallback(logdevs[0], audio_postmixScale, &two) < 0, "Validate removing a callback twice fails");
+    SDL_StepAudioDevice(logdevs[0], 1);
+
+    /* Closing the logical devices closes the hardware, which drops its callbacks */
+    SDL_CloseAudioDevice(logdevs[0]);
+    SDL_CloseAudioDevice(logdevs[1]);
+    logdevs[0] = logdevs[1] = 0;
+    SDLTest_AssertCheck(SDL_GetAudioPostmixStats(physical[0], audio_postmixOffset, &eighth, &postmix_stats) < 0, "Validate a closed device has no callbacks");
+
+    output = (float *)SDL_LoadFile("sdlaudio.raw", &output_len);
+    SDLTest_AssertCheck(output != NULL, "Validate the disk driver output could be loaded");
+    if (output != NULL) {
+        SDLTest_AssertCheck(output_len == (size_t)samples_per_period * 3 * sizeof(float), "Validate output size; expected: %d got: %d", samples_per_period * 3 * (int)sizeof(float), (int)output_len);
+        if (output_len == (size_t)samples_per_period * 3 * sizeof(float)) {
+            SDLTest_AssertCheck(audio_countMismatches(output, 0, samples_per_period * 2, 1.75f) == 0, "Validate output with both chains is 1.75");
+            SDLTest_AssertCheck(audio_countMismatches(output, samples_per_period * 2, samples_per_period, 1.25f) == 0, "Validate output without the logical chain is 1.25");
+        }
+        SDL_free(output);
+    }
+
+done:
+    for (i = 0; i < 2; ++i) {
+        if (logdevs[i]) {
+            SDL_CloseAudioDevice(logdevs[i]);
+        }
+        SDL_DestroyAudioStream(streams[i]);
+    }
+    SDL_free(data);
+    SDL_free(physical);
+    SDL_ResetHint(SDL_HINT_AUDIO_OFFLINE_MODE);
+    audioRestoreDriver(inits);
+
+    return TEST_COMPLETED;
+}
+
+/* Renders a few periods of several 22050Hz mono streams (and one stereo one) through the disk driver, with or without stream groups */
+static float *audio_renderStreamGroups(const char *group_streams, size_t *output_len, int *periods)
+{
+    const int num_streams = 5;
+    const int num_frames = 22050;
+    SDL_AudioSpec spec, src_spec;
+    SDL_AudioStreamStats stats;
+    SDL_AudioStream *streams[5] = { NULL, NULL, NULL, NULL, NULL };
+    SDL_AudioDeviceID devid;
+    Sint16 *data = NULL;
+    float *output = NULL;
+    int i, j, channels;
+
+    SDL_SetHint(SDL_HINT_AUDIO_GROUP_STREAMS, group_streams);
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_F32SYS;
+    spec.channels = 2;
+    spec.freq = 48000;
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &spec);
+    SDL_ResetHint(SDL_HINT_AUDIO_GROUP_STREAMS);
+    SDLTest_AssertCheck(devid > 0, "Validate SDL_OpenAudioDevice result; expected: > 0 got: %d", (int)devid);
+    if (devid == 0) {
+        return NULL;
+    }
+
+    data = (Sint16 *)SDL_malloc(num_frames * 2 * sizeof(Sint16));
+    SDLTest_AssertCheck(data != NULL, "Validate data buffer is not NULL");
+    if (data == NULL) {
+        goto done;
+    }
+
+    /* Every stream gets its own waveform, so a stream dropped or counted twice shows up */
+    for (i = 0; i < num_streams; ++i) {
+        channels = (i == num_streams - 1) ? 2 : 1;
+        SDL_zero(src_spec);
+        src_spec.format = SDL_AUDIO_S16SYS;
+        src_spec.channels = channels;
+        src_spec.freq = 22050;
+        for (j = 0; j < num_frames * channels; ++j) {
+            data[j] = (Sint16)(((j * (i + 3) * 97) % 8192) - 4096);
+        }
+        streams[i] = SDL_CreateAudioStream(&src_spec, &src_spec);
+        SDLTest_AssertCheck(streams[i] != NULL, "Validate SDL_CreateAudioStream result is not NULL");
+        if (streams[i] == NULL) {
+            goto done;
+        }
+        SDL_PutAudioStreamData(streams[i], data, num_frames * channels * (int)sizeof(Sint16));
+        SDL_SetAudioStreamGain(streams[i], (i == 1) ? 0.5f : 1.0f);
+        SDL_BindAudioStream(devid, streams[i]);
+    }
+
+    *periods = 4;
+    SDLTest_AssertCheck(SDL_StepAudioDevice(devid, *periods) > 0, "Validate SDL_StepAudioDevice succeeds");
+    for (i = 0; i < num_streams; ++i) {
+        SDL_GetAudioStreamStats(streams[i], &stats);
+        SDLTest_AssertCheck(stats.device_transfers == (Uint64)*periods, "Validate stream %d was read once per period; expected: %d got: %d", i, *periods, (int)stats.device_transfers);
+        SDLTest_AssertCheck(stats.starved == 0, "Validate stream %d didn't run dry; got: %d", i, (int)stats.starved);
+    }
+
+    SDL_CloseAudioDevice(devid);
+    devid = 0;
+    output = (float *)SDL_LoadFile("sdlaudio.raw", output_len);
+    SDLTest_AssertCheck(output != NULL, "Validate the disk driver output could be loaded");
+
+done:
+    if (devid) {
+        SDL_CloseAudioDevice(devid);
+    }
+    for (i = 0; i < num_streams; ++i) {
+        SDL_DestroyAudioStream(streams[i]);
+    }
+    SDL_free(data);
+    return output;
+}
+
+/**
+ * \brief Check that grouping streams with the same source format doesn't change the mix
+ *
+ * \sa SDL_HINT_AUDIO_GROUP_STREAMS
+ */
+static int audio_groupStreams(void *arg)
+{
+    float *separate = NULL, *grouped = NULL;
+    size_t separate_len = 0, grouped_len = 0;
+    int separate_periods = 0, grouped_periods = 0;
+    int i, samples, mismatches = 0, silent = 0;
+    float max_error = 0.0f;
+    int inits;
+
+    inits = audioSwitchDriver("disk");
+    if (inits < 0) {
+        return TEST_SKIPPED;
+    }
+    SDL_SetHint(SDL_HINT_AUDIO_OFFLINE_MODE, "manual");
+
+    separate = audio_renderStreamGroups("0", &separate_len, &separate_periods);
+    grouped = audio_renderStreamGroups("1", &grouped_len, &grouped_periods);
+    if (separate == NULL || grouped == NULL) {
+        goto done;
+    }
+
+    SDLTest_AssertCheck(separate_len == grouped_len && separate_len > 0, "Validate output sizes match; expected: %d got: %d", (int)separate_len, (int)grouped_len);
+    if (separate_len != grouped_len) {
+        goto done;
+    }
+
+    /* Resampling is linear, so only float rounding should differ */
+    samples = (int)(separate_len / sizeof(float));
+    for (i = 0; i < samples; ++i) {
+        const float error = SDL_fabsf(separate[i] - grouped[i]);
+        max_error = SDL_max(max_error, error);
+        if (error > 0.0001f) {
+            ++mismatches;
+        }
+        if (separate[i] == 0.0f) {
+            ++silent;
+        }
+    }
+    SDLTest_AssertCheck(silent < samples / 2, "Validate the mix isn't silent; %d of %d samples are zero", silent, samples);
+    SDLTest_AssertCheck(mismatches == 0, "Validate grouped output matches separate output; %d of %d samples differ, max error %f", mismatches, samples, max_error);
+
+done:
+    SDL_free(separate);
+    SDL_free(grouped);
+    SDL_ResetHint(SDL_HINT_AUDIO_OFFLINE_MODE);
+    audioRestoreDriver(inits);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check that a stream left on its own after its group breaks up keeps playing smoothly
+ *
+ * While grouped, a stream's own resampler isn't used, so its history has to be kept current
+ * for when it converts on its own again.
+ *
+ * \sa SDL_HINT_AUDIO_GROUP_STREAMS
+ */
+static int audio_groupStreamLeave(void *arg)
+{
+    const int num_frames = 22050;
+    SDL_AudioSpec spec, src_spec;
+    SDL_AudioStream *streams[2] = { NULL, NULL };
+    SDL_AudioDeviceID devid = 0;
+    float *data = NULL, *output = NULL;
+    size_t output_len = 0;
+    float min_value = 1.0f, max_value = 0.0f;
+    int i, frames, samples_per_period, inits;
+
+    inits = audioSwitchDriver("disk");
+    if (inits < 0) {
+        return TEST_SKIPPED;
+    }
+    SDL_SetHint(SDL_HINT_AUDIO_OFFLINE_MODE, "manual");
+
+    SDL_SetHint(SDL_HINT_AUDIO_GROUP_STREAMS, "1");
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_F32SYS;
+    spec.channels = 2;
+    spec.freq = 48000;
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &spec);
+    SDL_ResetHint(SDL_HINT_AUDIO_GROUP_STREAMS);
+    SDLTest_AssertCheck(devid > 0, "Validate SDL_OpenAudioDevice result; expected: > 0 got: %d", (int)devid);
+    if (devid == 0) {
+        goto done;
+    }
+    SDL_GetAudioDeviceFormat(devid, &spec);
+    if (spec.format != SDL_AUDIO_F32SYS) {
+        SDLTest_Log("Device opened as a different format, skipping");
+        goto done;
+    }
+
+    /* Two streams playing a constant 0.25, resampled from 22050Hz */
+    data = (float *)SDL_malloc(num_frames * sizeof(float));
+    SDLTest_AssertCheck(data != NULL, "Validate data buffer is not NULL");
+    if (data == NULL) {
+        goto done;
+    }
+    for (i = 0; i < num_frames; ++i) {
+        data[i] = 0.25f;
+    }
+    SDL_zero(src_spec);
+    src_spec.format = SDL_AUDIO_F32SYS;
+    src_spec.channels = 1;
+    src_spec.freq = 22050;
+    for (i = 0; i < 2; ++i) {
+        streams[i] = SDL_CreateAudioStream(&src_spec, &src_spec);
+        SDLTest_AssertCheck(streams[i] != NULL, "Validate SDL_CreateAudioStream result is not NULL");
+        if (streams[i] == NULL) {
+            goto done;
+        }
+        SDL_PutAudioStreamData(streams[i], data, num_frames * (int)sizeof(float));
+        SDL_BindAudioStream(devid, streams[i]);
+    }
+
+    /* Play them as a group, then leave the first one on its own */
+    frames = SDL_StepAudioDevice(devid, 2);
+    SDLTest_AssertCheck(frames > 0, "Validate SDL_StepAudioDevice result; got: %d", frames);
+    samples_per_period = frames / 2 * spec.channels;
+    SDL_UnbindAudioStream(streams[1]);
+    SDL_StepAudioDevice(devid, 2);
+
+    SDL_CloseAudioDevice(devid);
+    devid = 0;
+    output = (float *)SDL_LoadFile("sdlaudio.raw", &output_len);
+    SDLTest_AssertCheck(output != NULL, "Validate the disk driver output could be loaded");
+    if (output == NULL) {
+        goto done;
+    }
+    SDLTest_AssertCheck(output_len == (size_t)samples_per_period * 4 * sizeof(float), "Validate output size; expected: %d got: %d", samples_per_period * 4 * (int)sizeof(float), (int)output_len);
+    if (output_len != (size_t)samples_per_period * 4 * sizeof(float)) {
+        goto done;
+    }
+
+    /* Without its history, the stream's resampler would fade in from silence after the group breaks up */
+    for (i = samples_per_period * 2; i < samples_per_period * 4; ++i) {
+        min_value = SDL_min(min_value, output[i]);
+        max_value = SDL_max(max_value, output[i]);
+    }
+    SDLTest_AssertCheck(min_value > 0.24f && max_value < 0.26f, "Validate the stream left on its own plays 0.25; got %f to %f", min_value, max_value);
+
+done:
+    if (devid) {
+        SDL_CloseAudioDevice(devid);
+    }
+    for (i = 0; i < 2; ++i) {
+        SDL_DestroyAudioStream(streams[i]);
+    }
+    SDL_free(output);
+    SDL_free(data);
+    SDL_ResetHint(SDL_HINT_AUDIO_OFFLINE_MODE);
+    audioRestoreDriver(inits);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check that small reads from an upsampling stream don't read past the end of their input
+ *
+ * When the rates don't divide evenly, the last output frame of a read can land on the
+ * first input frame of the next read. That frame has to come from the right padding.
+ *
+ * \sa SDL_GetAudioStreamData
+ */
+static int audio_resampleSmallReads(void *arg)
+{
+    const int num_frames = 22050;
+    const int read_frames = 100;
+    SDL_AudioSpec src_spec, dst_spec;
+    SDL_AudioStream *stream;
+    float *input = NULL, *output = NULL;
+    float max_step = 0.0f;
+    int i, total = 0;
+
+    SDL_zero(src_spec);
+    src_spec.format = SDL_AUDIO_F32SYS;
+    src_spec.channels = 1;
+    src_spec.freq = 22050;
+    dst_spec = src_spec;
+    dst_spec.freq = 48000;
+
+    stream = SDL_CreateAudioStream(&src_spec, &dst_spec);
+    SDLTest_AssertCheck(stream != NULL, "Validate SDL_CreateAudioStream result is not NULL");
+    if (stream == NULL) {
+        return TEST_ABORTED;
+    }
+
+    input = (float *)SDL_malloc(num_frames * sizeof(float));
+    output = (float *)SDL_malloc(num_frames * 3 * sizeof(float));
+    SDLTest_AssertCheck(input != NULL && output != NULL, "Validate buffers are not NULL");
+    if (input == NULL || output == NULL) {
+        goto done;
+    }
+
+    /* A slow sine, so neighboring output frames are close together */
+    for (i = 0; i < num_frames; ++i) {
+        input[i] = 0.5f * SDL_sinf(2.0f * SDL_PI_F * 100.0f * (float)i / (float)src_spec.freq);
+    }
+    SDL_PutAudioStreamData(stream, input, num_frames * (int)sizeof(float));
+
+    while (total + read_frames <= num_frames * 2) {
+        const int len = SDL_GetAudioStreamData(stream, output + total, read_frames * (int)sizeof(float));
+        if (len <= 0) {
+            break;
+        }
+        total += len / (int)sizeof(float);
+    }
+    SDLTest_AssertCheck(total > num_frames, "Validate most of the input was resampled; got %d frames", total);
+
+    /* Skip the ramp up from the initial silence */
+    for (i = 1000; i < total; ++i) {
+        max_step = SDL_max(max_step, SDL_fabsf(output[i] - output[i - 1]));
+    }
+    SDLTest_AssertCheck(max_step < 0.02f, "Validate the output has no jumps between reads; largest step %f", max_step);
+
+done:
+    SDL_free(input);
+    SDL_free(output);
+    SDL_DestroyAudioStream(stream);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * \brief Check the device clock and streams scheduled to start and stop on exact device frames
+ *
+ * \sa SDL_GetAudioDeviceClock
+ * \sa SDL_ScheduleAudioStream
+ */
+static int audio_scheduledPlayback(void *arg)
+{
+    const int num_frames = 44100;
+    SDL_AudioSpec spec;
+    SDL_AudioStream *streams[3] = { NULL, NULL, NULL };
+    SDL_AudioDeviceID devid = 0;
+    float *data = NULL, *output;
+    size_t output_len = 0;
+    Uint64 clock_frames = 1, timestamp = 1, start_frame, stop_frame;
+    int i, j, period_frames, total_samples, inits;
+
+    SDLTest_AssertCheck(SDL_GetAudioDeviceClock(0, &clock_frames, &timestamp) < 0, "Validate SDL_GetAudioDeviceClock(0) fails");
+    SDLTest_AssertCheck(SDL_ScheduleAudioStream(NULL, 0, 0) < 0, "Validate SDL_ScheduleAudioStream(NULL) fails");
+
+    inits = audioSwitchDriver("disk");
+    if (inits < 0) {
+        return TEST_SKIPPED;
+    }
+    SDL_SetHint(SDL_HINT_AUDIO_OFFLINE_MODE, "manual");
+    SDL_SetHint(SDL_HINT_AUDIO_GROUP_STREAMS, "1");  /* scheduled streams must leave their group */
+
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_F32SYS;
+    spec.channels = 2;
+    spec.freq = 44100;
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &spec);
+    SDLTest_AssertCheck(devid > 0, "Validate SDL_OpenAudioDevice result; expected: > 0 got: %d", (int)devid);
+    if (devid == 0) {
+        goto done;
+    }
+    SDL_GetAudioDeviceFormat(devid, &spec);
+    if (spec.format != SDL_AUDIO_F32SYS) {
+        SDLTest_Log("Device opened as a different format, skipping");
+        goto done;
+    }
+
+    SDLTest_AssertCheck(SDL_GetAudioDeviceClock(devid, &clock_frames, &timestamp) == 0, "Validate SDL_GetAudioDeviceClock succeeds");
+    SDLTest_AssertCheck(clock_frames == 0 && timestamp == 0, "Validate the clock starts at zero; got: %" SDL_PRIu64 " frames at %" SDL_PRIu64, clock_frames, timestamp);
+
+    data = (float *)SDL_malloc(num_frames * spec.channels * sizeof(float));
+    SDLTest_AssertCheck(data != NULL, "Validate data buffer is not NULL");
+    if (data == NULL) {
+        goto done;
+    }
+
+    /* Two unscheduled streams of 0.125 and one scheduled stream of 0.5, all the same format */
+    for (i = 0; i < 3; ++i) {
+        const float value = (i == 2) ? 0.5f : 0.125f;
+        for (j = 0; j < num_frames * spec.channels; ++j) {
+            data[j] = value;
+        }
+        streams[i] = SDL_CreateAudioStream(&spec, &spec);
+        SDLTest_AssertCheck(streams[i] != NULL, "Validate SDL_CreateAudioStream result is not NULL");
+        if (streams[i] == NULL) {
+            goto done;
+        }
+        if (i < 2) {
+            SDL_PutAudioStreamData(streams[i], data, num_frames * spec.channels * (int)sizeof(float));
+        }
+    }
+    SDLTest_AssertCheck(SDL_ScheduleAudioStream(streams[2], 0, 0) < 0, "Validate scheduling an unbound stream fails");
+    for (i = 0; i < 3; ++i) {
+        SDL_BindAudioStream(devid, streams[i]);
+    }
+
+    /* The first buffer finds out the period, then the stream starts and stops in the middle of the next two */
+    period_frames = SDL_StepAudioDevice(devid, 1);
+    SDLTest_AssertCheck(period_frames > 0, "Validate SDL_StepAudioDevice result; got: %d", period_frames);
+    if (period_frames <= 0) {
+        goto done;
+    }
+    SDL_GetAudioDeviceClock(devid, &clock_frames, &timestamp);
+    SDLTest_AssertCheck(clock_frames == (Uint64)period_frames, "Validate the clock advanced by a buffer; expected: %d got: %" SDL_PRIu64, period_frames, clock_frames);
+    SDLTest_AssertCheck(timestamp > 0 && timestamp <= SDL_GetTicksNS(), "Validate the clock has a timestamp");
+
+    start_frame = clock_frames + (period_frames / 2) + 3;
+    stop_frame = start_frame + period_frames;
+    SDLTest_AssertCheck(SDL_ScheduleAudioStream(streams[2], start_frame, start_frame) < 0, "Validate stopping before starting fails");
+    SDLTest_AssertCheck(SDL_ScheduleAudioStream(streams[2], start_frame, stop_frame) == 0, "Validate SDL_ScheduleAudioStream succeeds");
+    SDL_PutAudioStreamData(streams[2], data, num_frames * spec.channels * (int)sizeof(float));  /* bound empty, so it couldn't start early */
+    SDL_StepAudioDevice(devid, 3);
+    SDL_GetAudioDeviceClock(devid, &clock_frames, NULL);
+    SDLTest_AssertCheck(clock_frames == (Uint64)period_frames * 4, "Validate the clock counts every buffer; expected: %d got: %" SDL_PRIu64, period_frames * 4, clock_frames);
+
+    SDL_CloseAudioDevice(devid);
+    devid = 0;
+
+    output = (float *)SDL_LoadFile("sdlaudio.raw", &output_len);
+    SDLTest_AssertCheck(output != NULL, "Validate the disk driver output could be loaded");
+    if (output != NULL) {
+        total_samples = period_frames * 4 * spec.channels;
+        SDLTest_AssertCheck(output_len == (size_t)total_samples * sizeof(float), "Validate output size; expected: %d got: %d", total_samples * (int)sizeof(float), (int)output_len);
+        if (output_len == (size_t)total_samples * sizeof(float)) {
+            const int first = (int)start_frame * spec.channels;
+            const int last = (int)stop_frame * spec.channels;
+            SDLTest_AssertCheck(audio_countMismatches(output, 0, first, 0.25f) == 0, "Validate output before the start frame is 0.25");
+            SDLTest_AssertCheck(audio_countMismatches(output, first, last - first, 0.75f) == 0, "Validate output from the start frame to the stop frame is 0.75");
+            SDLTest_AssertCheck(audio_countMismatches(output, last, total_samples - last, 0.25f) == 0, "Validate output after the stop frame is 0.25");
+        }
+        SDL_free(output);
+    }
+
+done:
+    if (devid) {
+        SDL_CloseAudioDevice(devid);
+    }
+    for (i = 0; i < 3; ++i) {
+        SDL_DestroyAudioStream(streams[i]);
+    }
+    SDL_free(data);
+    SDL_ResetHint(SDL_HINT_AUDIO_GROUP_STREAMS);
+    SDL_ResetHint(SDL_HINT_AUDIO_OFFLINE_MODE);
+    audioRestoreDriver(inits);
+
+    return TEST_COMPLETED;
+}
+
+/* Checks that a captured buffer from a reader is device buffer `chunk` of the input ramp */
+static void audio_checkCaptureChunk(SDL_AudioCaptureReader *reader, int chunk, int period_frames, int total_frames)
+{
+    const float *buffer = NULL;
+    const int buflen = SDL_AcquireAudioCaptureBuffer(reader, (const void **)&buffer);
+
+    SDLTest_AssertCheck(buflen == period_frames * 2 * (int)sizeof(float), "Validate SDL_AcquireAudioCaptureBuffer result; expected: %d got: %d", period_frames * 2 * (int)sizeof(float), buflen);
+    if (buflen > 0 && buffer != NULL) {
+        const float expected = (float)(chunk * period_frames) / total_frames;
+        SDLTest_AssertCheck(buffer[0] == expected, "Validate the reader got buffer %d; expected: %f got: %f", chunk, expected, buffer[0]);
+        SDLTest_AssertCheck(SDL_ReleaseAudioCaptureBuffer(reader) == 0, "Validate SDL_ReleaseAudioCaptureBuffer succeeds");
+    }
+}
+
+/**
+ * \brief Check that capture streams wanting the same format share one conversion, and that capture readers see the raw device buffers
+ *
+ * \sa SDL_HINT_AUDIO_GROUP_STREAMS
+ * \sa SDL_CreateAudioCaptureReader
+ * \sa SDL_AcquireAudioCaptureBuffer
+ */
+static int audio_captureFanout(void *arg)
+{
+    const int total_frames = 1 << 17;
+    SDL_AudioSpec spec, dst_spec, src_spec;
+    SDL_AudioStream *streams[3] = { NULL, NULL, NULL };
+    SDL_AudioStream *standalone = NULL;
+    SDL_AudioCaptureReader *reader = NULL, *reader2 = NULL;
+    SDL_AudioCaptureReaderStats stats;
+    SDL_AudioDeviceID devid = 0;
+    SDL_RWops *io;
+    const void *buffer = NULL;
+    float *input = NULL;
+    Uint8 *output[3] = { NULL, NULL, NULL };
+    Uint8 *expected = NULL;
+    int output_len[3] = { 0, 0, 0 };
+    int expected_len = 0;
+    int i, period_frames, periods, len, inits;
+
+    SDLTest_AssertCheck(SDL_CreateAudioCaptureReader(0) == NULL, "Validate SDL_CreateAudioCaptureReader(0) fails");
+    SDLTest_AssertCheck(SDL_AcquireAudioCaptureBuffer(NULL, &buffer) < 0, "Validate SDL_AcquireAudioCaptureBuffer(NULL) fails");
+    SDLTest_AssertCheck(SDL_GetAudioCaptureReaderStats(NULL, &stats) < 0, "Validate SDL_GetAudioCaptureReaderStats(NULL) fails");
+
+    /* The disk driver captures from this file: a stereo ramp, so every device buffer starts with a different value */
+    input = (float *)SDL_malloc(total_frames * 2 * sizeof(float));
+    SDLTest_AssertCheck(input != NULL, "Validate input buffer is not NULL");
+    if (input == NULL) {
+        return TEST_COMPLETED;
+    }
+    for (i = 0; i < total_frames; ++i) {
+        input[i * 2] = input[i * 2 + 1] = (float)i / total_frames;
+    }
+    io = SDL_RWFromFile("sdlaudio-in.raw", "wb");
+    SDLTest_AssertCheck(io != NULL, "Validate the capture input file could be created");
+    if (io == NULL) {
+        SDL_free(input);
+        return TEST_COMPLETED;
+    }
+    SDL_RWwrite(io, input, total_frames * 2 * sizeof(float));
+    SDL_RWclose(io);
+
+    inits = audioSwitchDriver("disk");
+    if (inits < 0) {
+        SDL_free(input);
+        return TEST_SKIPPED;
+    }
+    SDL_SetHint(SDL_HINT_AUDIO_OFFLINE_MODE, "manual");
+    SDL_SetHint(SDL_HINT_AUDIO_GROUP_STREAMS, "1");
+
+    SDL_zero(spec);
+    spec.format = SDL_AUDIO_F32SYS;
+    spec.channels = 2;
+    spec.freq = 48000;
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_CAPTURE, &spec);
+    SDLTest_AssertCheck(devid > 0, "Validate SDL_OpenAudioDevice result; expected: > 0 got: %d", (int)devid);
+    if (devid == 0) {
+        goto done;
+    }
+    SDL_GetAudioDeviceFormat(devid, &spec);
+    if (spec.format != SDL_AUDIO_F32SYS || spec.channels != 2) {
+        SDLTest_Log("Device opened as a different format, skipping");
+        goto done;
+    }
+
+    /* Two streams that want the same conversion, and one that wants the device format */
+    SDL_zero(dst_spec);
+    dst_spec.format = SDL_AUDIO_S16SYS;
+    dst_spec.channels = 1;
+    dst_spec.freq = 22050;
+    for (i = 0; i < 3; ++i) {
+        streams[i] = SDL_CreateAudioStream(&spec, (i < 2) ? &dst_spec : &spec);
+        SDLTest_AssertCheck(streams[i] != NULL, "Validate SDL_CreateAudioStream result is not NULL");
+        if (streams[i] == NULL) {
+            goto done;
+        }
+        SDL_BindAudioStream(devid, streams[i]);
+    }
+    standalone = SDL_CreateAudioStream(&spec, &dst_spec);
+    SDLTest_AssertCheck(standalone != NULL, "Validate SDL_CreateAudioStream result is not NULL");
+    if (standalone == NULL) {
+        goto done;
+    }
+
+    reader = SDL_CreateAudioCaptureReader(devid);
+    reader2 = SDL_CreateAudioCaptureReader(devid);
+    SDLTest_AssertCheck(reader != NULL && reader2 != NULL, "Validate SDL_CreateAudioCaptureReader succeeds");
+    if (reader == NULL || reader2 == NULL) {
+        goto done;
+    }
+    SDLTest_AssertCheck(SDL_AcquireAudioCaptureBuffer(reader, &buffer) == 0, "Validate a new reader has nothing to read yet");
+    SDLTest_AssertCheck(SDL_ReleaseAudioCaptureBuffer(reader) < 0, "Validate releasing without holding a buffer fails");
+
+    /* Read every buffer as it comes */
+    len = SDL_StepAudioDevice(devid, 3);
+    SDLTest_AssertCheck(len > 0 && (len % 3) == 0, "Validate SDL_StepAudioDevice result; got: %d", len);
+    if (len <= 0) {
+        goto done;
+    }
+    period_frames = len / 3;
+    SDL_DestroyAudioCaptureReader(reader2);  /* the other reader keeps the ring */
+    reader2 = NULL;
+    for (i = 0; i < 3; ++i) {
+        audio_checkCaptureChunk(reader, i, period_frames, total_frames);
+    }
+    SDLTest_AssertCheck(SDL_AcquireAudioCaptureBuffer(reader, &buffer) == 0, "Validate the reader is caught up");
+
+    /* Fall behind by more than the ring holds */
+    SDL_StepAudioDevice(devid, 10);
+    audio_checkCaptureChunk(reader, 5, period_frames, total_frames);
+    SDL_GetAudioCaptureReaderStats(reader, &stats);
+    SDLTest_AssertCheck(stats.dropped == 2, "Validate dropped buffers; expected: 2 got: %d", (int)stats.dropped);
+
+    /* Hold a buffer while the device goes around the ring; the device can't capture into it, so that buffer is lost too */
+    SDLTest_AssertCheck(SDL_AcquireAudioCaptureBuffer(reader, &buffer) > 0, "Validate SDL_AcquireAudioCaptureBuffer succeeds");
+    SDLTest_AssertCheck(SDL_AcquireAudioCaptureBuffer(reader, &buffer) < 0, "Validate holding two buffers fails");
+    SDL_StepAudioDevice(devid, 8);
+    SDLTest_AssertCheck(((const float *)buffer)[0] == (float)(6 * period_frames) / total_frames, "Validate the held buffer wasn't overwritten");
+    SDL_ReleaseAudioCaptureBuffer(reader);
+    audio_checkCaptureChunk(reader, 13, period_frames, total_frames);
+    audio_checkCaptureChunk(reader, 15, period_frames, total_frames);
+    SDL_GetAudioCaptureReaderStats(reader, &stats);
+    SDLTest_AssertCheck(stats.buffers == 7, "Validate acquired buffers; expected: 7 got: %d", (int)stats.buffers);
+    SDLTest_AssertCheck(stats.dropped == 9, "Validate dropped buffers; expected: 9 got: %d", (int)stats.dropped);
+
+    /* Grouped streams take converted audio internally, but still report the device format, and all got the same audio as a stream converting on its own */
+    periods = 21;
+    SDL_GetAudioStreamFormat(streams[0], &src_spec, NULL);
+    SDLTest_AssertCheck(src_spec.format == spec.format && src_spec.channels == spec.channels && src_spec.freq == spec.freq, "Validate a grouped stream still reports the device format as input");
+
+    expected = (Uint8 *)SDL_malloc(total_frames * 2 * sizeof(float));
+    for (i = 0; i < 3; ++i) {
+        output[i] = (Uint8 *)SDL_malloc(total_frames * 2 * sizeof(float));
+    }
+    if (expected == NULL || output[0] == NULL || output[1] == NULL || output[2] == NULL) {
+        SDLTest_AssertCheck(SDL_FALSE, "Validate output buffers were allocated");
+        goto done;
+    }
+    for (i = 0; i < periods; ++i) {  /* the device thread reads each buffer out as soon as it's put */
+        SDL_PutAudioStreamData(standalone, input + (i * period_frames * 2), period_frames * 2 * (int)sizeof(float));
+        len = SDL_GetAudioStreamData(standalone, expected + expected_len, SDL_GetAudioStreamAvailable(standalone));
+        expected_len += SDL_max(len, 0);
+    }
+    for (i = 0; i < 3; ++i) {
+        output_len[i] = SDL_GetAudioStreamData(streams[i], output[i], total_frames * 2 * (int)sizeof(float));
+    }
+    SDLTest_AssertCheck(expected_len > 0 && output_len[0] == expected_len && output_len[1] == expected_len, "Validate grouped stream sizes; expected: %d got: %d and %d", expected_len, output_len[0], output_len[1]);
+    if (output_len[0] == expected_len && output_len[1] == expected_len) {
+        SDLTest_AssertCheck(SDL_memcmp(output[0], expected, expected_len) == 0, "Validate the first grouped stream matches a separate conversion");
+        SDLTest_AssertCheck(SDL_memcmp(output[1], expected, expected_len) == 0, "Validate the second grouped stream matches a separate conversion");
+    }
+    len = periods * period_frames * 2 * (int)sizeof(float);
+    SDLTest_AssertCheck(output_len[2] == len, "Validate raw stream size; expected: %d got: %d", len, output_len[2]);
+    if (output_len[2] == len) {
+        SDLTest_AssertCheck(SDL_memcmp(output[2], input, len) == 0, "Validate the stream in the device format got the raw audio");
+    }
+
+    /* Closing the device detaches the reader */
+    SDL_CloseAudioDevice(devid);
+    devid = 0;
+    SDLTest_AssertCheck(SDL_AcquireAudioCaptureBuffer(reader, &buffer) < 0, "Validate reading after the device closed fails");
+
+done:
+    if (devid) {
+        SDL_CloseAudioDevice(devid);
+    }
+    SDL_DestroyAudioCaptureReader(reader);
+    SDL_DestroyAudioCaptureReader(reader2);
+    for (i = 0; i < 3; ++i) {
+        SDL_DestroyAudioStream(streams[i]);
+        SDL_free(output[i]);
+    }
+    SDL_DestroyAudioStream(standalone);
+    SDL_free(expected);
+    SDL_free(input);
+    SDL_ResetHint(SDL_HINT_AUDIO_GROUP_STREAMS);
+    SDL_ResetHint(SDL_HINT_AUDIO_OFFLINE_MODE);
+    audioRestoreDriver(inits);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -986,11 +2292,53 @@ static const SDLTest_TestCaseReference audioTest16 = {
     audio_resampleLoss, "audio_resampleLoss", "Check signal-to-noise ratio and maximum error of audio resampling.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference audioTest17 = {
+    audio_wavReader, "audio_wavReader", "Check streaming WAVE decoding against SDL_LoadWAV.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest18 = {
+    audio_mixGain, "audio_mixGain", "Check float32 mixing with stream and device gain.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest19 = {
+    audio_deviceStats, "audio_deviceStats", "Check audio device thread statistics and simulated load.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest20 = {
+    audio_offlineRendering, "audio_offlineRendering", "Check manually stepped and fast offline rendering with the disk driver.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest21 = {
+    audio_postmixCallbacks, "audio_postmixCallbacks", "Check post-mix callback chains on logical and physical devices.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest22 = {
+    audio_groupStreams, "audio_groupStreams", "Check that grouping streams with the same source format doesn't change the mix.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest23 = {
+    audio_resampleSmallReads, "audio_resampleSmallReads", "Check that small reads from an upsampling stream stay inside their input.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest24 = {
+    audio_scheduledPlayback, "audio_scheduledPlayback", "Check the device clock and streams scheduled to start and stop on exact device frames.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference audioTest25 = {
+    audio_captureFanout, "audio_captureFanout", "Check shared conversion for capture streams and raw capture readers.", TEST_ENABLED
+};
+
 /* Sequence of Audio test cases */
+static const SDLTest_TestCaseReference audioTest26 = {
+    audio_groupStreamLeave, "audio_groupStreamLeave", "Check that a stream keeps playing smoothly after its group breaks up.", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference *audioTests[] = {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
-    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16, NULL
+    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
+    &audioTest17, &audioTest18, &audioTest19, &audioTest20, &audioTest21, &audioTest22, &audioTest23, &audioTest24,
+    &audioTest25, &audioTest26, NULL
 };
 
 /* Audio test suite (global) */
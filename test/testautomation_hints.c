@@ -237,6 +237,102 @@ static int hints_setHint(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * \brief Call to SDL_GetHintHandle and SDL_GetHintHandleValue
+ */
+static int hints_hintHandle(void *arg)
+{
+    const char *testHint = "SDL_AUTOMATED_TEST_HINT_HANDLE";
+    SDL_HintHandle *handle;
+    const char *testValue;
+    int i;
+
+    handle = SDL_GetHintHandle(NULL);
+    SDLTest_AssertPass("Call to SDL_GetHintHandle(NULL)");
+    SDLTest_AssertCheck(handle == NULL, "Verify NULL handle was returned");
+
+    handle = SDL_GetHintHandle(testHint);
+    SDLTest_AssertPass("Call to SDL_GetHintHandle(%s)", testHint);
+    SDLTest_AssertCheck(handle != NULL, "Verify handle is not NULL");
+    if (handle == NULL) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(
+        handle == SDL_GetHintHandle(testHint),
+        "Verify the same handle is returned for the same hint");
+
+    testValue = SDL_GetHintHandleValue(handle);
+    SDLTest_AssertCheck(testValue == NULL, "testValue = %s, expected NULL", testValue);
+    SDLTest_AssertCheck(
+        SDL_GetHintHandleBoolean(handle, SDL_TRUE) == SDL_TRUE,
+        "Verify default value is returned for unset hint");
+
+    SDL_SetHint(testHint, "0");
+    SDLTest_AssertPass("Call to SDL_SetHint(%s, \"0\")", testHint);
+    testValue = SDL_GetHintHandleValue(handle);
+    SDLTest_AssertCheck(
+        testValue && SDL_strcmp(testValue, "0") == 0,
+        "testValue = %s, expected \"0\"",
+        testValue);
+    SDLTest_AssertCheck(
+        testValue == SDL_GetHint(testHint),
+        "Verify SDL_GetHint() returns the same value");
+    SDLTest_AssertCheck(
+        SDL_GetHintHandleBoolean(handle, SDL_TRUE) == SDL_FALSE,
+        "Verify boolean value is SDL_FALSE");
+
+    /* Environment overrides are picked up after SDL_setenv() */
+    SDL_setenv(testHint, "env", 1);
+    SDLTest_AssertPass("Call to SDL_setenv(%s, \"env\", 1)", testHint);
+    testValue = SDL_GetHintHandleValue(handle);
+    SDLTest_AssertCheck(
+        testValue && SDL_strcmp(testValue, "env") == 0,
+        "testValue = %s, expected \"env\"",
+        testValue);
+    SDLTest_AssertCheck(
+        SDL_SetHint(testHint, "1") == SDL_FALSE,
+        "Verify normal priority hint doesn't override the environment");
+
+    SDL_SetHintWithPriority(testHint, "1", SDL_HINT_OVERRIDE);
+    SDLTest_AssertPass("Call to SDL_SetHintWithPriority(\"1\", SDL_HINT_OVERRIDE)");
+    testValue = SDL_GetHintHandleValue(handle);
+    SDLTest_AssertCheck(
+        testValue && SDL_strcmp(testValue, "1") == 0,
+        "testValue = %s, expected \"1\"",
+        testValue);
+
+    SDL_ResetHint(testHint);
+    SDLTest_AssertPass("Call to SDL_ResetHint()");
+    testValue = SDL_GetHintHandleValue(handle);
+    SDLTest_AssertCheck(
+        testValue && SDL_strcmp(testValue, "env") == 0,
+        "testValue = %s, expected \"env\"",
+        testValue);
+
+    SDL_setenv(testHint, "", 1);
+    testValue = SDL_GetHintHandleValue(handle);
+    SDLTest_AssertCheck(
+        testValue && *testValue == '\0',
+        "testValue = %s, expected \"\"",
+        testValue);
+
+    /* Only a few values are kept per hint, make sure the latest one wins */
+    for (i = 0; i < 32; ++i) {
+        char value[16];
+
+        (void)SDL_snprintf(value, sizeof(value), "%d", i % 20);
+        SDL_SetHintWithPriority(testHint, value, SDL_HINT_OVERRIDE);
+        testValue = SDL_GetHintHandleValue(handle);
+        SDLTest_AssertCheck(
+            testValue && SDL_strcmp(testValue, value) == 0,
+            "testValue = %s, expected \"%s\"",
+            testValue ? testValue : "(null)", value);
+    }
+    SDLTest_AssertPass("Call to SDL_SetHintWithPriority() with 32 values");
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Hints test cases */
@@ -248,9 +344,13 @@ static const SDLTest_TestCaseReference hintsTest2 = {
     (SDLTest_TestCaseFp)hints_setHint, "hints_setHint", "Call to SDL_SetHint", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference hintsTest3 = {
+    (SDLTest_TestCaseFp)hints_hintHandle, "hints_hintHandle", "Call to SDL_GetHintHandle and SDL_GetHintHandleValue", TEST_ENABLED
+};
+
 /* Sequence of Hints test cases */
 static const SDLTest_TestCaseReference *hintsTests[] = {
-    &hintsTest1, &hintsTest2, NULL
+    &hintsTest1, &hintsTest2, &hintsTest3, NULL
 };
 
 /* Hints test suite (global) */
@@ -60,6 +60,37 @@ static int TestVirtualJoystick(void *arg)
             SDL_UpdateJoysticks();
             SDLTest_AssertCheck(SDL_GetJoystickButton(joystick, SDL_GAMEPAD_BUTTON_A) == SDL_RELEASED, "SDL_GetJoystickButton(SDL_GAMEPAD_BUTTON_A) == SDL_RELEASED");
 
+            {
+                SDL_JoystickState state;
+
+                SDLTest_AssertCheck(SDL_SetJoystickVirtualAxis(joystick, SDL_GAMEPAD_AXIS_LEFTX, SDL_JOYSTICK_AXIS_MAX) == 0, "SDL_SetJoystickVirtualAxis(SDL_GAMEPAD_AXIS_LEFTX, SDL_JOYSTICK_AXIS_MAX)");
+                SDLTest_AssertCheck(SDL_SetJoystickVirtualButton(joystick, SDL_GAMEPAD_BUTTON_B, SDL_PRESSED) == 0, "SDL_SetJoystickVirtualButton(SDL_GAMEPAD_BUTTON_B, SDL_PRESSED)");
+                SDL_UpdateJoysticks();
+
+                SDLTest_AssertCheck(SDL_GetJoystickState(joystick, NULL) < 0, "SDL_GetJoystickState(joystick, NULL) fails");
+                SDLTest_AssertCheck(SDL_GetJoystickState(joystick, &state) == 0, "SDL_GetJoystickState()");
+                SDLTest_AssertCheck(state.num_axes == desc.naxes, "state.num_axes == %d, got %d", desc.naxes, state.num_axes);
+                SDLTest_AssertCheck(state.num_buttons == desc.nbuttons, "state.num_buttons == %d, got %d", desc.nbuttons, state.num_buttons);
+                SDLTest_AssertCheck(state.num_hats == 0, "state.num_hats == 0, got %d", state.num_hats);
+                SDLTest_AssertCheck(state.axes[SDL_GAMEPAD_AXIS_LEFTX] == SDL_GetJoystickAxis(joystick, SDL_GAMEPAD_AXIS_LEFTX), "state.axes[SDL_GAMEPAD_AXIS_LEFTX] == %d, got %d", SDL_GetJoystickAxis(joystick, SDL_GAMEPAD_AXIS_LEFTX), state.axes[SDL_GAMEPAD_AXIS_LEFTX]);
+                SDLTest_AssertCheck(state.buttons[SDL_GAMEPAD_BUTTON_A] == SDL_RELEASED, "state.buttons[SDL_GAMEPAD_BUTTON_A] == SDL_RELEASED");
+                SDLTest_AssertCheck(state.buttons[SDL_GAMEPAD_BUTTON_B] == SDL_PRESSED, "state.buttons[SDL_GAMEPAD_BUTTON_B] == SDL_PRESSED");
+                SDLTest_AssertCheck(state.timestamp != 0, "state.timestamp != 0");
+
+                SDLTest_AssertCheck(SDL_SetJoystickVirtualButton(joystick, SDL_GAMEPAD_BUTTON_B, SDL_RELEASED) == 0, "SDL_SetJoystickVirtualButton(SDL_GAMEPAD_BUTTON_B, SDL_RELEASED)");
+                SDL_UpdateJoysticks();
+            }
+
+            {
+                Uint64 reports = ~(Uint64)0, events = 0;
+
+                SDLTest_AssertCheck(SDL_GetJoystickInputStats(joystick, &reports, &events) == 0, "SDL_GetJoystickInputStats()");
+                SDLTest_AssertCheck(reports == 0, "Virtual joysticks don't read input reports, got %" SDL_PRIu64, reports);
+                SDLTest_AssertCheck(events >= 2, "Button press and release were counted, got %" SDL_PRIu64, events);
+            }
+
+            SDLTest_AssertCheck(SDL_GetJoystickRumbleStats(joystick, NULL, NULL, NULL, NULL, NULL) < 0, "SDL_GetJoystickRumbleStats() isn't supported by virtual joysticks");
+
             SDL_CloseJoystick(joystick);
         }
         SDLTest_AssertCheck(SDL_DetachVirtualJoystick(device_id) == 0, "SDL_DetachVirtualJoystick()");
@@ -73,6 +104,75 @@ static int TestVirtualJoystick(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * \brief Check adding and looking up gamepad mappings
+ *
+ * \sa SDL_AddGamepadMapping
+ * \sa SDL_AddGamepadMappingsFromRW
+ * \sa SDL_GetGamepadMappingForGUID
+ */
+static int TestGamepadMappings(void *arg)
+{
+    const char *guid_string = "03000000cdab00000112000011010000";
+    const char *other_version = "03000000cdab00000112000022020000";
+    SDL_JoystickGUID guid;
+    char *db = NULL;
+    char *mapping;
+    int num_mappings;
+
+    SDLTest_AssertCheck(SDL_InitSubSystem(SDL_INIT_GAMEPAD) == 0, "SDL_InitSubSystem(SDL_INIT_GAMEPAD)");
+
+    num_mappings = SDL_GetNumGamepadMappings();
+
+    SDLTest_AssertCheck(SDL_AddGamepadMapping("03000000cdab00000112000011010000,Test Pad,a:b0,b:b1,") == 1, "SDL_AddGamepadMapping() adds a new mapping");
+    SDLTest_AssertCheck(SDL_GetNumGamepadMappings() == num_mappings + 1, "SDL_GetNumGamepadMappings() == %d", num_mappings + 1);
+    SDLTest_AssertCheck(SDL_AddGamepadMapping("03000000cdab00000112000011010000,Updated Pad,a:b1,b:b0,") == 0, "SDL_AddGamepadMapping() updates the existing mapping");
+    SDLTest_AssertCheck(SDL_GetNumGamepadMappings() == num_mappings + 1, "SDL_GetNumGamepadMappings() == %d", num_mappings + 1);
+
+    guid = SDL_GetJoystickGUIDFromString(guid_string);
+    mapping = SDL_GetGamepadMappingForGUID(guid);
+    SDLTest_AssertCheck(mapping != NULL && SDL_strstr(mapping, ",Updated Pad,a:b1,b:b0,") != NULL,
+                        "SDL_GetGamepadMappingForGUID(%s), got: %s", guid_string, mapping ? mapping : "NULL");
+    SDL_free(mapping);
+
+    /* A different version of the same device should fall back to the mapping */
+    guid = SDL_GetJoystickGUIDFromString(other_version);
+    mapping = SDL_GetGamepadMappingForGUID(guid);
+    SDLTest_AssertCheck(mapping != NULL && SDL_strstr(mapping, ",Updated Pad,") != NULL,
+                        "SDL_GetGamepadMappingForGUID(%s), got: %s", other_version, mapping ? mapping : "NULL");
+    SDL_free(mapping);
+
+    /* A device with a CRC should match a mapping for that CRC */
+    SDLTest_AssertCheck(SDL_AddGamepadMapping("03000000cdab00000212000000000000,CRC Pad,a:b0,crc:1234,") == 1, "SDL_AddGamepadMapping() with a CRC");
+    guid = SDL_GetJoystickGUIDFromString("03003412cdab00000212000000000000");
+    mapping = SDL_GetGamepadMappingForGUID(guid);
+    SDLTest_AssertCheck(mapping != NULL && SDL_strstr(mapping, ",CRC Pad,") != NULL,
+                        "SDL_GetGamepadMappingForGUID() with a CRC, got: %s", mapping ? mapping : "NULL");
+    SDL_free(mapping);
+
+    /* Only the lines for this platform should be added */
+    if (SDL_asprintf(&db, "03000000cdab00000312000000000000,File Pad,a:b0,platform:%s,\n"
+                          "03000000cdab00000412000000000000,Other Pad,a:b0,platform:Other,\n"
+                          "03000000cdab00000512000000000000,No Platform Pad,a:b0,\n",
+                     SDL_GetPlatform()) > 0) {
+        SDLTest_AssertCheck(SDL_AddGamepadMappingsFromRW(SDL_RWFromConstMem(db, (int)SDL_strlen(db)), SDL_TRUE) == 1, "SDL_AddGamepadMappingsFromRW()");
+        guid = SDL_GetJoystickGUIDFromString("03000000cdab00000312000000000000");
+        mapping = SDL_GetGamepadMappingForGUID(guid);
+        SDLTest_AssertCheck(mapping != NULL && SDL_strstr(mapping, ",File Pad,") != NULL,
+                            "SDL_GetGamepadMappingForGUID() after loading a file, got: %s", mapping ? mapping : "NULL");
+        SDL_free(mapping);
+        guid = SDL_GetJoystickGUIDFromString("03000000cdab00000412000000000000");
+        mapping = SDL_GetGamepadMappingForGUID(guid);
+        SDLTest_AssertCheck(mapping == NULL, "SDL_GetGamepadMappingForGUID() for another platform");
+        SDL_free(mapping);
+        SDL_free(db);
+    }
+
+    SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Joystick routine test cases */
@@ -80,9 +180,14 @@ static const SDLTest_TestCaseReference joystickTest1 = {
     (SDLTest_TestCaseFp)TestVirtualJoystick, "TestVirtualJoystick", "Test virtual joystick functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference joystickTest2 = {
+    (SDLTest_TestCaseFp)TestGamepadMappings, "TestGamepadMappings", "Test adding and looking up gamepad mappings", TEST_ENABLED
+};
+
 /* Sequence of Joystick routine test cases */
 static const SDLTest_TestCaseReference *joystickTests[] = {
     &joystickTest1,
+    &joystickTest2,
     NULL
 };
 
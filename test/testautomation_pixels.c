@@ -347,6 +347,369 @@ static int pixels_allocFreePalette(void *arg)
     return TEST_COMPLETED;
 }
 
+/* The palette index SDL_FindColor must return: the first of the closest colors */
+static Uint32 pixels_nearestColor(const SDL_Palette *palette, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    unsigned int smallest = ~0U;
+    Uint32 nearest = 0;
+    int i;
+
+    for (i = 0; i < palette->ncolors; i++) {
+        const int rd = palette->colors[i].r - r;
+        const int gd = palette->colors[i].g - g;
+        const int bd = palette->colors[i].b - b;
+        const int ad = palette->colors[i].a - a;
+        const unsigned int distance = (unsigned int)(rd * rd + gd * gd + bd * bd + ad * ad);
+        if (distance < smallest) {
+            smallest = distance;
+            nearest = (Uint32)i;
+        }
+    }
+    return nearest;
+}
+
+/* Maps every gray level with a shared palette, counting results that aren't the closest entry */
+static int SDLCALL pixels_mapRGBThread(void *data)
+{
+    SDL_PixelFormat *format = (SDL_PixelFormat *)data;
+    int i, mismatches = 0;
+
+    for (i = 0; i < 256; i++) {
+        const Uint8 level = (Uint8)i;
+        if (SDL_MapRGB(format, level, level, level) != pixels_nearestColor(format->palette, level, level, level, SDL_ALPHA_OPAQUE)) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * \brief Check that mapping colors to a palette always finds the closest entry, also after the palette changes
+ *
+ * \sa SDL_MapRGB
+ * \sa SDL_MapRGBA
+ */
+static int pixels_mapRGBPalette(void *arg)
+{
+    static const int palette_sizes[] = { 2, 7, 16, 17, 255, 256 };
+    SDL_PixelFormat *format;
+    SDL_Palette *palette;
+    SDL_Color colors[256];
+    int size, round, i, mismatches;
+
+    format = SDL_CreatePixelFormat(SDL_PIXELFORMAT_INDEX8);
+    SDLTest_AssertCheck(format != NULL, "Verify SDL_CreatePixelFormat(SDL_PIXELFORMAT_INDEX8) is not NULL");
+    if (format == NULL) {
+        return TEST_ABORTED;
+    }
+
+    for (size = 0; size < (int)SDL_arraysize(palette_sizes); size++) {
+        const int ncolors = palette_sizes[size];
+
+        palette = SDL_CreatePalette(ncolors);
+        SDLTest_AssertCheck(palette != NULL, "Verify SDL_CreatePalette(%d) is not NULL", ncolors);
+        if (palette == NULL) {
+            continue;
+        }
+        SDL_SetPixelFormatPalette(format, palette);
+
+        /* Change the palette between rounds, so stale results from before would show up */
+        for (round = 0; round < 3; round++) {
+            for (i = 0; i < ncolors; i++) {
+                colors[i].r = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                colors[i].g = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                colors[i].b = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                colors[i].a = (round == 2) ? (Uint8)SDLTest_RandomIntegerInRange(0, 255) : SDL_ALPHA_OPAQUE;
+            }
+            if (ncolors > 4) {
+                colors[ncolors - 1] = colors[1]; /* ties go to the lower index */
+            }
+            SDL_SetPaletteColors(palette, colors, 0, ncolors);
+
+            mismatches = 0;
+            for (i = 0; i < 2000; i++) {
+                /* Half the lookups are repeats, half are the palette colors themselves */
+                const SDL_Color *color = &colors[i % ncolors];
+                const Uint8 r = (i & 1) ? color->r : (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                const Uint8 g = (i & 1) ? color->g : (Uint8)(i % 37);
+                const Uint8 b = (i & 1) ? color->b : (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+                const Uint8 a = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+
+                if (SDL_MapRGB(format, r, g, b) != pixels_nearestColor(palette, r, g, b, SDL_ALPHA_OPAQUE)) {
+                    mismatches++;
+                }
+                if (SDL_MapRGBA(format, r, g, b, a) != pixels_nearestColor(palette, r, g, b, a)) {
+                    mismatches++;
+                }
+            }
+            SDLTest_AssertCheck(mismatches == 0, "Verify colors map to the closest of %d palette entries in round %d; %d mismatches", ncolors, round, mismatches);
+        }
+
+        SDL_SetPixelFormatPalette(format, NULL);
+        SDL_DestroyPalette(palette);
+    }
+
+    /* Threads mapping colors with a new palette all race to set up its lookup cache */
+    palette = SDL_CreatePalette(256);
+    SDLTest_AssertCheck(palette != NULL, "Verify SDL_CreatePalette(256) is not NULL");
+    if (palette != NULL) {
+        SDL_Thread *threads[4];
+        int result;
+
+        for (i = 0; i < 256; i++) {
+            colors[i].r = colors[i].g = colors[i].b = (Uint8)(255 - i);
+            colors[i].a = SDL_ALPHA_OPAQUE;
+        }
+        SDL_SetPaletteColors(palette, colors, 0, 256);
+        SDL_SetPixelFormatPalette(format, palette);
+
+        for (i = 0; i < (int)SDL_arraysize(threads); i++) {
+            threads[i] = SDL_CreateThread(pixels_mapRGBThread, "MapRGB", format);
+        }
+        mismatches = 0;
+        for (i = 0; i < (int)SDL_arraysize(threads); i++) {
+            result = 0;
+            SDL_WaitThread(threads[i], &result);
+            mismatches += result;
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify threads sharing a palette map colors to the closest entry; %d mismatches", mismatches);
+
+        SDL_SetPixelFormatPalette(format, NULL);
+        SDL_DestroyPalette(palette);
+    }
+
+    SDL_DestroyPixelFormat(format);
+    return TEST_COMPLETED;
+}
+
+static const Uint32 g_alphaFormats[] = {
+    SDL_PIXELFORMAT_ARGB8888,
+    SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_BGRA8888
+};
+
+/* Fills a block with random pixels, including fully transparent and opaque ones */
+static void pixels_randomAlphaPixels(Uint32 *pixels, int count)
+{
+    int i;
+
+    for (i = 0; i < count; i++) {
+        pixels[i] = (Uint32)SDLTest_RandomUint32();
+        if (i % 7 == 0) {
+            pixels[i] |= 0xFF000000;
+        } else if (i % 11 == 0) {
+            pixels[i] &= 0x00FFFFFF;
+        }
+    }
+}
+
+/* Checks a converted block against the reference formula, returns the number of wrong pixels */
+static int pixels_checkAlphaConversion(SDL_bool premultiply, int width, int height,
+                                       const SDL_PixelFormat *src_format, const Uint32 *src, int src_pitch,
+                                       const SDL_PixelFormat *dst_format, const Uint32 *dst, int dst_pitch)
+{
+    int x, y, mismatches = 0;
+
+    for (y = 0; y < height; y++) {
+        const Uint32 *src_row = (const Uint32 *)((const Uint8 *)src + y * src_pitch);
+        const Uint32 *dst_row = (const Uint32 *)((const Uint8 *)dst + y * dst_pitch);
+        for (x = 0; x < width; x++) {
+            Uint8 r, g, b, a;
+            Uint32 expected;
+
+            SDL_GetRGBA(src_row[x], src_format, &r, &g, &b, &a);
+            if (premultiply) {
+                expected = SDL_MapRGBA(dst_format, (Uint8)((r * a) / 255), (Uint8)((g * a) / 255), (Uint8)((b * a) / 255), a);
+            } else if (a == 0) {
+                expected = 0;
+            } else {
+                expected = SDL_MapRGBA(dst_format,
+                                       (Uint8)SDL_min((r * 255 + a / 2) / a, 255),
+                                       (Uint8)SDL_min((g * 255 + a / 2) / a, 255),
+                                       (Uint8)SDL_min((b * 255 + a / 2) / a, 255), a);
+            }
+            if (dst_row[x] != expected) {
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Check SDL_PremultiplyAlpha and SDL_UnpremultiplyAlpha against the reference formulas
+ *
+ * @sa SDL_PremultiplyAlpha
+ * @sa SDL_UnpremultiplyAlpha
+ */
+static int pixels_premultiplyAlpha(void *arg)
+{
+    /* Odd widths leave tails after the SIMD code, the big block is split across threads */
+    static const struct
+    {
+        int w, h;
+        const char *threads;
+    } sizes[] = {
+        { 1, 3, NULL }, { 7, 5, NULL }, { 33, 9, NULL }, { 1021, 301, "4" }, { 1021, 301, "1" }
+    };
+    const int num_formats = (int)SDL_arraysize(g_alphaFormats);
+    int size, s, d, pass, ret;
+
+    for (size = 0; size < (int)SDL_arraysize(sizes); size++) {
+        const int w = sizes[size].w;
+        const int h = sizes[size].h;
+        const int src_pitch = (w + 3) * 4;
+        const int dst_pitch = (w + 1) * 4;
+        Uint32 *src = (Uint32 *)SDL_malloc((size_t)src_pitch * h);
+        Uint32 *dst = (Uint32 *)SDL_malloc((size_t)dst_pitch * h);
+        Uint32 *inplace = (Uint32 *)SDL_malloc((size_t)src_pitch * h);
+
+        SDLTest_AssertCheck(src && dst && inplace, "Verify %dx%d pixel blocks were allocated", w, h);
+        if (!src || !dst || !inplace) {
+            SDL_free(src);
+            SDL_free(dst);
+            SDL_free(inplace);
+            return TEST_ABORTED;
+        }
+        SDL_SetHint(SDL_HINT_CONVERT_THREADS, sizes[size].threads);
+        pixels_randomAlphaPixels(src, src_pitch / 4 * h);
+
+        for (s = 0; s < num_formats; s++) {
+            SDL_PixelFormat *src_format = SDL_CreatePixelFormat(g_alphaFormats[s]);
+
+            for (d = 0; d < num_formats; d++) {
+                SDL_PixelFormat *dst_format = SDL_CreatePixelFormat(g_alphaFormats[d]);
+
+                for (pass = 0; pass < 2; pass++) {
+                    const SDL_bool premultiply = (pass == 0);
+                    int mismatches;
+
+                    if (premultiply) {
+                        ret = SDL_PremultiplyAlpha(w, h, g_alphaFormats[s], src, src_pitch, g_alphaFormats[d], dst, dst_pitch);
+                    } else {
+                        ret = SDL_UnpremultiplyAlpha(w, h, g_alphaFormats[s], src, src_pitch, g_alphaFormats[d], dst, dst_pitch);
+                    }
+                    SDLTest_AssertCheck(ret == 0, "Verify result from converting %dx%d %s to %s, expected: 0, got: %i",
+                                        w, h, SDL_GetPixelFormatName(g_alphaFormats[s]), SDL_GetPixelFormatName(g_alphaFormats[d]), ret);
+                    mismatches = pixels_checkAlphaConversion(premultiply, w, h, src_format, src, src_pitch, dst_format, dst, dst_pitch);
+                    SDLTest_AssertCheck(mismatches == 0, "Verify %s %dx%d %s to %s matches the scalar formula; %d mismatches",
+                                        premultiply ? "premultiplying" : "unpremultiplying",
+                                        w, h, SDL_GetPixelFormatName(g_alphaFormats[s]), SDL_GetPixelFormatName(g_alphaFormats[d]), mismatches);
+                }
+                SDL_DestroyPixelFormat(dst_format);
+            }
+
+            /* Converting in place gives the same pixels */
+            SDL_memcpy(inplace, src, (size_t)src_pitch * h);
+            ret = SDL_PremultiplyAlpha(w, h, g_alphaFormats[s], inplace, src_pitch, g_alphaFormats[s], inplace, src_pitch);
+            SDLTest_AssertCheck(ret == 0, "Verify result from premultiplying in place, expected: 0, got: %i", ret);
+            ret = pixels_checkAlphaConversion(SDL_TRUE, w, h, src_format, src, src_pitch, src_format, inplace, src_pitch);
+            SDLTest_AssertCheck(ret == 0, "Verify premultiplying %dx%d %s in place matches the scalar formula; %d mismatches",
+                                w, h, SDL_GetPixelFormatName(g_alphaFormats[s]), ret);
+
+            SDL_DestroyPixelFormat(src_format);
+        }
+
+        SDL_free(src);
+        SDL_free(dst);
+        SDL_free(inplace);
+    }
+    SDL_SetHint(SDL_HINT_CONVERT_THREADS, NULL);
+
+    /* Opaque pixels survive a round trip unchanged */
+    {
+        Uint32 pixels[17], original[17];
+        int i;
+
+        pixels_randomAlphaPixels(pixels, SDL_arraysize(pixels));
+        for (i = 0; i < (int)SDL_arraysize(pixels); i++) {
+            pixels[i] |= 0xFF000000;
+        }
+        SDL_memcpy(original, pixels, sizeof(pixels));
+        SDL_PremultiplyAlpha(17, 1, SDL_PIXELFORMAT_ARGB8888, pixels, sizeof(pixels), SDL_PIXELFORMAT_ARGB8888, pixels, sizeof(pixels));
+        SDL_UnpremultiplyAlpha(17, 1, SDL_PIXELFORMAT_ARGB8888, pixels, sizeof(pixels), SDL_PIXELFORMAT_ARGB8888, pixels, sizeof(pixels));
+        SDLTest_AssertCheck(SDL_memcmp(pixels, original, sizeof(pixels)) == 0, "Verify opaque pixels are unchanged by a round trip");
+    }
+
+    /* Formats without 8 bits of alpha are refused */
+    {
+        Uint32 pixel = 0;
+
+        ret = SDL_PremultiplyAlpha(1, 1, SDL_PIXELFORMAT_XRGB8888, &pixel, 4, SDL_PIXELFORMAT_ARGB8888, &pixel, 4);
+        SDLTest_AssertCheck(ret < 0, "Verify SDL_PremultiplyAlpha refuses SDL_PIXELFORMAT_XRGB8888, got: %i", ret);
+        ret = SDL_UnpremultiplyAlpha(1, 1, SDL_PIXELFORMAT_ARGB8888, &pixel, 4, SDL_PIXELFORMAT_ARGB2101010, &pixel, 4);
+        SDLTest_AssertCheck(ret < 0, "Verify SDL_UnpremultiplyAlpha refuses SDL_PIXELFORMAT_ARGB2101010, got: %i", ret);
+    }
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Check that converting a color keyed surface to a format with alpha makes the key transparent
+ *
+ * @sa SDL_ConvertSurfaceFormat
+ */
+static int pixels_colorkeyToAlpha(void *arg)
+{
+    static const struct
+    {
+        int w, h;
+        const char *threads;
+    } sizes[] = {
+        { 13, 7, NULL }, { 1023, 300, "4" }
+    };
+    const Uint32 key = 0x00123456;
+    int size;
+
+    for (size = 0; size < (int)SDL_arraysize(sizes); size++) {
+        const int w = sizes[size].w;
+        const int h = sizes[size].h;
+        SDL_Surface *surface, *converted;
+        int x, y, mismatches = 0;
+
+        surface = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_XRGB8888);
+        SDLTest_AssertCheck(surface != NULL, "Verify SDL_CreateSurface(%d, %d) is not NULL", w, h);
+        if (surface == NULL) {
+            return TEST_ABORTED;
+        }
+        for (y = 0; y < h; y++) {
+            Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+            for (x = 0; x < w; x++) {
+                row[x] = ((x + y) % 3 == 0) ? key : ((Uint32)SDLTest_RandomUint32() & 0x00FFFFFF);
+            }
+        }
+        SDL_SetSurfaceColorKey(surface, SDL_TRUE, key);
+
+        SDL_SetHint(SDL_HINT_CONVERT_THREADS, sizes[size].threads);
+        converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888);
+        SDL_SetHint(SDL_HINT_CONVERT_THREADS, NULL);
+        SDLTest_AssertCheck(converted != NULL, "Verify SDL_ConvertSurfaceFormat() is not NULL");
+        if (converted == NULL) {
+            SDL_DestroySurface(surface);
+            return TEST_ABORTED;
+        }
+
+        for (y = 0; y < h; y++) {
+            const Uint32 *src = (const Uint32 *)((const Uint8 *)surface->pixels + y * surface->pitch);
+            const Uint32 *dst = (const Uint32 *)((const Uint8 *)converted->pixels + y * converted->pitch);
+            for (x = 0; x < w; x++) {
+                const Uint32 rgb = src[x] & 0x00FFFFFF;
+                const Uint32 expected = (rgb == key) ? rgb : (rgb | 0xFF000000);
+                if (dst[x] != expected) {
+                    mismatches++;
+                }
+            }
+        }
+        SDLTest_AssertCheck(mismatches == 0, "Verify only color keyed pixels of %dx%d are transparent; %d mismatches", w, h, mismatches);
+
+        SDL_DestroySurface(converted);
+        SDL_DestroySurface(surface);
+    }
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Pixels test cases */
@@ -362,9 +725,21 @@ static const SDLTest_TestCaseReference pixelsTest3 = {
     (SDLTest_TestCaseFp)pixels_getPixelFormatName, "pixels_getPixelFormatName", "Call to SDL_GetPixelFormatName", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference pixelsTest4 = {
+    (SDLTest_TestCaseFp)pixels_mapRGBPalette, "pixels_mapRGBPalette", "Check SDL_MapRGB and SDL_MapRGBA against palettes", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference pixelsTest5 = {
+    (SDLTest_TestCaseFp)pixels_premultiplyAlpha, "pixels_premultiplyAlpha", "Check SDL_PremultiplyAlpha and SDL_UnpremultiplyAlpha", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference pixelsTest6 = {
+    (SDLTest_TestCaseFp)pixels_colorkeyToAlpha, "pixels_colorkeyToAlpha", "Check converting a color key to alpha", TEST_ENABLED
+};
+
 /* Sequence of Pixels test cases */
 static const SDLTest_TestCaseReference *pixelsTests[] = {
-    &pixelsTest1, &pixelsTest2, &pixelsTest3, NULL
+    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, &pixelsTest5, &pixelsTest6, NULL
 };
 
 /* Pixels test suite (global) */
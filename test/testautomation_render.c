@@ -2,6 +2,8 @@
  * Original code: automated SDL platform test written by Edgar Simo "bobbens"
  * Extended and extensively updated by aschiffler at ferzkopp dot net
  */
+#include <stdio.h>
+
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_test.h>
 #include "testautomation_images.h"
@@ -918,6 +920,76 @@ static int render_testLogicalSize(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests capturing presented frames in the background
+ */
+static int render_testCapture(void *arg)
+{
+    const char *prefix = "render_testCapture";
+    const int num_frames = 4;
+    Uint64 captured = 0, written = 0, dropped = 0;
+    SDL_FRect rect;
+    SDL_Surface *frame;
+    char path[64];
+    int i, ret;
+    int w = 0, h = 0;
+
+    clearScreen();
+    CHECK_FUNC(SDL_GetCurrentRenderOutputSize, (renderer, &w, &h))
+
+    CHECK_FUNC(SDL_StartRenderCapture, (renderer, prefix, SDL_RENDER_CAPTURE_BMP, 2))
+    ret = SDL_StartRenderCapture(renderer, prefix, SDL_RENDER_CAPTURE_BMP, 0);
+    SDLTest_AssertCheck(ret < 0, "Validate that SDL_StartRenderCapture() needs a queue, got: %i", ret);
+    CHECK_FUNC(SDL_StartRenderCapture, (renderer, prefix, SDL_RENDER_CAPTURE_BMP, num_frames))
+
+    /* Draw a growing rectangle in each frame */
+    for (i = 0; i < num_frames; ++i) {
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 0, SDL_ALPHA_OPAQUE))
+        CHECK_FUNC(SDL_RenderClear, (renderer))
+        CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 0, 0, SDL_ALPHA_OPAQUE))
+        rect.x = 0.0f;
+        rect.y = 0.0f;
+        rect.w = (float)(i + 1) * 10.0f;
+        rect.h = 10.0f;
+        CHECK_FUNC(SDL_RenderFillRect, (renderer, &rect))
+        CHECK_FUNC(SDL_RenderPresent, (renderer))
+    }
+
+    CHECK_FUNC(SDL_StopRenderCapture, (renderer))
+    CHECK_FUNC(SDL_GetRenderCaptureStats, (renderer, &captured, &written, &dropped))
+    SDLTest_AssertCheck(captured + dropped == (Uint64)num_frames, "Validate that every frame was captured or dropped, got %" SDL_PRIu64 " captured, %" SDL_PRIu64 " dropped", captured, dropped);
+    SDLTest_AssertCheck(written == captured, "Validate that every captured frame was written, expected: %" SDL_PRIu64 ", got: %" SDL_PRIu64, captured, written);
+
+    /* Check the last frame, unless it was dropped */
+    (void)SDL_snprintf(path, sizeof(path), "%s%8.8d.bmp", prefix, num_frames);
+    frame = SDL_LoadBMP(path);
+    if (frame) {
+        SDL_Surface *converted = SDL_ConvertSurfaceFormat(frame, SDL_PIXELFORMAT_XRGB8888);
+        Uint8 r, g, b;
+
+        SDLTest_AssertCheck(frame->w == w && frame->h == h, "Validate captured frame size, expected: %dx%d, got: %dx%d", w, h, frame->w, frame->h);
+        if (converted) {
+            const Uint32 *row = (const Uint32 *)converted->pixels;
+
+            SDL_GetRGB(row[(num_frames * 10) - 1], converted->format, &r, &g, &b);
+            SDLTest_AssertCheck(r == 255 && g == 0 && b == 0, "Validate captured rectangle color, got %d,%d,%d", r, g, b);
+            SDL_GetRGB(row[num_frames * 10], converted->format, &r, &g, &b);
+            SDLTest_AssertCheck(r == 0 && g == 0 && b == 0, "Validate captured background color, got %d,%d,%d", r, g, b);
+            SDL_DestroySurface(converted);
+        }
+        SDL_DestroySurface(frame);
+    } else {
+        SDLTest_AssertCheck(dropped > 0, "Validate that the last frame was written, %s", SDL_GetError());
+    }
+
+    for (i = 1; i <= num_frames; ++i) {
+        (void)SDL_snprintf(path, sizeof(path), "%s%8.8d.bmp", prefix, i);
+        (void)remove(path);
+    }
+
+    return TEST_COMPLETED;
+}
+
 /* Helper functions */
 
 /**
@@ -1270,11 +1342,15 @@ static const SDLTest_TestCaseReference renderTest9 = {
     (SDLTest_TestCaseFp)render_testLogicalSize, "render_testLogicalSize", "Tests logical size", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference renderTest10 = {
+    (SDLTest_TestCaseFp)render_testCapture, "render_testCapture", "Tests frame capture", TEST_ENABLED
+};
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTest1, &renderTest2, &renderTest3, &renderTest4,
     &renderTest5, &renderTest6, &renderTest7, &renderTest8,
-    &renderTest9, NULL
+    &renderTest9, &renderTest10, NULL
 };
 
 /* Render test suite (global) */
@@ -750,6 +750,101 @@ static int surface_testOverflow(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Converts a gray ramp to a 4-gray palette, returns the summed error of each column's average against the ramp, or -1 */
+static int surface_ditherRamp(const char *dither, Uint8 **indices)
+{
+    static const SDL_Color grays[4] = { { 0, 0, 0, 255 }, { 85, 85, 85, 255 }, { 170, 170, 170, 255 }, { 255, 255, 255, 255 } };
+    const int w = 64, h = 64;
+    SDL_Surface *ramp, *converted;
+    SDL_PixelFormat *format;
+    SDL_Palette *palette;
+    int x, y, error = -1;
+
+    ramp = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_RGB24);
+    format = SDL_CreatePixelFormat(SDL_PIXELFORMAT_INDEX8);
+    palette = SDL_CreatePalette(4);
+    SDLTest_AssertCheck(ramp != NULL && format != NULL && palette != NULL, "Verify the ramp, format and palette were created");
+    if (ramp == NULL || format == NULL || palette == NULL) {
+        goto done;
+    }
+    SDL_SetPaletteColors(palette, grays, 0, 4);
+    SDL_SetPixelFormatPalette(format, palette);
+    for (y = 0; y < h; y++) {
+        Uint8 *row = (Uint8 *)ramp->pixels + y * ramp->pitch;
+        for (x = 0; x < w; x++) {
+            row[x * 3 + 0] = row[x * 3 + 1] = row[x * 3 + 2] = (Uint8)(x * 4);
+        }
+    }
+
+    SDL_SetHint(SDL_HINT_SURFACE_DITHER, dither);
+    converted = SDL_ConvertSurface(ramp, format);
+    SDL_ResetHint(SDL_HINT_SURFACE_DITHER);
+    SDLTest_AssertCheck(converted != NULL, "Verify SDL_ConvertSurface with dither '%s' succeeds", dither ? dither : "(null)");
+    if (converted == NULL) {
+        goto done;
+    }
+
+    *indices = (Uint8 *)SDL_malloc(w * h);
+    if (*indices != NULL) {
+        error = 0;
+        for (x = 0; x < w; x++) {
+            int sum = 0;
+            for (y = 0; y < h; y++) {
+                const Uint8 index = ((Uint8 *)converted->pixels)[y * converted->pitch + x];
+                (*indices)[y * w + x] = index;
+                sum += grays[index & 3].r;
+            }
+            error += SDL_abs(sum / h - x * 4);
+        }
+    }
+    SDL_DestroySurface(converted);
+
+done:
+    SDL_DestroySurface(ramp);
+    SDL_DestroyPixelFormat(format);
+    SDL_DestroyPalette(palette);
+    return error;
+}
+
+/**
+ * \brief Tests dithering when converting to an 8-bit palette.
+ *
+ * \sa SDL_HINT_SURFACE_DITHER
+ */
+static int surface_testDitherToPalette(void *arg)
+{
+    Uint8 *plain = NULL, *none = NULL, *ordered = NULL, *diffused = NULL;
+    int plain_error, none_error, ordered_error, diffused_error, i, out_of_range = 0;
+
+    plain_error = surface_ditherRamp(NULL, &plain);
+    none_error = surface_ditherRamp("none", &none);
+    ordered_error = surface_ditherRamp("ordered", &ordered);
+    diffused_error = surface_ditherRamp("floyd-steinberg", &diffused);
+
+    if (plain != NULL && none != NULL) {
+        SDLTest_AssertCheck(none_error == plain_error && SDL_memcmp(plain, none, 64 * 64) == 0, "Verify 'none' converts the same as no hint");
+    }
+    if (ordered != NULL && diffused != NULL) {
+        for (i = 0; i < 64 * 64; i++) {
+            if (ordered[i] > 3 || diffused[i] > 3) {
+                out_of_range++;
+            }
+        }
+        SDLTest_AssertCheck(out_of_range == 0, "Verify dithered pixels are palette entries; %d are not", out_of_range);
+    }
+
+    /* Dithering should get each column's average much closer to the ramp */
+    SDLTest_AssertCheck(plain_error > 0, "Verify undithered columns are off; got %d", plain_error);
+    SDLTest_AssertCheck(ordered_error >= 0 && ordered_error < plain_error / 2, "Verify ordered dithering error %d is well under %d", ordered_error, plain_error);
+    SDLTest_AssertCheck(diffused_error >= 0 && diffused_error < plain_error / 2, "Verify Floyd-Steinberg error %d is well under %d", diffused_error, plain_error);
+
+    SDL_free(plain);
+    SDL_free(none);
+    SDL_free(ordered);
+    SDL_free(diffused);
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -808,11 +903,15 @@ static const SDLTest_TestCaseReference surfaceTestOverflow = {
     surface_testOverflow, "surface_testOverflow", "Test overflow detection.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestDither = {
+    surface_testDitherToPalette, "surface_testDitherToPalette", "Tests dithering when converting to an 8-bit palette.", TEST_ENABLED
+};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, &surfaceTestOverflow, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTestOverflow, &surfaceTestDither, NULL
 };
 
 /* Surface test suite (global) */
@@ -0,0 +1,246 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures the throughput of SDL_SaveBMP_RW() and SDL_LoadBMP_RW() and checks
+ * that images survive the round trip, with and without multi-threaded
+ * conversion.
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#include <stdio.h>
+
+typedef struct
+{
+    const char *name;
+    Uint32 format;
+    SDL_bool legacy;      /* Save without the alpha mask */
+    SDL_bool transparent; /* All alpha values are zero */
+} BMPFormat;
+
+static double elapsed(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static SDL_Surface *create_image(SDLTest_RandomContext *rndctx, const BMPFormat *format, int w, int h)
+{
+    SDL_Surface *surface = SDL_CreateSurface(w, h, format->format);
+    int x, y;
+
+    if (surface == NULL) {
+        return NULL;
+    }
+    for (y = 0; y < h; ++y) {
+        Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+        for (x = 0; x < surface->pitch; ++x) {
+            row[x] = (Uint8)SDLTest_RandomInt(rndctx);
+        }
+        if (format->transparent) {
+            Uint32 *pixels = (Uint32 *)row;
+            for (x = 0; x < w; ++x) {
+                pixels[x] &= ~surface->format->Amask;
+            }
+        }
+    }
+    return surface;
+}
+
+static SDL_bool same_pixels(SDL_Surface *a, SDL_Surface *b)
+{
+    const int bw = a->w * a->format->BytesPerPixel;
+    int y;
+
+    if (a->w != b->w || a->h != b->h || a->format->format != b->format->format) {
+        return SDL_FALSE;
+    }
+    for (y = 0; y < a->h; ++y) {
+        if (SDL_memcmp((Uint8 *)a->pixels + y * a->pitch, (Uint8 *)b->pixels + y * b->pitch, bw) != 0) {
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+/* Saves and loads the image through memory, or a file if there is a path, returns the loaded copy */
+static SDL_Surface *round_trip(SDL_Surface *surface, const char *path, Uint8 *buffer, size_t size, const char *threads, double *save_time, double *load_time)
+{
+    SDL_Surface *loaded;
+    Uint64 start;
+
+    SDL_SetHint(SDL_HINT_CONVERT_THREADS, threads);
+
+    start = SDL_GetPerformanceCounter();
+    if (SDL_SaveBMP_RW(surface, path ? SDL_RWFromFile(path, "wb") : SDL_RWFromMem(buffer, size), SDL_TRUE) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_SaveBMP_RW() failed: %s", SDL_GetError());
+        return NULL;
+    }
+    *save_time += elapsed(start);
+
+    start = SDL_GetPerformanceCounter();
+    loaded = SDL_LoadBMP_RW(path ? SDL_RWFromFile(path, "rb") : SDL_RWFromConstMem(buffer, size), SDL_TRUE);
+    if (loaded == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_LoadBMP_RW() failed: %s", SDL_GetError());
+        return NULL;
+    }
+    *load_time += elapsed(start);
+
+    return loaded;
+}
+
+int main(int argc, char *argv[])
+{
+    static const BMPFormat formats[] = {
+        { "ARGB8888", SDL_PIXELFORMAT_ARGB8888, SDL_FALSE, SDL_FALSE },
+        { "ARGB8888 legacy", SDL_PIXELFORMAT_ARGB8888, SDL_TRUE, SDL_FALSE },
+        { "ARGB8888 no alpha", SDL_PIXELFORMAT_ARGB8888, SDL_TRUE, SDL_TRUE },
+        { "XRGB8888", SDL_PIXELFORMAT_XRGB8888, SDL_FALSE, SDL_FALSE },
+        { "BGR24", SDL_PIXELFORMAT_BGR24, SDL_FALSE, SDL_FALSE },
+        { "INDEX8", SDL_PIXELFORMAT_INDEX8, SDL_FALSE, SDL_FALSE }
+    };
+    SDLTest_CommonState *state;
+    SDLTest_RandomContext rndctx;
+    const char *path = NULL;
+    int w = 1920, h = 1080;
+    int iterations = 10;
+    int result = 0;
+    size_t size;
+    Uint8 *buffer;
+    int i, f;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (state == NULL) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1] && argv[i + 2]) {
+                w = SDL_atoi(argv[i + 1]);
+                h = SDL_atoi(argv[i + 2]);
+                consumed = 3;
+            } else if (SDL_strcmp(argv[i], "--iterations") == 0 && argv[i + 1]) {
+                iterations = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--file") == 0 && argv[i + 1]) {
+                path = argv[i + 1];
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--size W H]", "[--iterations N]", "[--file path]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (w <= 0 || h <= 0 || iterations <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Image size and iteration count must be positive.");
+        return 1;
+    }
+
+    /* Enough for the largest header, a palette and 32-bit pixels */
+    size = 1024 + 256 * 4 + (size_t)w * h * 4;
+    buffer = (Uint8 *)SDL_malloc(size);
+    if (buffer == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        return 1;
+    }
+
+    SDLTest_RandomInit(&rndctx, 0x12345678, 0x9abcdef0);
+    SDL_Log("Saving and loading %dx%d images through %s, %d iterations, %d CPUs", w, h, path ? path : "memory", iterations, SDL_GetCPUCount());
+
+    for (f = 0; f < (int)SDL_arraysize(formats); f++) {
+        const BMPFormat *format = &formats[f];
+        SDL_Surface *surface = create_image(&rndctx, format, w, h);
+        SDL_Surface *single = NULL, *multi = NULL, *expected = NULL;
+        double single_save = 0.0, single_load = 0.0, multi_save = 0.0, multi_load = 0.0;
+        double megabytes;
+
+        if (surface == NULL) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create image: %s", SDL_GetError());
+            return 1;
+        }
+        SDL_SetHint(SDL_HINT_BMP_SAVE_LEGACY_FORMAT, format->legacy ? "1" : "0");
+
+        for (i = 0; i < iterations; i++) {
+            SDL_DestroySurface(single);
+            SDL_DestroySurface(multi);
+            single = round_trip(surface, path, buffer, size, "1", &single_save, &single_load);
+            multi = round_trip(surface, path, buffer, size, "", &multi_save, &multi_load);
+            if (single == NULL || multi == NULL) {
+                result = 1;
+                break;
+            }
+        }
+
+        if (single != NULL && multi != NULL) {
+            megabytes = (double)w * h * surface->format->BytesPerPixel * iterations / (1024.0 * 1024.0);
+            SDL_Log("%-18s save %8.1f / %8.1f MB/s, load %8.1f / %8.1f MB/s (single / multi-threaded)", format->name,
+                    megabytes / single_save, megabytes / multi_save, megabytes / single_load, megabytes / multi_load);
+
+            if (!same_pixels(single, multi)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: multi-threaded round trip differs!", format->name);
+                result = 1;
+            }
+
+            /* What the loaded image should look like */
+            if (format->transparent) {
+                expected = SDL_ConvertSurfaceFormat(surface, single->format->format);
+                if (expected != NULL) {
+                    int x, y;
+                    for (y = 0; y < h; ++y) {
+                        Uint32 *pixels = (Uint32 *)((Uint8 *)expected->pixels + y * expected->pitch);
+                        for (x = 0; x < w; ++x) {
+                            pixels[x] |= expected->format->Amask;
+                        }
+                    }
+                }
+            } else if (SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
+                /* The indices are saved as they are, a copy could remap duplicate colors */
+                expected = surface;
+            } else {
+                expected = SDL_ConvertSurfaceFormat(surface, single->format->format);
+            }
+            if (expected == NULL || !same_pixels(single, expected)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: round trip changed the image!", format->name);
+                result = 1;
+            }
+            if (expected != surface) {
+                SDL_DestroySurface(expected);
+            }
+        }
+
+        SDL_DestroySurface(single);
+        SDL_DestroySurface(multi);
+        SDL_DestroySurface(surface);
+    }
+
+    SDL_ResetHint(SDL_HINT_CONVERT_THREADS);
+    SDL_ResetHint(SDL_HINT_BMP_SAVE_LEGACY_FORMAT);
+    SDL_free(buffer);
+    if (path) {
+        (void)remove(path);
+    }
+    SDLTest_CommonDestroyState(state);
+
+    return result;
+}
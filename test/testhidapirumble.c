@@ -0,0 +1,197 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Checks the order the HIDAPI rumble queue sends requests in */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+/* Hack to avoid dynapi renaming */
+#include "../src/dynapi/SDL_dynapi.h"
+#ifdef SDL_DYNAMIC_API
+#undef SDL_DYNAMIC_API
+#endif
+#define SDL_DYNAMIC_API 0
+
+#include "../src/SDL_internal.h"
+
+#ifdef SDL_JOYSTICK_HIDAPI
+
+/* SDL_CreateThreadInternal() isn't exported, and the rumble thread is never
+   started here anyway, the test takes requests off the queue itself */
+#include "../src/thread/SDL_systhread.h"
+#define SDL_CreateThreadInternal(fn, name, stacksize, data) SDL_CreateThread(fn, name, data)
+
+#include "../src/joystick/hidapi/SDL_hidapi_rumble.c"
+
+#define RUMBLE_REPORT 0x01
+#define OTHER_REPORT  0x02
+
+static SDL_HIDAPI_Device *device_a;
+static SDL_HIDAPI_Device *device_b;
+
+static void SDLCALL RumbleSent(void *userdata)
+{
+}
+
+static void SetUpQueue(void)
+{
+    SDL_HIDAPI_RumbleContext *ctx = &rumble_context;
+
+    SDL_HIDAPI_rumble_lock = SDL_CreateMutex();
+    ctx->request_sem = SDL_CreateSemaphore(0);
+    SDL_AtomicSet(&ctx->running, SDL_TRUE);
+    SDL_AtomicSet(&ctx->initialized, SDL_TRUE);
+
+    device_a = (SDL_HIDAPI_Device *)SDL_calloc(1, sizeof(*device_a));
+    device_b = (SDL_HIDAPI_Device *)SDL_calloc(1, sizeof(*device_b));
+}
+
+static void TearDownQueue(void)
+{
+    SDL_HIDAPI_QuitRumble();
+    SDL_free(device_a);
+    SDL_free(device_b);
+}
+
+static void QueueRumble(SDL_HIDAPI_Device *device, Uint8 strength, SDL_bool stop)
+{
+    Uint8 data[4] = { RUMBLE_REPORT, 0, 0, 0 };
+
+    data[1] = strength;
+    device->rumble_priority = stop;
+    SDL_HIDAPI_SendRumble(device, data, sizeof(data));
+    device->rumble_priority = SDL_FALSE;
+}
+
+static void QueueOther(SDL_HIDAPI_Device *device)
+{
+    Uint8 data[8] = { OTHER_REPORT, 0, 0, 0, 0, 0, 0, 0 };
+
+    SDL_HIDAPI_LockRumble();
+    SDL_HIDAPI_SendRumbleWithCallbackAndUnlock(device, data, sizeof(data), RumbleSent, NULL);
+}
+
+/* Take the next request off the queue, the same way the rumble thread does */
+static SDL_bool CheckNextRequest(SDL_HIDAPI_Device *device, Uint8 report, Uint8 strength, const char *description)
+{
+    SDL_HIDAPI_RumbleContext *ctx = &rumble_context;
+    SDL_HIDAPI_RumbleRequest *request;
+    SDL_bool passed;
+
+    request = SDL_HIDAPI_PopRumbleRequest(&ctx->priority_requests);
+    if (request == NULL) {
+        request = SDL_HIDAPI_PopRumbleRequest(&ctx->requests);
+    }
+
+    if (request == NULL) {
+        passed = (device == NULL);
+    } else {
+        passed = (request->device == device && request->data[0] == report &&
+                  (report != RUMBLE_REPORT || request->data[1] == strength));
+        SDL_HIDAPI_FinishRumbleRequest(request);
+    }
+    SDL_Log("%s: %s", passed ? "PASS" : "FAIL", description);
+    return passed;
+}
+
+static SDL_bool run_test(void)
+{
+    SDL_bool passed = SDL_TRUE;
+
+    /* A stop replaces the pending motor-on request for the device */
+    SetUpQueue();
+    QueueRumble(device_a, 0xFF, SDL_FALSE);
+    QueueRumble(device_a, 0x00, SDL_TRUE);
+    passed &= CheckNextRequest(device_a, RUMBLE_REPORT, 0x00, "stop replaces the pending motor-on");
+    passed &= CheckNextRequest(NULL, 0, 0, "motor-on isn't sent after the stop");
+    if (device_a->rumble_coalesced != 1) {
+        SDL_Log("FAIL: replaced motor-on isn't counted as coalesced");
+        passed = SDL_FALSE;
+    }
+    TearDownQueue();
+
+    /* Rumble is only merged into the device's last request, not one queued before another report */
+    SetUpQueue();
+    QueueRumble(device_a, 0x40, SDL_FALSE);
+    QueueOther(device_a);
+    QueueRumble(device_a, 0x80, SDL_FALSE);
+    QueueRumble(device_a, 0xC0, SDL_FALSE);
+    passed &= CheckNextRequest(device_a, RUMBLE_REPORT, 0x40, "rumble queued before the other report keeps its data");
+    passed &= CheckNextRequest(device_a, OTHER_REPORT, 0, "other report is sent in order");
+    passed &= CheckNextRequest(device_a, RUMBLE_REPORT, 0xC0, "latest rumble is sent last");
+    passed &= CheckNextRequest(NULL, 0, 0, "rumble after the other report is merged");
+    if (device_a->rumble_coalesced != 1) {
+        SDL_Log("FAIL: merged rumble isn't counted as coalesced");
+        passed = SDL_FALSE;
+    }
+    TearDownQueue();
+
+    /* A stop is sent ahead of other devices, but after the device's own earlier packets */
+    SetUpQueue();
+    QueueRumble(device_b, 0x80, SDL_FALSE);
+    QueueRumble(device_a, 0xFF, SDL_FALSE);
+    QueueOther(device_a);
+    QueueRumble(device_a, 0x00, SDL_TRUE);
+    passed &= CheckNextRequest(device_a, OTHER_REPORT, 0, "device's earlier packet is sent first");
+    passed &= CheckNextRequest(device_a, RUMBLE_REPORT, 0x00, "stop overtakes the other device");
+    passed &= CheckNextRequest(device_b, RUMBLE_REPORT, 0x80, "other device's rumble is sent last");
+    passed &= CheckNextRequest(NULL, 0, 0, "queue is empty");
+    TearDownQueue();
+
+    /* Only the stop itself is prioritized, packets queued after it stay in order */
+    SetUpQueue();
+    QueueRumble(device_b, 0x80, SDL_FALSE);
+    device_a->rumble_priority = SDL_TRUE;
+    QueueOther(device_a);
+    QueueOther(device_a);
+    device_a->rumble_priority = SDL_FALSE;
+    passed &= CheckNextRequest(device_a, OTHER_REPORT, 0, "first packet of the stop is prioritized");
+    passed &= CheckNextRequest(device_b, RUMBLE_REPORT, 0x80, "other device's rumble is sent next");
+    passed &= CheckNextRequest(device_a, OTHER_REPORT, 0, "second packet of the stop stays in order");
+    TearDownQueue();
+
+    return passed;
+}
+
+#else
+
+static SDL_bool run_test(void)
+{
+    SDL_Log("HIDAPI joystick support isn't enabled, skipping the test");
+    return SDL_TRUE;
+}
+
+#endif /* SDL_JOYSTICK_HIDAPI */
+
+int main(int argc, char *argv[])
+{
+    int result;
+    SDLTest_CommonState *state;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (state == NULL) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    if (!SDLTest_CommonDefaultArgs(state, argc, argv)) {
+        return 1;
+    }
+
+    result = run_test() ? 0 : 1;
+
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
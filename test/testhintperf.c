@@ -0,0 +1,182 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures hint lookups per second while another thread keeps changing the
+ * hint, and checks that readers never see anything but a valid value.
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define TEST_HINT "SDL_TEST_HINT_PERF"
+
+static const char *hint_names[] = {
+    SDL_HINT_RENDER_SCALE_QUALITY,
+    SDL_HINT_RENDER_VSYNC,
+    SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS,
+    SDL_HINT_MOUSE_RELATIVE_MODE_WARP,
+    SDL_HINT_GAMECONTROLLERCONFIG,
+    TEST_HINT
+};
+
+static SDL_AtomicInt stop;
+static SDL_AtomicInt errors;
+static SDL_bool use_handles;
+
+static int SDLCALL reader_thread(void *data)
+{
+    Uint64 *lookups = (Uint64 *)data;
+    SDL_HintHandle *handles[SDL_arraysize(hint_names)];
+    Uint64 count = 0;
+    int i;
+
+    for (i = 0; i < (int)SDL_arraysize(hint_names); ++i) {
+        handles[i] = SDL_GetHintHandle(hint_names[i]);
+    }
+
+    while (!SDL_AtomicGet(&stop)) {
+        const char *value = NULL;
+
+        for (i = 0; i < 1000; ++i) {
+            const int index = i % (int)SDL_arraysize(hint_names);
+            if (use_handles) {
+                value = SDL_GetHintHandleValue(handles[index]);
+            } else {
+                value = SDL_GetHint(hint_names[index]);
+            }
+        }
+        count += 1000;
+
+        /* The test hint must always be one of the values set by the updater */
+        value = use_handles ? SDL_GetHintHandleValue(handles[SDL_arraysize(hint_names) - 1]) : SDL_GetHint(TEST_HINT);
+        if (value == NULL || (SDL_strcmp(value, "0") != 0 && SDL_strcmp(value, "1") != 0)) {
+            SDL_AtomicAdd(&errors, 1);
+        }
+    }
+    *lookups = count;
+    return 0;
+}
+
+static int SDLCALL updater_thread(void *data)
+{
+    Uint64 *updates = (Uint64 *)data;
+    Uint64 count = 0;
+
+    while (!SDL_AtomicGet(&stop)) {
+        SDL_SetHint(TEST_HINT, (count & 1) ? "1" : "0");
+        ++count;
+    }
+    *updates = count;
+    return 0;
+}
+
+static int run_test(int num_threads, Uint32 duration)
+{
+    SDL_Thread *readers[64];
+    SDL_Thread *updater;
+    Uint64 lookups[64];
+    Uint64 updates = 0;
+    Uint64 total = 0;
+    Uint64 start, elapsed;
+    int i;
+
+    SDL_AtomicSet(&stop, 0);
+    SDL_AtomicSet(&errors, 0);
+
+    start = SDL_GetTicks();
+    for (i = 0; i < num_threads; ++i) {
+        lookups[i] = 0;
+        readers[i] = SDL_CreateThread(reader_thread, "HintReader", &lookups[i]);
+    }
+    updater = SDL_CreateThread(updater_thread, "HintUpdater", &updates);
+
+    SDL_Delay(duration);
+    SDL_AtomicSet(&stop, 1);
+
+    for (i = 0; i < num_threads; ++i) {
+        SDL_WaitThread(readers[i], NULL);
+        total += lookups[i];
+    }
+    SDL_WaitThread(updater, NULL);
+    elapsed = SDL_GetTicks() - start;
+    if (elapsed == 0) {
+        elapsed = 1;
+    }
+
+    SDL_Log("%-12s %d readers: %10.1f M lookups/s, %10.1f K updates/s",
+            use_handles ? "handles" : "SDL_GetHint", num_threads,
+            (double)total * 1000.0 / elapsed / 1000000.0,
+            (double)updates * 1000.0 / elapsed / 1000.0);
+
+    if (SDL_AtomicGet(&errors) > 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d lookups returned an invalid value!", SDL_AtomicGet(&errors));
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int num_threads = 4;
+    Uint32 duration = 500;
+    int result = 0;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (state == NULL) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--threads") == 0 && argv[i + 1]) {
+                num_threads = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--duration") == 0 && argv[i + 1]) {
+                duration = (Uint32)SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--threads N]", "[--duration milliseconds]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (num_threads <= 0 || num_threads > 64) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Thread count must be between 1 and 64.");
+        return 1;
+    }
+
+    SDL_SetHint(TEST_HINT, "0");
+
+    use_handles = SDL_FALSE;
+    result |= run_test(num_threads, duration);
+    use_handles = SDL_TRUE;
+    result |= run_test(num_threads, duration);
+
+    SDL_ResetHint(TEST_HINT);
+    SDLTest_CommonDestroyState(state);
+    SDL_Quit();
+
+    return result;
+}
@@ -0,0 +1,144 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how long joystick events wait between the time they were stamped
+ * and the time the application sees them, while simulating a frame loop.
+ * Run it with and without --thread and move the sticks around.
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    SDL_bool use_thread = SDL_FALSE;
+    SDL_bool wait = SDL_FALSE;
+    int fps = 60;
+    int max_events = 1000;
+    int count = 0;
+    Uint64 total = 0, min = ~(Uint64)0, max = 0;
+    SDL_bool done = SDL_FALSE;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (state == NULL) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--thread") == 0) {
+                use_thread = SDL_TRUE;
+                consumed = 1;
+            } else if (SDL_strcmp(argv[i], "--wait") == 0) {
+                wait = SDL_TRUE;
+                consumed = 1;
+            } else if (SDL_strcmp(argv[i], "--fps") == 0 && argv[i + 1]) {
+                fps = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--events") == 0 && argv[i + 1]) {
+                max_events = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--thread]", "[--wait]", "[--fps N]", "[--events N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (fps <= 0 || max_events <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Frame rate and event count must be positive.");
+        return 1;
+    }
+
+    if (use_thread) {
+        SDL_SetHint(SDL_HINT_JOYSTICK_THREAD, "1");
+    }
+
+    if (SDL_Init(SDL_INIT_JOYSTICK) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("Waiting for %d joystick events (%s, %s)...", max_events,
+            use_thread ? "input thread" : "polled input",
+            wait ? "waiting for events" : "simulated frame loop");
+
+    while (!done) {
+        SDL_Event event;
+
+        if (wait) {
+            if (!SDL_WaitEventTimeout(&event, 1000)) {
+                continue;
+            }
+        } else {
+            SDL_Delay(1000 / fps);
+            if (!SDL_PollEvent(&event)) {
+                continue;
+            }
+        }
+
+        do {
+            switch (event.type) {
+            case SDL_EVENT_JOYSTICK_ADDED:
+                if (SDL_OpenJoystick(event.jdevice.which) == NULL) {
+                    SDL_Log("Couldn't open joystick: %s", SDL_GetError());
+                } else {
+                    SDL_Log("Opened joystick %" SDL_PRIu32, event.jdevice.which);
+                }
+                break;
+            case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+            case SDL_EVENT_JOYSTICK_HAT_MOTION:
+            case SDL_EVENT_JOYSTICK_BUTTON_DOWN:
+            case SDL_EVENT_JOYSTICK_BUTTON_UP:
+            {
+                const Uint64 now = SDL_GetTicksNS();
+                const Uint64 latency = (now > event.common.timestamp) ? (now - event.common.timestamp) : 0;
+
+                total += latency;
+                min = SDL_min(min, latency);
+                max = SDL_max(max, latency);
+                if (++count == max_events) {
+                    done = SDL_TRUE;
+                }
+                break;
+            }
+            case SDL_EVENT_QUIT:
+                done = SDL_TRUE;
+                break;
+            default:
+                break;
+            }
+        } while (!done && SDL_PollEvent(&event));
+    }
+
+    if (count > 0) {
+        SDL_Log("%d events, latency min %.3f ms, avg %.3f ms, max %.3f ms", count,
+                min / 1000000.0, (double)total / count / 1000000.0, max / 1000000.0);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Compares the time spent in SDL_Log() with synchronous and asynchronous log
+ * output when the output function is slow, and checks that every message is
+ * either written out or counted as dropped.
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static SDL_AtomicInt written;
+static SDL_AtomicInt corrupted;
+static Uint32 io_delay_us = 20;
+static int num_messages = 2000;
+static SDL_LogOutputFunction default_output;
+static void *default_userdata;
+
+static void SDLCALL slow_output(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    const Uint64 end = SDL_GetTicksNS() + SDL_US_TO_NS(io_delay_us);
+
+    if (category != SDL_LOG_CATEGORY_TEST) {
+        default_output(default_userdata, category, priority, message);
+        return;
+    }
+
+    if (priority != SDL_LOG_PRIORITY_INFO ||
+        SDL_strncmp(message, "thread ", 7) != 0 || SDL_strstr(message, " message ") == NULL) {
+        SDL_AtomicIncRef(&corrupted);
+    }
+    SDL_AtomicIncRef(&written);
+
+    /* Pretend to be a slow console or file */
+    while (SDL_GetTicksNS() < end) {
+    }
+}
+
+static int SDLCALL log_thread(void *data)
+{
+    const int index = (int)(intptr_t)data;
+    int i;
+
+    for (i = 0; i < num_messages; ++i) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_TEST, "thread %d message %d\n", index, i);
+    }
+    return 0;
+}
+
+static int run_test(SDL_bool async, int num_threads)
+{
+    SDL_Thread *threads[16];
+    Uint64 start, elapsed;
+    int total = num_threads * num_messages;
+    int dropped = 0;
+    int i;
+
+    SDL_AtomicSet(&written, 0);
+    SDL_AtomicSet(&corrupted, 0);
+
+    if (async && SDL_LogSetAsync(SDL_TRUE) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't enable asynchronous logging: %s", SDL_GetError());
+        return 1;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_threads; ++i) {
+        threads[i] = SDL_CreateThread(log_thread, "LogThread", (void *)(intptr_t)i);
+    }
+    for (i = 0; i < num_threads; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    if (async) {
+        /* Wait for the log thread to catch up before checking the counts */
+        while (SDL_AtomicGet(&written) + SDL_LogGetDroppedMessages() < total &&
+               SDL_GetTicksNS() - start < SDL_MS_TO_NS(10000)) {
+            SDL_Delay(10);
+        }
+        dropped = SDL_LogGetDroppedMessages();
+        SDL_LogSetAsync(SDL_FALSE);
+    }
+
+    SDL_Log("%-12s %d threads: %8.2f us per message, %d written, %d dropped",
+            async ? "asynchronous" : "synchronous", num_threads,
+            (double)elapsed / 1000.0 / total, SDL_AtomicGet(&written), dropped);
+
+    if (SDL_AtomicGet(&corrupted) > 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d messages were corrupted!", SDL_AtomicGet(&corrupted));
+        return 1;
+    }
+    if (SDL_AtomicGet(&written) + dropped != total) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d messages were lost!", total - SDL_AtomicGet(&written) - dropped);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int num_threads = 4;
+    int result = 0;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (state == NULL) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--threads") == 0 && argv[i + 1]) {
+                num_threads = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--messages") == 0 && argv[i + 1]) {
+                num_messages = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--io-delay") == 0 && argv[i + 1]) {
+                io_delay_us = (Uint32)SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--threads N]", "[--messages N]", "[--io-delay microseconds]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (num_threads <= 0 || num_threads > 16 || num_messages <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Thread count must be between 1 and 16 and message count must be positive.");
+        return 1;
+    }
+
+    SDL_LogGetOutputFunction(&default_output, &default_userdata);
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_TEST, SDL_LOG_PRIORITY_INFO);
+    SDL_LogSetOutputFunction(slow_output, NULL);
+
+    result |= run_test(SDL_FALSE, num_threads);
+    result |= run_test(SDL_TRUE, num_threads);
+
+    SDL_LogSetOutputFunction(default_output, default_userdata);
+
+    SDLTest_CommonDestroyState(state);
+    SDL_Quit();
+
+    return result;
+}
@@ -0,0 +1,165 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures SDL_malloc() and SDL_free() throughput from several threads at
+ * once, using a mix of allocation sizes similar to what SDL does internally.
+ *
+ * Run with --trackmem to print allocation statistics at the end.
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define WORKING_SET 256
+
+static int num_operations = 200000;
+static SDL_AtomicInt errors;
+
+static int SDLCALL alloc_thread(void *data)
+{
+    SDLTest_RandomContext rndctx;
+    void *blocks[WORKING_SET];
+    size_t sizes[WORKING_SET];
+    int i;
+
+    SDLTest_RandomInit(&rndctx, 0x12345678, (unsigned int)(uintptr_t)data);
+    SDL_zeroa(blocks);
+    SDL_zeroa(sizes);
+
+    for (i = 0; i < num_operations; ++i) {
+        const int slot = (int)(SDLTest_Random(&rndctx) % WORKING_SET);
+        const Uint32 r = SDLTest_Random(&rndctx);
+        size_t size;
+
+        if (blocks[slot]) {
+            /* Make sure nobody else handed out the same memory */
+            if (*(Uint8 *)blocks[slot] != (Uint8)slot || ((Uint8 *)blocks[slot])[sizes[slot] - 1] != (Uint8)slot) {
+                SDL_AtomicIncRef(&errors);
+            }
+            SDL_free(blocks[slot]);
+        }
+
+        /* Mostly small allocations, with the occasional large one */
+        if ((r & 0xFF) == 0) {
+            size = 4096 + (r >> 8) % 65536;
+        } else {
+            size = 1 + (r >> 8) % 512;
+        }
+        if (r & 0x100) {
+            blocks[slot] = SDL_calloc(1, size);
+        } else {
+            blocks[slot] = SDL_malloc(size);
+        }
+        if (blocks[slot] == NULL) {
+            SDL_AtomicIncRef(&errors);
+            continue;
+        }
+        sizes[slot] = size;
+        SDL_memset(blocks[slot], slot, size);
+    }
+
+    for (i = 0; i < WORKING_SET; ++i) {
+        SDL_free(blocks[i]);
+    }
+    return 0;
+}
+
+static void run_test(int num_threads)
+{
+    SDL_Thread *threads[64];
+    Uint64 start, elapsed;
+    int i;
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_threads; ++i) {
+        threads[i] = SDL_CreateThread(alloc_thread, "AllocThread", (void *)(uintptr_t)(i + 1));
+    }
+    for (i = 0; i < num_threads; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    if (elapsed == 0) {
+        elapsed = 1;
+    }
+
+    SDL_Log("%2d threads: %8.2f M allocations/s", num_threads,
+            (double)num_operations * num_threads / ((double)elapsed / SDL_NS_PER_SECOND) / 1000000.0);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    SDLTest_MemoryStats stats;
+    int num_threads = 4;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (state == NULL) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--threads") == 0 && argv[i + 1]) {
+                num_threads = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--operations") == 0 && argv[i + 1]) {
+                num_operations = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--threads N]", "[--operations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (num_threads <= 0 || num_threads > 64 || num_operations <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Thread count must be between 1 and 64 and operation count must be positive.");
+        return 1;
+    }
+
+    run_test(1);
+    if (num_threads > 1) {
+        run_test(num_threads);
+    }
+
+    SDLTest_GetMemoryStats(&stats);
+    if (stats.total_allocations > 0) {
+        SDL_Log("Peak %.2f KB in use, %" SDL_PRIu64 " allocations made", stats.peak_bytes_in_use / 1024.0, stats.total_allocations);
+        for (i = 0; i < SDLTEST_MEMORY_SIZE_CLASSES; ++i) {
+            if (i < SDLTEST_MEMORY_SIZE_CLASSES - 1) {
+                SDL_Log("    up to %6d bytes: %" SDL_PRIu64, 16 << i, stats.size_classes[i]);
+            } else {
+                SDL_Log("    larger:            %" SDL_PRIu64, stats.size_classes[i]);
+            }
+        }
+    }
+
+    SDLTest_CommonDestroyState(state);
+    SDL_Quit();
+
+    if (SDL_AtomicGet(&errors) > 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d allocations failed or were corrupted!", SDL_AtomicGet(&errors));
+        return 1;
+    }
+    return 0;
+}
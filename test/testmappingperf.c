@@ -0,0 +1,168 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how long it takes to initialize the gamepad subsystem with the
+ * built-in mapping database, to load a large mapping file and to look up
+ * mappings by GUID afterwards.
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define MAPPING_BODY "a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,"
+
+static double elapsed(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+/* Every mapping gets a unique vendor and product, the same way the GUID is built in the database */
+static void make_guid(int index, char *guid, size_t size)
+{
+    const Uint16 vendor = (Uint16)(0x1000 + (index >> 16));
+    const Uint16 product = (Uint16)index;
+
+    (void)SDL_snprintf(guid, size, "03000000%.2x%.2x0000%.2x%.2x000001000000",
+                       vendor & 0xff, vendor >> 8, product & 0xff, product >> 8);
+}
+
+static char *build_database(int count, size_t *len)
+{
+    const char *platform = SDL_GetPlatform();
+    const size_t line_size = 512;
+    char *db, *p;
+    int i;
+
+    /* Half of the lines are for another platform, like in the community database */
+    db = (char *)SDL_malloc(2 * count * line_size);
+    if (db == NULL) {
+        return NULL;
+    }
+
+    p = db;
+    for (i = 0; i < count; ++i) {
+        char guid[33];
+
+        make_guid(i, guid, sizeof(guid));
+        p += SDL_snprintf(p, line_size, "%s,Benchmark Pad %d,%splatform:%s,\n", guid, i, MAPPING_BODY, platform);
+        p += SDL_snprintf(p, line_size, "%s,Other Pad %d,%splatform:Other,\n", guid, i, MAPPING_BODY);
+    }
+    *len = (size_t)(p - db);
+    return db;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int count = 10000;
+    int iterations = 10;
+    int result = 0;
+    char *db;
+    size_t dblen = 0;
+    double seconds;
+    Uint64 start;
+    int added, i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (state == NULL) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--mappings") == 0 && argv[i + 1]) {
+                count = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--iterations") == 0 && argv[i + 1]) {
+                iterations = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--mappings N]", "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (count <= 0 || count > 0xffff || iterations <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "The mapping count must be between 1 and 65535, and the iteration count positive.");
+        return 1;
+    }
+
+    /* Startup with the built-in database */
+    seconds = 0.0;
+    for (i = 0; i < iterations; ++i) {
+        start = SDL_GetPerformanceCounter();
+        if (SDL_InitSubSystem(SDL_INIT_GAMEPAD) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize gamepads: %s", SDL_GetError());
+            return 1;
+        }
+        seconds += elapsed(start);
+        if (i < iterations - 1) {
+            SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+        }
+    }
+    SDL_Log("Gamepad subsystem startup: %.3f ms with %d built-in mappings",
+            seconds * 1000.0 / iterations, SDL_GetNumGamepadMappings());
+
+    /* Loading a large mapping file */
+    db = build_database(count, &dblen);
+    if (db == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        return 1;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    added = SDL_AddGamepadMappingsFromRW(SDL_RWFromConstMem(db, dblen), SDL_TRUE);
+    seconds = elapsed(start);
+    SDL_Log("SDL_AddGamepadMappingsFromRW(): %d of %d lines in %.3f ms", added, 2 * count, seconds * 1000.0);
+    if (added != count) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Expected %d new mappings, got %d", count, added);
+        result = 1;
+    }
+
+    /* Looking up every mapping */
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < count; ++i) {
+        char guid_string[33];
+        char expected[64];
+        char *mapping;
+
+        make_guid(i, guid_string, sizeof(guid_string));
+        mapping = SDL_GetGamepadMappingForGUID(SDL_GetJoystickGUIDFromString(guid_string));
+        (void)SDL_snprintf(expected, sizeof(expected), ",Benchmark Pad %d,", i);
+        if (mapping == NULL || SDL_strstr(mapping, expected) == NULL) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Wrong mapping for %s: %s", guid_string, mapping ? mapping : SDL_GetError());
+            result = 1;
+            SDL_free(mapping);
+            break;
+        }
+        SDL_free(mapping);
+    }
+    seconds = elapsed(start);
+    SDL_Log("SDL_GetGamepadMappingForGUID(): %.0f lookups/s", count / seconds);
+
+    SDL_free(db);
+    SDL_QuitSubSystem(SDL_INIT_GAMEPAD);
+    SDLTest_CommonDestroyState(state);
+
+    return result;
+}
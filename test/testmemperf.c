@@ -0,0 +1,319 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Checks SDL_memcpy(), SDL_memmove(), SDL_memset() and SDL_strlen() against
+ * the C runtime across sizes and alignments, and compares their speed.
+ * This is most interesting when SDL is built without a C runtime, where SDL
+ * uses its own versions of these.
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#include <string.h>
+
+#define GUARD       64
+#define MAX_OFFSET  33
+#define MAX_CHECK   65537
+#define BUFFER_SIZE (MAX_CHECK + 2 * GUARD + MAX_OFFSET)
+#define MAX_MEASURE (1024 * 1024)
+
+/* Called through pointers so the compiler can't inline or drop them */
+static void *(*volatile libc_memcpy)(void *, const void *, size_t) = memcpy;
+static void *(*volatile libc_memmove)(void *, const void *, size_t) = memmove;
+static void *(*volatile libc_memset)(void *, int, size_t) = memset;
+static size_t (*volatile libc_strlen)(const char *) = strlen;
+
+/* Every size up to a few vectors is checked, then these */
+#define NUM_SMALL_SIZES 161
+static const size_t large_sizes[] = { 255, 256, 257, 1000, 4095, 4096, 4097, MAX_CHECK };
+
+static Uint8 *src_buffer;
+static Uint8 *dst_buffer;
+static Uint8 *expected_buffer;
+
+static double elapsed(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static void fill_pattern(Uint8 *buffer, size_t len, Uint32 seed)
+{
+    size_t i;
+
+    for (i = 0; i < len; ++i) {
+        seed = seed * 1103515245 + 12345;
+        buffer[i] = (Uint8)((seed >> 16) | 1); /* Never zero, for strlen() */
+    }
+}
+
+static size_t check_size(int index)
+{
+    if (index < NUM_SMALL_SIZES) {
+        return (size_t)index;
+    }
+    return large_sizes[index - NUM_SMALL_SIZES];
+}
+
+#define NUM_CHECK_SIZES (NUM_SMALL_SIZES + (int)SDL_arraysize(large_sizes))
+
+static SDL_bool check_memcpy(void)
+{
+    int i, s, d;
+
+    fill_pattern(src_buffer, BUFFER_SIZE, 1);
+    for (i = 0; i < NUM_CHECK_SIZES; ++i) {
+        const size_t len = check_size(i);
+        const size_t span = len + 2 * GUARD + MAX_OFFSET;
+
+        for (s = 0; s < MAX_OFFSET; ++s) {
+            for (d = 0; d < MAX_OFFSET; ++d) {
+                Uint8 *dst = dst_buffer + GUARD + d;
+
+                libc_memset(dst_buffer, 0xEE, span);
+                libc_memset(expected_buffer, 0xEE, span);
+                libc_memcpy(expected_buffer + GUARD + d, src_buffer + s, len);
+                if (SDL_memcpy(dst, src_buffer + s, len) != dst ||
+                    memcmp(dst_buffer, expected_buffer, span) != 0) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_memcpy() failed: %u bytes, source offset %d, destination offset %d", (unsigned int)len, s, d);
+                    return SDL_FALSE;
+                }
+            }
+        }
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool check_memmove(void)
+{
+    int i, s, d;
+
+    /* Source and destination are in the same buffer, overlapping either way */
+    for (i = 0; i < NUM_CHECK_SIZES; ++i) {
+        const size_t len = check_size(i);
+        const size_t span = len + 2 * GUARD + MAX_OFFSET;
+
+        for (s = 0; s < MAX_OFFSET; ++s) {
+            for (d = 0; d < MAX_OFFSET; ++d) {
+                Uint8 *dst = dst_buffer + GUARD + d;
+
+                fill_pattern(dst_buffer, span, (Uint32)(s + d));
+                libc_memcpy(expected_buffer, dst_buffer, span);
+                libc_memmove(expected_buffer + GUARD + d, expected_buffer + GUARD + s, len);
+                if (SDL_memmove(dst, dst_buffer + GUARD + s, len) != dst ||
+                    memcmp(dst_buffer, expected_buffer, span) != 0) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_memmove() failed: %u bytes, source offset %d, destination offset %d", (unsigned int)len, s, d);
+                    return SDL_FALSE;
+                }
+            }
+            if (len > 4096 && s > 2) {
+                break; /* The large moves are slow to check, a few offsets will do */
+            }
+        }
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool check_memset(void)
+{
+    static const int values[] = { 0, 0x5A, 0xFF, 0x1234, -1 };
+    int i, v, d;
+
+    for (i = 0; i < NUM_CHECK_SIZES; ++i) {
+        const size_t len = check_size(i);
+        const size_t span = len + 2 * GUARD + MAX_OFFSET;
+
+        for (v = 0; v < (int)SDL_arraysize(values); ++v) {
+            for (d = 0; d < MAX_OFFSET; ++d) {
+                Uint8 *dst = dst_buffer + GUARD + d;
+
+                libc_memset(dst_buffer, 0xEE, span);
+                libc_memset(expected_buffer, 0xEE, span);
+                libc_memset(expected_buffer + GUARD + d, values[v], len);
+                if (SDL_memset(dst, values[v], len) != dst ||
+                    memcmp(dst_buffer, expected_buffer, span) != 0) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_memset() failed: %u bytes, value 0x%x, offset %d", (unsigned int)len, values[v], d);
+                    return SDL_FALSE;
+                }
+            }
+        }
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool check_strlen(void)
+{
+    int i, s;
+
+    fill_pattern(src_buffer, BUFFER_SIZE, 2);
+    for (i = 0; i < NUM_CHECK_SIZES; ++i) {
+        const size_t len = check_size(i);
+
+        for (s = 0; s < MAX_OFFSET; ++s) {
+            const char *string = (const char *)src_buffer + GUARD + s;
+            size_t result;
+
+            src_buffer[GUARD + s + len] = '\0';
+            result = SDL_strlen(string);
+            src_buffer[GUARD + s + len] = 1;
+            if (result != len) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_strlen() failed: got %u instead of %u, offset %d", (unsigned int)result, (unsigned int)len, s);
+                return SDL_FALSE;
+            }
+        }
+    }
+    return SDL_TRUE;
+}
+
+typedef enum
+{
+    FUNC_MEMCPY,
+    FUNC_MEMMOVE,
+    FUNC_MEMSET,
+    FUNC_STRLEN
+} MemFunc;
+
+static const char *func_names[] = { "memcpy", "memmove", "memset", "strlen" };
+
+/* Returns the throughput in MB/s */
+static double measure(MemFunc func, SDL_bool use_sdl, size_t len, int misalign, size_t megabytes)
+{
+    Uint8 *dst = dst_buffer + GUARD + misalign;
+    const Uint8 *src = src_buffer + GUARD + (misalign ? 2 * misalign + 1 : 0);
+    Uint64 calls = SDL_max((Uint64)megabytes * 1024 * 1024 / SDL_max(len, 1), 1);
+    Uint64 i, start;
+    size_t total = 0;
+
+    calls = SDL_min(calls, 4000000);
+    if (func == FUNC_STRLEN) {
+        fill_pattern(src_buffer, MAX_MEASURE + BUFFER_SIZE, 3);
+        src_buffer[(src - src_buffer) + len] = '\0';
+    }
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < calls; ++i) {
+        switch (func) {
+        case FUNC_MEMCPY:
+            if (use_sdl) {
+                SDL_memcpy(dst, src, len);
+            } else {
+                libc_memcpy(dst, src, len);
+            }
+            break;
+        case FUNC_MEMMOVE:
+            /* Overlapping, moving towards the end of the buffer */
+            if (use_sdl) {
+                SDL_memmove(dst + 8, dst, len);
+            } else {
+                libc_memmove(dst + 8, dst, len);
+            }
+            break;
+        case FUNC_MEMSET:
+            if (use_sdl) {
+                SDL_memset(dst, (int)i, len);
+            } else {
+                libc_memset(dst, (int)i, len);
+            }
+            break;
+        case FUNC_STRLEN:
+            if (use_sdl) {
+                total += SDL_strlen((const char *)src);
+            } else {
+                total += libc_strlen((const char *)src);
+            }
+            break;
+        }
+    }
+    if (func == FUNC_STRLEN && total != len * calls) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "strlen() returned the wrong length");
+    }
+    return (double)calls * len / (1024.0 * 1024.0) / elapsed(start);
+}
+
+int main(int argc, char *argv[])
+{
+    static const size_t sizes[] = { 8, 64, 256, 4096, 65536, MAX_MEASURE };
+    SDLTest_CommonState *state;
+    size_t megabytes = 64;
+    int result = 0;
+    int i, f, s, a;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (state == NULL) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--megabytes") == 0 && argv[i + 1]) {
+                megabytes = (size_t)SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--megabytes N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (megabytes == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "The amount of data per measurement must be positive.");
+        return 1;
+    }
+
+    /* Room for the largest measurement, moved a little and misaligned */
+    src_buffer = (Uint8 *)SDL_aligned_alloc(64, MAX_MEASURE + BUFFER_SIZE);
+    dst_buffer = (Uint8 *)SDL_aligned_alloc(64, MAX_MEASURE + BUFFER_SIZE);
+    expected_buffer = (Uint8 *)SDL_aligned_alloc(64, BUFFER_SIZE);
+    if (src_buffer == NULL || dst_buffer == NULL || expected_buffer == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        return 1;
+    }
+
+    SDL_Log("CPU features: SSE2 %s, AVX2 %s, NEON %s",
+            SDL_HasSSE2() ? "yes" : "no", SDL_HasAVX2() ? "yes" : "no", SDL_HasNEON() ? "yes" : "no");
+
+    if (!check_memcpy() || !check_memmove() || !check_memset() || !check_strlen()) {
+        result = 1;
+    } else {
+        SDL_Log("All sizes and alignments match the C runtime");
+    }
+
+    SDL_Log("%-8s %8s %9s %12s %12s", "function", "size", "alignment", "SDL MB/s", "libc MB/s");
+    for (f = FUNC_MEMCPY; f <= FUNC_STRLEN; ++f) {
+        for (s = 0; s < (int)SDL_arraysize(sizes); ++s) {
+            for (a = 0; a < 2; ++a) {
+                const int misalign = a ? 3 : 0;
+                const double sdl = measure((MemFunc)f, SDL_TRUE, sizes[s], misalign, megabytes);
+                const double libc = measure((MemFunc)f, SDL_FALSE, sizes[s], misalign, megabytes);
+
+                SDL_Log("%-8s %8u %9s %12.1f %12.1f", func_names[f], (unsigned int)sizes[s], a ? "unaligned" : "aligned", sdl, libc);
+            }
+        }
+    }
+
+    SDL_aligned_free(src_buffer);
+    SDL_aligned_free(dst_buffer);
+    SDL_aligned_free(expected_buffer);
+    SDLTest_CommonDestroyState(state);
+
+    return result;
+}
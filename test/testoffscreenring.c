@@ -0,0 +1,308 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Reads the frames of an offscreen window back through the shared memory
+ * frame ring, the way an external process would, and measures how fast
+ * frames can be presented. Also checks that the software renderer only
+ * presents the areas it drew.
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_offscreen.h>
+#include <SDL3/SDL_test.h>
+
+#ifdef __LINUX__
+#include <sys/mman.h>
+#endif
+
+#define NUM_FRAMES 3 /* Keep in sync with the hint below */
+
+static SDLTest_CommonState *state;
+static SDL_Window *window;
+static const Uint8 *ring;
+static size_t ring_size;
+
+static const SDL_OffscreenFrameHeader *get_frame(int index)
+{
+    const SDL_OffscreenFrameRingHeader *header = (const SDL_OffscreenFrameRingHeader *)ring;
+    return (const SDL_OffscreenFrameHeader *)(ring + header->frame_offset + (size_t)index * header->frame_stride);
+}
+
+static Uint32 get_pixel(int index, int x, int y)
+{
+    const SDL_OffscreenFrameRingHeader *header = (const SDL_OffscreenFrameRingHeader *)ring;
+    const Uint8 *pixels = (const Uint8 *)get_frame(index) + header->pixels_offset;
+    return *(const Uint32 *)(pixels + y * header->pitch + x * 4);
+}
+
+#ifdef __LINUX__
+static const Uint8 *map_ring(size_t *size)
+{
+    const SDL_OffscreenFrameRingHeader *probe;
+    const Uint8 *mapping;
+    const int *fd;
+
+    fd = (const int *)SDL_GetWindowData(window, SDL_WINDOW_DATA_OFFSCREEN_FRAME_RING_FD);
+    if (fd == NULL) {
+        return NULL;
+    }
+
+    /* Map the ring like a consumer process would, read-only */
+    probe = (const SDL_OffscreenFrameRingHeader *)mmap(NULL, sizeof(*probe), PROT_READ, MAP_SHARED, *fd, 0);
+    if (probe == MAP_FAILED) {
+        return NULL;
+    }
+    *size = probe->frame_offset + (size_t)probe->num_frames * probe->frame_stride;
+    munmap((void *)probe, sizeof(*probe));
+
+    mapping = (const Uint8 *)mmap(NULL, *size, PROT_READ, MAP_SHARED, *fd, 0);
+    if (mapping == MAP_FAILED) {
+        return NULL;
+    }
+    return mapping;
+}
+
+static void unmap_ring(void)
+{
+    if (ring) {
+        munmap((void *)ring, ring_size);
+        ring = NULL;
+    }
+}
+#endif
+
+/* Releases everything and returns the exit code, so any failure can bail out */
+static int quit(int result)
+{
+#ifdef __LINUX__
+    unmap_ring();
+#endif
+    if (window) {
+        SDL_DestroyWindow(window);
+    }
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
+
+static int check(SDL_bool condition, const char *message)
+{
+    if (!condition) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FAILED: %s", message);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    SDL_Surface *surface;
+    SDL_Renderer *renderer;
+    const SDL_OffscreenFrameRingHeader *header;
+    const SDL_OffscreenFrameHeader *frame;
+    SDL_Rect rect;
+    SDL_FRect frect;
+    Uint32 red, green;
+    int result = 0;
+    int i, iterations = 1000;
+    Uint64 start;
+    double seconds;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (state == NULL) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--iterations") == 0 && argv[i + 1]) {
+                iterations = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return quit(1);
+        }
+
+        i += consumed;
+    }
+
+#ifndef __LINUX__
+    SDL_Log("Shared memory frame rings aren't available on this platform");
+    SDLTest_CommonDestroyState(state);
+    return 0;
+#else
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen");
+    SDL_SetHint(SDL_HINT_FRAMEBUFFER_ACCELERATION, "0");
+    SDL_SetHint(SDL_HINT_VIDEO_OFFSCREEN_FRAME_RING, "3");
+
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        SDL_Log("Couldn't initialize the offscreen video driver: %s", SDL_GetError());
+        SDLTest_CommonDestroyState(state);
+        return 0;
+    }
+
+    window = SDL_CreateWindow("Offscreen frame ring", 320, 240, 0);
+    surface = window ? SDL_GetWindowSurface(window) : NULL;
+    if (surface == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create window surface: %s", SDL_GetError());
+        return quit(1);
+    }
+
+    if (SDL_GetWindowData(window, SDL_WINDOW_DATA_OFFSCREEN_FRAME_RING_FD) == NULL) {
+        SDL_Log("The offscreen video driver wasn't built with frame ring support");
+        return quit(0);
+    }
+
+    ring = map_ring(&ring_size);
+    if (ring == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't map the frame ring");
+        return quit(1);
+    }
+    header = (const SDL_OffscreenFrameRingHeader *)ring;
+
+    result |= check(header->magic == SDL_OFFSCREEN_FRAME_RING_MAGIC && header->version == SDL_OFFSCREEN_FRAME_RING_VERSION, "ring header magic and version");
+    result |= check(header->format == surface->format->format, "ring pixel format");
+    result |= check(header->w == surface->w && header->h == surface->h && header->pitch == surface->pitch, "ring frame size");
+    result |= check(header->num_frames == NUM_FRAMES, "ring frame count");
+    result |= check(SDL_AtomicGet((SDL_AtomicInt *)&header->latest_frame) == 0, "no frames presented yet");
+
+    red = SDL_MapRGB(surface->format, 255, 0, 0);
+    green = SDL_MapRGB(surface->format, 0, 255, 0);
+
+    /* Frame 1, the whole window */
+    SDL_FillSurfaceRect(surface, NULL, red);
+    SDL_UpdateWindowSurface(window);
+    result |= check(SDL_AtomicGet((SDL_AtomicInt *)&header->latest_frame) == 1, "frame 1 presented");
+    result |= check(SDL_AtomicGet((SDL_AtomicInt *)&get_frame(0)->frame_number) == 1, "frame 1 is in the first slot");
+    result |= check(get_frame(0)->num_rects == 0, "frame 1 changed completely");
+    result |= check(get_pixel(0, 100, 100) == red, "frame 1 is red");
+    result |= check(SDL_AtomicGet((SDL_AtomicInt *)&get_frame(1)->frame_number) == 0, "the second slot is being drawn");
+
+    /* Frame 2, a small rectangle on top of frame 1 */
+    rect.x = 10;
+    rect.y = 20;
+    rect.w = 4;
+    rect.h = 4;
+    SDL_FillSurfaceRect(surface, &rect, green);
+    SDL_UpdateWindowSurfaceRects(window, &rect, 1);
+    result |= check(SDL_AtomicGet((SDL_AtomicInt *)&header->latest_frame) == 2, "frame 2 presented");
+    result |= check(get_frame(1)->num_rects == 1 && SDL_RectsEqual(&get_frame(1)->rects[0], &rect), "frame 2 dirty rect");
+    result |= check(get_pixel(1, 11, 21) == green, "frame 2 has the green rectangle");
+    result |= check(get_pixel(1, 100, 100) == red, "frame 2 kept the rest of frame 1");
+    result |= check(get_pixel(0, 11, 21) == red, "frame 1 wasn't touched");
+
+    /* Frame 3, nothing drawn, it should match frame 2 */
+    SDL_UpdateWindowSurface(window);
+    result |= check(get_pixel(2, 11, 21) == green && get_pixel(2, 100, 100) == red, "frame 3 matches frame 2");
+
+    /* The first slot is drawn again and caught up with frames 2 and 3 */
+    result |= check(SDL_AtomicGet((SDL_AtomicInt *)&get_frame(0)->frame_number) == 0, "the first slot is being drawn");
+    result |= check(get_pixel(0, 11, 21) == green, "the first slot caught up with frame 2");
+
+    /* Frame 4, a rectangle elsewhere, later frames catch up with it even though they don't update it */
+    rect.x = 50;
+    rect.y = 50;
+    SDL_FillSurfaceRect(surface, &rect, green);
+    SDL_UpdateWindowSurfaceRects(window, &rect, 1);
+    rect.x = 10;
+    rect.y = 20;
+    for (i = 0; i < NUM_FRAMES; ++i) {
+        SDL_UpdateWindowSurfaceRects(window, &rect, 1);
+        result |= check(get_pixel((4 + i) % NUM_FRAMES, 51, 51) == green, "later frames kept the rectangle of frame 4");
+    }
+
+    /* Present small updates as fast as possible */
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; ++i) {
+        rect.x = i % (surface->w - rect.w);
+        SDL_FillSurfaceRect(surface, &rect, (i & 1) ? red : green);
+        SDL_UpdateWindowSurfaceRects(window, &rect, 1);
+    }
+    seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    SDL_Log("Presented %d frames in %.3f ms, %.0f frames/s", iterations, seconds * 1000.0, iterations / seconds);
+
+    SDL_DestroyWindow(window);
+    window = NULL;
+    result |= check(SDL_AtomicGet((SDL_AtomicInt *)&header->closed) != 0, "ring closed with the window");
+
+    unmap_ring();
+
+    /* The software renderer only presents what it drew */
+    window = SDL_CreateWindow("Offscreen frame ring", 320, 240, 0);
+    renderer = window ? SDL_CreateRenderer(window, "software", 0) : NULL;
+    if (renderer == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create software renderer: %s", SDL_GetError());
+        return quit(1);
+    }
+    ring = map_ring(&ring_size);
+    if (ring == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't map the frame ring");
+        return quit(1);
+    }
+    header = (const SDL_OffscreenFrameRingHeader *)ring;
+
+    SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    SDL_RenderPresent(renderer);
+    frame = get_frame(0);
+    result |= check(SDL_AtomicGet((SDL_AtomicInt *)&frame->frame_number) == 1 && frame->num_rects == 0, "renderer cleared the whole window");
+
+    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
+    frect.x = 10.0f;
+    frect.y = 20.0f;
+    frect.w = 4.0f;
+    frect.h = 4.0f;
+    SDL_RenderFillRect(renderer, &frect);
+    frect.x = 200.0f;
+    SDL_RenderFillRect(renderer, &frect);
+    SDL_RenderPresent(renderer);
+    frame = get_frame(1);
+    rect.x = 10;
+    rect.y = 20;
+    rect.w = 4;
+    rect.h = 4;
+    result |= check(frame->num_rects == 2, "renderer presented two rectangles");
+    result |= check(SDL_RectsEqual(&frame->rects[0], &rect) || SDL_RectsEqual(&frame->rects[1], &rect), "renderer presented the first rectangle");
+    result |= check(get_pixel(1, 11, 21) != get_pixel(1, 100, 100), "renderer drew the first rectangle");
+
+    /* Overlapping draws are merged */
+    frect.x = 12.0f;
+    SDL_RenderFillRect(renderer, &frect);
+    frect.x = 14.0f;
+    SDL_RenderFillRect(renderer, &frect);
+    SDL_RenderPresent(renderer);
+    frame = get_frame(2);
+    rect.x = 12;
+    rect.w = 6;
+    result |= check(frame->num_rects == 1 && SDL_RectsEqual(&frame->rects[0], &rect), "renderer merged overlapping rectangles");
+
+    /* Nothing drawn, nothing presented */
+    SDL_RenderPresent(renderer);
+    result |= check(SDL_AtomicGet((SDL_AtomicInt *)&header->latest_frame) == 3, "renderer skipped an empty frame");
+
+    SDL_DestroyRenderer(renderer);
+
+    if (result == 0) {
+        SDL_Log("All frame ring checks passed");
+    }
+    return quit(result);
+#endif /* __LINUX__ */
+}
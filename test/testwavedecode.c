@@ -0,0 +1,222 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures the ADPCM decoding throughput of SDL_LoadWAV_RW() and checks that
+ * multi-threaded decoding gives the same result as single-threaded decoding.
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define MS_ADPCM_CODE  0x0002
+#define IMA_ADPCM_CODE 0x0011
+
+static void put16(Uint8 **p, Uint16 v)
+{
+    (*p)[0] = (Uint8)(v & 0xff);
+    (*p)[1] = (Uint8)(v >> 8);
+    *p += 2;
+}
+
+static void put32(Uint8 **p, Uint32 v)
+{
+    put16(p, (Uint16)(v & 0xffff));
+    put16(p, (Uint16)(v >> 16));
+}
+
+/* Builds a WAVE file with random ADPCM data. Any nibble sequence is valid
+ * ADPCM, only the block headers need sane values.
+ */
+static Uint8 *build_adpcm_wave(SDLTest_RandomContext *rndctx, Uint16 encoding, Uint16 channels, Uint16 blockalign, Uint32 blocks, size_t *len)
+{
+    static const Sint16 coeffs[14] = { 256, 0, 512, -256, 0, 0, 192, 64, 240, 0, 460, -208, 392, -232 };
+    const SDL_bool ms = (encoding == MS_ADPCM_CODE) ? SDL_TRUE : SDL_FALSE;
+    const Uint32 headersize = ms ? 7 * channels : 4 * channels;
+    const Uint16 samplesperblock = (Uint16)((blockalign - headersize) * 2 / channels + (ms ? 2 : 1));
+    const Uint32 fmtlen = ms ? 50 : 20;
+    const Uint32 datalen = (Uint32)blockalign * blocks;
+    Uint8 *wave, *p;
+    Uint32 i, b, c;
+
+    *len = 12 + 8 + fmtlen + 8 + datalen;
+    wave = (Uint8 *)SDL_malloc(*len);
+    if (wave == NULL) {
+        return NULL;
+    }
+
+    p = wave;
+    SDL_memcpy(p, "RIFF", 4);
+    p += 4;
+    put32(&p, (Uint32)(*len - 8));
+    SDL_memcpy(p, "WAVEfmt ", 8);
+    p += 8;
+    put32(&p, fmtlen);
+    put16(&p, encoding);
+    put16(&p, channels);
+    put32(&p, 44100);
+    put32(&p, 44100 * blockalign / samplesperblock);
+    put16(&p, blockalign);
+    put16(&p, 4);
+    put16(&p, (Uint16)(fmtlen - 18));
+    put16(&p, samplesperblock);
+    if (ms) {
+        put16(&p, 7);
+        for (i = 0; i < SDL_arraysize(coeffs); i++) {
+            put16(&p, (Uint16)coeffs[i]);
+        }
+    }
+    SDL_memcpy(p, "data", 4);
+    p += 4;
+    put32(&p, datalen);
+
+    for (i = 0; i < datalen; i++) {
+        p[i] = (Uint8)SDLTest_RandomInt(rndctx);
+    }
+    for (b = 0; b < blocks; b++) {
+        Uint8 *block = p + (size_t)b * blockalign;
+        for (c = 0; c < channels; c++) {
+            if (ms) {
+                block[c] %= 7; /* Predictor index. */
+            } else {
+                block[c * 4 + 2] %= 89; /* Step index. */
+                block[c * 4 + 3] = 0;
+            }
+        }
+    }
+
+    return wave;
+}
+
+static int decode(const Uint8 *wave, size_t len, const char *threads, Uint8 **buf, Uint32 *buflen, double *seconds)
+{
+    SDL_AudioSpec spec;
+    Uint64 start;
+    int result;
+
+    SDL_SetHint(SDL_HINT_CONVERT_THREADS, threads);
+    start = SDL_GetPerformanceCounter();
+    result = SDL_LoadWAV_RW(SDL_RWFromConstMem(wave, (int)len), SDL_TRUE, &spec, buf, buflen);
+    *seconds = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    if (result < 0) {
+        SDL_Log("SDL_LoadWAV_RW() failed: %s", SDL_GetError());
+    }
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    static const struct
+    {
+        const char *name;
+        Uint16 encoding;
+        Uint16 channels;
+        Uint16 blockalign;
+    } formats[] = {
+        { "MS ADPCM mono", MS_ADPCM_CODE, 1, 512 },
+        { "MS ADPCM stereo", MS_ADPCM_CODE, 2, 1024 },
+        { "IMA ADPCM mono", IMA_ADPCM_CODE, 1, 512 },
+        { "IMA ADPCM stereo", IMA_ADPCM_CODE, 2, 1024 },
+        { "IMA ADPCM 5.1", IMA_ADPCM_CODE, 6, 2040 }
+    };
+    SDLTest_CommonState *state;
+    SDLTest_RandomContext rndctx;
+    Uint32 blocks = 4096;
+    int iterations = 3;
+    int result = 0;
+    int i, f;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (state == NULL) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--blocks") == 0 && argv[i + 1]) {
+                blocks = (Uint32)SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--iterations") == 0 && argv[i + 1]) {
+                iterations = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--blocks N]", "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (blocks == 0 || iterations <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Block and iteration counts must be positive.");
+        return 1;
+    }
+
+    SDLTest_RandomInit(&rndctx, 0x12345678, 0x9abcdef0);
+    SDL_Log("Decoding %" SDL_PRIu32 " blocks, %d iterations, %d CPUs", blocks, iterations, SDL_GetCPUCount());
+
+    for (f = 0; f < (int)SDL_arraysize(formats); f++) {
+        Uint8 *single = NULL, *multi = NULL;
+        Uint32 singlelen = 0, multilen = 0;
+        double singletime = 0.0, multitime = 0.0, seconds;
+        size_t wavelen;
+        Uint8 *wave = build_adpcm_wave(&rndctx, formats[f].encoding, formats[f].channels, formats[f].blockalign, blocks, &wavelen);
+
+        if (wave == NULL) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+            return 1;
+        }
+
+        for (i = 0; i < iterations; i++) {
+            SDL_free(single);
+            SDL_free(multi);
+            single = multi = NULL;
+            if (decode(wave, wavelen, "1", &single, &singlelen, &seconds) < 0) {
+                result = 1;
+                break;
+            }
+            singletime += seconds;
+            if (decode(wave, wavelen, "", &multi, &multilen, &seconds) < 0) {
+                result = 1;
+                break;
+            }
+            multitime += seconds;
+        }
+
+        if (single != NULL && multi != NULL) {
+            const double megabytes = (double)singlelen * iterations / (1024.0 * 1024.0);
+            SDL_Log("%-18s single-threaded: %8.1f MB/s, multi-threaded: %8.1f MB/s", formats[f].name,
+                    megabytes / singletime, megabytes / multitime);
+            if (singlelen != multilen || SDL_memcmp(single, multi, singlelen) != 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: multi-threaded output differs!", formats[f].name);
+                result = 1;
+            }
+        }
+
+        SDL_free(single);
+        SDL_free(multi);
+        SDL_free(wave);
+    }
+
+    SDL_ResetHint(SDL_HINT_CONVERT_THREADS);
+    SDLTest_CommonDestroyState(state);
+
+    return result;
+}
@@ -0,0 +1,183 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how long it takes to get from an event back to its window and
+ * that window's named data, as the number of windows grows. Every window
+ * carries several named data pointers, like the tool windows of an editor.
+ * Uses the dummy video driver, so no windows actually appear.
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define EVENT_BATCH 1000
+
+static const char *data_names[] = {
+    "editor.panel",
+    "editor.layout",
+    "editor.theme",
+    "editor.shortcuts",
+    "editor.undo",
+    "editor.selection",
+    "editor.viewport",
+    "editor.document"
+};
+
+/* Returns the average nanoseconds to resolve one event, or a negative value on error */
+static double measure(int num_windows, int num_events, double *lookup_ns)
+{
+    SDL_Window **windows;
+    SDL_Event events[EVENT_BATCH];
+    Uint64 start, elapsed, lookups = 0;
+    double result = -1.0;
+    int i, j, sent = 0, resolved = 0;
+    Uint32 checksum = 0;
+
+    windows = (SDL_Window **)SDL_calloc(num_windows, sizeof(SDL_Window *));
+    if (windows == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory");
+        return -1.0;
+    }
+
+    for (i = 0; i < num_windows; ++i) {
+        windows[i] = SDL_CreateWindow("testwindowlookupperf", 64, 64, SDL_WINDOW_HIDDEN);
+        if (windows[i] == NULL) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create window: %s", SDL_GetError());
+            goto done;
+        }
+        for (j = 0; j < (int)SDL_arraysize(data_names); ++j) {
+            SDL_SetWindowData(windows[i], data_names[j], &windows[i]);
+        }
+    }
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    /* Straight lookups first, cycling through every window */
+    start = SDL_GetPerformanceCounter();
+    while (lookups < (Uint64)num_events) {
+        for (i = 0; i < num_windows; ++i) {
+            if (SDL_GetWindowFromID(SDL_GetWindowID(windows[i])) != windows[i]) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_GetWindowFromID returned the wrong window");
+                goto done;
+            }
+        }
+        lookups += num_windows;
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+    *lookup_ns = ((double)elapsed * 1000000000.0) / SDL_GetPerformanceFrequency() / lookups;
+
+    /* Then the whole trip: queue window events, and find the window and its data for each one */
+    start = SDL_GetPerformanceCounter();
+    while (sent < num_events) {
+        const int batch = SDL_min(EVENT_BATCH, num_events - sent);
+        for (i = 0; i < batch; ++i) {
+            SDL_zero(events[i]);
+            events[i].type = SDL_EVENT_WINDOW_EXPOSED;
+            events[i].window.windowID = SDL_GetWindowID(windows[(sent + i) % num_windows]);
+        }
+        if (SDL_PeepEvents(events, batch, SDL_ADDEVENT, 0, 0) != batch) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't queue events: %s", SDL_GetError());
+            goto done;
+        }
+        sent += batch;
+
+        while (SDL_PollEvent(&events[0])) {
+            SDL_Window *window = SDL_GetWindowFromID(events[0].window.windowID);
+            if (window == NULL) {
+                continue;
+            }
+            /* The first name set is the last one in the list */
+            checksum += (Uint32)(uintptr_t)SDL_GetWindowData(window, data_names[0]);
+            ++resolved;
+        }
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+
+    if (resolved != num_events || checksum == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Resolved %d of %d events", resolved, num_events);
+        goto done;
+    }
+    result = ((double)elapsed * 1000000000.0) / SDL_GetPerformanceFrequency() / num_events;
+
+done:
+    for (i = 0; i < num_windows; ++i) {
+        if (windows[i]) {
+            SDL_DestroyWindow(windows[i]);
+        }
+    }
+    SDL_free(windows);
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    static const int window_counts[] = { 1, 16, 64, 256, 1024 };
+    SDLTest_CommonState *state;
+    int num_events = 200000;
+    int result = 0;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (state == NULL) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--events") == 0 && argv[i + 1]) {
+                num_events = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--events N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (num_events <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "The number of events must be positive.");
+        return 1;
+    }
+
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize video: %s", SDL_GetError());
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+
+    SDL_Log("%8s %16s %16s", "windows", "lookup ns", "event ns");
+    for (i = 0; i < (int)SDL_arraysize(window_counts); ++i) {
+        double lookup = 0.0;
+        const double event = measure(window_counts[i], num_events, &lookup);
+
+        if (event < 0.0) {
+            result = 1;
+            break;
+        }
+        SDL_Log("%8d %16.1f %16.1f", window_counts[i], lookup, event);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return result;
+}